@@ -516,7 +516,7 @@ static B32 eng_ensure_job_system(EngContext* ctx) {
     }
 
     state->workerCount = eng_select_worker_count(ctx->host);
-    state->jobSystem = job_system_create(ctx->host->stateArena, state->workerCount);
+    state->jobSystem = job_system_create(ctx->host->stateArena, .workerCount = state->workerCount);
     if (!state->jobSystem) {
         LOG_ERROR("jobs", "Failed to create job system (workers={})", state->workerCount);
         ASSERT_ALWAYS(state->jobSystem != 0);
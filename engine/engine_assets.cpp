@@ -26,6 +26,10 @@
 //                       [2] 0 [3] mark
 #define ENG_ARTIFACT_PUBLISHED_MARK 1ull
 
+// Blob copies run as background jobs; between chunks of this size they
+// give way to queued frame work and notice cancellation.
+#define ENG_ASSET_COPY_CHUNK MB(1)
+
 // assetIndex names the project asset slot; textureLocal is the
 // model-local texture index for texture requests (model requests
 // ignore it).
@@ -57,7 +61,16 @@ static B32 eng_asset_build_blob_(ArtifactBuildContext* buildCtx, U32 expectedMag
         arena_release(arena);
         return 0;
     }
-    MEMCPY(blob, view.data, view.size);
+    for (U64 offset = 0u; offset < view.size; offset += ENG_ASSET_COPY_CHUNK) {
+        if (offset != 0u) {
+            job_system_checkpoint();
+            if (buildCtx->cancelFlag && ATOMIC_LOAD(buildCtx->cancelFlag, MEMORY_ORDER_ACQUIRE) != 0u) {
+                arena_release(arena);
+                return 0;
+            }
+        }
+        MEMCPY(blob + offset, (const U8*)view.data + offset, MIN(ENG_ASSET_COPY_CHUNK, view.size - offset));
+    }
     outValue->u64[0] = (U64)arena;
     outValue->u64[1] = (U64)blob;
     outValue->u64[2] = view.size;
@@ -62,15 +62,17 @@ static void eng_debug_draw_world_bounds(EngContext* ctx, U32 maxBounds) {
 
     F32 windowWidth = (F32)state->windowWidth;
     F32 windowHeight = (F32)state->windowHeight;
+    const ShdWorldRenderableRecord* pool = (const ShdWorldRenderableRecord*)world->recordPool.base;
+    RangeU64 ranges[ENG_WORLD_MAX_LANES + 1u];
+    U32 rangeCount = eng_world_filled_records_(world, 0, ranges);
     U32 drawn = 0u;
-    for (U32 lane = 0u; lane < world->laneCount && drawn < maxBounds; ++lane) {
-        const EngWorldLaneWriter* writer = world->laneWriters + lane;
-        U32 count = MIN(writer->count, maxBounds - drawn);
-        for (U32 renderableIndex = 0u; renderableIndex < count; ++renderableIndex) {
-            eng_debug_draw_record_bounds_(ctx, world, writer->records + renderableIndex,
+    for (U32 rangeAt = 0u; rangeAt < rangeCount && drawn < maxBounds; ++rangeAt) {
+        U64 count = MIN(ranges[rangeAt].max - ranges[rangeAt].min, (U64)(maxBounds - drawn));
+        for (U64 at = 0u; at < count; ++at) {
+            eng_debug_draw_record_bounds_(ctx, world, pool + ranges[rangeAt].min + at,
                                           windowWidth, windowHeight);
         }
-        drawn += count;
+        drawn += (U32)count;
     }
 }
 
@@ -149,6 +149,22 @@ static void eng_dbg_tab_overview_(EngContext* ctx, UI_Context* ui) {
     eng_dbg_kv(ui, "profiler", UI_COLOR_TEXT, "res {:.0}ns  scope {:.1}ns  sites {}",
                info.resolutionNs, info.overheadNsPerScope, info.siteCount);
 
+    if (state->jobSystem) {
+        eng_dbg_section_(ui, "jobs (executed  steals / tries  idle  parked  queue hw)");
+        U32 threadCount = job_system_thread_count(state->jobSystem);
+        for (U32 threadIndex = 0u; threadIndex < threadCount; ++threadIndex) {
+            JobSystemStats jobs = job_system_stats(state->jobSystem, threadIndex);
+            U64 executed = 0u;
+            for (U32 priority = 0u; priority < JobPriority_Count; ++priority) {
+                executed += jobs.executed[priority];
+            }
+            eng_dbg_kv(ui, threadIndex == 0u ? "main" : "worker", UI_COLOR_TEXT,
+                       "#{}  {}  {} / {}  {:.0}ms  {:.0}ms  {}", threadIndex, executed,
+                       jobs.steals, jobs.stealAttempts, (F64)jobs.idleNs / 1.0e6,
+                       (F64)jobs.parkedNs / 1.0e6, jobs.queueHighWater);
+        }
+    }
+
     eng_dbg_section_(ui, "warnings");
     const UI_Stats* uiStats = &state->ui.stats;
     const GfxStats* gfx = &state->render2d.lastGfxStats;
@@ -411,6 +427,100 @@ static void eng_dbg_tab_graphics_(EngContext* ctx, UI_Context* ui) {
     }
 }
 
+#if ARENA_TRACKING
+static void eng_dbg_alloc_row_(UI_Context* ui, const ProfSiteStats* stats, const ProfPathStats* path,
+                               U64 laneBytes) {
+    const ProfSiteStats* siteStats = stats + path->site;
+    StringU8 indent = str8("");
+    if (path->depth != 0u) {
+        U64 pad = (U64)path->depth * 2u;
+        U8* padBytes = ARENA_PUSH_ARRAY(ui->frameArena, U8, pad);
+        if (padBytes) {
+            MEMSET(padBytes, ' ', pad);
+            indent = str8(padBytes, pad);
+        }
+    }
+    B32 isCallsite = (siteStats->category == PROF_CAT_ALLOC);
+    StringU8 name = isCallsite
+        ? str8_fmt(ui->frameArena, "{}{}:{}", indent, str8(siteStats->label), siteStats->line)
+        : str8_fmt(ui->frameArena, "{}{}", indent, str8(siteStats->label));
+    StringU8 detail = str8_fmt(ui->frameArena, "{}  max {}",
+                               eng_dbg_bytes_(ui->frameArena, path->avgAllocBytes),
+                               eng_dbg_bytes_(ui->frameArena, path->maxAllocBytes));
+    if (isCallsite) {
+        detail = str8_fmt(ui->frameArena, "{}  x{}", detail, (U32)(siteStats->avgAllocs + 0.5f));
+    }
+    eng_dbg_meter_row_(ui, name, path->avgAllocBytes, laneBytes, detail);
+}
+
+static B32 eng_dbg_alloc_path_live_(const ProfPathStats* path) {
+    return (path->avgAllocBytes != 0u || path->lastAllocBytes != 0u) ? 1 : 0;
+}
+
+// Memory flame view: the profiler's scope tree weighed by the arena bytes
+// pushed under each path per frame, bars relative to the thread's total.
+// The leaves are the arena_push callsites.
+static void eng_dbg_alloc_flame_(UI_Context* ui) {
+    U32 siteCount = 0u;
+    U32 pathCount = 0u;
+    const ProfSiteStats* stats = prof_site_stats(&siteCount);
+    const ProfPathStats* paths = prof_path_stats(&pathCount);
+    const ProfFrameView* view = prof_frame_view();
+    if (!stats || !paths || !view) {
+        ui_label_colored(ui, str8("profiler is off"), UI_COLOR_TEXT_DIM);
+        return;
+    }
+
+    for (U32 laneIndex = 0u; laneIndex < view->laneCount; ++laneIndex) {
+        const ProfLaneView* lane = view->lanes + laneIndex;
+        U64 laneBytes = 0u;
+        for (U32 root = 1u; root < pathCount; ++root) {
+            if (paths[root].parent == PROF_PATH_NIL && paths[root].thread == lane->threadIndex) {
+                laneBytes += paths[root].avgAllocBytes;
+            }
+        }
+        if (laneBytes == 0u) {
+            continue;
+        }
+        ui_label_value(ui, ENG_DBG_COLOR_HEADER, "[{}] {}/frame", str8(lane->name),
+                       eng_dbg_bytes_(ui->frameArena, laneBytes));
+
+        for (U32 root = 1u; root < pathCount; ++root) {
+            if (paths[root].parent != PROF_PATH_NIL || paths[root].thread != lane->threadIndex) {
+                continue;
+            }
+            if (!eng_dbg_alloc_path_live_(paths + root)) {
+                continue;
+            }
+            eng_dbg_alloc_row_(ui, stats, paths + root, laneBytes);
+
+            U32 walkStack[PROF_OPEN_STACK_DEPTH + 1u];
+            U32 walkTop = 0u;
+            U32 current = paths[root].firstChild;
+            while (current != PROF_PATH_NIL || walkTop != 0u) {
+                if (current == PROF_PATH_NIL) {
+                    walkTop -= 1u;
+                    current = paths[walkStack[walkTop]].nextSibling;
+                    continue;
+                }
+                if (!eng_dbg_alloc_path_live_(paths + current)) {
+                    current = paths[current].nextSibling;
+                    continue;
+                }
+                eng_dbg_alloc_row_(ui, stats, paths + current, laneBytes);
+                if (paths[current].firstChild != PROF_PATH_NIL && walkTop < ARRAY_COUNT(walkStack)) {
+                    walkStack[walkTop] = current;
+                    walkTop += 1u;
+                    current = paths[current].firstChild;
+                } else {
+                    current = paths[current].nextSibling;
+                }
+            }
+        }
+    }
+}
+#endif
+
 static void eng_dbg_tab_memory_(EngContext* ctx, UI_Context* ui) {
     EngState* state = ctx->engine;
 
@@ -424,6 +534,8 @@ static void eng_dbg_tab_memory_(EngContext* ctx, UI_Context* ui) {
         U64 committed;
         U64 pos;
         U64 highWater;
+        U64 reclaimed;
+        U64 largePageBytes;
         U32 instances;
     };
     ArenaAgg aggs[ARENA_DEBUG_MAX];
@@ -444,12 +556,16 @@ static void eng_dbg_tab_memory_(EngContext* ctx, UI_Context* ui) {
             agg->committed = 0u;
             agg->pos = 0u;
             agg->highWater = 0u;
+            agg->reclaimed = 0u;
+            agg->largePageBytes = 0u;
             agg->instances = 0u;
         }
         agg->reserved += infos[i].reserved;
         agg->committed += infos[i].committed;
         agg->pos += infos[i].pos;
         agg->highWater = MAX(agg->highWater, infos[i].highWater);
+        agg->reclaimed += infos[i].reclaimed;
+        agg->largePageBytes += infos[i].largePageBytes;
         agg->instances += 1u;
     }
     for (U32 i = 0u; i < aggCount; ++i) {
@@ -457,11 +573,19 @@ static void eng_dbg_tab_memory_(EngContext* ctx, UI_Context* ui) {
         StringU8 name = (agg->instances > 1u)
             ? str8_fmt(ui->frameArena, "{} x{}", str8(agg->name), agg->instances)
             : str8(agg->name);
-        eng_dbg_meter_row_(ui, name, agg->pos, agg->committed,
-                           str8_fmt(ui->frameArena, "{} / {}  hw {}",
-                                    eng_dbg_bytes_(ui->frameArena, agg->pos),
-                                    eng_dbg_bytes_(ui->frameArena, agg->committed),
-                                    eng_dbg_bytes_(ui->frameArena, agg->highWater)));
+        StringU8 detail = str8_fmt(ui->frameArena, "{} / {}  hw {}",
+                                   eng_dbg_bytes_(ui->frameArena, agg->pos),
+                                   eng_dbg_bytes_(ui->frameArena, agg->committed),
+                                   eng_dbg_bytes_(ui->frameArena, agg->highWater));
+        if (agg->reclaimed != 0u) {
+            detail = str8_fmt(ui->frameArena, "{}  freed {}", detail,
+                              eng_dbg_bytes_(ui->frameArena, agg->reclaimed));
+        }
+        if (agg->largePageBytes != 0u) {
+            detail = str8_fmt(ui->frameArena, "{}  huge {}", detail,
+                              eng_dbg_bytes_(ui->frameArena, agg->largePageBytes));
+        }
+        eng_dbg_meter_row_(ui, name, agg->pos, agg->committed, detail);
     }
 
     eng_dbg_section_(ui, "gpu frame memory");
@@ -501,6 +625,11 @@ static void eng_dbg_tab_memory_(EngContext* ctx, UI_Context* ui) {
         eng_dbg_bytes_meter_(ui, "actions", (U64)replay->cursor * actionSize,
                              sizeof(replay->actions));
     }
+
+#if ARENA_TRACKING
+    eng_dbg_section_(ui, "arena pushes (avg / frame)");
+    eng_dbg_alloc_flame_(ui);
+#endif
 }
 
 static void eng_dbg_tab_assets_(EngContext* ctx, UI_Context* ui) {
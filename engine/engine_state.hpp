@@ -141,15 +141,17 @@ struct EngWorldModelResources {
     F32 boundsRadius;
 };
 
-// One per extraction lane; slices of the per-frame arrays, no sharing.
-// Transparent depth/cull happen at merge time on the main thread.
+// One per extraction lane. Lanes share the frame's record pools and claim
+// ENG_WORLD_RECORD_CHUNK records at a time, so a busy lane is only capped
+// by the pool, not by an even split. Transparent depth/cull happen at merge
+// time on the main thread.
+#define ENG_WORLD_RECORD_CHUNK 32u
+
 struct EngWorldLaneWriter {
-    ShdWorldRenderableRecord* records;
+    AtomicArenaCursor records;
+    AtomicArenaCursor transparents;
     U32 count;
-    U32 cap;
-    ShdWorldRenderableRecord* transparents;
     U32 transparentCount;
-    U32 transparentCap;
     U32 dropped;
 };
 
@@ -212,6 +214,8 @@ struct EngWorldState {
 
     ShdWorldFrameRecord frameRecord;
     Vec3F32 cameraForward;
+    AtomicArena recordPool;      // ShdWorldRenderableRecord, opaque + alpha-test
+    AtomicArena transparentPool; // ShdWorldRenderableRecord, transparent bin
     EngWorldLaneWriter* laneWriters;
     U32 laneCount;
     U32 requestedLaneCount; // project policy, set in pre_frame; 0 = single lane
@@ -576,26 +576,33 @@ static void eng_world_begin_frame_(EngContext* ctx) {
     }
     world->laneCount = laneCount;
     world->laneWriters = ARENA_PUSH_ARRAY(arena, EngWorldLaneWriter, laneCount);
-    ShdWorldRenderableRecord* records = ARENA_PUSH_ARRAY(arena, ShdWorldRenderableRecord, ENG_WORLD_MAX_RENDERABLES);
-    ShdWorldRenderableRecord* transparents = ARENA_PUSH_ARRAY(arena, ShdWorldRenderableRecord, ENG_WORLD_MAX_TRANSPARENTS);
-    world->frameOpen = (world->laneWriters != 0 && records != 0 && transparents != 0);
+    U64 chunkBytes = sizeof(ShdWorldRenderableRecord) * ENG_WORLD_RECORD_CHUNK;
+    world->frameOpen =
+        world->laneWriters != 0 &&
+        atomic_arena_init(&world->recordPool, arena, sizeof(ShdWorldRenderableRecord) * ENG_WORLD_MAX_RENDERABLES, chunkBytes) &&
+        atomic_arena_init(&world->transparentPool, arena, sizeof(ShdWorldRenderableRecord) * ENG_WORLD_MAX_TRANSPARENTS, chunkBytes);
     if (!world->frameOpen) {
         eng_world_fail_once_(world, EngWorldFailLog_FrameAlloc, "frame arena exhausted in begin");
         return;
     }
+    MEMSET(world->laneWriters, 0, sizeof(EngWorldLaneWriter) * laneCount);
+}
 
-    U32 cap = ENG_WORLD_MAX_RENDERABLES / laneCount;
-    U32 transparentCap = ENG_WORLD_MAX_TRANSPARENTS / laneCount;
-    for (U32 lane = 0u; lane < laneCount; ++lane) {
-        EngWorldLaneWriter* writer = world->laneWriters + lane;
-        writer->records = records + (U64)lane * cap;
-        writer->count = 0u;
-        writer->cap = cap;
-        writer->transparents = transparents + (U64)lane * transparentCap;
-        writer->transparentCount = 0u;
-        writer->transparentCap = transparentCap;
-        writer->dropped = 0u;
+// Records a pool holds once every lane is done, as index ranges into the
+// pool; out needs ENG_WORLD_MAX_LANES + 1 entries.
+static U32 eng_world_filled_records_(EngWorldState* world, B32 transparents, RangeU64* out) {
+    AtomicArenaCursor cursors[ENG_WORLD_MAX_LANES];
+    for (U32 lane = 0u; lane < world->laneCount; ++lane) {
+        const EngWorldLaneWriter* writer = world->laneWriters + lane;
+        cursors[lane] = transparents ? writer->transparents : writer->records;
+    }
+    AtomicArena* pool = transparents ? &world->transparentPool : &world->recordPool;
+    U32 rangeCount = atomic_arena_filled_ranges(pool, cursors, world->laneCount, out);
+    for (U32 at = 0u; at < rangeCount; ++at) {
+        out[at].min /= sizeof(ShdWorldRenderableRecord);
+        out[at].max /= sizeof(ShdWorldRenderableRecord);
     }
+    return rangeCount;
 }
 
 static void eng_world_set_camera(EngContext* ctx, Vec3F32 eye, Vec3F32 target, F32 fovYRadians,
@@ -657,22 +664,21 @@ static void eng_world_writer_push_(EngWorldState* world, EngWorldLaneWriter* wri
         : (U32)bin * ENG_WORLD_MAX_MESHES + meshHandle.index;
     record.flags = 0u;
 
-    if (bin == EngWorldBin_Transparent) {
-        if (writer->transparentCount >= writer->transparentCap) {
-            writer->dropped += 1u;
-            return;
-        }
-        writer->transparents[writer->transparentCount] = record;
-        writer->transparentCount += 1u;
-        return;
-    }
-
-    if (writer->count >= writer->cap) {
+    B32 transparent = (bin == EngWorldBin_Transparent);
+    ShdWorldRenderableRecord* slot = (ShdWorldRenderableRecord*)atomic_arena_push(
+        transparent ? &world->transparentPool : &world->recordPool,
+        transparent ? &writer->transparents : &writer->records,
+        sizeof(ShdWorldRenderableRecord), alignof(ShdWorldRenderableRecord));
+    if (!slot) {
         writer->dropped += 1u;
         return;
     }
-    writer->records[writer->count] = record;
-    writer->count += 1u;
+    *slot = record;
+    if (transparent) {
+        writer->transparentCount += 1u;
+    } else {
+        writer->count += 1u;
+    }
 }
 
 static void eng_world_push(EngContext* ctx, EngWorldMeshHandle meshHandle, U32 materialIndex,
@@ -709,18 +715,36 @@ static B32 eng_world_cull_sort_transparents_(EngWorldState* world, Arena* frameA
     const F32* planes = world->frameRecord.frustumPlanes;
     const F32* eye = world->frameRecord.cameraPos;
     Vec3F32 forward = world->cameraForward;
+    const ShdWorldRenderableRecord* pool = (const ShdWorldRenderableRecord*)world->transparentPool.base;
+    RangeU64 ranges[ENG_WORLD_MAX_LANES + 1u];
+    U32 rangeCount = eng_world_filled_records_(world, 1, ranges);
+    // Eight records per step: gather bounds to SoA, cull and key them
+    // together, then compact the visible lanes in record order.
     U32 visible = 0u;
-    for (U32 lane = 0u; lane < world->laneCount; ++lane) {
-        const EngWorldLaneWriter* writer = world->laneWriters + lane;
-        for (U32 at = 0u; at < writer->transparentCount; ++at) {
-            const ShdWorldRenderableRecord* record = writer->transparents + at;
-            F32 radius = record->boundsRadius;
-            if (!eng_world_sphere_visible_(planes, record->boundsCenter, radius)) {
-                continue;
+    for (U32 rangeAt = 0u; rangeAt < rangeCount; ++rangeAt) {
+        for (U64 at = ranges[rangeAt].min; at < ranges[rangeAt].max; at += 8u) {
+            U32 lanes = (U32)MIN(ranges[rangeAt].max - at, (U64)8u);
+            F32 xs[8] = {};
+            F32 ys[8] = {};
+            F32 zs[8] = {};
+            F32 radii[8] = {};
+            for (U32 lane = 0u; lane < lanes; ++lane) {
+                const ShdWorldRenderableRecord* record = pool + at + lane;
+                xs[lane] = record->boundsCenter[0];
+                ys[lane] = record->boundsCenter[1];
+                zs[lane] = record->boundsCenter[2];
+                radii[lane] = record->boundsRadius;
+            }
+            F32 laneDepths[8];
+            U32 visibleLanes = eng_world_cull_depth_x8_(planes, eye, forward, vec3x8_load(xs, ys, zs),
+                                                        f32x8_load(radii), laneDepths);
+            for (U32 lane = 0u; lane < lanes; ++lane) {
+                if (visibleLanes & (1u << lane)) {
+                    depths[visible] = laneDepths[lane];
+                    sources[visible] = pool + at + lane;
+                    visible += 1u;
+                }
             }
-            depths[visible] = eng_world_transparent_depth_(record->boundsCenter, radius, eye, forward);
-            sources[visible] = record;
-            visible += 1u;
         }
     }
     if (visible == 0u) {
@@ -762,6 +786,55 @@ static B32 eng_world_cull_sort_transparents_(EngWorldState* world, Arena* frameA
     return 1;
 }
 
+// Upload stage: the opaque copy and the transparent cull/sort write
+// disjoint ranges of the mapped renderable buffer (head and tail), so they
+// run as two job graph branches while the render thread records the
+// mesh/material uploads. Only the transparent branch touches frameArena.
+struct EngWorldUploadStage {
+    EngWorldState* world;
+    Arena* frameArena;
+    ShdWorldRenderableRecord* renderables;
+    U32 opaqueTotal;
+    U32 transparentTotal;
+    U32* transparentCells;
+    U32 transparentUpload;
+    U32 transparentDropped;
+    B32 transparentOk;
+};
+
+static void eng_world_copy_opaques_(EngWorldUploadStage* stage) {
+    EngWorldState* world = stage->world;
+    const ShdWorldRenderableRecord* pool = (const ShdWorldRenderableRecord*)world->recordPool.base;
+    RangeU64 ranges[ENG_WORLD_MAX_LANES + 1u];
+    U32 rangeCount = eng_world_filled_records_(world, 0, ranges);
+    U64 uploadOffset = 0u;
+    for (U32 at = 0u; at < rangeCount; ++at) {
+        U64 count = ranges[at].max - ranges[at].min;
+        MEMCPY(stage->renderables + uploadOffset, pool + ranges[at].min, sizeof(ShdWorldRenderableRecord) * count);
+        uploadOffset += count;
+    }
+}
+
+static void eng_world_build_transparents_(EngWorldUploadStage* stage) {
+    PROF_SCOPE("world transparents");
+    stage->transparentOk = eng_world_cull_sort_transparents_(stage->world, stage->frameArena,
+                                                             stage->transparentTotal,
+                                                             ENG_WORLD_MAX_RENDERABLES - stage->opaqueTotal,
+                                                             stage->renderables + stage->opaqueTotal,
+                                                             &stage->transparentCells,
+                                                             &stage->transparentUpload,
+                                                             &stage->transparentDropped);
+}
+
+static void eng_world_copy_opaques_job_(void* params) {
+    PROF_SCOPE("world opaque copy");
+    eng_world_copy_opaques_(*(EngWorldUploadStage**)params);
+}
+
+static void eng_world_build_transparents_job_(void* params) {
+    eng_world_build_transparents_(*(EngWorldUploadStage**)params);
+}
+
 static void eng_world_execute_(EngContext* ctx, EngRendererFrame* rendererFrame) {
     EngState* state = ctx->engine;
     EngWorldState* world = &state->world;
@@ -808,46 +881,37 @@ static void eng_world_execute_(EngContext* ctx, EngRendererFrame* rendererFrame)
 
     // Transparents never enter the GPU cull set: CPU frustum cull + sort,
     // written as a contiguous tail after the opaque records, drawn directly.
-    U32* transparentCells = 0;
-    U32 transparentUpload = 0u;
-    if (transparentTotal != 0u) {
-        PROF_SCOPE("world transparents");
-        U32 transparentDropped = 0u;
-        if (!eng_world_cull_sort_transparents_(world, ctx->host->frameArena, transparentTotal,
-                                               ENG_WORLD_MAX_RENDERABLES - opaqueTotal,
-                                               mappedRenderables + opaqueTotal,
-                                               &transparentCells, &transparentUpload, &transparentDropped)) {
-            eng_world_fail_once_(world, EngWorldFailLog_TransparentBuild, "transparent cull/sort allocation failed");
-            return;
+    EngWorldUploadStage stage = {};
+    stage.world = world;
+    stage.frameArena = ctx->host->frameArena;
+    stage.renderables = mappedRenderables;
+    stage.opaqueTotal = opaqueTotal;
+    stage.transparentTotal = transparentTotal;
+    stage.transparentOk = 1;
+
+    Job uploadRoot = {};
+    B32 uploadInFlight = 0;
+    if (state->jobSystem && opaqueTotal != 0u && transparentTotal != 0u) {
+        JobGraph* graph = job_graph_create(ctx->host->frameArena, 2u);
+        if (graph) {
+            EngWorldUploadStage* stagePtr = &stage;
+            job_graph_add(graph, (.function = eng_world_copy_opaques_job_), stagePtr);
+            job_graph_add(graph, (.function = eng_world_build_transparents_job_), stagePtr);
+            job_graph_submit(graph, &uploadRoot);
+            uploadInFlight = 1;
         }
-        dropped += transparentDropped;
-        world->lastDroppedCount = dropped;
     }
-    U32 renderableTotal = opaqueTotal + transparentUpload;
-    if (renderableTotal == 0u) {
-        return;
-    }
-    world->lastRenderableCount = renderableTotal;
-
-    world->frameRecord.renderableCount = opaqueTotal;
-    *mappedFrameRecord = world->frameRecord;
-    U32 uploadOffset = 0u;
-    for (U32 lane = 0u; lane < world->laneCount; ++lane) {
-        const EngWorldLaneWriter* writer = world->laneWriters + lane;
-        if (writer->count == 0u) {
-            continue;
+    if (!uploadInFlight) {
+        if (transparentTotal != 0u) {
+            eng_world_build_transparents_(&stage);
         }
-        MEMCPY(mappedRenderables + uploadOffset, writer->records,
-               sizeof(ShdWorldRenderableRecord) * writer->count);
-        uploadOffset += writer->count;
+        eng_world_copy_opaques_(&stage);
     }
 
     if (world->meshRecordsDirty) {
         ShdWorldMeshRecord meshRecords[ENG_WORLD_MAX_MESHES] = {};
-        for (U32 meshSlot = 0u; meshSlot < ENG_WORLD_MAX_MESHES; ++meshSlot) {
-            if (!slot_map_is_occupied(&world->meshes, meshSlot)) {
-                continue;
-            }
+        for (U32 at = 0u; at < world->meshes.count; ++at) {
+            U32 meshSlot = world->meshes.dense[at];
             EngWorldMesh* mesh = (EngWorldMesh*)slot_map_item_at(&world->meshes, meshSlot);
             meshRecords[meshSlot].indexCount = mesh->indexCount;
             meshRecords[meshSlot].firstIndex = mesh->firstIndex;
@@ -864,6 +928,27 @@ static void eng_world_execute_(EngContext* ctx, EngRendererFrame* rendererFrame)
         }
     }
 
+    if (uploadInFlight) {
+        PROF_SCOPE("world upload wait");
+        job_system_wait(state->jobSystem, &uploadRoot);
+    }
+    if (!stage.transparentOk) {
+        eng_world_fail_once_(world, EngWorldFailLog_TransparentBuild, "transparent cull/sort allocation failed");
+        return;
+    }
+    dropped += stage.transparentDropped;
+    world->lastDroppedCount = dropped;
+    U32* transparentCells = stage.transparentCells;
+    U32 transparentUpload = stage.transparentUpload;
+    U32 renderableTotal = opaqueTotal + transparentUpload;
+    if (renderableTotal == 0u) {
+        return;
+    }
+    world->lastRenderableCount = renderableTotal;
+
+    world->frameRecord.renderableCount = opaqueTotal;
+    *mappedFrameRecord = world->frameRecord;
+
     U32 cellCount = ENG_WORLD_CELL_COUNT;
 
     GfxTemp rootTemp = gfx_allocate_temp(frame, sizeof(ShdWorldCullRootData), 16u);
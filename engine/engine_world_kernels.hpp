@@ -67,6 +67,26 @@ static F32 eng_world_transparent_depth_(const F32* center, F32 radius,
            radius;
 }
 
+// Eight spheres per call: the plane test and depth key above, lane for
+// lane in the same order, so a lane agrees with the scalar kernels. Returns
+// the visible lanes as bits; depths are written for every lane.
+static U32 eng_world_cull_depth_x8_(const F32* planes, const F32* eye, Vec3F32 forward,
+                                    Vec3x8F32 centers, F32x8 radii, F32* outDepths) {
+    F32x8 negativeRadii = f32x8_sub(f32x8_set1(0.0f), radii);
+    M32x8 culled = {};
+    for (U32 plane = 0u; plane < 6u; ++plane) {
+        F32x8 distance = f32x8_mul(f32x8_set1(planes[plane * 4u + 0u]), centers.x);
+        distance = f32x8_madd(f32x8_set1(planes[plane * 4u + 1u]), centers.y, distance);
+        distance = f32x8_madd(f32x8_set1(planes[plane * 4u + 2u]), centers.z, distance);
+        distance = f32x8_add(distance, f32x8_set1(planes[plane * 4u + 3u]));
+        M32x8 outside = f32x8_lt(distance, negativeRadii);
+        culled = (plane == 0u) ? outside : m32x8_or(culled, outside);
+    }
+    Vec3x8F32 toCenter = vec3x8_sub(centers, vec3x8_set1(vec3_make(eye[0], eye[1], eye[2])));
+    f32x8_store(outDepths, f32x8_sub(vec3x8_dot(toCenter, vec3x8_set1(forward)), radii));
+    return m32x8_bits(m32x8_not(culled));
+}
+
 static void eng_world_order_ascending_(const F32* depths, U32* order, U32* scratch, U32 count) {
     for (U32 at = 0u; at < count; ++at) {
         order[at] = at;
@@ -38,7 +38,7 @@
     X(WorldScatter,   ENG_SHADER_SLANG_WORLD_CULL_SOURCE, world_scatter,   compute,  compute) \
     X(WorldArgs,      ENG_SHADER_SLANG_WORLD_CULL_SOURCE, world_args,      compute,  compute)
 
-#if defined(PLATFORM_OS_WINDOWS) || defined(SOB_WINDOWS)
+#if defined(PLATFORM_OS_WINDOWS) || defined(SOB_WINDOWS) || defined(PLATFORM_OS_LINUX) || defined(SOB_LINUX)
 #define ENG_SHADER_OUTPUT_EXT ".spv"
 #elif defined(PLATFORM_OS_MACOS) || defined(SOB_MACOS)
 #define ENG_SHADER_OUTPUT_EXT ".metal"
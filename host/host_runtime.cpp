@@ -27,7 +27,8 @@
 #define HOST_MAX_TARGET_FPS 240u
 #define HOST_DEFAULT_MIN_SLEEP_MS 1u
 #define HOST_MAX_MIN_SLEEP_MS 16u
-#define HOST_MODULE_WATCH_INTERVAL_FRAMES 15u
+#define HOST_MODULE_WATCH_INTERVAL_FRAMES 15u // polling, and retrying a module load that did not land
+#define HOST_INPUT_WATCH_MAX_DIRS 256u
 #define HOST_GFX_FRAMES_IN_FLIGHT 2u
 #define HOST_GFX_TEMP_BUFFER_SIZE MB(8)
 #define HOST_GFX_STAGING_BUFFER_SIZE MB(32)
@@ -48,6 +49,19 @@ static U32 g_hostModuleInputCount;
 static U64 g_hostModuleInputsManifestTimestamp;
 static B32 g_hostModuleInputsWarned;
 
+// Every directory holding a module input, a host-owned input, the manifest
+// or the module binary gets a watch. While all of them are watched, the
+// mtime sweeps run only after one of them reported a change; a directory
+// that cannot be watched puts the host back on polling.
+static char g_hostInputWatchText[32u * 1024u];
+static U32 g_hostInputWatchTextUsed;
+static StringU8 g_hostInputWatchDirs[HOST_INPUT_WATCH_MAX_DIRS];
+static OS_Handle g_hostInputWatches[HOST_INPUT_WATCH_MAX_DIRS];
+static U32 g_hostInputWatchCount;
+static B32 g_hostInputWatchesBuilt; // cleared when the manifest reloads or a directory goes away
+static B32 g_hostInputWatchComplete;
+static B32 g_hostInputsDirty; // a watch reported (or some directory is unwatched); cleared by the next sweep
+
 static void host_refresh_module_inputs(void) {
     OS_FileInfo manifestInfo = OS_get_file_info(HOST_MODULE_INPUTS_MANIFEST_PATH);
     if (!manifestInfo.exists) {
@@ -94,6 +108,7 @@ static void host_refresh_module_inputs(void) {
         }
     }
     g_hostModuleInputCount = count;
+    g_hostInputWatchesBuilt = 0;
     LOG_INFO("host", "Module inputs manifest loaded: {} files", count);
 }
 
@@ -246,6 +261,7 @@ struct HostState {
     StringU8 retiredModulePaths[HOT_MODULE_HISTORY_MAX];
     U32 retiredModuleCount;
     B32 buildFailed;
+    B32 moduleReloadPending; // the module changed but no candidate committed yet
     B32 restartRequired;
     B32 windowFocused;
     U32 targetFpsFocused;
@@ -268,6 +284,8 @@ static StringU8 host_build_module_path(StringU8 relativePath, Arena* arena);
 static void host_record_retired_module(HostState* state, OS_SharedLibrary library, StringU8 path);
 static B32 host_copy_file(StringU8 srcPath, StringU8 dstPath);
 static void host_delete_file(StringU8 path);
+static void host_input_watches_release(void);
+static B32 host_input_watches_quiet(void);
 static U64 host_get_newest_input_timestamp(const char* const* inputs, U32 inputCount, const char** outNewestPath);
 static U64 host_get_newest_module_input_timestamp(void);
 static U64 host_get_newest_restart_required_input_timestamp(const char** outNewestPath);
@@ -423,7 +441,7 @@ static void host_update(HostState* state, F32 deltaSeconds) {
 
     arena_pop_to(state->frameArena, 0);
 
-    if ((state->framesRun % HOST_MODULE_WATCH_INTERVAL_FRAMES) == 0ull) {
+    if (g_hostInputWatchComplete || (state->framesRun % HOST_MODULE_WATCH_INTERVAL_FRAMES) == 0ull) {
         PROF_SCOPE("module watch");
         host_try_reload_module(state);
     }
@@ -464,6 +482,7 @@ static void host_shutdown(HostState* state) {
     }
 
     host_cleanup_retired_modules(state);
+    host_input_watches_release();
     host_release_memory(state);
 }
 
@@ -539,10 +558,12 @@ static B32 host_allocate_memory(HostState* state) {
     MEMSET(state->storage.permanentBase, 0, state->storage.permanentSize);
     MEMSET(state->storage.transientBase, 0, state->storage.transientSize);
 
+    // Engine state lives here and the world's renderable buffers in the frame
+    // arena below; both are walked every frame, so ask for large pages.
     state->programArena = arena_alloc(
         .arenaSize = MB(256),
         .committedSize = MB(8),
-        .flags = ArenaFlags_DoChain,
+        .flags = ArenaFlags_DoChain | ArenaFlags_LargePages,
         .debugName = "host/program"
     );
     if (!state->programArena) {
@@ -554,7 +575,7 @@ static B32 host_allocate_memory(HostState* state) {
     state->frameArena = arena_alloc(
         .arenaSize = MB(16),
         .committedSize = MB(1),
-        .flags = ArenaFlags_DoChain,
+        .flags = ArenaFlags_DoChain | ArenaFlags_LargePages,
         .debugName = "host/frame"
     );
     if (!state->frameArena) {
@@ -963,6 +984,106 @@ static void host_unload_module(HostState* state) {
     state->currentModulePath = STR8_NIL;
 }
 
+static void host_input_watches_release(void) {
+    for (U32 index = 0; index < g_hostInputWatchCount; ++index) {
+        if (g_hostInputWatches[index].handle) {
+            OS_unwatch_directory(g_hostInputWatches[index]);
+        }
+    }
+    g_hostInputWatchCount = 0u;
+    g_hostInputWatchTextUsed = 0u;
+    g_hostInputWatchesBuilt = 0;
+    g_hostInputWatchComplete = 0;
+}
+
+static void host_input_watch_add(StringU8 path) {
+    U64 split = path.size;
+    while (split > 0u && path.data[split - 1u] != '/' && path.data[split - 1u] != '\\') {
+        split -= 1u;
+    }
+    StringU8 directory = (split == 0u) ? str8(".") : str8(path.data, (split == 1u) ? 1u : split - 1u);
+    for (U32 index = 0; index < g_hostInputWatchCount; ++index) {
+        if (str8_equal(g_hostInputWatchDirs[index], directory)) {
+            return;
+        }
+    }
+    if (g_hostInputWatchCount == HOST_INPUT_WATCH_MAX_DIRS ||
+        g_hostInputWatchTextUsed + directory.size + 1u > sizeof(g_hostInputWatchText)) {
+        g_hostInputWatchComplete = 0;
+        return;
+    }
+
+    char* copy = g_hostInputWatchText + g_hostInputWatchTextUsed;
+    MEMCPY(copy, directory.data, directory.size);
+    copy[directory.size] = 0;
+    g_hostInputWatchTextUsed += (U32) directory.size + 1u;
+    g_hostInputWatchDirs[g_hostInputWatchCount] = str8(copy, directory.size);
+    g_hostInputWatches[g_hostInputWatchCount] = OS_watch_directory(copy);
+    if (!g_hostInputWatches[g_hostInputWatchCount].handle) {
+        g_hostInputWatchComplete = 0;
+    }
+    g_hostInputWatchCount += 1u;
+}
+
+static void host_input_watches_build(void) {
+    host_input_watches_release();
+    g_hostInputWatchesBuilt = 1;
+    g_hostInputWatchComplete = 1;
+
+    host_input_watch_add(str8(HOST_MODULE_INPUTS_MANIFEST_PATH));
+    for (U32 index = 0; index < ARRAY_COUNT(HOST_RESTART_REQUIRED_INPUTS); ++index) {
+        host_input_watch_add(str8(HOST_RESTART_REQUIRED_INPUTS[index]));
+    }
+    for (U32 index = 0; index < g_hostModuleInputCount; ++index) {
+        host_input_watch_add(str8(g_hostModuleInputs[index]));
+    }
+
+    Temp scratch = get_scratch(0, 0);
+    StringU8 modulePath = scratch.arena ? host_build_module_path(str8(ENG_MODULE_SOURCE_RELATIVE), scratch.arena) : STR8_NIL;
+    if (modulePath.data && modulePath.size > 0) {
+        host_input_watch_add(modulePath);
+    } else {
+        g_hostInputWatchComplete = 0;
+    }
+    if (scratch.arena) {
+        temp_end(&scratch);
+    }
+
+    LOG_INFO("host", "Watching {} input directories ({})", g_hostInputWatchCount,
+             str8(g_hostInputWatchComplete ? "event driven" : "some unwatched, polling"));
+}
+
+// 1 when every input directory is watched and none of them reported
+// anything since the last call, so the stat sweeps can be skipped.
+static B32 host_input_watches_quiet(void) {
+    if (!g_hostInputWatchesBuilt) {
+        host_input_watches_build();
+        return 0;
+    }
+
+    Temp scratch = get_scratch(0, 0);
+    if (!scratch.arena) {
+        return 0;
+    }
+    DEFER_REF(temp_end(&scratch));
+
+    B32 quiet = g_hostInputWatchComplete;
+    OS_WatchEvent events[16];
+    for (U32 index = 0; index < g_hostInputWatchCount; ++index) {
+        if (!g_hostInputWatches[index].handle) {
+            continue;
+        }
+        U32 eventCount = OS_poll_watch_events(g_hostInputWatches[index], scratch.arena, events, ARRAY_COUNT(events));
+        for (U32 at = 0; at < eventCount; ++at) {
+            quiet = 0;
+            if (events[at].flags & OS_WatchEvent_Closed) {
+                g_hostInputWatchesBuilt = 0;
+            }
+        }
+    }
+    return quiet;
+}
+
 static U64 host_get_newest_input_timestamp(const char* const* inputs, U32 inputCount, const char** outNewestPath) {
     U64 newestTimestamp = 0;
     const char* newestPath = 0;
@@ -1023,13 +1144,16 @@ static B32 host_restart_required_inputs_changed(HostState* state) {
 
 static void host_try_build_module(HostState* state) {
     // The generated input list runs a few hundred files; polling that
-    // many mtimes per frame is waste. 4 Hz keeps reloads instant enough.
+    // many mtimes per frame is waste, and so is a sweep per event while a
+    // save or a build touches a burst of files. 4 Hz keeps reloads instant
+    // enough; a throttled sweep stays owed in g_hostInputsDirty.
     static U64 lastPollNanos;
     U64 nowNanos = OS_get_time_nanoseconds();
     if (lastPollNanos != 0ull && nowNanos - lastPollNanos < 250000000ull) {
         return;
     }
     lastPollNanos = nowNanos;
+    g_hostInputsDirty = 0;
 
     if (host_restart_required_inputs_changed(state)) {
         return;
@@ -1079,7 +1203,19 @@ static void host_try_reload_module(HostState* state) {
     (void) state;
     return;
 #else
-    host_try_build_module(state);
+    // A candidate that failed to load, or was read mid-write, brings no
+    // further event, so it is retried on the polling interval regardless.
+    if (!host_input_watches_quiet()) {
+        g_hostInputsDirty = 1;
+    }
+    B32 retryDue = state->moduleReloadPending && (state->framesRun % HOST_MODULE_WATCH_INTERVAL_FRAMES) == 0ull;
+    if (!g_hostInputsDirty && !retryDue) {
+        return;
+    }
+
+    if (g_hostInputsDirty) {
+        host_try_build_module(state);
+    }
 
     if (state->restartRequired) {
         return;
@@ -1113,8 +1249,10 @@ static void host_try_reload_module(HostState* state) {
 
     U64 timestamp = moduleInfo.lastWriteTimestampNs;
     if (timestamp <= state->moduleTimestamp) {
+        state->moduleReloadPending = 0;
         return;
     }
+    state->moduleReloadPending = 1;
 
     LOG_INFO("host", "Detected module change ({} -> {}), loading candidate", state->moduleTimestamp, timestamp);
     prof_record_gate(0);
@@ -1127,6 +1265,8 @@ static void host_try_reload_module(HostState* state) {
     }
     if (!host_commit_candidate(state, &candidate, candidatePath, 1)) {
         LOG_ERROR("host", "Candidate swap failed; active module remains running");
+    } else {
+        state->moduleReloadPending = 0;
     }
     prof_record_gate(1);
 #endif
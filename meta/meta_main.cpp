@@ -371,7 +371,8 @@ int main(int argc, char** argv) {
         SPMDGroup* group = spmd_run(arena,
                                     .laneCount = laneCount,
                                     .kernel = spmd_process_files_kernel,
-                                    .kernelParameters = &ctx
+                                    .kernelParameters = &ctx,
+                                    .groupParams = {}
         );
 
         spmd_group_destroy(group);
@@ -173,4 +173,4 @@ StringU8 str8_fmt_(Arena* arena, StringU8 fmt, const Str8FmtArg* args, U64 argCo
         const U64 _count = (U64)((sizeof(_args) / sizeof(Str8FmtArg)) - 1);                \
         const Str8FmtArg* _ptr = (_count > 0) ? (_args + 1) : nullptr;                     \
         return str8_fmt_((arena), str8(fmt), _ptr, _count);                                \
-    }())
\ No newline at end of file
+    }())
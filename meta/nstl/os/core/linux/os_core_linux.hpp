@@ -0,0 +1,82 @@
+//
+// Linux os_core backend state for the tools snapshot: entity records
+// behind OS_Handle and the process-wide globals.
+//
+
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <limits.h>
+#include <cstdlib>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <dirent.h>
+
+
+// ////////////////////////
+// State
+
+enum OS_LINUX_EntityType : U64 {
+    OS_LINUX_EntityType_Invalid = (0),
+    OS_LINUX_EntityType_Thread = (1 << 0),
+    OS_LINUX_EntityType_Mutex = (2 << 0),
+    OS_LINUX_EntityType_File = (3 << 0),
+    OS_LINUX_EntityType_ConditionVariable = (4 << 0),
+    OS_LINUX_EntityType_Barrier = (5 << 0),
+};
+
+struct OS_LINUX_Entity {
+    OS_LINUX_Entity* next;
+    OS_LINUX_EntityType type;
+
+    union {
+        struct {
+            pthread_t handle;
+            OS_ThreadFunc* func;
+            void* args;
+        } thread;
+
+        pthread_mutex_t mutex;
+
+        struct {
+            int fd;
+        } file;
+
+        struct {
+            pthread_cond_t cond;
+        } conditionVariable;
+
+        struct {
+            OS_Handle conditionHandle;
+            OS_Handle mutexHandle;
+            U32 threadCount;
+            U32 waitingCount;
+            U32 generation;
+        } barrier;
+    };
+};
+
+static OS_LINUX_Entity* alloc_OS_entity();
+static void free_OS_entity(OS_LINUX_Entity* entity);
+
+struct OS_LINUX_State {
+    OS_SystemInfo systemInfo;
+
+    Arena* arena;
+
+    Arena* osEntityArena;
+    OS_LINUX_Entity* freeEntities;
+    pthread_mutex_t entityMutex;
+};
+
+
+// ////////////////////////
+// Globals
+
+extern OS_LINUX_State g_OS_LinuxState;
\ No newline at end of file
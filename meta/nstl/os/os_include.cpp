@@ -7,5 +7,5 @@
 #elif defined(PLATFORM_OS_MACOS)
 #include "core/macos/os_core_macos.cpp"
 #elif defined(PLATFORM_OS_LINUX)
-#error "not supported"
+#include "core/linux/os_core_linux.cpp"
 #endif
@@ -1,4 +1,5 @@
 #define ARTIFACT_DEFAULT_SLOT_CAPACITY 64u
+#define ARTIFACT_DEFAULT_MAX_SLOT_CAPACITY (1u << 20)
 #define ARTIFACT_DEFAULT_TABLE_CAPACITY 128u
 #define ARTIFACT_DEFAULT_TYPE_CAPACITY 16u
 #define ARTIFACT_REQUEST_DATA_MAX 256u
@@ -18,13 +19,28 @@ struct ArtifactNode {
     U64 requestedGeneration;
     U64 workingGeneration;
     U64 failedGeneration;
-    U64 lastTouchFrame;
     U64 bytes;
     U32 retainCount;
     U32 requestDataSize;
     U8 requestData[ARTIFACT_REQUEST_DATA_MAX];
     U64 cancelFlag;
     ArtifactStatus status;
+    U32 slot;
+    U32 typeIndex;
+    U64 lastTouchFrame;
+    U32 lruPrev;
+    U32 lruNext;
+    B32 lruLinked;
+};
+
+// Per registered type, parallel to ArtifactCache::types. Nodes that could be
+// evicted right now (not retained, not working) sit on their type's LRU list,
+// oldest touch at lruHead.
+struct ArtifactTypeState {
+    U32 lruHead;
+    U32 lruTail;
+    U32 liveCount;
+    U64 liveBytes;
 };
 
 struct ArtifactTableEntry {
@@ -38,6 +54,7 @@ struct ArtifactQueuedJob {
     U32 slot;
     U32 slotGeneration;
     U64 generation;
+    JobPriority priority; // HighPriority requests build as critical jobs
 };
 
 struct ArtifactCompletedJob {
@@ -66,11 +83,13 @@ struct ArtifactCache {
     ContentStore* content;
     OS_Handle mutex;
     SlotMap slots;
+    U64 lruFrame; // newest frame seen by touch or evict, stamped on nodes as they are linked
     ArtifactTableEntry* table;
     U32 tableCapacity;
     U32 tableCount;
     U32 tableTombstones;
     ArtifactTypeDesc* types;
+    ArtifactTypeState* typeStates;
     U32 typeCount;
     U32 typeCapacity;
     ArtifactQueuedJob* highQueue;
@@ -100,7 +119,7 @@ static U32 artifact_table_capacity_from_count_(U32 requested) {
 
 static U64 artifact_table_hash_(ArtifactTypeId typeId, ArtifactKey key) {
     U64 values[3] = {(U64)typeId, key.hash[0], key.hash[1]};
-    return hash_fnv1a(values, sizeof(values), 1469598103934665603ull ^ 0xF1357AEA2E62A9C5ull);
+    return hash64_from_bytes(values, sizeof(values), 0xF1357AEA2E62A9C5ull);
 }
 
 B32 artifact_key_equal(ArtifactKey a, ArtifactKey b) {
@@ -112,9 +131,8 @@ B32 artifact_key_is_zero(ArtifactKey key) {
 }
 
 ArtifactKey artifact_key_from_bytes(const void* data, U64 size) {
-    ArtifactKey result = ARTIFACT_KEY_ZERO;
-    result.hash[0] = hash_fnv1a(data, size, 1469598103934665603ull ^ 0xA24BAED4963EE407ull);
-    result.hash[1] = hash_fnv1a(data, size, 1099511628211ull ^ 0x9FB21C651E98DF25ull);
+    Hash128 hash = hash128_from_bytes(data, size, 0xA24BAED4963EE407ull);
+    ArtifactKey result = {{hash.u64[0], hash.u64[1]}};
     return result;
 }
 
@@ -393,6 +411,7 @@ static B32 artifact_queue_node_locked_(ArtifactCache* cache,
     job.slot = slot;
     job.slotGeneration = cache->slots.generations[slot];
     job.generation = generation;
+    job.priority = FLAGS_HAS(flags, ArtifactGetFlags_HighPriority) ? JobPriority_Critical : JobPriority_Background;
 
     B32 ok = 0;
     if (FLAGS_HAS(flags, ArtifactGetFlags_HighPriority)) {
@@ -446,6 +465,56 @@ static B32 artifact_status_is_working_(ArtifactStatus status) {
             status == ArtifactStatus_Publishing) ? 1 : 0;
 }
 
+// ////////////////////////
+// LRU
+//
+// Linking a node stamps it with the newest frame seen, so every list stays
+// sorted by lastTouchFrame and eviction only ever looks at list heads.
+
+static void artifact_lru_unlink_locked_(ArtifactCache* cache, ArtifactNode* node) {
+    if (!node->lruLinked) {
+        return;
+    }
+    ArtifactTypeState* state = cache->typeStates + node->typeIndex;
+    if (node->lruPrev != SLOT_MAP_INVALID_INDEX) {
+        ((ArtifactNode*)slot_map_item_at(&cache->slots, node->lruPrev))->lruNext = node->lruNext;
+    } else {
+        state->lruHead = node->lruNext;
+    }
+    if (node->lruNext != SLOT_MAP_INVALID_INDEX) {
+        ((ArtifactNode*)slot_map_item_at(&cache->slots, node->lruNext))->lruPrev = node->lruPrev;
+    } else {
+        state->lruTail = node->lruPrev;
+    }
+    node->lruPrev = SLOT_MAP_INVALID_INDEX;
+    node->lruNext = SLOT_MAP_INVALID_INDEX;
+    node->lruLinked = 0;
+}
+
+static void artifact_lru_push_locked_(ArtifactCache* cache, ArtifactNode* node) {
+    ArtifactTypeState* state = cache->typeStates + node->typeIndex;
+    node->lastTouchFrame = MAX(node->lastTouchFrame, cache->lruFrame);
+    node->lruPrev = state->lruTail;
+    node->lruNext = SLOT_MAP_INVALID_INDEX;
+    if (state->lruTail != SLOT_MAP_INVALID_INDEX) {
+        ((ArtifactNode*)slot_map_item_at(&cache->slots, state->lruTail))->lruNext = node->slot;
+    } else {
+        state->lruHead = node->slot;
+    }
+    state->lruTail = node->slot;
+    node->lruLinked = 1;
+}
+
+// Call after anything that changes retainCount or status.
+static void artifact_lru_update_locked_(ArtifactCache* cache, ArtifactNode* node) {
+    B32 evictable = (node->retainCount == 0u && !artifact_status_is_working_(node->status)) ? 1 : 0;
+    if (evictable && !node->lruLinked) {
+        artifact_lru_push_locked_(cache, node);
+    } else if (!evictable && node->lruLinked) {
+        artifact_lru_unlink_locked_(cache, node);
+    }
+}
+
 static void artifact_set_status_locked_(ArtifactCache* cache, ArtifactNode* node, ArtifactStatus status) {
     if (artifact_status_is_working_(node->status)) {
         cache->workingCount -= 1u;
@@ -454,6 +523,7 @@ static void artifact_set_status_locked_(ArtifactCache* cache, ArtifactNode* node
     if (artifact_status_is_working_(status)) {
         cache->workingCount += 1u;
     }
+    artifact_lru_update_locked_(cache, node);
 }
 
 static void artifact_destroy_value_(ArtifactTypeDesc* type, ArtifactValue value) {
@@ -478,26 +548,32 @@ B32 artifact_cache_create(const ArtifactCacheDesc* desc, ArtifactCache* outCache
 
     U32 slotCapacity = desc->initialSlotCapacity ? desc->initialSlotCapacity : ARTIFACT_DEFAULT_SLOT_CAPACITY;
     U32 typeCapacity = desc->initialTypeCapacity ? desc->initialTypeCapacity : ARTIFACT_DEFAULT_TYPE_CAPACITY;
-    if (!slot_map_init(&outCache->slots, outCache->arena, sizeof(ArtifactNode), slotCapacity)) {
+    U32 maxSlotCapacity = desc->maxSlotCapacity ? desc->maxSlotCapacity : ARTIFACT_DEFAULT_MAX_SLOT_CAPACITY;
+    if (!slot_map_init_reserved(&outCache->slots, sizeof(ArtifactNode), slotCapacity, maxSlotCapacity)) {
         MEMSET(outCache, 0, sizeof(*outCache));
         return 0;
     }
 
     outCache->types = ARENA_PUSH_ARRAY(outCache->arena, ArtifactTypeDesc, typeCapacity);
-    if (!outCache->types) {
+    outCache->typeStates = ARENA_PUSH_ARRAY(outCache->arena, ArtifactTypeState, typeCapacity);
+    if (!outCache->types || !outCache->typeStates) {
+        slot_map_destroy(&outCache->slots);
         MEMSET(outCache, 0, sizeof(*outCache));
         return 0;
     }
     MEMSET(outCache->types, 0, sizeof(ArtifactTypeDesc) * typeCapacity);
+    MEMSET(outCache->typeStates, 0, sizeof(ArtifactTypeState) * typeCapacity);
     outCache->typeCapacity = typeCapacity;
 
     if (!artifact_table_rebuild_(outCache, desc->initialTableCapacity ? desc->initialTableCapacity : ARTIFACT_DEFAULT_TABLE_CAPACITY)) {
+        slot_map_destroy(&outCache->slots);
         MEMSET(outCache, 0, sizeof(*outCache));
         return 0;
     }
 
     outCache->mutex = OS_mutex_create();
     if (!outCache->mutex.handle) {
+        slot_map_destroy(&outCache->slots);
         MEMSET(outCache, 0, sizeof(*outCache));
         return 0;
     }
@@ -524,11 +600,8 @@ void artifact_cache_destroy(ArtifactCache* cache) {
 
     artifact_lock_(cache);
     ATOMIC_STORE(&cache->shuttingDown, 1u, MEMORY_ORDER_RELEASE);
-    for (U32 slot = 0u; slot < cache->slots.capacity; ++slot) {
-        if (!slot_map_is_occupied(&cache->slots, slot)) {
-            continue;
-        }
-        ArtifactNode* node = (ArtifactNode*)slot_map_item_at(&cache->slots, slot);
+    for (U32 at = 0u; at < cache->slots.count; ++at) {
+        ArtifactNode* node = (ArtifactNode*)slot_map_item_at(&cache->slots, cache->slots.dense[at]);
         if (node) {
             ATOMIC_STORE(&node->cancelFlag, 1u, MEMORY_ORDER_RELEASE);
         }
@@ -545,18 +618,15 @@ void artifact_cache_destroy(ArtifactCache* cache) {
         OS_thread_yield();
     }
 
-    for (U32 slot = 0u; slot < cache->slots.capacity; ++slot) {
-        if (!slot_map_is_occupied(&cache->slots, slot)) {
-            continue;
-        }
-
-        ArtifactNode* node = (ArtifactNode*)slot_map_item_at(&cache->slots, slot);
+    for (U32 at = 0u; at < cache->slots.count; ++at) {
+        ArtifactNode* node = (ArtifactNode*)slot_map_item_at(&cache->slots, cache->slots.dense[at]);
         ArtifactTypeDesc* type = artifact_type_from_id_locked_(cache, node ? node->typeId : 0u);
         if (node && node->readyGeneration != 0u) {
             artifact_destroy_value_(type, node->value);
         }
     }
 
+    slot_map_destroy(&cache->slots);
     if (cache->mutex.handle) {
         OS_mutex_destroy(cache->mutex);
     }
@@ -580,18 +650,25 @@ B32 artifact_register_type(ArtifactCache* cache, const ArtifactTypeDesc* desc) {
         U32 oldCapacity = cache->typeCapacity;
         U32 newCapacity = oldCapacity ? oldCapacity * 2u : ARTIFACT_DEFAULT_TYPE_CAPACITY;
         ArtifactTypeDesc* newTypes = ARENA_PUSH_ARRAY(cache->arena, ArtifactTypeDesc, newCapacity);
-        if (!newTypes) {
+        ArtifactTypeState* newStates = ARENA_PUSH_ARRAY(cache->arena, ArtifactTypeState, newCapacity);
+        if (!newTypes || !newStates) {
             artifact_unlock_(cache);
             return 0;
         }
         MEMSET(newTypes, 0, sizeof(ArtifactTypeDesc) * newCapacity);
+        MEMSET(newStates, 0, sizeof(ArtifactTypeState) * newCapacity);
         if (cache->types && oldCapacity != 0u) {
             MEMCPY(newTypes, cache->types, sizeof(ArtifactTypeDesc) * oldCapacity);
+            MEMCPY(newStates, cache->typeStates, sizeof(ArtifactTypeState) * oldCapacity);
         }
         cache->types = newTypes;
+        cache->typeStates = newStates;
         cache->typeCapacity = newCapacity;
     }
 
+    ArtifactTypeState* state = cache->typeStates + cache->typeCount;
+    state->lruHead = SLOT_MAP_INVALID_INDEX;
+    state->lruTail = SLOT_MAP_INVALID_INDEX;
     cache->types[cache->typeCount] = *desc;
     cache->typeCount += 1u;
     artifact_unlock_(cache);
@@ -654,6 +731,12 @@ static ArtifactResult artifact_get_once_(ArtifactCache* cache,
         node = (ArtifactNode*)slotItem;
         node->typeId = typeId;
         node->key = key;
+        node->slot = slot;
+        node->typeIndex = (U32)(type - cache->types);
+        node->lruPrev = SLOT_MAP_INVALID_INDEX;
+        node->lruNext = SLOT_MAP_INVALID_INDEX;
+        cache->typeStates[node->typeIndex].liveCount += 1u;
+        artifact_lru_push_locked_(cache, node);
         createdNode = 1;
         cache->stats.misses += 1u;
     }
@@ -763,7 +846,12 @@ void artifact_touch(ArtifactCache* cache, ArtifactTypeId typeId, ArtifactKey key
     artifact_lock_(cache);
     ArtifactNode* node = artifact_node_from_type_key_locked_(cache, typeId, key, 0);
     if (node) {
-        node->lastTouchFrame = frameIndex;
+        cache->lruFrame = MAX(cache->lruFrame, frameIndex);
+        node->lastTouchFrame = cache->lruFrame;
+        if (node->lruLinked) {
+            artifact_lru_unlink_locked_(cache, node);
+            artifact_lru_push_locked_(cache, node);
+        }
     }
     artifact_unlock_(cache);
 }
@@ -778,6 +866,7 @@ B32 artifact_retain(ArtifactCache* cache, ArtifactTypeId typeId, ArtifactKey key
     ArtifactNode* node = artifact_node_from_type_key_locked_(cache, typeId, key, 0);
     if (node) {
         node->retainCount += 1u;
+        artifact_lru_update_locked_(cache, node);
         result = 1;
     }
     artifact_unlock_(cache);
@@ -793,22 +882,17 @@ void artifact_release(ArtifactCache* cache, ArtifactTypeId typeId, ArtifactKey k
     ArtifactNode* node = artifact_node_from_type_key_locked_(cache, typeId, key, 0);
     if (node && node->retainCount != 0u) {
         node->retainCount -= 1u;
+        artifact_lru_update_locked_(cache, node);
     }
     artifact_unlock_(cache);
 }
 
-static void artifact_submit_one_(ArtifactCache* cache, ArtifactQueuedJob job) {
-    ArtifactJobParams params = {};
-    params.cache = cache;
-    params.slot = job.slot;
-    params.slotGeneration = job.slotGeneration;
-    params.generation = job.generation;
-
-    if (cache->jobSystem) {
-        job_system_submit((.function = artifact_build_job_), params);
-    } else {
-        artifact_build_job_(&params);
-    }
+static void artifact_job_params_(ArtifactCache* cache, ArtifactQueuedJob job, ArtifactJobParams* outParams) {
+    MEMSET(outParams, 0, sizeof(*outParams));
+    outParams->cache = cache;
+    outParams->slot = job.slot;
+    outParams->slotGeneration = job.slotGeneration;
+    outParams->generation = job.generation;
 }
 
 static B32 artifact_prepare_submit_locked_(ArtifactCache* cache, ArtifactQueuedJob* outJob) {
@@ -923,6 +1007,8 @@ static void artifact_publish_completed_(ArtifactCache* cache, ArtifactCompletedJ
             finalBytes = completed.bytes;
         }
         node->bytes = finalBytes;
+        ArtifactTypeState* state = cache->typeStates + node->typeIndex;
+        state->liveBytes = ((state->liveBytes >= oldBytes) ? (state->liveBytes - oldBytes) : 0u) + finalBytes;
         if (cache->stats.bytesLive >= oldBytes) {
             cache->stats.bytesLive -= oldBytes;
         } else {
@@ -950,16 +1036,46 @@ void artifact_cache_tick(ArtifactCache* cache, U64 frameIndex, U32 maxSubmits, U
         return;
     }
 
-    for (U32 submitIndex = 0u; submitIndex < maxSubmits; ++submitIndex) {
-        ArtifactQueuedJob job = {};
+    if (maxSubmits != 0u) {
+        Temp scratch = get_scratch(0, 0);
+        DEFER_REF(temp_end(&scratch));
+        ArtifactQueuedJob* queued = ARENA_PUSH_ARRAY(scratch.arena, ArtifactQueuedJob, maxSubmits);
+        U32 queuedCount = 0u;
+
         artifact_lock_(cache);
-        B32 haveJob = artifact_prepare_submit_locked_(cache, &job);
-        artifact_unlock_(cache);
-        if (!haveJob) {
-            break;
+        while (queuedCount < maxSubmits && artifact_prepare_submit_locked_(cache, &queued[queuedCount])) {
+            queuedCount += 1u;
         }
+        artifact_unlock_(cache);
 
-        artifact_submit_one_(cache, job);
+        if (cache->jobSystem && queuedCount != 0u) {
+            // One publish and one wake per priority for the whole tick's
+            // worth of builds (the queue pops high priority first).
+            Job* jobs = ARENA_PUSH_ARRAY(scratch.arena, Job, queuedCount);
+            for (U32 at = 0u; at < queuedCount; ++at) {
+                ArtifactJobParams params = {};
+                artifact_job_params_(cache, queued[at], &params);
+                MEMSET(&jobs[at], 0, sizeof(Job));
+                jobs[at].function = artifact_build_job_;
+                job_set_parameters(&jobs[at], params);
+            }
+            U32 runStart = 0u;
+            while (runStart < queuedCount) {
+                JobPriority priority = queued[runStart].priority;
+                U32 runEnd = runStart + 1u;
+                while (runEnd < queuedCount && queued[runEnd].priority == priority) {
+                    runEnd += 1u;
+                }
+                job_system_submit_batch_at(jobs + runStart, runEnd - runStart, priority);
+                runStart = runEnd;
+            }
+        } else {
+            for (U32 at = 0u; at < queuedCount; ++at) {
+                ArtifactJobParams params = {};
+                artifact_job_params_(cache, queued[at], &params);
+                artifact_build_job_(&params);
+            }
+        }
     }
 
     for (U32 publishIndex = 0u; publishIndex < maxPublishes; ++publishIndex) {
@@ -980,6 +1096,40 @@ void artifact_cache_tick(ArtifactCache* cache, U64 frameIndex, U32 maxSubmits, U
     }
 }
 
+// Type budgets come first: the oldest evictable node of a type over its
+// evictionTargetCount / evictionTargetBytes goes. Otherwise, while the cache
+// is over targetCount, the oldest list head across types goes. Each list is
+// sorted, so a head touched this frame or still inside its type's idle window
+// shields the whole list.
+static U32 artifact_evict_victim_locked_(ArtifactCache* cache, U64 frameIndex, U32 targetCount) {
+    B32 overTarget = (cache->slots.count > targetCount) ? 1 : 0;
+    U32 bestSlot = SLOT_MAP_INVALID_INDEX;
+    U64 bestFrame = UINT64_MAX;
+    for (U32 typeIndex = 0u; typeIndex < cache->typeCount; ++typeIndex) {
+        ArtifactTypeState* state = cache->typeStates + typeIndex;
+        if (state->lruHead == SLOT_MAP_INVALID_INDEX) {
+            continue;
+        }
+
+        ArtifactTypeDesc* type = cache->types + typeIndex;
+        ArtifactNode* head = (ArtifactNode*)slot_map_item_at(&cache->slots, state->lruHead);
+        if (head->lastTouchFrame >= frameIndex ||
+            (type->evictionMaxIdleFrames != 0u && head->lastTouchFrame + type->evictionMaxIdleFrames > frameIndex)) {
+            continue;
+        }
+
+        if ((type->evictionTargetCount != 0u && state->liveCount > type->evictionTargetCount) ||
+            (type->evictionTargetBytes != 0u && state->liveBytes > type->evictionTargetBytes)) {
+            return state->lruHead;
+        }
+        if (overTarget && head->lastTouchFrame < bestFrame) {
+            bestFrame = head->lastTouchFrame;
+            bestSlot = state->lruHead;
+        }
+    }
+    return bestSlot;
+}
+
 void artifact_cache_evict(ArtifactCache* cache, U64 frameIndex, U32 targetCount) {
     if (!cache) {
         return;
@@ -987,53 +1137,23 @@ void artifact_cache_evict(ArtifactCache* cache, U64 frameIndex, U32 targetCount)
 
     for (;;) {
         artifact_lock_(cache);
-        if (cache->slots.count <= targetCount) {
-            artifact_unlock_(cache);
-            break;
-        }
-
-        U32 bestSlot = SLOT_MAP_INVALID_INDEX;
-        U64 bestFrame = UINT64_MAX;
-        for (U32 slot = 0u; slot < cache->slots.capacity; ++slot) {
-            if (!slot_map_is_occupied(&cache->slots, slot)) {
-                continue;
-            }
-
-            ArtifactNode* node = (ArtifactNode*)slot_map_item_at(&cache->slots, slot);
-            if (!node ||
-                node->lastTouchFrame == frameIndex ||
-                node->retainCount != 0u ||
-                artifact_status_is_working_(node->status)) {
-                continue;
-            }
-
-            ArtifactTypeDesc* type = artifact_type_from_id_locked_(cache, node->typeId);
-            if (type && type->evictionMaxIdleFrames != 0u &&
-                node->lastTouchFrame + type->evictionMaxIdleFrames > frameIndex) {
-                continue;
-            }
-
-            if (node->lastTouchFrame < bestFrame) {
-                bestFrame = node->lastTouchFrame;
-                bestSlot = slot;
-            }
-        }
-
+        cache->lruFrame = MAX(cache->lruFrame, frameIndex);
+        U32 bestSlot = artifact_evict_victim_locked_(cache, frameIndex, targetCount);
         if (bestSlot == SLOT_MAP_INVALID_INDEX) {
             artifact_unlock_(cache);
             break;
         }
 
         ArtifactNode* node = (ArtifactNode*)slot_map_item_at(&cache->slots, bestSlot);
-        ArtifactTypeDesc type = {};
-        ArtifactTypeDesc* typePtr = artifact_type_from_id_locked_(cache, node ? node->typeId : 0u);
-        if (typePtr) {
-            type = *typePtr;
-        }
+        ArtifactTypeDesc type = cache->types[node->typeIndex];
+        ArtifactTypeState* state = cache->typeStates + node->typeIndex;
+        artifact_lru_unlink_locked_(cache, node);
+        state->liveCount -= 1u;
+        state->liveBytes = (state->liveBytes >= node->bytes) ? (state->liveBytes - node->bytes) : 0u;
 
         ArtifactValue value = {};
         B32 destroyValue = 0;
-        if (node && node->readyGeneration != 0u) {
+        if (node->readyGeneration != 0u) {
             value = node->value;
             destroyValue = 1;
             if (cache->stats.bytesLive >= node->bytes) {
@@ -1043,9 +1163,7 @@ void artifact_cache_evict(ArtifactCache* cache, U64 frameIndex, U32 targetCount)
             }
         }
 
-        ArtifactTypeId typeId = node ? node->typeId : 0u;
-        ArtifactKey key = node ? node->key : ARTIFACT_KEY_ZERO;
-        artifact_table_remove_locked_(cache, typeId, key);
+        artifact_table_remove_locked_(cache, node->typeId, node->key);
         slot_map_release(&cache->slots, bestSlot, cache->slots.generations[bestSlot], 0);
         cache->stats.evicted += 1u;
         artifact_unlock_(cache);
@@ -1077,12 +1195,8 @@ U32 artifact_debug_dump(ArtifactCache* cache, ArtifactDebugEntry* outEntries, U3
     }
 
     artifact_lock_(cache);
-    for (U32 slot = 0u; slot < cache->slots.capacity && result < maxEntries; ++slot) {
-        if (!slot_map_is_occupied(&cache->slots, slot)) {
-            continue;
-        }
-
-        ArtifactNode* node = (ArtifactNode*)slot_map_item_at(&cache->slots, slot);
+    for (U32 at = 0u; at < cache->slots.count && result < maxEntries; ++at) {
+        ArtifactNode* node = (ArtifactNode*)slot_map_item_at(&cache->slots, cache->slots.dense[at]);
         if (!node) {
             continue;
         }
@@ -89,9 +89,9 @@ struct ArtifactTypeDesc {
     ArtifactDestroyProc* destroyProc;
     void* userData;
     U32 flags;
-    U32 evictionTargetCount;
+    U32 evictionTargetCount;   // per-type budgets, enforced by artifact_cache_evict; 0 = none
     U64 evictionTargetBytes;
-    U64 evictionMaxIdleFrames;
+    U64 evictionMaxIdleFrames; // never evict within this many frames of the last touch
 };
 
 struct ArtifactCacheDesc {
@@ -99,6 +99,7 @@ struct ArtifactCacheDesc {
     JobSystem* jobSystem;
     ContentStore* content;
     U32 initialSlotCapacity;
+    U32 maxSlotCapacity; // 0 = ARTIFACT_DEFAULT_MAX_SLOT_CAPACITY; address space is reserved for this many
     U32 initialTableCapacity;
     U32 initialTypeCapacity;
     U32 requestDataSize;
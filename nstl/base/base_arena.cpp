@@ -62,35 +62,78 @@ U32 arena_debug_snapshot(ArenaDebugInfo* out, U32 capacity) {
         info->name = g_arenaDebugSlots[i].name;
         info->reserved = 0;
         info->committed = 0;
+        info->largePageBytes = 0;
         info->blockCount = 0;
         for (Arena* block = head->current; block != 0; block = block->prev) {
             info->reserved += block->reserved;
             info->committed += block->committed;
+            if (block->largePages != OS_LargePageKind_None) {
+                info->largePageBytes += block->reserved;
+            }
+            info->blockCount += 1u;
+        }
+        for (Arena* block = head->spareBlocks; block != 0; block = block->prev) {
+            info->reserved += block->reserved;
+            info->committed += block->committed;
+            info->largePageBytes += block->reserved;
             info->blockCount += 1u;
         }
         info->pos = arena_get_pos(head);
         info->highWater = head->highWater;
+        info->reclaimed = head->reclaimed;
     }
     arena_debug_unlock_();
     return count;
 }
 
+// Transparent large pages are committed a whole large page at a time, or the
+// kernel has nothing to back with one.
+static U64 arena_commit_granularity_(Arena* block) {
+    OS_SystemInfo* sysInfo = OS_get_system_info();
+    return (block->largePages == OS_LargePageKind_Transparent) ? sysInfo->largePageSize : sysInfo->pageSize;
+}
+
 Arena* arena_alloc_(const ArenaParameters& parameters) {
     ASSERT_DEBUG(parameters.arenaSize >= parameters.committedSize && "Arena size should be bigger than commit size");
 
     auto sysInfo = OS_get_system_info();
     U64 pageSize = sysInfo->pageSize;
-
-    U64 reserveSize = align_pow2(parameters.arenaSize + ARENA_HEADER_SIZE, pageSize);
-    U64 initialCommitSize = align_pow2(ARENA_HEADER_SIZE + parameters.committedSize, pageSize);
-
-    void* raw = OS_reserve(reserveSize);
+    B32 wantLargePages = FLAGS_HAS(parameters.flags, ArenaFlags_LargePages) && sysInfo->largePageSize != 0;
+
+    U64 reserveSize = align_pow2(parameters.arenaSize + ARENA_HEADER_SIZE,
+                                 wantLargePages ? sysInfo->largePageSize : pageSize);
+
+    // Explicit large pages are resident from the moment they are reserved, so
+    // a chained arena only asks for its initial commit in them and lets the
+    // chain add blocks as it grows; otherwise arenaSize would be pinned up front.
+    U32 largePages = OS_LargePageKind_None;
+    void* raw = 0;
+    if (wantLargePages) {
+        U64 pinnedSize = reserveSize;
+        if (FLAGS_HAS(parameters.flags, ArenaFlags_DoChain)) {
+            pinnedSize = MIN(align_pow2(ARENA_HEADER_SIZE + parameters.committedSize, sysInfo->largePageSize), reserveSize);
+        }
+        raw = OS_reserve_large(pinnedSize, &largePages);
+        if (raw && largePages != OS_LargePageKind_Explicit && pinnedSize != reserveSize) {
+            OS_release(raw, pinnedSize);
+            raw = OS_reserve_large(reserveSize, &largePages);
+        } else if (largePages == OS_LargePageKind_Explicit) {
+            reserveSize = pinnedSize;
+        }
+    } else {
+        raw = OS_reserve(reserveSize);
+    }
     if (UNLIKELY(raw == nullptr)) {
         ASSERT_DEBUG(false && "Failed to reserve memory for Arena!");
         OS_abort(1);
     }
 
-    if (UNLIKELY(!OS_commit(raw, initialCommitSize))) {
+    U64 commitGranularity = (largePages == OS_LargePageKind_Transparent) ? sysInfo->largePageSize : pageSize;
+    U64 initialCommitSize = align_pow2(ARENA_HEADER_SIZE + parameters.committedSize, commitGranularity);
+    initialCommitSize = MIN(initialCommitSize, reserveSize);
+    if (largePages == OS_LargePageKind_Explicit) {
+        initialCommitSize = reserveSize;
+    } else if (UNLIKELY(!OS_commit(raw, initialCommitSize))) {
         OS_release(raw, reserveSize);
         ASSERT_DEBUG(false && "Failed to commit initial memory for Arena!");
         return nullptr;
@@ -102,9 +145,16 @@ Arena* arena_alloc_(const ArenaParameters& parameters) {
     arena->pos = ARENA_HEADER_SIZE;
     arena->highWater = 0;
     arena->flags = parameters.flags;
+    arena->largePages = largePages;
     arena->current = arena;
     arena->startPos = 0;
     arena->prev = nullptr;
+    arena->decommitKeepSize = parameters.decommitKeepSize;
+    arena->decommitWindowNs = parameters.decommitWindowNs;
+    arena->windowPeak = 0;
+    arena->windowStartNs = 0;
+    arena->reclaimed = 0;
+    arena->spareBlocks = nullptr;
 
     ASAN_POISON_MEMORY_REGION(raw, initialCommitSize);
     ASAN_UNPOISON_MEMORY_REGION(raw, ARENA_HEADER_SIZE);
@@ -123,13 +173,34 @@ void arena_release(Arena* arena) {
 
     arena_debug_unregister_(arena);
 
+    for (Arena* n = arena->spareBlocks,* prev = 0; n != 0; n = prev) {
+        prev = n->prev;
+        OS_release(n, n->reserved);
+    }
     for (Arena* n = arena->current,* prev = 0; n != 0; n = prev) {
         prev = n->prev;
         OS_release(n, n->reserved);
     }
 }
 
-void* arena_push(Arena* arena, U64 size, U64 alignment) {
+// Explicit large-page blocks come back from the kernel zeroed and mapped
+// anew each time, which a per-frame arena would pay every frame; popped
+// ones wait on the first block for the chain to grow again.
+static Arena* arena_take_spare_block_(Arena* arena, U64 minReserved) {
+    for (Arena** link = &arena->spareBlocks; *link != 0; link = &(*link)->prev) {
+        Arena* block = *link;
+        if (block->reserved >= minReserved) {
+            *link = block->prev;
+            block->pos = ARENA_HEADER_SIZE;
+            block->current = block;
+            block->prev = nullptr;
+            return block;
+        }
+    }
+    return nullptr;
+}
+
+void* (arena_push)(Arena* arena, U64 size, U64 alignment) {
     ASSERT_DEBUG(arena && "Arena must not be null");
     ASSERT_DEBUG(is_power_of_two(alignment) && "Alignment must be a power of two");
 
@@ -141,10 +212,7 @@ void* arena_push(Arena* arena, U64 size, U64 alignment) {
 
         if (newPos <= current->reserved) {
             if (newPos > current->committed) {
-                auto sysInfo = OS_get_system_info();
-                U64 pageSize = sysInfo->pageSize;
-
-                U64 newCommitTarget = align_pow2(newPos, pageSize);
+                U64 newCommitTarget = align_pow2(newPos, arena_commit_granularity_(current));
                 newCommitTarget = MIN(newCommitTarget, current->reserved);
 
                 U64 sizeToCommit = newCommitTarget - current->committed;
@@ -162,6 +230,9 @@ void* arena_push(Arena* arena, U64 size, U64 alignment) {
             if (absolutePos > arena->highWater) {
                 arena->highWater = absolutePos;
             }
+            if (absolutePos > arena->windowPeak) {
+                arena->windowPeak = absolutePos;
+            }
             ASAN_UNPOISON_MEMORY_REGION(result, size);
 
             if (UNLIKELY(result == nullptr)) {
@@ -178,11 +249,14 @@ void* arena_push(Arena* arena, U64 size, U64 alignment) {
         }
 
         U64 nextArenaSize = MAX(current->reserved, size + ARENA_HEADER_SIZE);
-        Arena* nextArena = arena_alloc(
-            .arenaSize = nextArenaSize,
-            .committedSize = nextArenaSize,
-            .flags = current->flags,
-        );
+        Arena* nextArena = arena_take_spare_block_(arena, size + ARENA_HEADER_SIZE);
+        if (!nextArena) {
+            nextArena = arena_alloc(
+                .arenaSize = nextArenaSize,
+                .committedSize = nextArenaSize,
+                .flags = current->flags,
+            );
+        }
         nextArena->startPos = current->startPos + current->reserved;
         nextArena->prev = current;
         current->current = nextArena;
@@ -192,6 +266,34 @@ void* arena_push(Arena* arena, U64 size, U64 alignment) {
     }
 }
 
+// Only the current block is trimmed; blocks past it were already released
+// by the pop. The clock is read only when there is something to give back.
+// Explicit large pages cannot be decommitted.
+static void arena_decommit_tick_(Arena* arena, Arena* current) {
+    if (arena->decommitKeepSize == 0 || current->committed <= arena->decommitKeepSize ||
+        current->largePages == OS_LargePageKind_Explicit) {
+        return;
+    }
+    U64 nowNs = OS_get_time_nanoseconds();
+    if (nowNs - arena->windowStartNs < arena->decommitWindowNs) {
+        return;
+    }
+
+    U64 granularity = arena_commit_granularity_(current);
+    U64 peakInBlock = arena->windowPeak + ARENA_HEADER_SIZE;
+    peakInBlock = (peakInBlock > current->startPos) ? (peakInBlock - current->startPos) : 0;
+    U64 keep = MAX(MAX(peakInBlock, current->pos), arena->decommitKeepSize);
+    keep = MIN(align_pow2(keep, granularity), current->reserved);
+    if (keep < current->committed) {
+        OS_decommit((U8*)current + keep, current->committed - keep);
+        arena->reclaimed += current->committed - keep;
+        current->committed = keep;
+    }
+
+    arena->windowStartNs = nowNs;
+    arena->windowPeak = arena_get_pos(arena);
+}
+
 void arena_pop_to(Arena* arena, U64 pos) {
     if (!arena) {
         return;
@@ -202,7 +304,13 @@ void arena_pop_to(Arena* arena, U64 pos) {
 
     while (current->prev != nullptr && absolutePos < current->startPos) {
         Arena* prev = current->prev;
-        OS_release(current, current->reserved);
+        if (current->largePages == OS_LargePageKind_Explicit) {
+            ASAN_POISON_MEMORY_REGION((U8*)current + ARENA_HEADER_SIZE, current->reserved - ARENA_HEADER_SIZE);
+            current->prev = arena->spareBlocks;
+            arena->spareBlocks = current;
+        } else {
+            OS_release(current, current->reserved);
+        }
         current = prev;
         arena->current = current;
     }
@@ -210,6 +318,8 @@ void arena_pop_to(Arena* arena, U64 pos) {
     U64 relativePos = absolutePos - current->startPos;
     current->pos = CLAMP_BOT(ARENA_HEADER_SIZE, relativePos);
     ASAN_POISON_MEMORY_REGION((U8*)current + current->pos, current->pos - relativePos);
+
+    arena_decommit_tick_(arena, current);
 }
 
 U64 arena_get_pos(Arena* arena) {
@@ -220,6 +330,90 @@ U64 arena_get_pos(Arena* arena) {
     return (arena->current->startPos + arena->current->pos) - ARENA_HEADER_SIZE;
 }
 
+#if ARENA_TRACKING
+// prof sits above base, so tracking declares what it needs.
+UTILITIES_SHARED_API void prof_alloc(U32* site, const char* label, const char* file, U32 line, U64 size);
+
+void* arena_push_tracked_(U32* site, const char* function, const char* file, U32 line,
+                          Arena* arena, U64 size, U64 alignment) {
+    void* result = (arena_push)(arena, size, alignment);
+    prof_alloc(site, function, file, line, size);
+    return result;
+}
+#endif
+
+
+// ////////////////////////
+// Atomic Arena
+
+B32 atomic_arena_init(AtomicArena* atomic, Arena* backing, U64 capacity, U64 chunkSize) {
+    ASSERT_DEBUG(chunkSize != 0u && "AtomicArena needs a chunk size");
+    atomic->base = (U8*)arena_push(backing, capacity, CACHE_LINE_SIZE);
+    atomic->capacity = atomic->base ? capacity : 0u;
+    atomic->chunkSize = chunkSize;
+    atomic->pos = 0u;
+    return atomic->base != 0;
+}
+
+void* atomic_arena_push(AtomicArena* atomic, AtomicArenaCursor* cursor, U64 size, U64 alignment) {
+    U64 at = align_pow2(cursor->at, alignment);
+    if (cursor->end == 0u || at + size > cursor->end) {
+        U64 claim = MAX(atomic->chunkSize, size + alignment - 1u);
+        U64 start = ATOMIC_FETCH_ADD(&atomic->pos, claim, MEMORY_ORDER_RELAXED);
+        if (start >= atomic->capacity) {
+            return 0;
+        }
+        at = align_pow2(start, alignment);
+        cursor->end = MIN(start + claim, atomic->capacity);
+        if (at + size > cursor->end) {
+            cursor->at = start;
+            return 0;
+        }
+    }
+    cursor->at = at + size;
+    return atomic->base + at;
+}
+
+void atomic_arena_reset(AtomicArena* atomic) {
+    ATOMIC_STORE(&atomic->pos, 0u, MEMORY_ORDER_RELAXED);
+}
+
+U32 atomic_arena_filled_ranges(AtomicArena* atomic, const AtomicArenaCursor* cursors,
+                               U32 cursorCount, RangeU64* outRanges) {
+    U64 used = MIN(ATOMIC_LOAD(&atomic->pos, MEMORY_ORDER_ACQUIRE), atomic->capacity);
+
+    // Tails first, insertion-sorted by start; there is one per writer.
+    U32 tailCount = 0u;
+    for (U32 at = 0u; at < cursorCount; ++at) {
+        const AtomicArenaCursor* cursor = cursors + at;
+        if (cursor->end == 0u || cursor->at >= cursor->end) {
+            continue;
+        }
+        U32 insert = tailCount;
+        while (insert > 0u && outRanges[insert - 1u].min > cursor->at) {
+            outRanges[insert] = outRanges[insert - 1u];
+            insert -= 1u;
+        }
+        outRanges[insert] = {cursor->at, cursor->end};
+        tailCount += 1u;
+    }
+
+    // Then the gaps between them, in place: range k never overtakes tail k.
+    U32 rangeCount = 0u;
+    U64 filledFrom = 0u;
+    for (U32 at = 0u; at < tailCount; ++at) {
+        RangeU64 tail = outRanges[at];
+        if (tail.min > filledFrom) {
+            outRanges[rangeCount++] = {filledFrom, tail.min};
+        }
+        filledFrom = tail.max;
+    }
+    if (used > filledFrom) {
+        outRanges[rangeCount++] = {filledFrom, used};
+    }
+    return rangeCount;
+}
+
 
 // ////////////////////////
 // Scratch
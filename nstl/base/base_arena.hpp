@@ -10,6 +10,14 @@
 enum ArenaFlags {
     ArenaFlags_None = 0,
     ArenaFlags_DoChain = (1 << 0),
+    // Back the reservation with large pages when the OS grants them, for big
+    // tables streamed every frame. Falls back to normal pages silently;
+    // Arena::largePages and ArenaDebugInfo::largePageBytes say what was granted.
+    // Explicit pages are resident once reserved: with DoChain they are taken a
+    // block at a time as the arena grows, without it for the whole arenaSize.
+    // Chained explicit blocks are kept across pops and reused, so a per-frame
+    // arena maps them once at its peak rather than every frame.
+    ArenaFlags_LargePages = (1 << 1),
 };
 
 struct ArenaParameters {
@@ -17,6 +25,13 @@ struct ArenaParameters {
     U64 committedSize = KB(32);
     U64 flags = ArenaFlags_DoChain;
     const char* debugName = 0; // static string; non-null registers the arena for debug snapshots
+    // Decommit policy, off while decommitKeepSize is 0. Otherwise arena_pop_to
+    // hands committed pages back to the OS above the larger of
+    // decommitKeepSize and the peak reached over the last decommitWindowNs,
+    // so a one-off spike stops being resident once a whole window passes
+    // without it, while a per-frame spike never thrashes.
+    U64 decommitKeepSize = 0;
+    U64 decommitWindowNs = BILLION(1ull);
 };
 
 struct Arena {
@@ -26,8 +41,16 @@ struct Arena {
     U64 startPos; // This position is relative to the total arena size, including all blocks
     U64 highWater; // max arena_get_pos ever reached, survives pops
     U64 flags;
+    U64 largePages; // OS_LargePageKind granted to this block
     Arena* prev;
     Arena* current;
+    // Decommit policy state, kept on the first block only.
+    U64 decommitKeepSize;
+    U64 decommitWindowNs;
+    U64 windowPeak;    // max arena_get_pos since windowStartNs
+    U64 windowStartNs;
+    U64 reclaimed;     // bytes handed back by the policy, cumulative
+    Arena* spareBlocks; // explicit large-page blocks popped off the chain, linked by prev
 };
 
 #define ARENA_HEADER_SIZE sizeof(Arena)
@@ -36,7 +59,8 @@ UTILITIES_SHARED_API Arena* arena_alloc_(const ArenaParameters& parameters);
 #define arena_alloc(...) arena_alloc_({__VA_ARGS__})
 UTILITIES_SHARED_API void arena_release(Arena* arena);
 
-UTILITIES_SHARED_API void* arena_push(Arena* arena, U64 size, U64 alignment = sizeof(void*));
+// The name is parenthesized so the ARENA_TRACKING wrapper below can reuse it.
+UTILITIES_SHARED_API void* (arena_push)(Arena* arena, U64 size, U64 alignment = sizeof(void*));
 UTILITIES_SHARED_API void arena_pop_to(Arena* arena, U64 pos);
 UTILITIES_SHARED_API U64 arena_get_pos(Arena* arena);
 
@@ -51,16 +75,70 @@ struct ArenaDebugInfo {
     U64 committed;
     U64 pos;
     U64 highWater;
+    U64 reclaimed;
+    U64 largePageBytes; // reserved bytes of blocks backed by large pages
     U32 blockCount;
 };
 
 UTILITIES_SHARED_API U32 arena_debug_snapshot(ArenaDebugInfo* out, U32 capacity);
 
+// Allocation tracking, off unless built with ARENA_TRACKING=1. Every
+// arena_push then reports its callsite and size into the calling thread's
+// profiler ring; collation charges the bytes to that frame, to the callsite
+// (ProfSiteStats) and to the scope that was open (ProfPathStats, one leaf
+// per callsite under it). Compiled out, arena_push is the plain call.
+#ifndef ARENA_TRACKING
+#define ARENA_TRACKING 0
+#endif
+
+#if ARENA_TRACKING
+UTILITIES_SHARED_API void* arena_push_tracked_(U32* site, const char* function, const char* file, U32 line,
+                                               Arena* arena, U64 size, U64 alignment = sizeof(void*));
+// One cached profiler site per expansion.
+#define ARENA_TRACK_SITE_() ([]() -> U32* { static U32 site = 0u; return &site; }())
+#define arena_push(...) arena_push_tracked_(ARENA_TRACK_SITE_(), __func__, __FILE__, (U32)__LINE__, __VA_ARGS__)
+#endif
+
 #define ARENA_PUSH_ARRAY_ALIGNED(arena, T, count, alignment) (T*)arena_push((arena), sizeof(T) * (count), (alignment))
 #define ARENA_PUSH_ARRAY(arena, T, count) ARENA_PUSH_ARRAY_ALIGNED(arena, T, count, alignof(T))
 #define ARENA_PUSH_STRUCT(arena, T) (T*)arena_push(arena, sizeof(T), alignof(T))
 
 
+// ////////////////////////
+// Atomic Arena
+//
+// Bump allocation from many threads into one fixed range pushed from a
+// backing arena, so it goes away with the backing arena's next pop. Each
+// writer owns an AtomicArenaCursor and claims chunkSize bytes at a time
+// with a single fetch-add, then bumps inside its chunk privately. Once the
+// range is used up, pushes return 0.
+//
+// Writers that push one fixed size dividing chunkSize (itself a multiple of
+// the alignment) leave no gaps except the unfilled tail of each cursor's
+// last chunk; atomic_arena_filled_ranges lists what is between those tails.
+
+struct AtomicArena {
+    U8* base;
+    U64 capacity;
+    U64 chunkSize;
+    U64 pos; // bytes claimed; runs past capacity once full
+};
+
+struct AtomicArenaCursor {
+    U64 at;  // offsets from base; end == 0 until the first claim
+    U64 end;
+};
+
+UTILITIES_SHARED_API B32 atomic_arena_init(AtomicArena* atomic, Arena* backing, U64 capacity, U64 chunkSize);
+UTILITIES_SHARED_API void* atomic_arena_push(AtomicArena* atomic, AtomicArenaCursor* cursor, U64 size, U64 alignment);
+// No writer may be pushing; zero their cursors as well.
+UTILITIES_SHARED_API void atomic_arena_reset(AtomicArena* atomic);
+// Fills outRanges (room for cursorCount + 1) with the byte ranges written so
+// far, ascending, skipping the cursors' tails. Writers must have finished.
+UTILITIES_SHARED_API U32 atomic_arena_filled_ranges(AtomicArena* atomic, const AtomicArenaCursor* cursors,
+                                                    U32 cursorCount, RangeU64* outRanges);
+
+
 // ////////////////////////
 // Temp
 
@@ -84,6 +84,14 @@ static inline S32 safe_cast_u32_s32_impl(U32 value) {
 #define FORCE_INLINE inline
 #endif
 
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+#define NO_INLINE __attribute__((noinline))
+#elif defined(COMPILER_MSVC)
+#define NO_INLINE __declspec(noinline)
+#else
+#define NO_INLINE
+#endif
+
 
 // ////////////////////////
 // Keywords
@@ -126,13 +134,22 @@ EXTERN_C void __asan_unpoison_memory_region(void const volatile* addr, U32 size)
 // //////////////////////////////
 // Memory Operations
 
+// The 8-byte fast paths below copy arbitrary objects through a word type
+// that may alias anything, so type-based alias analysis cannot reorder
+// them against the caller's typed stores.
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+typedef U64 __attribute__((may_alias)) U64Alias;
+#else
+typedef U64 U64Alias;
+#endif
+
 FORCE_INLINE void* mem_copy(void* dst, const void* src, U64 size) {
     U8* d = (U8*)dst;
     const U8* s = (const U8*)src;
 
     if (((uintptr)d & 7) == 0 && ((uintptr)s & 7) == 0) {
         while (size >= 8) {
-            *(U64*)d = *(const U64*)s;
+            *(U64Alias*)d = *(const U64Alias*)s;
             d += 8; s += 8; size -= 8;
         }
     }
@@ -161,7 +178,7 @@ FORCE_INLINE void* mem_move(void* dst, const void* src, U64 size) {
     if (((uintptr)d & 7) == 0 && ((uintptr)s & 7) == 0) {
         while (size >= 8) {
             d -= 8; s -= 8;
-            *(U64*)d = *(const U64*)s;
+            *(U64Alias*)d = *(const U64Alias*)s;
             size -= 8;
         }
     }
@@ -181,7 +198,7 @@ FORCE_INLINE void* mem_set(void* dst, U8 value, U64 size) {
 
     if (((uintptr)d & 7) == 0) {
         while (size >= 8) {
-            *(U64*)d = fill8;
+            *(U64Alias*)d = fill8;
             d += 8; size -= 8;
         }
     }
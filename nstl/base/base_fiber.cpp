@@ -0,0 +1,159 @@
+//
+// Fiber context switches: the SysV x86-64 and AAPCS64 switch and start
+// routines in assembly, and the stack frame a fresh fiber starts from.
+//
+
+#if FIBER_SUPPORTED
+
+// ////////////////////////
+// Context switch
+//
+// fiber_switch_asm_(void** fromStackPointer, void* toStackPointer) pushes
+// the callee-saved state, stores the stack pointer through the first
+// argument, loads the second and pops the target's state. A fresh fiber's
+// frame returns into fiber_start_asm_, which calls entry(userData) with the
+// two values parked in callee-saved registers.
+
+#if defined(PLATFORM_OS_MACOS)
+#define FIBER_ASM_BEGIN(name) \
+    ".text\n.globl _" #name "\n.private_extern _" #name "\n.p2align 4\n_" #name ":\n"
+#else
+#define FIBER_ASM_BEGIN(name) \
+    ".text\n.globl " #name "\n.hidden " #name "\n.type " #name ", %function\n.p2align 4\n" #name ":\n"
+#endif
+
+EXTERN_C __attribute__((visibility("hidden"))) void fiber_switch_asm_(void** fromStackPointer, void* toStackPointer);
+EXTERN_C __attribute__((visibility("hidden"))) void fiber_start_asm_(void);
+
+#if defined(PLATFORM_ARCH_X64)
+
+// Frame (low to high): x87 control word + MXCSR, r15, r14, r13, r12, rbx,
+// rbp, return address.
+#define FIBER_FRAME_WORDS 8u
+
+__asm__(
+    FIBER_ASM_BEGIN(fiber_switch_asm_)
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr 4(%rsp)\n"
+    "    fnstcw (%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr 4(%rsp)\n"
+    "    fldcw (%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    FIBER_ASM_BEGIN(fiber_start_asm_)
+    "    movq %r13, %rdi\n"
+    "    callq *%r12\n"
+    "    ud2\n"
+);
+
+#elif defined(PLATFORM_ARCH_ARM64)
+
+// Frame (low to high): x19..x28, x29 (fp), x30 (lr), d8..d15.
+#define FIBER_FRAME_WORDS 20u
+
+__asm__(
+    FIBER_ASM_BEGIN(fiber_switch_asm_)
+    "    sub sp, sp, #160\n"
+    "    stp x19, x20, [sp, #0]\n"
+    "    stp x21, x22, [sp, #16]\n"
+    "    stp x23, x24, [sp, #32]\n"
+    "    stp x25, x26, [sp, #48]\n"
+    "    stp x27, x28, [sp, #64]\n"
+    "    stp x29, x30, [sp, #80]\n"
+    "    stp d8, d9, [sp, #96]\n"
+    "    stp d10, d11, [sp, #112]\n"
+    "    stp d12, d13, [sp, #128]\n"
+    "    stp d14, d15, [sp, #144]\n"
+    "    mov x9, sp\n"
+    "    str x9, [x0]\n"
+    "    mov sp, x1\n"
+    "    ldp x19, x20, [sp, #0]\n"
+    "    ldp x21, x22, [sp, #16]\n"
+    "    ldp x23, x24, [sp, #32]\n"
+    "    ldp x25, x26, [sp, #48]\n"
+    "    ldp x27, x28, [sp, #64]\n"
+    "    ldp x29, x30, [sp, #80]\n"
+    "    ldp d8, d9, [sp, #96]\n"
+    "    ldp d10, d11, [sp, #112]\n"
+    "    ldp d12, d13, [sp, #128]\n"
+    "    ldp d14, d15, [sp, #144]\n"
+    "    add sp, sp, #160\n"
+    "    ret\n"
+    FIBER_ASM_BEGIN(fiber_start_asm_)
+    "    mov x0, x20\n"
+    "    blr x19\n"
+    "    brk #0\n"
+);
+
+#endif
+
+static
+void fiber_context_init(FiberContext* context, void* stackBase, U64 stackSize,
+                        FiberEntryFunc* entry, void* userData) {
+    ASSERT_DEBUG(context && stackBase && entry);
+    ASSERT_DEBUG(stackSize >= KB(4) && ((uintptr) stackBase & 15u) == 0u);
+
+    *(U64*) stackBase = FIBER_STACK_CANARY;
+
+    uintptr top = ((uintptr) stackBase + stackSize) & ~(uintptr) 15u;
+    U64* frame = (U64*) (top - FIBER_FRAME_WORDS * sizeof(U64));
+    MEMSET(frame, 0, FIBER_FRAME_WORDS * sizeof(U64));
+#if defined(PLATFORM_ARCH_X64)
+    frame[0] = 0x037Full | (0x1F80ull << 32); // default x87 control word, MXCSR
+    frame[3] = (U64) (uintptr) userData;      // r13
+    frame[4] = (U64) (uintptr) entry;         // r12
+    frame[7] = (U64) (uintptr) fiber_start_asm_;
+#elif defined(PLATFORM_ARCH_ARM64)
+    frame[0] = (U64) (uintptr) entry;         // x19
+    frame[1] = (U64) (uintptr) userData;      // x20
+    frame[11] = (U64) (uintptr) fiber_start_asm_; // x30
+#endif
+    context->stackPointer = frame;
+}
+
+static
+void fiber_switch(FiberContext* from, FiberContext* to) {
+    ASSERT_DEBUG(from && to && to->stackPointer);
+    fiber_switch_asm_(&from->stackPointer, to->stackPointer);
+}
+
+#else
+
+static
+void fiber_context_init(FiberContext* context, void* stackBase, U64 stackSize,
+                        FiberEntryFunc* entry, void* userData) {
+    (void) context;
+    (void) stackBase;
+    (void) stackSize;
+    (void) entry;
+    (void) userData;
+    ASSERT_ALWAYS(false && "Fibers are not supported on this target");
+}
+
+static
+void fiber_switch(FiberContext* from, FiberContext* to) {
+    (void) from;
+    (void) to;
+    ASSERT_ALWAYS(false && "Fibers are not supported on this target");
+}
+
+#endif
+
+static
+B32 fiber_stack_intact(const void* stackBase) {
+    return *(const U64*) stackBase == FIBER_STACK_CANARY;
+}
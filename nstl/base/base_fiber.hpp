@@ -0,0 +1,35 @@
+//
+// Minimal user-mode context switching: one hand-written switch per
+// architecture saves the callee-saved registers on the current stack, swaps
+// stack pointers and restores the target's. No signal masks, no TLS
+// swapping; the job system builds its fiber backend on top.
+//
+
+#pragma once
+
+// Hand-written switches exist for the SysV x86-64 and AAPCS64 ABIs
+// (macOS, Linux). Windows x64 keeps extra state in the TIB and MSVC has no
+// x64 inline assembler, so fibers stay off there; ASan builds skip them
+// too rather than annotating every switch for the sanitizer.
+#if (defined(COMPILER_CLANG) || defined(COMPILER_GCC)) && !defined(PLATFORM_OS_WINDOWS) && \
+    (defined(PLATFORM_ARCH_X64) || defined(PLATFORM_ARCH_ARM64)) && !ADDRESS_SANITIZER
+#define FIBER_SUPPORTED 1
+#else
+#define FIBER_SUPPORTED 0
+#endif
+
+// Stacks are carved from arenas, so there is no guard page; debug builds
+// check this canary at the stack's low end when a fiber is recycled.
+#define FIBER_STACK_CANARY 0xF1BE55AC0FFEE000ull
+
+typedef void FiberEntryFunc(void* userData);
+
+struct FiberContext {
+    void* stackPointer; // saved register frame while switched out
+};
+
+// entry must never return: it switches away for good instead.
+static void fiber_context_init(FiberContext* context, void* stackBase, U64 stackSize,
+                               FiberEntryFunc* entry, void* userData);
+static void fiber_switch(FiberContext* from, FiberContext* to);
+static B32 fiber_stack_intact(const void* stackBase);
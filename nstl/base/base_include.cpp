@@ -7,8 +7,10 @@
 #include "base_math.cpp"
 #include "base_arena.cpp"
 #include "base_slot_map.cpp"
+#include "base_pool.cpp"
 #include "base_string.cpp"
 #include "base_spmc.cpp"
+#include "base_fiber.cpp"
 #include "base_job_system.cpp"
 #include "base_threading.cpp"
 #include "base_log.cpp"
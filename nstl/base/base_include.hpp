@@ -8,11 +8,14 @@
 
 #include "base_typedefs.hpp"
 #include "base_core.hpp"
+#include "base_simd.hpp"
 #include "base_math.hpp"
 #include "base_arena.hpp"
 #include "base_slot_map.hpp"
+#include "base_pool.hpp"
 #include "base_string.hpp"
 #include "base_spmc.hpp"
+#include "base_fiber.hpp"
 #include "base_job_system.hpp"
 #include "base_threading.hpp"
 #include "base_log.hpp"
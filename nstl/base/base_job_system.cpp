@@ -7,21 +7,67 @@
 static_assert(is_power_of_two(JOB_SYSTEM_QUEUE_SIZE), "JOB_SYSTEM_QUEUE_SIZE must be a power of two");
 #define JOB_SYSTEM_INVALID_WORKER_INDEX 0xFFFFFFFFu
 
+// Job::remainingJobs layout.
+#define JOB_COUNT_MASK 0xFFFFFFFFull
+#define JOB_WAITER_SHIFT 32u
+
+
 // ////////////////////////
 // JobSystem struct definition
 
+enum JobFiberAction {
+    JobFiberAction_None = 0,
+    JobFiberAction_Finished,
+    JobFiberAction_Wait,
+    JobFiberAction_Yield, // job_system_checkpoint gave way to critical work
+};
+
+struct JobFiber {
+    Job job; // job to start; fibers loop, so this is refilled per run
+    FiberContext context;
+    void* stackBase;
+    Job* waitRoot;
+    U32 index;
+    U32 priority; // JobPriority of the job it runs; resumes queue at it
+    U32 nextFree; // free list link: index + 1, 0 ends the list
+};
+
+// Steal victims sorted by topology distance. Attempt a of a steal round
+// draws from the first ringEnd[a] entries; the last ring is everyone.
+struct JobVictimOrder {
+    U32* victims; // queue indices, nearest first
+    U32 ringEnd[JOB_SYSTEM_STEAL_TRIES];
+};
+
+// One cache line (or more) per thread so live counters never false-share.
+struct alignas(CACHE_LINE_SIZE) JobThreadStats {
+    JobSystemStats stats;
+};
+static_assert(sizeof(JobSystemStats) % sizeof(U64) == 0, "JobSystemStats is read as U64 words");
+
 struct JobSystem {
-    WSDeque** queues;
+    WSDeque** queues[JobPriority_Count]; // per priority: main + workers
     OS_Handle* workers;
     U32 workerCount;
     U64 shutdown;
-    U64 pendingJobs;
-    OS_Handle wakeMutex;
-    OS_Handle wakeCondition;
-#ifndef NDEBUG
-    JobSystemStats* workerStats; // length = workerCount + 1 (main + workers)
-    JobSystemStats totals;
-#endif
+    // Queued, not yet started jobs per priority.
+    alignas(CACHE_LINE_SIZE) U64 pendingJobs[JobPriority_Count];
+    // Eventcount: idle workers park on wakeEpoch. Submitters read
+    // sleepingWorkers and only bump the epoch (and pay the wake syscall)
+    // when somebody is actually parked.
+    alignas(CACHE_LINE_SIZE) U32 wakeEpoch;
+    U32 sleepingWorkers;
+    // Joiners (job_system_wait with nothing left to help with) park on
+    // joinEpoch; whoever drops a parent count to zero bumps it.
+    alignas(CACHE_LINE_SIZE) U32 joinEpoch;
+    U32 sleepingJoiners;
+    // Fiber pool (null without JobSystemFlags_Fibers). The free list head
+    // packs an ABA tag (high 32) over fiber index + 1 (low 32).
+    JobFiber* fibers;
+    U32 fiberCount;
+    alignas(CACHE_LINE_SIZE) U64 fiberFreeHead;
+    JobThreadStats* threadStats; // workerCount + 1 (main + workers)
+    JobVictimOrder* victimOrders; // workerCount + 1, null without JobSystemFlags_TopologySteal
 };
 
 // ////////////////////////
@@ -29,32 +75,66 @@ struct JobSystem {
 
 struct JobSystemThreadState {
     U32 workerIndex;
-    WSDeque* queue;
+    U32 priority; // JobPriority of the job running on this thread
+    WSDeque* queues[JobPriority_Count];
     XorShift randomGenerator;
     JobSystem* jobSystem;
-#ifndef NDEBUG
-    JobSystemStats stats;
-#endif
+    FiberContext schedulerContext; // thread stack while a fiber runs
+    JobFiber* fiber;               // fiber running on this thread, if any
+    U32 fiberAction;               // JobFiberAction, set by the fiber before it switches out
+    JobSystemStats* stats;         // this thread's slot in JobSystem::threadStats
+    const JobVictimOrder* victimOrder; // null: uniform random victims
 };
 
 thread_local JobSystemThreadState g_tlsJobState = {};
 
+// With fibers a job can suspend on one thread and resume on another, and
+// compilers cache TLS addresses across calls within a function. Every
+// access goes through this opaque accessor so it is re-derived each time.
+static NO_INLINE JobSystemThreadState* job_tls_(void) {
+#if FIBER_SUPPORTED
+    __asm__ __volatile__("" ::: "memory");
+#endif
+    return &g_tlsJobState;
+}
+
+static void job_system_wake_joiners_(JobSystem* jobSystem);
+static void job_fiber_ready_(JobSystem* jobSystem, JobFiber* fiber);
+static void job_fiber_resume_(void* params);
+
 static
 void job_execute(const Job* job) {
     ASSERT_DEBUG(job && job->function);
     job->function((void*) job->parameters);
     if (job->parent) {
-        ATOMIC_FETCH_SUB(&job->parent->remainingJobs, 1, MEMORY_ORDER_ACQ_REL);
+        // The parent may live on the waiter's stack: once the count hits
+        // zero it is gone, so only the job system is touched afterwards. A
+        // parked fiber's index comes back in the same fetch-sub.
+        U64 previous = ATOMIC_FETCH_SUB(&job->parent->remainingJobs, 1, MEMORY_ORDER_ACQ_REL);
+        if ((previous & JOB_COUNT_MASK) == 1u) {
+            JobSystem* jobSystem = job_tls_()->jobSystem;
+            if (jobSystem) {
+                U32 waiter = (U32) (previous >> JOB_WAITER_SHIFT);
+                if (waiter != 0u) {
+                    job_fiber_ready_(jobSystem, &jobSystem->fibers[waiter - 1u]);
+                }
+                job_system_wake_joiners_(jobSystem);
+            }
+        }
     }
 }
 
 static U32 job_system_pick_victim(U32 selfIndex,
                                   U32 totalQueues,
                                   XorShift* rng,
-                                  U32 attempt) {
+                                  U32 attempt,
+                                  const JobVictimOrder* order) {
     if (totalQueues <= 1u) {
         return 0u;
     }
+    if (order) {
+        return order->victims[xorshift_bounded(rng, order->ringEnd[attempt])];
+    }
 
     U32 victim = xorshift_bounded(rng, totalQueues);
     victim = (victim + attempt) % totalQueues;
@@ -66,6 +146,91 @@ static U32 job_system_pick_victim(U32 selfIndex,
     return victim;
 }
 
+// ////////////////////////
+// Topology
+
+// Performance cores before efficiency cores, and the first logical core of
+// every physical core before any SMT sibling. Threads past the core count
+// wrap around.
+static void job_system_place_threads_(const OS_SystemInfo* info, U32* coreOfThread, U32 threadCount) {
+    U32 order[OS_MAX_TOPOLOGY_CORES];
+    U32 orderCount = 0u;
+    for (U32 pass = 0u; pass < 4u; ++pass) {
+        U32 kind = (pass < 2u) ? OS_CoreKind_Performance : OS_CoreKind_Efficiency;
+        B32 wantFirstSibling = (pass % 2u) == 0u;
+        for (U32 at = 0u; at < info->coreCount; ++at) {
+            const OS_CoreInfo* core = &info->cores[at];
+            if (core->kind != kind) {
+                continue;
+            }
+            B32 firstSibling = 1;
+            for (U32 prior = 0u; prior < at; ++prior) {
+                if (info->cores[prior].physicalCore == core->physicalCore) {
+                    firstSibling = 0;
+                    break;
+                }
+            }
+            if (firstSibling == wantFirstSibling) {
+                order[orderCount++] = at;
+            }
+        }
+    }
+    for (U32 thread = 0u; thread < threadCount; ++thread) {
+        coreOfThread[thread] = (orderCount != 0u) ? order[thread % orderCount] : 0u;
+    }
+}
+
+static U32 job_system_core_distance_(const OS_SystemInfo* info, U32 a, U32 b) {
+    const OS_CoreInfo* coreA = &info->cores[a];
+    const OS_CoreInfo* coreB = &info->cores[b];
+    if (coreA->physicalCore == coreB->physicalCore || coreA->l2Group == coreB->l2Group) {
+        return 0u;
+    }
+    if (coreA->l3Group == coreB->l3Group) {
+        return 1u;
+    }
+    return 2u;
+}
+
+static JobVictimOrder* job_system_build_victim_orders_(Arena* arena, const OS_SystemInfo* info,
+                                                       const U32* coreOfThread, U32 threadCount) {
+    JobVictimOrder* orders = (JobVictimOrder*) arena_push(arena, sizeof(JobVictimOrder) * threadCount,
+                                                          alignof(JobVictimOrder));
+    U32* distances = (U32*) arena_push(arena, sizeof(U32) * threadCount, alignof(U32));
+    for (U32 self = 0u; self < threadCount; ++self) {
+        JobVictimOrder* order = &orders[self];
+        order->victims = (U32*) arena_push(arena, sizeof(U32) * (threadCount - 1u), alignof(U32));
+        U32 count = 0u;
+        // Insertion sort by distance; ties keep queue order.
+        for (U32 other = 0u; other < threadCount; ++other) {
+            if (other == self) {
+                continue;
+            }
+            U32 distance = job_system_core_distance_(info, coreOfThread[self], coreOfThread[other]);
+            U32 at = count;
+            while (at != 0u && distances[at - 1u] > distance) {
+                order->victims[at] = order->victims[at - 1u];
+                distances[at] = distances[at - 1u];
+                at -= 1u;
+            }
+            order->victims[at] = other;
+            distances[at] = distance;
+            count += 1u;
+        }
+        // Ring a covers distances <= a (at least the nearest tier); the
+        // last attempt always covers everyone.
+        for (U32 attempt = 0u; attempt < JOB_SYSTEM_STEAL_TRIES; ++attempt) {
+            U32 limit = MAX(attempt, distances[0]);
+            U32 end = 0u;
+            while (end < count && distances[end] <= limit) {
+                end += 1u;
+            }
+            order->ringEnd[attempt] = (attempt + 1u == JOB_SYSTEM_STEAL_TRIES) ? count : end;
+        }
+    }
+    return orders;
+}
+
 // ////////////////////////
 // Worker thread parameters
 
@@ -75,52 +240,160 @@ struct WorkerParameters {
 };
 
 static void job_system_worker_entry(void* params);
-static void job_system_on_job_popped_(JobSystem* jobSystem);
+static void job_system_wake_(JobSystem* jobSystem, U32 count);
+static B32 job_system_park_(JobSystem* jobSystem, JobSystemThreadState* tls);
+static B32 job_system_take_(JobSystem* jobSystem, JobSystemThreadState* tls, U32 maxPriority,
+                            Job* outJob, U32* outPriority);
+static void job_system_run_(JobSystem* jobSystem, const Job* job, U32 priority);
+static void job_fiber_pool_create_(JobSystem* jobSystem, Arena* arena, U32 fiberCount, U64 stackSize);
+
+// ////////////////////////
+// Stats
+//
+// Every counter has a single writer (its thread), so updates are a relaxed
+// load/store pair rather than an RMW; readers use relaxed loads.
+
+static void job_stat_add_(U64* counter, U64 delta) {
+    ATOMIC_STORE(counter, ATOMIC_LOAD(counter, MEMORY_ORDER_RELAXED) + delta, MEMORY_ORDER_RELAXED);
+}
+
+static void job_stat_max_(U64* counter, U64 value) {
+    if (value > ATOMIC_LOAD(counter, MEMORY_ORDER_RELAXED)) {
+        ATOMIC_STORE(counter, value, MEMORY_ORDER_RELAXED);
+    }
+}
+
+static void job_system_stats_accumulate_(JobSystemStats* into, const JobSystemStats* from) {
+    for (U32 priority = 0u; priority < JobPriority_Count; ++priority) {
+        into->executed[priority] += from->executed[priority];
+        into->latencyNsTotal[priority] += from->latencyNsTotal[priority];
+        into->latencyNsMax[priority] = MAX(into->latencyNsMax[priority], from->latencyNsMax[priority]);
+    }
+    into->pops += from->pops;
+    into->stealAttempts += from->stealAttempts;
+    into->steals += from->steals;
+    into->yields += from->yields;
+    into->parks += from->parks;
+    into->preemptions += from->preemptions;
+    into->idleNs += from->idleNs;
+    into->parkedNs += from->parkedNs;
+    into->queueHighWater = MAX(into->queueHighWater, from->queueHighWater);
+}
+
+U32 job_system_thread_count(JobSystem* jobSystem) {
+    return jobSystem ? jobSystem->workerCount + 1u : 0u;
+}
+
+JobSystemStats job_system_stats(JobSystem* jobSystem, U32 threadIndex) {
+    JobSystemStats result = {};
+    if (!jobSystem || threadIndex > jobSystem->workerCount) {
+        return result;
+    }
+    const U64* source = (const U64*) &jobSystem->threadStats[threadIndex].stats;
+    U64* dest = (U64*) &result;
+    for (U32 word = 0u; word < sizeof(JobSystemStats) / sizeof(U64); ++word) {
+        dest[word] = ATOMIC_LOAD(&source[word], MEMORY_ORDER_RELAXED);
+    }
+    return result;
+}
+
+JobSystemStats job_system_get_totals(JobSystem* jobSystem) {
+    JobSystemStats totals = {};
+    for (U32 at = 0u; at < job_system_thread_count(jobSystem); ++at) {
+        JobSystemStats stats = job_system_stats(jobSystem, at);
+        job_system_stats_accumulate_(&totals, &stats);
+    }
+    return totals;
+}
+
+// prof sits above base, so the worker timeline declares what it needs.
+// Category 1 is PROF_CAT_DEFAULT; sites stay 0 until the profiler is up.
+UTILITIES_SHARED_API void prof_thread_name(const char* name);
+UTILITIES_SHARED_API U32 prof_require_site(const char* label, const char* file, U32 line, U32 category);
+UTILITIES_SHARED_API void prof_begin(U32 site);
+UTILITIES_SHARED_API void prof_end();
+
+static B32 job_prof_begin_(U32* site, const char* label) {
+    U32 id = ATOMIC_LOAD(site, MEMORY_ORDER_RELAXED);
+    if (id == 0u) {
+        id = prof_require_site(label, "job_system", 0u, 1u);
+        if (id == 0u) {
+            return 0;
+        }
+        ATOMIC_STORE(site, id, MEMORY_ORDER_RELAXED);
+    }
+    prof_begin(id);
+    return 1;
+}
 
 // ////////////////////////
 // Lifecycle
 
-JobSystem* job_system_create(Arena* arena, U32 workerCount) {
+JobSystem* job_system_create_(Arena* arena, const JobSystemParameters& parameters) {
+    U32 workerCount = parameters.workerCount;
+    JobSystemThreadState* tls = job_tls_();
     ASSERT_DEBUG(workerCount >= 1);
-    ASSERT_DEBUG(g_tlsJobState.jobSystem == nullptr && "JobSystem already initialized on this thread");
+    ASSERT_DEBUG(tls->jobSystem == nullptr && "JobSystem already initialized on this thread");
     JobSystem* jobSystem = (JobSystem*) arena_push(arena, sizeof(JobSystem), alignof(JobSystem));
     MEMSET(jobSystem, 0, sizeof(JobSystem));
     jobSystem->workerCount = workerCount;
-    jobSystem->pendingJobs = 0u;
 
     U32 totalQueues = workerCount + 1u;
-    jobSystem->queues = (WSDeque**) arena_push(arena, sizeof(WSDeque*) * totalQueues, alignof(WSDeque*));
-    for (U32 i = 0; i < totalQueues; ++i) {
-        jobSystem->queues[i] = wsdq_create(arena, JOB_SYSTEM_QUEUE_SIZE, sizeof(Job));
+    for (U32 priority = 0u; priority < JobPriority_Count; ++priority) {
+        WSDeque** queues = (WSDeque**) arena_push(arena, sizeof(WSDeque*) * totalQueues, alignof(WSDeque*));
+        for (U32 i = 0; i < totalQueues; ++i) {
+            queues[i] = wsdq_create(arena, JOB_SYSTEM_QUEUE_SIZE, sizeof(Job));
+        }
+        jobSystem->queues[priority] = queues;
     }
 
     jobSystem->workers = (OS_Handle*) arena_push(arena, sizeof(OS_Handle) * workerCount, alignof(OS_Handle));
-    jobSystem->wakeMutex = OS_mutex_create();
-    jobSystem->wakeCondition = OS_condition_variable_create();
-#ifndef NDEBUG
-    jobSystem->workerStats = (JobSystemStats*) arena_push(arena, sizeof(JobSystemStats) * totalQueues,
-                                                          alignof(JobSystemStats));
-    MEMSET(jobSystem->workerStats, 0, sizeof(JobSystemStats) * totalQueues);
-    MEMSET(&jobSystem->totals, 0, sizeof(jobSystem->totals));
-#endif
+    jobSystem->threadStats = (JobThreadStats*) arena_push(arena, sizeof(JobThreadStats) * totalQueues,
+                                                          alignof(JobThreadStats));
+    MEMSET(jobSystem->threadStats, 0, sizeof(JobThreadStats) * totalQueues);
 
-    g_tlsJobState.workerIndex = 0;
-    g_tlsJobState.queue = jobSystem->queues[0];
-    g_tlsJobState.jobSystem = jobSystem;
-    g_tlsJobState.randomGenerator = xorshift_seed(((U64) (uintptr_t) jobSystem) ^ 0xD1B54A32D192ED03ull);
-#ifndef NDEBUG
-    MEMSET(&g_tlsJobState.stats, 0, sizeof(g_tlsJobState.stats));
+    if (parameters.flags & JobSystemFlags_Fibers) {
+#if FIBER_SUPPORTED
+        job_fiber_pool_create_(jobSystem, arena, parameters.fiberCount, parameters.fiberStackSize);
+#else
+        LOG_WARNING("job", "Fibers are not supported on this target; waits run nested jobs instead.");
 #endif
+    }
+
+    tls->workerIndex = 0;
+    tls->priority = JobPriority_Critical;
+    for (U32 priority = 0u; priority < JobPriority_Count; ++priority) {
+        tls->queues[priority] = jobSystem->queues[priority][0];
+    }
+    tls->jobSystem = jobSystem;
+    tls->randomGenerator = xorshift_seed(((U64) (uintptr_t) jobSystem) ^ 0xD1B54A32D192ED03ull);
+    tls->stats = &jobSystem->threadStats[0].stats;
+
+    U32* coreOfThread = 0;
+    if (parameters.flags & (JobSystemFlags_PinWorkers | JobSystemFlags_TopologySteal)) {
+        coreOfThread = (U32*) arena_push(arena, sizeof(U32) * totalQueues, alignof(U32));
+        job_system_place_threads_(OS_get_system_info(), coreOfThread, totalQueues);
+    }
+    if (parameters.flags & JobSystemFlags_TopologySteal) {
+        jobSystem->victimOrders = job_system_build_victim_orders_(arena, OS_get_system_info(),
+                                                                  coreOfThread, totalQueues);
+    }
+    tls->victimOrder = jobSystem->victimOrders ? &jobSystem->victimOrders[0] : 0;
 
+    U32 pinned = 0u;
     for (U32 i = 0; i < workerCount; ++i) {
         WorkerParameters* workerParameters = (WorkerParameters*) arena_push(
             arena, sizeof(WorkerParameters), alignof(WorkerParameters));
         workerParameters->jobSystem = jobSystem;
         workerParameters->workerIndex = i + 1u;
         jobSystem->workers[i] = OS_thread_create(job_system_worker_entry, workerParameters);
-#ifndef NDEBUG
-        MEMSET(&jobSystem->workerStats[i], 0, sizeof(JobSystemStats));
-#endif
+        if ((parameters.flags & JobSystemFlags_PinWorkers) && jobSystem->workers[i].handle) {
+            U32 osCoreIndex = OS_get_system_info()->cores[coreOfThread[i + 1u]].osIndex;
+            pinned += OS_thread_set_affinity(jobSystem->workers[i], osCoreIndex) ? 1u : 0u;
+        }
+    }
+    if ((parameters.flags & JobSystemFlags_PinWorkers) && pinned != workerCount) {
+        LOG_WARNING("job", "Pinned {} of {} workers; the rest float.", pinned, workerCount);
     }
 
     return jobSystem;
@@ -131,94 +404,312 @@ void job_system_destroy(JobSystem* jobSystem) {
         return;
     }
 
-    if (jobSystem->wakeMutex.handle && jobSystem->wakeCondition.handle) {
-        OS_mutex_lock(jobSystem->wakeMutex);
-        ATOMIC_STORE(&jobSystem->shutdown, 1, MEMORY_ORDER_RELEASE);
-        OS_condition_variable_broadcast(jobSystem->wakeCondition);
-        OS_mutex_unlock(jobSystem->wakeMutex);
-    } else {
-        ATOMIC_STORE(&jobSystem->shutdown, 1, MEMORY_ORDER_RELEASE);
-    }
+    ATOMIC_STORE(&jobSystem->shutdown, 1, MEMORY_ORDER_SEQ_CST);
+    ATOMIC_FETCH_ADD(&jobSystem->wakeEpoch, 1u, MEMORY_ORDER_SEQ_CST);
+    OS_address_wake_all(&jobSystem->wakeEpoch);
 
     for (U32 i = 0; i < jobSystem->workerCount; ++i) {
         OS_thread_join(jobSystem->workers[i]);
     }
-
-    if (jobSystem->wakeCondition.handle) {
-        OS_condition_variable_destroy(jobSystem->wakeCondition);
-        jobSystem->wakeCondition.handle = 0;
-    }
-    if (jobSystem->wakeMutex.handle) {
-        OS_mutex_destroy(jobSystem->wakeMutex);
-        jobSystem->wakeMutex.handle = 0;
-    }
-
-#ifndef NDEBUG
-    jobSystem->workerStats[0].pops += g_tlsJobState.stats.pops;
-    jobSystem->workerStats[0].steals += g_tlsJobState.stats.steals;
-    jobSystem->workerStats[0].yields += g_tlsJobState.stats.yields;
-
-    MEMSET(&jobSystem->totals, 0, sizeof(jobSystem->totals));
-    for (U32 i = 0; i < (jobSystem->workerCount + 1u); ++i) {
-        jobSystem->totals.pops += jobSystem->workerStats[i].pops;
-        jobSystem->totals.steals += jobSystem->workerStats[i].steals;
-        jobSystem->totals.yields += jobSystem->workerStats[i].yields;
+    for (U32 priority = 0u; priority < JobPriority_Count; ++priority) {
+        for (U32 i = 0; i < (jobSystem->workerCount + 1u); ++i) {
+            wsdq_release(jobSystem->queues[priority][i]);
+        }
     }
-#endif
 
-    g_tlsJobState.workerIndex = JOB_SYSTEM_INVALID_WORKER_INDEX;
-    MEMSET(&g_tlsJobState, 0, sizeof(g_tlsJobState));
+    JobSystemThreadState* tls = job_tls_();
+    tls->workerIndex = JOB_SYSTEM_INVALID_WORKER_INDEX;
+    MEMSET(tls, 0, sizeof(*tls));
 }
 
 // ////////////////////////
 // Submission
 
-B32 job_system_submit_(const Job& job) {
-    ASSERT_DEBUG(g_tlsJobState.queue);
-    JobSystem* jobSystem = g_tlsJobState.jobSystem;
+JobPriority job_system_current_priority(void) {
+    return (JobPriority) job_tls_()->priority;
+}
 
-    if (jobSystem && jobSystem->wakeMutex.handle && jobSystem->wakeCondition.handle) {
-        OS_mutex_lock(jobSystem->wakeMutex);
-    }
+B32 job_system_submit_(const Job& job, JobPriority priority) {
+    JobSystemThreadState* tls = job_tls_();
+    ASSERT_DEBUG((U32) priority < JobPriority_Count);
+    ASSERT_DEBUG(tls->queues[priority]);
+    JobSystem* jobSystem = tls->jobSystem;
 
     if (job.parent) {
         ATOMIC_FETCH_ADD(&job.parent->remainingJobs, 1, MEMORY_ORDER_RELEASE);
     }
     if (jobSystem) {
-        ATOMIC_FETCH_ADD(&jobSystem->pendingJobs, 1u, MEMORY_ORDER_RELEASE);
+        ATOMIC_FETCH_ADD(&jobSystem->pendingJobs[priority], 1u, MEMORY_ORDER_RELEASE);
     }
 
-    B32 pushOk = wsdq_push(g_tlsJobState.queue, &job);
+    // The push only touches this thread's deque; nothing on this path
+    // blocks unless a worker is parked.
+#if JOB_SYSTEM_LATENCY_STATS
+    Job stamped = job;
+    stamped.remainingJobs = OS_get_time_nanoseconds();
+    B32 pushOk = wsdq_push(tls->queues[priority], &stamped);
+#else
+    B32 pushOk = wsdq_push(tls->queues[priority], &job);
+#endif
     if (pushOk) {
-        if (jobSystem && jobSystem->wakeCondition.handle) {
-            OS_condition_variable_signal(jobSystem->wakeCondition);
+        if (jobSystem) {
+            job_stat_max_(&tls->stats->queueHighWater, (U64) wsdq_count_approx(tls->queues[priority]));
+            job_system_wake_(jobSystem, 1u);
         }
     } else {
         if (job.parent) {
             ATOMIC_FETCH_SUB(&job.parent->remainingJobs, 1, MEMORY_ORDER_ACQ_REL);
         }
         if (jobSystem) {
-            ATOMIC_FETCH_SUB(&jobSystem->pendingJobs, 1u, MEMORY_ORDER_ACQ_REL);
+            ATOMIC_FETCH_SUB(&jobSystem->pendingJobs[priority], 1u, MEMORY_ORDER_ACQ_REL);
         }
     }
 
-    if (jobSystem && jobSystem->wakeMutex.handle && jobSystem->wakeCondition.handle) {
-        OS_mutex_unlock(jobSystem->wakeMutex);
+    ASSERT_ALWAYS(pushOk && "WSDeque growth failed: out of memory.");
+    return pushOk;
+}
+
+// Adds delta to each parent, once per run of consecutive jobs that share
+// it (the common batch has a single parent and pays one atomic).
+static void job_system_add_parent_counts_(const Job* jobs, U32 count, B32 undo) {
+    U32 runStart = 0u;
+    while (runStart < count) {
+        Job* parent = jobs[runStart].parent;
+        U32 runEnd = runStart + 1u;
+        while (runEnd < count && jobs[runEnd].parent == parent) {
+            runEnd += 1u;
+        }
+        if (parent) {
+            U64 runCount = (U64) (runEnd - runStart);
+            if (undo) {
+                ATOMIC_FETCH_SUB(&parent->remainingJobs, runCount, MEMORY_ORDER_ACQ_REL);
+            } else {
+                ATOMIC_FETCH_ADD(&parent->remainingJobs, runCount, MEMORY_ORDER_RELEASE);
+            }
+        }
+        runStart = runEnd;
+    }
+}
+
+B32 job_system_submit_batch_at(const Job* jobs, U32 count, JobPriority priority) {
+    JobSystemThreadState* tls = job_tls_();
+    ASSERT_DEBUG((U32) priority < JobPriority_Count);
+    ASSERT_DEBUG(tls->queues[priority]);
+    ASSERT_DEBUG(jobs != nullptr || count == 0u);
+    if (count == 0u) {
+        return 1;
     }
+    JobSystem* jobSystem = tls->jobSystem;
 
-    ASSERT_ALWAYS(pushOk && "WSDeque overflow. Increase JOB_SYSTEM_QUEUE_SIZE.");
+#if JOB_SYSTEM_LATENCY_STATS
+    // Latency stats need a submit time on every queued copy.
+    Temp scratch = get_scratch(0, 0);
+    DEFER_REF(temp_end(&scratch));
+    Job* stamped = ARENA_PUSH_ARRAY(scratch.arena, Job, count);
+    if (stamped) {
+        U64 nowNs = OS_get_time_nanoseconds();
+        MEMCPY(stamped, jobs, sizeof(Job) * count);
+        for (U32 at = 0u; at < count; ++at) {
+            stamped[at].remainingJobs = nowNs;
+        }
+        jobs = stamped;
+    }
+#endif
+
+    job_system_add_parent_counts_(jobs, count, 0);
+    if (jobSystem) {
+        ATOMIC_FETCH_ADD(&jobSystem->pendingJobs[priority], (U64) count, MEMORY_ORDER_RELEASE);
+    }
+
+    B32 pushOk = wsdq_push_many(tls->queues[priority], jobs, count);
+    if (pushOk) {
+        if (jobSystem) {
+            job_stat_max_(&tls->stats->queueHighWater, (U64) wsdq_count_approx(tls->queues[priority]));
+            job_system_wake_(jobSystem, count);
+        }
+    } else {
+        job_system_add_parent_counts_(jobs, count, 1);
+        if (jobSystem) {
+            ATOMIC_FETCH_SUB(&jobSystem->pendingJobs[priority], (U64) count, MEMORY_ORDER_ACQ_REL);
+        }
+    }
+
+    ASSERT_ALWAYS(pushOk && "WSDeque growth failed: out of memory.");
     return pushOk;
 }
 
-static void job_system_on_job_popped_(JobSystem* jobSystem) {
+B32 job_system_submit_batch(const Job* jobs, U32 count) {
+    return job_system_submit_batch_at(jobs, count, job_system_current_priority());
+}
+
+// ////////////////////////
+// Parking (eventcount)
+//
+// Submitter: publish work (pendingJobs), fence, read sleepingWorkers.
+// Parker:    read epoch, announce (sleepingWorkers), fence, re-read
+//            pendingJobs, then wait while the epoch is unchanged.
+// The two fences order the store-then-load on each side, so either the
+// parker sees the new work or the submitter sees the parker and bumps the
+// epoch, which makes the wait return immediately.
+//
+// Wakers claim parkers by decrementing sleepingWorkers themselves, so a
+// burst of submits pays one wake per parked worker, not one per job. A
+// parker that returns without being claimed leaves a stale count behind;
+// the next waker drains it with one wasted wake.
+
+static void job_system_wake_(JobSystem* jobSystem, U32 count) {
+    ATOMIC_THREAD_FENCE(MEMORY_ORDER_SEQ_CST);
+    U32 sleeping = ATOMIC_LOAD(&jobSystem->sleepingWorkers, MEMORY_ORDER_RELAXED);
+    U32 claimed = 0u;
+    for (;;) {
+        if (LIKELY(sleeping == 0u)) {
+            return;
+        }
+        claimed = MIN(count, sleeping);
+        if (ATOMIC_COMPARE_EXCHANGE(&jobSystem->sleepingWorkers, &sleeping, sleeping - claimed,
+                                    true, MEMORY_ORDER_ACQ_REL, MEMORY_ORDER_RELAXED)) {
+            break;
+        }
+    }
+    ATOMIC_FETCH_ADD(&jobSystem->wakeEpoch, 1u, MEMORY_ORDER_RELEASE);
+    if (claimed == sleeping) {
+        OS_address_wake_all(&jobSystem->wakeEpoch);
+    } else {
+        for (U32 i = 0; i < claimed; ++i) {
+            OS_address_wake_one(&jobSystem->wakeEpoch);
+        }
+    }
+}
+
+// Returns 1 if the worker went to sleep; 0 when work or shutdown showed up
+// between the failed steal and the announce.
+static B32 job_system_any_pending_(JobSystem* jobSystem, U32 maxPriority) {
+    for (U32 priority = 0u; priority <= maxPriority; ++priority) {
+        if (ATOMIC_LOAD(&jobSystem->pendingJobs[priority], MEMORY_ORDER_RELAXED) != 0u) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static B32 job_system_park_(JobSystem* jobSystem, JobSystemThreadState* tls) {
+    static U32 parkedSite = 0u;
+    U32 epoch = ATOMIC_LOAD(&jobSystem->wakeEpoch, MEMORY_ORDER_ACQUIRE);
+    ATOMIC_FETCH_ADD(&jobSystem->sleepingWorkers, 1u, MEMORY_ORDER_RELAXED);
+    ATOMIC_THREAD_FENCE(MEMORY_ORDER_SEQ_CST);
+
+    if (!job_system_any_pending_(jobSystem, JobPriority_Count - 1u) &&
+        ATOMIC_LOAD(&jobSystem->shutdown, MEMORY_ORDER_RELAXED) == 0u) {
+        B32 profiled = job_prof_begin_(&parkedSite, "jobs: parked");
+        U64 parkStartNs = OS_get_time_nanoseconds();
+        OS_address_wait(&jobSystem->wakeEpoch, epoch);
+        job_stat_add_(&tls->stats->parkedNs, OS_get_time_nanoseconds() - parkStartNs);
+        job_stat_add_(&tls->stats->parks, 1u);
+        if (profiled) {
+            prof_end();
+        }
+        return 1;
+    }
+
+    // Withdraw the announce unless a waker already claimed it.
+    U32 sleeping = ATOMIC_LOAD(&jobSystem->sleepingWorkers, MEMORY_ORDER_RELAXED);
+    while (sleeping != 0u &&
+           !ATOMIC_COMPARE_EXCHANGE(&jobSystem->sleepingWorkers, &sleeping, sleeping - 1u,
+                                    true, MEMORY_ORDER_ACQ_REL, MEMORY_ORDER_RELAXED)) {
+    }
+    return 0;
+}
+
+// Joiners wait on a parent count rather than on the queues, so they use a
+// second eventcount with the same fence pairing: the joiner announces,
+// fences and re-reads the count; the finisher drops the count, fences and
+// reads sleepingJoiners. Every joiner re-checks its own root, so wakes are
+// broadcast and joiners withdraw their own announce.
+
+static void job_system_wake_joiners_(JobSystem* jobSystem) {
+    ATOMIC_THREAD_FENCE(MEMORY_ORDER_SEQ_CST);
+    if (LIKELY(ATOMIC_LOAD(&jobSystem->sleepingJoiners, MEMORY_ORDER_RELAXED) == 0u)) {
+        return;
+    }
+    ATOMIC_FETCH_ADD(&jobSystem->joinEpoch, 1u, MEMORY_ORDER_RELEASE);
+    OS_address_wake_all(&jobSystem->joinEpoch);
+}
+
+// Sleeps only while root is unfinished and no job it may help with is
+// queued anywhere, so a joiner never naps on work it could take. Work
+// submitted while it sleeps goes to the workers.
+static B32 job_system_join_park_(JobSystem* jobSystem, Job* root, U32 maxPriority) {
+    U32 epoch = ATOMIC_LOAD(&jobSystem->joinEpoch, MEMORY_ORDER_ACQUIRE);
+    ATOMIC_FETCH_ADD(&jobSystem->sleepingJoiners, 1u, MEMORY_ORDER_RELAXED);
+    ATOMIC_THREAD_FENCE(MEMORY_ORDER_SEQ_CST);
+
+    B32 slept = 0;
+    if ((ATOMIC_LOAD(&root->remainingJobs, MEMORY_ORDER_RELAXED) & JOB_COUNT_MASK) != 0u &&
+        !job_system_any_pending_(jobSystem, maxPriority)) {
+        U64 parkStartNs = OS_get_time_nanoseconds();
+        OS_address_wait(&jobSystem->joinEpoch, epoch);
+        JobSystemStats* stats = job_tls_()->stats;
+        job_stat_add_(&stats->parkedNs, OS_get_time_nanoseconds() - parkStartNs);
+        job_stat_add_(&stats->parks, 1u);
+        slept = 1;
+    }
+    ATOMIC_FETCH_SUB(&jobSystem->sleepingJoiners, 1u, MEMORY_ORDER_RELAXED);
+    return slept;
+}
+
+static void job_system_on_job_popped_(JobSystem* jobSystem, U32 priority) {
     ASSERT_DEBUG(jobSystem != 0);
-    U64 previous = ATOMIC_FETCH_SUB(&jobSystem->pendingJobs, 1u, MEMORY_ORDER_ACQ_REL);
+    U64 previous = ATOMIC_FETCH_SUB(&jobSystem->pendingJobs[priority], 1u, MEMORY_ORDER_ACQ_REL);
     if (UNLIKELY(previous == 0u)) {
-        ATOMIC_STORE(&jobSystem->pendingJobs, 0u, MEMORY_ORDER_RELEASE);
+        ATOMIC_STORE(&jobSystem->pendingJobs[priority], 0u, MEMORY_ORDER_RELEASE);
     }
 }
 
-UTILITIES_SHARED_API void prof_thread_name(const char* name);
+// Pops or steals the next job this thread may run, most urgent priority
+// first. Lower priorities are only looked at while nothing more urgent is
+// queued anywhere: when the steals miss queued critical work the caller
+// backs off and retries instead of starting a long background job.
+static B32 job_system_take_(JobSystem* jobSystem, JobSystemThreadState* tls, U32 maxPriority,
+                            Job* outJob, U32* outPriority) {
+    U32 totalQueues = jobSystem->workerCount + 1u;
+    for (U32 priority = 0u; priority <= maxPriority; ++priority) {
+        B32 taken = 0;
+        if (LIKELY(wsdq_pop(tls->queues[priority], outJob))) {
+            job_stat_add_(&tls->stats->pops, 1u);
+            taken = 1;
+        } else {
+            WSDeque** queues = jobSystem->queues[priority];
+            for (U32 attempt = 0; attempt < JOB_SYSTEM_STEAL_TRIES; ++attempt) {
+                U32 victimIndex = job_system_pick_victim(tls->workerIndex, totalQueues, &tls->randomGenerator,
+                                                         attempt, tls->victimOrder);
+                job_stat_add_(&tls->stats->stealAttempts, 1u);
+                if (wsdq_steal(queues[victimIndex], outJob)) {
+                    job_stat_add_(&tls->stats->steals, 1u);
+                    taken = 1;
+                    break;
+                }
+            }
+        }
+
+        if (taken) {
+            job_system_on_job_popped_(jobSystem, priority);
+            if (outJob->function != job_fiber_resume_) {
+                job_stat_add_(&tls->stats->executed[priority], 1u);
+#if JOB_SYSTEM_LATENCY_STATS
+                U64 latencyNs = OS_get_time_nanoseconds() - outJob->remainingJobs;
+                job_stat_add_(&tls->stats->latencyNsTotal[priority], latencyNs);
+                job_stat_max_(&tls->stats->latencyNsMax[priority], latencyNs);
+#endif
+            }
+            *outPriority = priority;
+            return 1;
+        }
+        if (ATOMIC_LOAD(&jobSystem->pendingJobs[priority], MEMORY_ORDER_RELAXED) != 0u) {
+            return 0;
+        }
+    }
+    return 0;
+}
 
 static
 void job_system_worker_entry(void* params) {
@@ -228,148 +719,343 @@ void job_system_worker_entry(void* params) {
     U32 workerIndex = workerParameters->workerIndex;
     prof_thread_name("worker");
 
-    ASSERT_DEBUG(g_tlsJobState.jobSystem == nullptr && "JobSystem already initialized on this thread");
+    // The worker loop runs on the thread's own stack and never migrates,
+    // so it may hold on to its TLS pointer.
+    JobSystemThreadState* tls = job_tls_();
+    ASSERT_DEBUG(tls->jobSystem == nullptr && "JobSystem already initialized on this thread");
 
-    g_tlsJobState.workerIndex = workerIndex;
-    g_tlsJobState.queue = jobSystem->queues[workerIndex];
-    g_tlsJobState.jobSystem = jobSystem;
+    tls->workerIndex = workerIndex;
+    tls->priority = JobPriority_Critical;
+    for (U32 priority = 0u; priority < JobPriority_Count; ++priority) {
+        tls->queues[priority] = jobSystem->queues[priority][workerIndex];
+    }
+    tls->jobSystem = jobSystem;
     U64 seed = ((U64) (uintptr_t) workerParameters) ^ ((U64) (uintptr_t) jobSystem) ^ (
                    (U64) workerIndex * 0x9E3779B97F4A7C15ull);
-    g_tlsJobState.randomGenerator = xorshift_seed(seed);
-#ifndef NDEBUG
-    MEMSET(&g_tlsJobState.stats, 0, sizeof(g_tlsJobState.stats));
-#endif
+    tls->randomGenerator = xorshift_seed(seed);
+    tls->stats = &jobSystem->threadStats[workerIndex].stats;
+    tls->victimOrder = jobSystem->victimOrders ? &jobSystem->victimOrders[workerIndex] : 0;
 
-    WSDeque** queues = jobSystem->queues;
-    U32 totalQueues = jobSystem->workerCount + 1u;
+    // Busy spans run from the first job after an idle stretch to the next
+    // failed take; idle time is the gap between them minus time parked.
+    static U32 busySite = 0u;
+    B32 busy = 0;
+    B32 busyProfiled = 0;
+    U64 idleStartNs = OS_get_time_nanoseconds();
+    U64 idleStartParkedNs = 0u;
 
     U32 backoff = 1u;
 
     while (LIKELY(!ATOMIC_LOAD(&jobSystem->shutdown, MEMORY_ORDER_ACQUIRE))) {
         Job job = {};
+        U32 priority = 0u;
 
-        if (LIKELY(wsdq_pop(g_tlsJobState.queue, &job))) {
-            job_system_on_job_popped_(jobSystem);
-#ifndef NDEBUG
-            ++g_tlsJobState.stats.pops;
-#endif
-            job_execute(&job);
+        if (LIKELY(job_system_take_(jobSystem, tls, JobPriority_Count - 1u, &job, &priority))) {
+            if (!busy) {
+                U64 parkedNs = ATOMIC_LOAD(&tls->stats->parkedNs, MEMORY_ORDER_RELAXED) - idleStartParkedNs;
+                U64 idleNs = OS_get_time_nanoseconds() - idleStartNs;
+                job_stat_add_(&tls->stats->idleNs, idleNs > parkedNs ? idleNs - parkedNs : 0u);
+                busyProfiled = job_prof_begin_(&busySite, "jobs: busy");
+                busy = 1;
+            }
+            job_system_run_(jobSystem, &job, priority);
             backoff = 1u;
-            continue;
-        }
-
-        B32 stolen = 0;
-        for (U32 attempt = 0; attempt < JOB_SYSTEM_STEAL_TRIES; ++attempt) {
-            U32 victimIndex = job_system_pick_victim(workerIndex, totalQueues, &g_tlsJobState.randomGenerator, attempt);
-            if (LIKELY(wsdq_steal(queues[victimIndex], &job))) {
-                job_system_on_job_popped_(jobSystem);
-#ifndef NDEBUG
-                ++g_tlsJobState.stats.steals;
-#endif
-                job_execute(&job);
-                stolen = 1;
+        } else {
+            if (busy) {
+                if (busyProfiled) {
+                    prof_end();
+                }
+                idleStartNs = OS_get_time_nanoseconds();
+                idleStartParkedNs = ATOMIC_LOAD(&tls->stats->parkedNs, MEMORY_ORDER_RELAXED);
+                busy = 0;
+            }
+            if (job_system_park_(jobSystem, tls)) {
                 backoff = 1u;
-                break;
+                continue;
             }
-        }
 
-        if (UNLIKELY(!stolen)) {
-            B32 usedConditionWait = 0;
-            if (jobSystem->wakeMutex.handle && jobSystem->wakeCondition.handle) {
-                OS_mutex_lock(jobSystem->wakeMutex);
-                while (ATOMIC_LOAD(&jobSystem->pendingJobs, MEMORY_ORDER_ACQUIRE) == 0u &&
-                       ATOMIC_LOAD(&jobSystem->shutdown, MEMORY_ORDER_ACQUIRE) == 0u) {
-                    OS_condition_variable_wait(jobSystem->wakeCondition, jobSystem->wakeMutex);
-#ifndef NDEBUG
-                    ++g_tlsJobState.stats.yields;
-#endif
-                }
-                OS_mutex_unlock(jobSystem->wakeMutex);
-                usedConditionWait = 1;
+            // Work is pending but the random victims came up empty: back
+            // off before the next round instead of hammering the deques.
+            U32 spins = backoff;
+            if (spins > JOB_SYSTEM_BACKOFF_MAX) {
+                spins = JOB_SYSTEM_BACKOFF_MAX;
+            }
+            for (U32 spin = 0; spin < spins; ++spin) {
+                OS_cpu_pause();
+            }
+            if (backoff < JOB_SYSTEM_BACKOFF_MAX) {
+                U32 next = backoff << 1;
+                backoff = (next > JOB_SYSTEM_BACKOFF_MAX) ? JOB_SYSTEM_BACKOFF_MAX : next;
             }
+        }
+    }
 
-            if (UNLIKELY(!usedConditionWait)) {
-                U32 spins = backoff;
-                if (spins > JOB_SYSTEM_BACKOFF_MAX) {
-                    spins = JOB_SYSTEM_BACKOFF_MAX;
-                }
-                for (U32 spin = 0; spin < spins; ++spin) {
-                    OS_cpu_pause();
-                }
-#ifndef NDEBUG
-                ++g_tlsJobState.stats.yields;
-#endif
-                OS_thread_yield();
-                if (backoff < JOB_SYSTEM_BACKOFF_MAX) {
-                    U32 next = backoff << 1;
-                    backoff = (next > JOB_SYSTEM_BACKOFF_MAX) ? JOB_SYSTEM_BACKOFF_MAX : next;
-                }
-            } else {
-                backoff = 1u;
+    if (busy && busyProfiled) {
+        prof_end();
+    }
+
+    MEMSET(tls, 0, sizeof(*tls));
+}
+
+// ////////////////////////
+// Fibers
+//
+// With JobSystemFlags_Fibers every job starts on a pooled fiber. A job that
+// waits switches back to its thread's scheduler (worker loop or a thread
+// stack wait), which parks the fiber on the root by writing its index + 1
+// into the high half of remainingJobs. Whoever drops the count to zero gets
+// the index back from the same fetch-sub and pushes a resume job, so the
+// waiter continues on whichever thread pops it instead of under unrelated
+// jobs on its own stack. Registration happens only after the switch, so no
+// thread can resume a fiber that is still running.
+
+// Never run: the scheduler recognizes the pointer and switches instead.
+static void job_fiber_resume_(void* params) {
+    (void) params;
+    ASSERT_ALWAYS(false && "Fiber resume jobs are switched to, not executed");
+}
+
+static JobFiber* job_fiber_acquire_(JobSystem* jobSystem) {
+    U64 head = ATOMIC_LOAD(&jobSystem->fiberFreeHead, MEMORY_ORDER_ACQUIRE);
+    for (;;) {
+        U32 slot = (U32) (head & 0xFFFFFFFFull);
+        if (slot == 0u) {
+            return 0;
+        }
+        JobFiber* fiber = &jobSystem->fibers[slot - 1u];
+        U32 next = ATOMIC_LOAD(&fiber->nextFree, MEMORY_ORDER_RELAXED);
+        U64 desired = (((head >> 32) + 1u) << 32) | (U64) next;
+        if (ATOMIC_COMPARE_EXCHANGE(&jobSystem->fiberFreeHead, &head, desired,
+                                    true, MEMORY_ORDER_ACQUIRE, MEMORY_ORDER_ACQUIRE)) {
+            return fiber;
+        }
+    }
+}
+
+static void job_fiber_release_(JobSystem* jobSystem, JobFiber* fiber) {
+    ASSERT_DEBUG(fiber_stack_intact(fiber->stackBase) && "Fiber stack overflow. Raise fiberStackSize.");
+    U64 head = ATOMIC_LOAD(&jobSystem->fiberFreeHead, MEMORY_ORDER_RELAXED);
+    for (;;) {
+        ATOMIC_STORE(&fiber->nextFree, (U32) (head & 0xFFFFFFFFull), MEMORY_ORDER_RELAXED);
+        U64 desired = (((head >> 32) + 1u) << 32) | (U64) (fiber->index + 1u);
+        if (ATOMIC_COMPARE_EXCHANGE(&jobSystem->fiberFreeHead, &head, desired,
+                                    true, MEMORY_ORDER_RELEASE, MEMORY_ORDER_RELAXED)) {
+            return;
+        }
+    }
+}
+
+static void job_fiber_ready_(JobSystem* jobSystem, JobFiber* fiber) {
+    (void) jobSystem;
+    Job resume = {};
+    resume.function = job_fiber_resume_;
+    job_set_parameters(&resume, fiber);
+    job_system_submit_(resume, (JobPriority) fiber->priority);
+}
+
+static void job_fiber_entry_(void* userData) {
+    JobFiber* fiber = (JobFiber*) userData;
+    for (;;) {
+        job_execute(&fiber->job);
+        JobSystemThreadState* tls = job_tls_();
+        tls->fiberAction = JobFiberAction_Finished;
+        fiber_switch(&fiber->context, &tls->schedulerContext);
+    }
+}
+
+static void job_fiber_pool_create_(JobSystem* jobSystem, Arena* arena, U32 fiberCount, U64 stackSize) {
+    ASSERT_DEBUG(fiberCount != 0u && stackSize >= KB(4));
+    JobFiber* fibers = ARENA_PUSH_ARRAY(arena, JobFiber, fiberCount);
+    if (!fibers) {
+        LOG_ERROR("job", "Failed to allocate {} fibers; waits run nested jobs instead.", fiberCount);
+        return;
+    }
+    stackSize = align_pow2(stackSize, 16u);
+    for (U32 at = 0u; at < fiberCount; ++at) {
+        JobFiber* fiber = &fibers[at];
+        MEMSET(fiber, 0, sizeof(*fiber));
+        fiber->stackBase = arena_push(arena, stackSize, 16u);
+        if (!fiber->stackBase) {
+            LOG_ERROR("job", "Fiber stacks ran out of arena space after {} fibers.", at);
+            fiberCount = at;
+            break;
+        }
+        fiber->index = at;
+        fiber->nextFree = (at + 1u < fiberCount) ? at + 2u : 0u;
+        fiber_context_init(&fiber->context, fiber->stackBase, stackSize, job_fiber_entry_, fiber);
+    }
+    if (fiberCount == 0u) {
+        return;
+    }
+    fibers[fiberCount - 1u].nextFree = 0u;
+    jobSystem->fibers = fibers;
+    jobSystem->fiberCount = fiberCount;
+    jobSystem->fiberFreeHead = 1u;
+}
+
+// Scheduler side of a wait, run once the fiber is off its stack. Returns 0
+// when the fiber should resume right away (its root already finished). If
+// another fiber already waits on the root, this one is requeued and polls.
+static B32 job_fiber_park_(JobSystem* jobSystem, JobFiber* fiber) {
+    Job* root = fiber->waitRoot;
+    U64 word = ATOMIC_LOAD(&root->remainingJobs, MEMORY_ORDER_ACQUIRE);
+    for (;;) {
+        if ((word & JOB_COUNT_MASK) == 0u) {
+            return 0;
+        }
+        if ((word >> JOB_WAITER_SHIFT) != 0u) {
+            job_fiber_ready_(jobSystem, fiber);
+            return 1;
+        }
+        U64 parked = word | ((U64) (fiber->index + 1u) << JOB_WAITER_SHIFT);
+        // Past this CAS the fiber belongs to whoever finishes the root.
+        if (ATOMIC_COMPARE_EXCHANGE(&root->remainingJobs, &word, parked,
+                                    true, MEMORY_ORDER_ACQ_REL, MEMORY_ORDER_ACQUIRE)) {
+            return 1;
+        }
+    }
+}
+
+// Fiber side of job_system_wait.
+static void job_fiber_wait_(Job* root) {
+    JobFiber* fiber = job_tls_()->fiber;
+    while ((ATOMIC_LOAD(&root->remainingJobs, MEMORY_ORDER_ACQUIRE) & JOB_COUNT_MASK) != 0u) {
+        fiber->waitRoot = root;
+        JobSystemThreadState* tls = job_tls_();
+        tls->fiberAction = JobFiberAction_Wait;
+        fiber_switch(&fiber->context, &tls->schedulerContext);
+    }
+    // A parked wait leaves this fiber's index in the high half. The count
+    // is zero, so nobody else touches the root any more.
+    ATOMIC_STORE(&root->remainingJobs, 0u, MEMORY_ORDER_RELAXED);
+}
+
+// Runs a popped job from a thread stack: inline without fibers; otherwise
+// on a fresh pooled fiber, or by switching back into a resumed one. Pool
+// exhaustion degrades to running on this stack.
+static void job_system_run_(JobSystem* jobSystem, const Job* job, U32 priority) {
+    JobSystemThreadState* tls = job_tls_();
+    U32 outerPriority = tls->priority;
+    tls->priority = priority;
+
+    JobFiber* fiber = 0;
+    if (jobSystem->fibers) {
+        if (job->function == job_fiber_resume_) {
+            MEMCPY(&fiber, job->parameters, sizeof(fiber));
+        } else {
+            fiber = job_fiber_acquire_(jobSystem);
+            if (fiber) {
+                fiber->job = *job;
+                fiber->priority = priority;
             }
         }
     }
+    if (!fiber) {
+        job_execute(job);
+        tls->priority = outerPriority;
+        return;
+    }
 
-#ifndef NDEBUG
-    if (jobSystem->workerStats && workerIndex < (jobSystem->workerCount + 1u)) {
-        JobSystemStats* s = &jobSystem->workerStats[workerIndex];
-        s->pops += g_tlsJobState.stats.pops;
-        s->steals += g_tlsJobState.stats.steals;
-        s->yields += g_tlsJobState.stats.yields;
+    for (;;) {
+        tls->fiber = fiber;
+        tls->fiberAction = JobFiberAction_None;
+        fiber_switch(&tls->schedulerContext, &fiber->context);
+        tls->fiber = 0;
+
+        if (tls->fiberAction == JobFiberAction_Finished) {
+            job_fiber_release_(jobSystem, fiber);
+            break;
+        }
+        if (tls->fiberAction == JobFiberAction_Yield) {
+            job_fiber_ready_(jobSystem, fiber);
+            break;
+        }
+        ASSERT_DEBUG(tls->fiberAction == JobFiberAction_Wait);
+        if (job_fiber_park_(jobSystem, fiber)) {
+            break;
+        }
     }
-#endif
+    tls->priority = outerPriority;
+}
 
-    MEMSET(&g_tlsJobState, 0, sizeof(g_tlsJobState));
-    
+// ////////////////////////
+// Preemption
+
+B32 job_system_checkpoint(void) {
+    JobSystemThreadState* tls = job_tls_();
+    JobSystem* jobSystem = tls->jobSystem;
+    if (!jobSystem || tls->priority == JobPriority_Critical ||
+        ATOMIC_LOAD(&jobSystem->pendingJobs[JobPriority_Critical], MEMORY_ORDER_RELAXED) == 0u) {
+        return 0;
+    }
+    job_stat_add_(&tls->stats->preemptions, 1u);
+
+    if (tls->fiber) {
+        // Requeue behind the critical work; the scheduler picks that first.
+        tls->fiberAction = JobFiberAction_Yield;
+        fiber_switch(&tls->fiber->context, &tls->schedulerContext);
+        return 1;
+    }
+
+    // Thread stack: run the critical jobs on top of this one.
+    Job job = {};
+    U32 priority = 0u;
+    while (job_system_take_(jobSystem, tls, JobPriority_Critical, &job, &priority)) {
+        job_system_run_(jobSystem, &job, priority);
+    }
+    return 1;
 }
 
 // ////////////////////////
 // Waiting
 
+static void job_fiber_wait_(Job* root);
+
 void job_system_wait(JobSystem* jobSystem, Job* root) {
     ASSERT_DEBUG(jobSystem && root);
-    WSDeque* localQueue = g_tlsJobState.queue;
-    ASSERT_DEBUG(localQueue);
+    if (job_tls_()->fiber) {
+        job_fiber_wait_(root);
+        return;
+    }
 
-    WSDeque** queues = jobSystem->queues;
-    U32 totalQueues = jobSystem->workerCount + 1u;
-    U32 workerIndex = g_tlsJobState.workerIndex;
-    if (g_tlsJobState.randomGenerator.state == 0) {
+    // Not on a fiber: this is a thread stack, which never migrates.
+    JobSystemThreadState* tls = job_tls_();
+    ASSERT_DEBUG(tls->queues[0]);
+    U32 maxPriority = tls->priority;
+    if (tls->randomGenerator.state == 0) {
         U64 seed = ((U64) (uintptr_t) jobSystem) ^ OS_get_time_nanoseconds();
-        g_tlsJobState.randomGenerator = xorshift_seed(seed);
+        tls->randomGenerator = xorshift_seed(seed);
     }
 
     U32 backoff = 1u;
+    U32 helpPriority = maxPriority;
 
-    while (ATOMIC_LOAD(&root->remainingJobs, MEMORY_ORDER_ACQUIRE) > 0) {
+    while ((ATOMIC_LOAD(&root->remainingJobs, MEMORY_ORDER_ACQUIRE) & JOB_COUNT_MASK) != 0u) {
         Job job = {};
+        U32 priority = 0u;
 
-        if (LIKELY(wsdq_pop(localQueue, &job))) {
-            job_system_on_job_popped_(jobSystem);
-#ifndef NDEBUG
-            ++g_tlsJobState.stats.pops;
-#endif
-            job_execute(&job);
+        if (LIKELY(job_system_take_(jobSystem, tls, helpPriority, &job, &priority))) {
+            job_system_run_(jobSystem, &job, priority);
             backoff = 1u;
-            continue;
-        }
-
-        B32 stolen = 0;
-        for (U32 attempt = 0; attempt < JOB_SYSTEM_STEAL_TRIES; ++attempt) {
-            U32 victimIndex = job_system_pick_victim(workerIndex, totalQueues, &g_tlsJobState.randomGenerator, attempt);
-            if (LIKELY(wsdq_steal(queues[victimIndex], &job))) {
-                job_system_on_job_popped_(jobSystem);
-#ifndef NDEBUG
-                ++g_tlsJobState.stats.steals;
-#endif
-                job_execute(&job);
-                stolen = 1;
-                backoff = 1u;
-                break;
+            helpPriority = maxPriority;
+        } else {
+            if (backoff == JOB_SYSTEM_BACKOFF_MAX) {
+                // Nothing at this priority for a whole backoff: the tree
+                // may be waiting in a lower queue (a critical job that
+                // submitted background children), and if every thread
+                // waits like this nobody else will run it. Help there too.
+                if (helpPriority != JobPriority_Count - 1u) {
+                    helpPriority = JobPriority_Count - 1u;
+                    continue;
+                }
+                // Still nothing: the rest of the tree is running
+                // elsewhere, so sleep until a parent count hits zero.
+                if (job_system_join_park_(jobSystem, root, helpPriority)) {
+                    backoff = 1u;
+                    helpPriority = maxPriority;
+                    continue;
+                }
             }
-        }
-
-        if (UNLIKELY(!stolen)) {
             U32 spins = backoff;
             if (spins > JOB_SYSTEM_BACKOFF_MAX) {
                 spins = JOB_SYSTEM_BACKOFF_MAX;
@@ -377,9 +1063,7 @@ void job_system_wait(JobSystem* jobSystem, Job* root) {
             for (U32 spin = 0; spin < spins; ++spin) {
                 OS_cpu_pause();
             }
-#ifndef NDEBUG
-            ++g_tlsJobState.stats.yields;
-#endif
+            job_stat_add_(&tls->stats->yields, 1u);
             OS_thread_yield();
             if (backoff < JOB_SYSTEM_BACKOFF_MAX) {
                 U32 next = backoff << 1;
@@ -389,8 +1073,246 @@ void job_system_wait(JobSystem* jobSystem, Job* root) {
     }
 }
 
+// ////////////////////////
+// Parallel for
+
+struct JobParallelFor {
+    JobRangeFunc* fn;
+    void* userData;
+    U64 grain;
+    Job* root;
+};
+
+struct JobParallelForRange {
+    const JobParallelFor* loop; // lives on the caller's stack until the wait returns
+    U64 begin;
+    U64 end;
+};
+
+static void job_parallel_for_job_(void* params);
+
+static void job_parallel_for_run_(const JobParallelFor* loop, U64 begin, U64 end) {
+    while (end - begin > loop->grain) {
+        JobSystemThreadState* tls = job_tls_();
+        if (wsdq_count_approx(tls->queues[tls->priority]) < (S64) JOB_PARALLEL_FOR_SPLIT_THRESHOLD) {
+            U64 mid = begin + (end - begin) / 2u;
+            JobParallelForRange upper = {loop, mid, end};
+            job_system_submit((.function = job_parallel_for_job_, .parent = loop->root), upper);
+            end = mid;
+        } else {
+            U64 chunkEnd = begin + loop->grain;
+            loop->fn(loop->userData, begin, chunkEnd);
+            begin = chunkEnd;
+            job_system_checkpoint();
+        }
+    }
+    if (begin < end) {
+        loop->fn(loop->userData, begin, end);
+    }
+}
+
+static void job_parallel_for_job_(void* params) {
+    JobParallelForRange* range = (JobParallelForRange*) params;
+    job_parallel_for_run_(range->loop, range->begin, range->end);
+}
+
+void job_parallel_for(JobSystem* jobSystem, U64 count, U64 grain, JobRangeFunc* fn, void* userData) {
+    ASSERT_DEBUG(fn != nullptr);
+    if (count == 0u) {
+        return;
+    }
+
+    U64 threadCount = jobSystem ? (U64) jobSystem->workerCount + 1u : 1u;
+    if (grain == 0u) {
+        grain = MAX(1u, count / (threadCount * JOB_PARALLEL_FOR_CHUNKS_PER_THREAD));
+    }
+
+    if (!jobSystem || job_tls_()->jobSystem != jobSystem || count <= grain) {
+        for (U64 begin = 0u; begin < count; begin += grain) {
+            fn(userData, begin, MIN(begin + grain, count));
+        }
+        return;
+    }
+
+    Job root = {};
+    JobParallelFor loop = {};
+    loop.fn = fn;
+    loop.userData = userData;
+    loop.grain = grain;
+    loop.root = &root;
+
+    job_parallel_for_run_(&loop, 0u, count);
+    job_system_wait(jobSystem, &root);
+}
+
+// ////////////////////////
+// Job graph
+
+#define JOB_GRAPH_READY_BATCH 8u
+
+struct JobGraphEdge {
+    JobGraphEdge* next;
+    JobGraphNode node;
+};
+
+struct JobGraphNodeData {
+    Job job; // user function + inline parameters
+    JobGraph* graph;
+    JobGraphEdge* successors;
+    U32 dependencyCount;
+    U32 remainingDependencies;
+};
+
+struct JobGraph {
+    Arena* arena;
+    JobGraphNodeData* nodes;
+    U32 nodeCount;
+    U32 maxNodes;
+    Job* root;
+};
+
+static void job_graph_node_job_(void* params);
+
+static void job_graph_ready_job_(JobGraphNodeData* node, Job* outJob) {
+    MEMSET(outJob, 0, sizeof(Job));
+    outJob->function = job_graph_node_job_;
+    outJob->parent = node->graph->root;
+    job_set_parameters(outJob, node);
+}
+
+// Runs the user job, then enqueues every successor whose last dependency
+// this was. The submits land before job_execute drops this node's count
+// on the root, so the root cannot reach zero while continuations remain.
+static void job_graph_node_job_(void* params) {
+    JobGraphNodeData* node = *(JobGraphNodeData**) params;
+    node->job.function((void*) node->job.parameters);
+
+    JobGraph* graph = node->graph;
+    Job ready[JOB_GRAPH_READY_BATCH];
+    U32 readyCount = 0u;
+    for (JobGraphEdge* edge = node->successors; edge; edge = edge->next) {
+        JobGraphNodeData* successor = &graph->nodes[edge->node];
+        U32 previous = ATOMIC_FETCH_SUB(&successor->remainingDependencies, 1u, MEMORY_ORDER_ACQ_REL);
+        ASSERT_DEBUG(previous != 0u);
+        if (previous != 1u) {
+            continue;
+        }
+        job_graph_ready_job_(successor, &ready[readyCount]);
+        readyCount += 1u;
+        if (readyCount == JOB_GRAPH_READY_BATCH) {
+            job_system_submit_batch(ready, readyCount);
+            readyCount = 0u;
+        }
+    }
+    if (readyCount != 0u) {
+        job_system_submit_batch(ready, readyCount);
+    }
+}
+
+JobGraph* job_graph_create(Arena* arena, U32 maxNodes) {
+    ASSERT_DEBUG(arena != nullptr && maxNodes != 0u);
+    JobGraph* graph = ARENA_PUSH_STRUCT(arena, JobGraph);
+    JobGraphNodeData* nodes = ARENA_PUSH_ARRAY(arena, JobGraphNodeData, maxNodes);
+    if (!graph || !nodes) {
+        LOG_ERROR("job", "Failed to allocate job graph ({} nodes).", maxNodes);
+        return 0;
+    }
+    graph->arena = arena;
+    graph->nodes = nodes;
+    graph->nodeCount = 0u;
+    graph->maxNodes = maxNodes;
+    graph->root = 0;
+    return graph;
+}
+
+JobGraphNode job_graph_add_(JobGraph* graph, const Job& job) {
+    ASSERT_DEBUG(graph != nullptr && job.function != nullptr);
+    ASSERT_DEBUG(job.parent == nullptr && "Graph nodes report to the root passed at submit");
+    ASSERT_ALWAYS(graph->nodeCount < graph->maxNodes && "Job graph is full. Raise maxNodes.");
+    JobGraphNode index = graph->nodeCount++;
+    JobGraphNodeData* node = &graph->nodes[index];
+    MEMSET(node, 0, sizeof(*node));
+    node->job = job;
+    node->graph = graph;
+    return index;
+}
+
+void job_graph_depend(JobGraph* graph, JobGraphNode before, JobGraphNode after) {
+    ASSERT_DEBUG(graph != nullptr);
+    ASSERT_DEBUG(before < graph->nodeCount && after < graph->nodeCount && before != after);
+    JobGraphEdge* edge = ARENA_PUSH_STRUCT(graph->arena, JobGraphEdge);
+    ASSERT_ALWAYS(edge && "Job graph arena exhausted.");
+    JobGraphNodeData* from = &graph->nodes[before];
+    edge->node = after;
+    edge->next = from->successors;
+    from->successors = edge;
+    graph->nodes[after].dependencyCount += 1u;
+}
+
 #ifndef NDEBUG
-JobSystemStats job_system_get_totals(JobSystem* jobSystem) {
-    return jobSystem->totals;
+// Kahn's walk over the dependency counts: a node never released means a
+// cycle, which would otherwise leave the root waiting forever.
+static B32 job_graph_is_acyclic_(const JobGraph* graph) {
+    Temp scratch = get_scratch(0, 0);
+    DEFER_REF(temp_end(&scratch));
+    U32* remaining = ARENA_PUSH_ARRAY(scratch.arena, U32, graph->nodeCount);
+    U32* stack = ARENA_PUSH_ARRAY(scratch.arena, U32, graph->nodeCount);
+    if (!remaining || !stack) {
+        return 1;
+    }
+    U32 stackCount = 0u;
+    for (U32 at = 0u; at < graph->nodeCount; ++at) {
+        remaining[at] = graph->nodes[at].dependencyCount;
+        if (remaining[at] == 0u) {
+            stack[stackCount++] = at;
+        }
+    }
+    U32 released = 0u;
+    while (stackCount != 0u) {
+        U32 at = stack[--stackCount];
+        released += 1u;
+        for (JobGraphEdge* edge = graph->nodes[at].successors; edge; edge = edge->next) {
+            if (--remaining[edge->node] == 0u) {
+                stack[stackCount++] = edge->node;
+            }
+        }
+    }
+    return released == graph->nodeCount;
 }
 #endif
+
+void job_graph_submit(JobGraph* graph, Job* root) {
+    ASSERT_DEBUG(graph != nullptr && root != nullptr);
+    ASSERT_DEBUG(job_graph_is_acyclic_(graph) && "Job graph has a cycle");
+    graph->root = root;
+
+    // Reset every count before the first node can run and release others.
+    for (U32 at = 0u; at < graph->nodeCount; ++at) {
+        JobGraphNodeData* node = &graph->nodes[at];
+        ATOMIC_STORE(&node->remainingDependencies, node->dependencyCount, MEMORY_ORDER_RELAXED);
+    }
+
+    Job ready[JOB_GRAPH_READY_BATCH];
+    U32 readyCount = 0u;
+    for (U32 at = 0u; at < graph->nodeCount; ++at) {
+        JobGraphNodeData* node = &graph->nodes[at];
+        if (node->dependencyCount != 0u) {
+            continue;
+        }
+        job_graph_ready_job_(node, &ready[readyCount]);
+        readyCount += 1u;
+        if (readyCount == JOB_GRAPH_READY_BATCH) {
+            job_system_submit_batch(ready, readyCount);
+            readyCount = 0u;
+        }
+    }
+    if (readyCount != 0u) {
+        job_system_submit_batch(ready, readyCount);
+    }
+}
+
+void job_graph_run(JobSystem* jobSystem, JobGraph* graph) {
+    Job root = {};
+    job_graph_submit(graph, &root);
+    job_system_wait(jobSystem, &root);
+}
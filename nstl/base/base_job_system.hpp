@@ -9,8 +9,10 @@
 // ////////////////////////
 // Configuration
 
+// Initial jobs per deque (each thread has one per priority). Deques double
+// on overflow, so this only sizes the common case.
 #ifndef JOB_SYSTEM_QUEUE_SIZE
-#define JOB_SYSTEM_QUEUE_SIZE (1 << 14)
+#define JOB_SYSTEM_QUEUE_SIZE (1 << 8)
 #endif
 
 #ifndef JOB_SYSTEM_STEAL_TRIES
@@ -25,23 +27,74 @@
 #define JOB_SYSTEM_BACKOFF_MAX 1024u
 #endif
 
+// job_parallel_for hands off half of its remaining range while the local
+// deque holds fewer than this many jobs (lazy binary splitting).
+#ifndef JOB_PARALLEL_FOR_SPLIT_THRESHOLD
+#define JOB_PARALLEL_FOR_SPLIT_THRESHOLD 1u
+#endif
+
+// Auto grain (grain == 0) targets this many chunks per thread.
+#ifndef JOB_PARALLEL_FOR_CHUNKS_PER_THREAD
+#define JOB_PARALLEL_FOR_CHUNKS_PER_THREAD 16u
+#endif
+
+// Fiber pool defaults (JobSystemFlags_Fibers). Stacks come from the
+// creation arena: count * stack size bytes up front.
+#ifndef JOB_SYSTEM_FIBER_COUNT
+#define JOB_SYSTEM_FIBER_COUNT 128u
+#endif
+
+#ifndef JOB_SYSTEM_FIBER_STACK_SIZE
+#define JOB_SYSTEM_FIBER_STACK_SIZE KB(64)
+#endif
+
+// Submit-to-start latency stats stamp every queued job with a clock read
+// and read the clock again when it starts. Debug builds only by default.
+#ifndef JOB_SYSTEM_LATENCY_STATS
+#ifdef NDEBUG
+#define JOB_SYSTEM_LATENCY_STATS 0
+#else
+#define JOB_SYSTEM_LATENCY_STATS 1
+#endif
+#endif
+
 
 // ////////////////////////
 // Types & Data
 
-#ifndef NDEBUG
+// Every thread owns one deque per priority. Threads always drain critical
+// work (theirs, then stolen) before touching background work, and
+// background jobs give way to queued critical jobs at job_system_checkpoint.
+enum JobPriority {
+    JobPriority_Critical = 0, // frame work; the default outside of jobs
+    JobPriority_Background,   // asset builds and other work that can slip a frame
+    JobPriority_Count,
+};
+
+// Per-thread counters, always on. Each thread only writes its own, with
+// plain relaxed stores, so they can be read live; a read may mix values
+// from slightly different moments.
 struct JobSystemStats {
+    U64 executed[JobPriority_Count];       // jobs started (fiber resumes excluded)
     U64 pops;
+    U64 stealAttempts;
     U64 steals;
-    U64 yields;
+    U64 yields;                            // OS yields while waiting on a root
+    U64 parks;                             // sleeps on an eventcount
+    U64 preemptions;                       // checkpoints that gave way to critical work
+    U64 idleNs;                            // workers: looking for work, not parked
+    U64 parkedNs;                          // workers: asleep until work shows up
+    U64 queueHighWater;                    // deepest own deque seen after a submit
+    U64 latencyNsTotal[JobPriority_Count]; // submit -> start (JOB_SYSTEM_LATENCY_STATS)
+    U64 latencyNsMax[JobPriority_Count];
 };
-#endif
 
 typedef void JobFunc(void*);
 
 struct alignas(CACHE_LINE_SIZE) Job {
     JobFunc* function;
-    U64 remainingJobs;
+    U64 remainingJobs; // low 32 bits: unfinished children; high 32: parked fiber + 1.
+                       // Queued copies carry the submit time instead (latency stats).
     Job* parent;
     U8 parameters[CACHE_LINE_SIZE - sizeof(JobFunc*) - sizeof(U64) - sizeof(Job*)];
 };
@@ -51,26 +104,124 @@ static_assert(sizeof(Job) == CACHE_LINE_SIZE, "Job struct must exactly fill cach
 
 struct JobSystem;
 
-UTILITIES_SHARED_API JobSystem* job_system_create(Arena* arena, U32 workerCount);
-UTILITIES_SHARED_API void job_system_destroy(JobSystem* jobSystem);
+enum JobSystemFlags {
+    JobSystemFlags_None = 0,
+    // Jobs start on pooled fibers, and job_system_wait inside a job suspends
+    // the fiber instead of running other jobs on top of the waiter's stack;
+    // the job resumes on whichever thread picks it up once its root is done.
+    // Jobs must not hold thread-local state (scratch temps, profiler scopes)
+    // across a wait, and a root takes one waiter. Ignored with a warning
+    // where FIBER_SUPPORTED is 0.
+    JobSystemFlags_Fibers = (1 << 0),
+    // Places threads from OS_SystemInfo topology (performance cores first,
+    // one per physical core before SMT siblings, efficiency cores last) and
+    // pins each worker to its core. The creating thread keeps the first
+    // place but is left unpinned.
+    JobSystemFlags_PinWorkers = (1 << 1),
+    // Steal rounds widen by topology distance from the thief's place: SMT
+    // sibling and shared L2 first, then shared L3, then everything. Only
+    // meaningful with JobSystemFlags_PinWorkers; unpinned threads move.
+    JobSystemFlags_TopologySteal = (1 << 2),
+};
 
-UTILITIES_SHARED_API B32 job_system_submit_(const Job& job);
+struct JobSystemParameters {
+    U32 workerCount = 1u;
+    U64 flags = JobSystemFlags_None;
+    U32 fiberCount = JOB_SYSTEM_FIBER_COUNT;         // jobs past this run on the thread stack
+    U64 fiberStackSize = JOB_SYSTEM_FIBER_STACK_SIZE;
+};
+
+UTILITIES_SHARED_API JobSystem* job_system_create_(Arena* arena, const JobSystemParameters& parameters);
+#define job_system_create(arena, ...) job_system_create_((arena), {__VA_ARGS__})
+UTILITIES_SHARED_API void job_system_destroy(JobSystem* jobSystem);
 
+UTILITIES_SHARED_API B32 job_system_submit_(const Job& job, JobPriority priority);
+// Submits count jobs with one pendingJobs bump, one parent bump per run of
+// jobs sharing a parent, one publish on the deque and a single wake of up
+// to min(count, parked workers).
+UTILITIES_SHARED_API B32 job_system_submit_batch_at(const Job* jobs, U32 count, JobPriority priority);
+// Same, at job_system_current_priority().
+UTILITIES_SHARED_API B32 job_system_submit_batch(const Job* jobs, U32 count);
+
+// Priority of the job running on this thread; critical outside of jobs.
+// Plain submits inherit it, so a background job's children, ranges and
+// continuations stay in the background.
+UTILITIES_SHARED_API JobPriority job_system_current_priority(void);
+
+// Cooperative preemption point for background jobs, called between chunks
+// of work. If critical jobs are queued it runs them before returning (on a
+// fiber it requeues the job behind them instead, so it may resume on
+// another thread). Returns 1 if it gave way. No-op in critical jobs.
+UTILITIES_SHARED_API B32 job_system_checkpoint(void);
+
+// Helps with queued work until root is done. A thread helps with work at or
+// above its current priority first; lower-priority work only once none of
+// that has turned up for a full backoff, so a critical waiter rarely ends up
+// under a long background job but still runs background children it waits on.
 UTILITIES_SHARED_API void job_system_wait(JobSystem* jobSystem, Job* root);
 
-#ifndef NDEBUG
+// ////////////////////////
+// Parallel for
+//
+// Calls fn over [0, count) in contiguous sub-ranges of at most grain items
+// (grain == 0 picks one from count and the thread count). Ranges split
+// lazily: a runner pushes the upper half of what it has left only while
+// its own deque is empty, so stolen halves rebalance uneven per-item costs
+// without pre-cutting the range. Returns once every item ran; the caller
+// helps while it waits, so this is safe inside a job. Threads that are not
+// attached to jobSystem run the whole range inline. Ranges run at the
+// caller's priority and pass a checkpoint between chunks.
+
+typedef void JobRangeFunc(void* userData, U64 begin, U64 end);
+
+UTILITIES_SHARED_API void job_parallel_for(JobSystem* jobSystem, U64 count, U64 grain,
+                                           JobRangeFunc* fn, void* userData);
+
+// ////////////////////////
+// Job graph
+//
+// A DAG of jobs built once and submitted once. A node becomes runnable
+// when its last predecessor finishes, and that predecessor enqueues it as
+// a continuation, so no thread coordinates between stages and independent
+// branches overlap. Wide stages call job_parallel_for inside their node.
+// Nodes report to the root passed at submit (their own .parent must be
+// null). A graph may be submitted again once its previous run finished;
+// every submit resets the dependency counts.
+
+struct JobGraph;
+typedef U32 JobGraphNode;
+
+UTILITIES_SHARED_API JobGraph* job_graph_create(Arena* arena, U32 maxNodes);
+UTILITIES_SHARED_API JobGraphNode job_graph_add_(JobGraph* graph, const Job& job);
+// after runs only once before has finished.
+UTILITIES_SHARED_API void job_graph_depend(JobGraph* graph, JobGraphNode before, JobGraphNode after);
+UTILITIES_SHARED_API void job_graph_submit(JobGraph* graph, Job* root);
+// Submit + job_system_wait on a stack root.
+UTILITIES_SHARED_API void job_graph_run(JobSystem* jobSystem, JobGraph* graph);
+
+// Thread 0 is the one that created the system, 1..workerCount the workers.
+UTILITIES_SHARED_API U32 job_system_thread_count(JobSystem* jobSystem);
+UTILITIES_SHARED_API JobSystemStats job_system_stats(JobSystem* jobSystem, U32 threadIndex);
+// Sum over every thread; still readable after job_system_destroy.
 UTILITIES_SHARED_API JobSystemStats job_system_get_totals(JobSystem* jobSystem);
-#endif
 
 // ////////////////////////
 // Single submission macro with optional parameter argument
 // Usage:
 //   job_system_submit((.function = myFunc));
 //   job_system_submit((.function = myFunc, .parent = &root), myParams);
+//   job_system_submit_at(JobPriority_Background, (.function = myFunc), myParams);
 
 #define JOB_REMOVE_PARENS(...) __VA_ARGS__
 
-#define job_system_submit(jobInit, ...) \
+// Inline parameter copy for jobs built by hand (e.g. batch arrays).
+#define job_set_parameters(jobPtr, value) \
+    do { \
+        static_assert(sizeof(value) <= JOB_PARAMETER_SPACE, "Parameter too large for inline storage"); \
+        MEMCPY((jobPtr)->parameters, &(value), (U32)sizeof(value)); \
+    } while (0)
+
+#define job_system_submit_at(priority, jobInit, ...) \
     do { \
         Job _jobTmp; \
         { \
@@ -79,5 +230,22 @@ UTILITIES_SHARED_API JobSystemStats job_system_get_totals(JobSystem* jobSystem);
         } \
         __VA_OPT__( static_assert(sizeof(__VA_ARGS__) <= JOB_PARAMETER_SPACE, "Parameter too large for inline storage"); ) \
         __VA_OPT__( MEMCPY(_jobTmp.parameters, &(__VA_ARGS__), (U32)sizeof(__VA_ARGS__)); ) \
-        job_system_submit_(_jobTmp); \
+        job_system_submit_(_jobTmp, (priority)); \
     } while (0)
+
+#define job_system_submit(jobInit, ...) \
+    job_system_submit_at(job_system_current_priority(), jobInit __VA_OPT__(,) __VA_ARGS__)
+
+// Same shape as job_system_submit; evaluates to the new node.
+//   JobGraphNode cull = job_graph_add(graph, (.function = cull_job_), cullParams);
+#define job_graph_add(graph, jobInit, ...) \
+    ([&]() { \
+        Job _jobTmp; \
+        { \
+            Job _jobInitValues = { JOB_REMOVE_PARENS jobInit }; \
+            _jobTmp = _jobInitValues; \
+        } \
+        __VA_OPT__( static_assert(sizeof(__VA_ARGS__) <= JOB_PARAMETER_SPACE, "Parameter too large for inline storage"); ) \
+        __VA_OPT__( MEMCPY(_jobTmp.parameters, &(__VA_ARGS__), (U32)sizeof(__VA_ARGS__)); ) \
+        return job_graph_add_((graph), _jobTmp); \
+    }())
@@ -124,10 +124,7 @@ Vec3F32 operator/(Vec3F32 v, F32 s) noexcept {
 
 static
 Vec4F32& operator+=(Vec4F32& a, const Vec4F32& b) noexcept {
-    a.x += b.x;
-    a.y += b.y;
-    a.z += b.z;
-    a.w += b.w;
+    f32x4_store(a.v, f32x4_add(f32x4_load(a.v), f32x4_load(b.v)));
     return a;
 }
 
@@ -138,10 +135,7 @@ Vec4F32 operator+(Vec4F32 a, const Vec4F32& b) noexcept {
 
 static
 Vec4F32& operator-=(Vec4F32& a, const Vec4F32& b) noexcept {
-    a.x -= b.x;
-    a.y -= b.y;
-    a.z -= b.z;
-    a.w -= b.w;
+    f32x4_store(a.v, f32x4_sub(f32x4_load(a.v), f32x4_load(b.v)));
     return a;
 }
 
@@ -152,10 +146,7 @@ Vec4F32 operator-(Vec4F32 a, const Vec4F32& b) noexcept {
 
 static
 Vec4F32& operator*=(Vec4F32& v, F32 s) noexcept {
-    v.x *= s;
-    v.y *= s;
-    v.z *= s;
-    v.w *= s;
+    f32x4_store(v.v, f32x4_mul(f32x4_load(v.v), f32x4_set1(s)));
     return v;
 }
 
@@ -172,11 +163,7 @@ Vec4F32 operator*(F32 s, Vec4F32 v) noexcept {
 static
 Vec4F32& operator/=(Vec4F32& v, F32 s) noexcept {
     F32 inv = 1.0f / s;
-    v.x *= inv;
-    v.y *= inv;
-    v.z *= inv;
-    v.w *= inv;
-    return v;
+    return v *= inv;
 }
 
 static
@@ -320,24 +307,7 @@ Mat4x4F32 operator-(Mat4x4F32 a, const Mat4x4F32& b) noexcept {
 
 static
 Mat4x4F32& operator*=(Mat4x4F32& a, const Mat4x4F32& b) noexcept {
-    Mat4x4F32 res{};
-    res.v[0][0] = a.v[0][0] * b.v[0][0] + a.v[0][1] * b.v[1][0] + a.v[0][2] * b.v[2][0] + a.v[0][3] * b.v[3][0];
-    res.v[0][1] = a.v[0][0] * b.v[0][1] + a.v[0][1] * b.v[1][1] + a.v[0][2] * b.v[2][1] + a.v[0][3] * b.v[3][1];
-    res.v[0][2] = a.v[0][0] * b.v[0][2] + a.v[0][1] * b.v[1][2] + a.v[0][2] * b.v[2][2] + a.v[0][3] * b.v[3][2];
-    res.v[0][3] = a.v[0][0] * b.v[0][3] + a.v[0][1] * b.v[1][3] + a.v[0][2] * b.v[2][3] + a.v[0][3] * b.v[3][3];
-    res.v[1][0] = a.v[1][0] * b.v[0][0] + a.v[1][1] * b.v[1][0] + a.v[1][2] * b.v[2][0] + a.v[1][3] * b.v[3][0];
-    res.v[1][1] = a.v[1][0] * b.v[0][1] + a.v[1][1] * b.v[1][1] + a.v[1][2] * b.v[2][1] + a.v[1][3] * b.v[3][1];
-    res.v[1][2] = a.v[1][0] * b.v[0][2] + a.v[1][1] * b.v[1][2] + a.v[1][2] * b.v[2][2] + a.v[1][3] * b.v[3][2];
-    res.v[1][3] = a.v[1][0] * b.v[0][3] + a.v[1][1] * b.v[1][3] + a.v[1][2] * b.v[2][3] + a.v[1][3] * b.v[3][3];
-    res.v[2][0] = a.v[2][0] * b.v[0][0] + a.v[2][1] * b.v[1][0] + a.v[2][2] * b.v[2][0] + a.v[2][3] * b.v[3][0];
-    res.v[2][1] = a.v[2][0] * b.v[0][1] + a.v[2][1] * b.v[1][1] + a.v[2][2] * b.v[2][1] + a.v[2][3] * b.v[3][1];
-    res.v[2][2] = a.v[2][0] * b.v[0][2] + a.v[2][1] * b.v[1][2] + a.v[2][2] * b.v[2][2] + a.v[2][3] * b.v[3][2];
-    res.v[2][3] = a.v[2][0] * b.v[0][3] + a.v[2][1] * b.v[1][3] + a.v[2][2] * b.v[2][3] + a.v[2][3] * b.v[3][3];
-    res.v[3][0] = a.v[3][0] * b.v[0][0] + a.v[3][1] * b.v[1][0] + a.v[3][2] * b.v[2][0] + a.v[3][3] * b.v[3][0];
-    res.v[3][1] = a.v[3][0] * b.v[0][1] + a.v[3][1] * b.v[1][1] + a.v[3][2] * b.v[2][1] + a.v[3][3] * b.v[3][1];
-    res.v[3][2] = a.v[3][0] * b.v[0][2] + a.v[3][1] * b.v[1][2] + a.v[3][2] * b.v[2][2] + a.v[3][3] * b.v[3][2];
-    res.v[3][3] = a.v[3][0] * b.v[0][3] + a.v[3][1] * b.v[1][3] + a.v[3][2] * b.v[2][3] + a.v[3][3] * b.v[3][3];
-    a = res;
+    a = mat4_mul(a, b);
     return a;
 }
 
@@ -377,10 +347,255 @@ Mat4x4F32 operator/(Mat4x4F32 m, F32 s) noexcept {
 
 static
 Vec4F32 operator*(const Vec4F32& v, const Mat4x4F32& m) noexcept {
-    Vec4F32 res;
-    res.x = v.x * m.v[0][0] + v.y * m.v[1][0] + v.z * m.v[2][0] + v.w * m.v[3][0];
-    res.y = v.x * m.v[0][1] + v.y * m.v[1][1] + v.z * m.v[2][1] + v.w * m.v[3][1];
-    res.z = v.x * m.v[0][2] + v.y * m.v[1][2] + v.z * m.v[2][2] + v.w * m.v[3][2];
-    res.w = v.x * m.v[0][3] + v.y * m.v[1][3] + v.z * m.v[2][3] + v.w * m.v[3][3];
-    return res;
+    return vec4_mul_mat4(v, m);
+}
+
+// --- Hashing ---
+
+// splitmix64 outputs from pi; mixed with the seed into the per-call keys.
+static const U64 g_hashSecret[16] = {
+    0x2CB0F69F4ABEA221ull, 0x9417034723148989ull, 0xDD555950609DFE03ull, 0xDBAFB150DEB12800ull,
+    0x7E789B2E6C442CB6ull, 0xF41E5636C7E4F8C4ull, 0x0959D150F8FBA7E4ull, 0xA97316F13CDB9EEAull,
+    0x74CD8258F9520068ull, 0x55C74A62E116868Bull, 0xD2F4C799A2023CBDull, 0xDF98CB79A37B51B9ull,
+    0x396F5885524F3905ull, 0xAF1D56386CA3B276ull, 0xA9FFBE6B5104E85Aull, 0x6BD0C51B9FD533B3ull,
+};
+
+static U64 hash_read64_(const U8* bytes) {
+    U64 value;
+    MEMCPY(&value, bytes, sizeof(value));
+    return value;
+}
+
+static U64 hash_read32_(const U8* bytes) {
+    U32 value;
+    MEMCPY(&value, bytes, sizeof(value));
+    return value;
+}
+
+// Both halves of the 128-bit product, folded.
+static U64 hash_fold64_(U64 a, U64 b) {
+#if defined(PLATFORM_OS_WINDOWS)
+    U64 high = 0u;
+    U64 low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    __uint128_t product = (__uint128_t)a * b;
+    return (U64)product ^ (U64)(product >> 64u);
+#endif
+}
+
+static U64 hash_avalanche_(U64 hash) {
+    hash ^= hash >> 37u;
+    hash *= 0x165667919E3779F9ull;
+    hash ^= hash >> 32u;
+    return hash;
+}
+
+// Sixteen keys, repeated once so a stripe's eight keys at any shift are
+// contiguous.
+#define HASH_KEY_COUNT 32u
+
+static void hash_keys_(U64 seed, U64* keys) {
+    for (U32 at = 0u; at < HASH_KEY_COUNT; ++at) {
+        U32 index = at & 15u;
+        keys[at] = (index & 1u) ? (g_hashSecret[index] - seed) : (g_hashSecret[index] + seed);
+    }
+}
+
+static Hash128 hash_finish_(U64 low, U64 high) {
+    Hash128 result = {{hash_avalanche_(low), hash_avalanche_(high)}};
+    if (result.u64[0] == 0u && result.u64[1] == 0u) {
+        result.u64[0] = 1u;
+    }
+    return result;
+}
+
+// Up to HASH128_BUFFER_SIZE bytes. 16 bytes or less are packed into two
+// words; longer inputs fold 16-byte chunks, the last read flush with the end.
+static Hash128 hash_short_(const U8* bytes, U64 size, const U64* keys) {
+    if (size <= 16u) {
+        U64 a = 0u;
+        U64 b = 0u;
+        if (size >= 4u) {
+            U64 step = (size >> 3u) << 2u;
+            a = (hash_read32_(bytes) << 32u) | hash_read32_(bytes + step);
+            b = (hash_read32_(bytes + size - 4u) << 32u) | hash_read32_(bytes + size - 4u - step);
+        } else if (size > 0u) {
+            a = ((U64)bytes[0] << 16u) | ((U64)bytes[size >> 1u] << 8u) | (U64)bytes[size - 1u];
+        }
+        return hash_finish_(hash_fold64_(a ^ keys[0], b ^ keys[1] ^ size),
+                            hash_fold64_(a ^ keys[2] ^ size, b ^ keys[3]));
+    }
+    U64 low = size * 0x9E3779B185EBCA87ull;
+    U64 high = size * 0xC2B2AE3D27D4EB4Full;
+    U64 chunkCount = (size + 15u) / 16u;
+    for (U64 chunk = 0u; chunk < chunkCount; ++chunk) {
+        const U8* at = bytes + MIN(chunk * 16u, size - 16u);
+        U64 a = hash_read64_(at);
+        U64 b = hash_read64_(at + 8u);
+        U32 key = (U32)(chunk * 2u);
+        low += hash_fold64_(a ^ keys[key & 15u], b ^ keys[(key + 1u) & 15u]);
+        high += hash_fold64_(a ^ keys[(key + 7u) & 15u], b ^ keys[(key + 8u) & 15u]);
+    }
+    return hash_finish_(low, high ^ low);
+}
+
+static void hash_acc_init_(U64* acc) {
+    acc[0] = 0xC2B2AE3Dull;
+    acc[1] = 0x9E3779B185EBCA87ull;
+    acc[2] = 0xC2B2AE3D27D4EB4Full;
+    acc[3] = 0x165667B19E3779F9ull;
+    acc[4] = 0x85EBCA77C2B2AE63ull;
+    acc[5] = 0x85EBCA77ull;
+    acc[6] = 0x27D4EB2F165667C5ull;
+    acc[7] = 0x9E3779B1ull;
+}
+
+// Eight independent lanes, one 32x32->64 multiply each; the raw word also
+// feeds the neighbour lane so no input bit is lost to the multiply.
+static void hash_accumulate_(U64* acc, const U8* stripe, const U64* keys, U32 keyShift) {
+    for (U32 lane = 0u; lane < 8u; ++lane) {
+        U64 value = hash_read64_(stripe + lane * 8u);
+        U64 keyed = value ^ keys[lane + keyShift];
+        acc[lane ^ 1u] += value;
+        acc[lane] += (keyed & 0xFFFFFFFFull) * (keyed >> 32u);
+    }
+}
+
+// `count` whole stripes. Stripe indices count from the start of the input,
+// so one-shot and streaming scramble at the same places (after every
+// eighth). The SSE2 form is the same integer math two lanes at a time.
+static void hash_stripes_(U64* acc, const U8* bytes, U64 count, const U64* keys, U64 firstIndex) {
+#if SIMD_SSE
+    __m128i lanes[4];
+    for (U32 pair = 0u; pair < 4u; ++pair) {
+        lanes[pair] = _mm_loadu_si128((const __m128i*)(acc + pair * 2u));
+    }
+    const __m128i prime = _mm_set1_epi32((int)0x9E3779B1u);
+    for (U64 stripe = 0u; stripe < count; ++stripe) {
+        U32 shift = (U32)((firstIndex + stripe) & 7u);
+        const U8* at = bytes + stripe * HASH128_STRIPE_SIZE;
+        for (U32 pair = 0u; pair < 4u; ++pair) {
+            __m128i value = _mm_loadu_si128((const __m128i*)(at + pair * 16u));
+            __m128i keyed = _mm_xor_si128(value, _mm_loadu_si128((const __m128i*)(keys + pair * 2u + shift)));
+            __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[pair] = _mm_add_epi64(lanes[pair], _mm_add_epi64(product, swapped));
+        }
+        if (shift == 7u) {
+            for (U32 pair = 0u; pair < 4u; ++pair) {
+                __m128i mixed = _mm_xor_si128(lanes[pair], _mm_srli_epi64(lanes[pair], 47));
+                mixed = _mm_xor_si128(mixed, _mm_loadu_si128((const __m128i*)(keys + 8u + pair * 2u)));
+                __m128i low = _mm_mul_epu32(mixed, prime);
+                __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(mixed, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+                lanes[pair] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+            }
+        }
+    }
+    for (U32 pair = 0u; pair < 4u; ++pair) {
+        _mm_storeu_si128((__m128i*)(acc + pair * 2u), lanes[pair]);
+    }
+#else
+    for (U64 stripe = 0u; stripe < count; ++stripe) {
+        U32 shift = (U32)((firstIndex + stripe) & 7u);
+        hash_accumulate_(acc, bytes + stripe * HASH128_STRIPE_SIZE, keys, shift);
+        if (shift == 7u) {
+            for (U32 lane = 0u; lane < 8u; ++lane) {
+                acc[lane] ^= acc[lane] >> 47u;
+                acc[lane] ^= keys[lane + 8u];
+                acc[lane] *= 0x9E3779B1ull;
+            }
+        }
+    }
+#endif
+}
+
+// Final stripe (the input's last 64 bytes, overlapping what came before),
+// then the lanes fold into two halves with different keys.
+static Hash128 hash_long_finish_(U64* acc, const U8* lastStripe, const U64* keys, U64 size) {
+    hash_accumulate_(acc, lastStripe, keys, 9u);
+    U64 low = size * 0x9E3779B185EBCA87ull;
+    U64 high = ~(size * 0xC2B2AE3D27D4EB4Full);
+    for (U32 pair = 0u; pair < 4u; ++pair) {
+        U32 lane = pair * 2u;
+        low += hash_fold64_(acc[lane] ^ keys[lane + 1u], acc[lane + 1u] ^ keys[lane + 2u]);
+        high += hash_fold64_(acc[lane] ^ keys[(lane + 9u) & 15u], acc[lane + 1u] ^ keys[(lane + 10u) & 15u]);
+    }
+    return hash_finish_(low, high);
+}
+
+Hash128 hash128_from_bytes(const void* data, U64 size, U64 seed) {
+    const U8* bytes = (const U8*)data;
+    U64 keys[HASH_KEY_COUNT];
+    hash_keys_(seed, keys);
+    if (size <= HASH128_BUFFER_SIZE) {
+        return hash_short_(bytes, size, keys);
+    }
+    U64 acc[8];
+    hash_acc_init_(acc);
+    hash_stripes_(acc, bytes, (size - 1u) / HASH128_STRIPE_SIZE, keys, 0u);
+    return hash_long_finish_(acc, bytes + size - HASH128_STRIPE_SIZE, keys, size);
+}
+
+U64 hash64_from_bytes(const void* data, U64 size, U64 seed) {
+    return hash128_from_bytes(data, size, seed).u64[0];
+}
+
+void hash128_begin(Hash128State* state, U64 seed) {
+    MEMSET(state, 0, sizeof(*state));
+    state->seed = seed;
+    hash_acc_init_(state->acc);
+}
+
+// The buffer is only consumed once more input arrives, so at the end it
+// still holds 1..256 bytes: the whole input for the short path, or the
+// tail the long path needs (with `previous` when the tail straddles a flush).
+void hash128_update(Hash128State* state, const void* data, U64 size) {
+    const U8* bytes = (const U8*)data;
+    U64 keys[HASH_KEY_COUNT];
+    hash_keys_(state->seed, keys);
+    state->totalSize += size;
+    while (size > 0u) {
+        if (state->bufferSize == HASH128_BUFFER_SIZE) {
+            hash_stripes_(state->acc, state->buffer, HASH128_BUFFER_SIZE / HASH128_STRIPE_SIZE, keys, state->stripeCount);
+            state->stripeCount += HASH128_BUFFER_SIZE / HASH128_STRIPE_SIZE;
+            MEMCPY(state->previous, state->buffer + HASH128_BUFFER_SIZE - HASH128_STRIPE_SIZE, HASH128_STRIPE_SIZE);
+            state->bufferSize = 0u;
+        }
+        if (state->bufferSize == 0u && size > HASH128_BUFFER_SIZE) {
+            // Whole buffers straight from the caller's memory, leaving 1..256 bytes.
+            U64 direct = ((size - 1u) / HASH128_BUFFER_SIZE) * HASH128_BUFFER_SIZE;
+            hash_stripes_(state->acc, bytes, direct / HASH128_STRIPE_SIZE, keys, state->stripeCount);
+            state->stripeCount += direct / HASH128_STRIPE_SIZE;
+            MEMCPY(state->previous, bytes + direct - HASH128_STRIPE_SIZE, HASH128_STRIPE_SIZE);
+            bytes += direct;
+            size -= direct;
+            continue;
+        }
+        U64 take = MIN(size, (U64)(HASH128_BUFFER_SIZE - state->bufferSize));
+        MEMCPY(state->buffer + state->bufferSize, bytes, take);
+        state->bufferSize += (U32)take;
+        bytes += take;
+        size -= take;
+    }
+}
+
+Hash128 hash128_end(const Hash128State* state) {
+    U64 keys[HASH_KEY_COUNT];
+    hash_keys_(state->seed, keys);
+    if (state->totalSize <= HASH128_BUFFER_SIZE) {
+        return hash_short_(state->buffer, state->totalSize, keys);
+    }
+    U64 acc[8];
+    MEMCPY(acc, state->acc, sizeof(acc));
+    hash_stripes_(acc, state->buffer, (state->bufferSize - 1u) / HASH128_STRIPE_SIZE, keys, state->stripeCount);
+    U8 lastStripe[HASH128_STRIPE_SIZE];
+    if (state->bufferSize >= HASH128_STRIPE_SIZE) {
+        MEMCPY(lastStripe, state->buffer + state->bufferSize - HASH128_STRIPE_SIZE, HASH128_STRIPE_SIZE);
+    } else {
+        U32 fromPrevious = HASH128_STRIPE_SIZE - state->bufferSize;
+        MEMCPY(lastStripe, state->previous + state->bufferSize, fromPrevious);
+        MEMCPY(lastStripe + fromPrevious, state->buffer, state->bufferSize);
+    }
+    return hash_long_finish_(acc, lastStripe, keys, state->totalSize);
 }
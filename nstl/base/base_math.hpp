@@ -82,7 +82,8 @@ inline U32 u32_next_power_of_two(U32 v) {
 // Hashing
 
 // FNV-1a over bytes with a size finalizer; callers reserve 0 as the
-// empty sentinel, so a zero hash maps to 1.
+// empty sentinel, so a zero hash maps to 1. One multiply per byte: keep
+// it for short keys, bulk data goes through hash128_from_bytes.
 inline U64 hash_fnv1a(const void* data, U64 size, U64 seed) {
     const U8* bytes = (const U8*)data;
     U64 hash = seed;
@@ -98,6 +99,36 @@ inline U64 hash_fnv1a(const void* data, U64 size, U64 seed) {
     return hash;
 }
 
+// XXH3-style 128-bit hash: eight 64-bit lanes eat a 64-byte stripe per
+// step with 32x32->64 multiplies, short inputs take 128-bit multiply-fold
+// paths. Not cryptographic. The result depends only on bytes and seed (no
+// SIMD or endianness dependence on little-endian targets), so it is safe
+// to persist. Like hash_fnv1a it never returns all zero.
+struct Hash128 {
+    U64 u64[2];
+};
+
+#define HASH128_STRIPE_SIZE 64u
+#define HASH128_BUFFER_SIZE 256u
+
+// Streaming form: begin, any number of updates, end. Equals the one-shot
+// hash of the concatenated bytes however the input is split.
+struct Hash128State {
+    U64 acc[8];
+    U64 seed;
+    U64 totalSize;
+    U64 stripeCount;
+    U32 bufferSize;
+    U8 buffer[HASH128_BUFFER_SIZE];
+    U8 previous[HASH128_STRIPE_SIZE]; // last stripe of the previous flush, for the tail read
+};
+
+UTILITIES_SHARED_API Hash128 hash128_from_bytes(const void* data, U64 size, U64 seed);
+UTILITIES_SHARED_API U64 hash64_from_bytes(const void* data, U64 size, U64 seed);
+UTILITIES_SHARED_API void hash128_begin(Hash128State* state, U64 seed);
+UTILITIES_SHARED_API void hash128_update(Hash128State* state, const void* data, U64 size);
+UTILITIES_SHARED_API Hash128 hash128_end(const Hash128State* state);
+
 
 // ////////////////////////
 // Vector
@@ -229,8 +260,14 @@ union QuatF32 {
 
 // ////////////////////////
 // Matrix Operators
+//
+// The operators and the plain-named functions go through base_simd. Each
+// keeps the evaluation order of its *_exact twin, which is plain scalar
+// code: replays and other bit-for-bit consumers (the deterministic sim)
+// call the *_exact forms, so neither MATH_SIMD nor the target ISA can move
+// their results.
 
-inline Mat4x4F32 operator*(const Mat4x4F32& a, const Mat4x4F32& b) noexcept {
+inline Mat4x4F32 mat4_mul_exact(const Mat4x4F32& a, const Mat4x4F32& b) noexcept {
     Mat4x4F32 res = {};
     for (int row = 0; row < 4; ++row) {
         for (int col = 0; col < 4; ++col) {
@@ -243,7 +280,48 @@ inline Mat4x4F32 operator*(const Mat4x4F32& a, const Mat4x4F32& b) noexcept {
     return res;
 }
 
-inline Vec4F32 operator*(const Mat4x4F32& m, const Vec4F32& v) noexcept {
+// Row r of the product is sum_k a[r][k] * b.row[k], accumulated in k order.
+inline Mat4x4F32 mat4_mul(const Mat4x4F32& a, const Mat4x4F32& b) noexcept {
+    Mat4x4F32 res;
+#if SIMD_AVX
+    // Two rows per register: the in-lane shuffle broadcasts a[r][k] and
+    // a[r+1][k] into the low and high halves.
+    __m256 b0 = _mm256_broadcast_ps((const __m128*)b.v[0]);
+    __m256 b1 = _mm256_broadcast_ps((const __m128*)b.v[1]);
+    __m256 b2 = _mm256_broadcast_ps((const __m128*)b.v[2]);
+    __m256 b3 = _mm256_broadcast_ps((const __m128*)b.v[3]);
+    for (int row = 0; row < 4; row += 2) {
+        __m256 rows = _mm256_loadu_ps(a.v[row]);
+        __m256 acc = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b0);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), b1));
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b2));
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b3));
+        _mm256_storeu_ps(res.v[row], acc);
+    }
+#else
+    F32x4 b0 = f32x4_load(b.v[0]);
+    F32x4 b1 = f32x4_load(b.v[1]);
+    F32x4 b2 = f32x4_load(b.v[2]);
+    F32x4 b3 = f32x4_load(b.v[3]);
+    for (int row = 0; row < 4; ++row) {
+        F32x4 r = f32x4_load(a.v[row]);
+        F32x4 acc = f32x4_mul(f32x4_splat<0>(r), b0);
+        acc = f32x4_madd(f32x4_splat<1>(r), b1, acc);
+        acc = f32x4_madd(f32x4_splat<2>(r), b2, acc);
+        acc = f32x4_madd(f32x4_splat<3>(r), b3, acc);
+        f32x4_store(res.v[row], acc);
+    }
+#endif
+    return res;
+}
+
+inline Mat4x4F32 operator*(const Mat4x4F32& a, const Mat4x4F32& b) noexcept {
+    return mat4_mul(a, b);
+}
+
+// Column-vector m·v. Against this storage it is NOT a point transform
+// (see vec4_mul_mat4).
+inline Vec4F32 mat4_mul_vec4_exact(const Mat4x4F32& m, const Vec4F32& v) noexcept {
     Vec4F32 res;
     res.x = m.v[0][0] * v.x + m.v[0][1] * v.y + m.v[0][2] * v.z + m.v[0][3] * v.w;
     res.y = m.v[1][0] * v.x + m.v[1][1] * v.y + m.v[1][2] * v.z + m.v[1][3] * v.w;
@@ -252,6 +330,68 @@ inline Vec4F32 operator*(const Mat4x4F32& m, const Vec4F32& v) noexcept {
     return res;
 }
 
+inline Vec4F32 mat4_mul_vec4(const Mat4x4F32& m, const Vec4F32& v) noexcept {
+    F32x4 c0 = f32x4_load(m.v[0]);
+    F32x4 c1 = f32x4_load(m.v[1]);
+    F32x4 c2 = f32x4_load(m.v[2]);
+    F32x4 c3 = f32x4_load(m.v[3]);
+    f32x4_transpose(&c0, &c1, &c2, &c3);
+    F32x4 acc = f32x4_mul(c0, f32x4_set1(v.x));
+    acc = f32x4_madd(c1, f32x4_set1(v.y), acc);
+    acc = f32x4_madd(c2, f32x4_set1(v.z), acc);
+    acc = f32x4_madd(c3, f32x4_set1(v.w), acc);
+    Vec4F32 res;
+    f32x4_store(res.v, acc);
+    return res;
+}
+
+inline Vec4F32 operator*(const Mat4x4F32& m, const Vec4F32& v) noexcept {
+    return mat4_mul_vec4(m, v);
+}
+
+// Row-vector v·M, the engine's point convention (translation in row 3).
+inline Vec4F32 vec4_mul_mat4_exact(const Vec4F32& v, const Mat4x4F32& m) noexcept {
+    Vec4F32 res;
+    res.x = v.x * m.v[0][0] + v.y * m.v[1][0] + v.z * m.v[2][0] + v.w * m.v[3][0];
+    res.y = v.x * m.v[0][1] + v.y * m.v[1][1] + v.z * m.v[2][1] + v.w * m.v[3][1];
+    res.z = v.x * m.v[0][2] + v.y * m.v[1][2] + v.z * m.v[2][2] + v.w * m.v[3][2];
+    res.w = v.x * m.v[0][3] + v.y * m.v[1][3] + v.z * m.v[2][3] + v.w * m.v[3][3];
+    return res;
+}
+
+inline Vec4F32 vec4_mul_mat4(const Vec4F32& v, const Mat4x4F32& m) noexcept {
+    F32x4 acc = f32x4_mul(f32x4_set1(v.x), f32x4_load(m.v[0]));
+    acc = f32x4_madd(f32x4_set1(v.y), f32x4_load(m.v[1]), acc);
+    acc = f32x4_madd(f32x4_set1(v.z), f32x4_load(m.v[2]), acc);
+    acc = f32x4_madd(f32x4_set1(v.w), f32x4_load(m.v[3]), acc);
+    Vec4F32 res;
+    f32x4_store(res.v, acc);
+    return res;
+}
+
+// p·M with w = 1, w of the result dropped: affine transforms only.
+inline Vec3F32 mat4_transform_point_exact(const Mat4x4F32& m, Vec3F32 p) noexcept {
+    Vec3F32 res;
+    res.x = p.x * m.v[0][0] + p.y * m.v[1][0] + p.z * m.v[2][0] + m.v[3][0];
+    res.y = p.x * m.v[0][1] + p.y * m.v[1][1] + p.z * m.v[2][1] + m.v[3][1];
+    res.z = p.x * m.v[0][2] + p.y * m.v[1][2] + p.z * m.v[2][2] + m.v[3][2];
+    return res;
+}
+
+inline Vec3F32 mat4_transform_point(const Mat4x4F32& m, Vec3F32 p) noexcept {
+    F32x4 acc = f32x4_mul(f32x4_set1(p.x), f32x4_load(m.v[0]));
+    acc = f32x4_madd(f32x4_set1(p.y), f32x4_load(m.v[1]), acc);
+    acc = f32x4_madd(f32x4_set1(p.z), f32x4_load(m.v[2]), acc);
+    acc = f32x4_add(acc, f32x4_load(m.v[3]));
+    F32 lanes[4];
+    f32x4_store(lanes, acc);
+    Vec3F32 res;
+    res.x = lanes[0];
+    res.y = lanes[1];
+    res.z = lanes[2];
+    return res;
+}
+
 
 // ////////////////////////
 // Vector Operations
@@ -352,7 +492,7 @@ inline QuatF32 quat_identity() {
     return q;
 }
 
-inline QuatF32 quat_mul(QuatF32 a, QuatF32 b) {
+inline QuatF32 quat_mul_exact(QuatF32 a, QuatF32 b) {
     QuatF32 q;
     q.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
     q.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
@@ -361,6 +501,51 @@ inline QuatF32 quat_mul(QuatF32 a, QuatF32 b) {
     return q;
 }
 
+// a.w * b, then the a.x, a.y, a.z terms against signed permutations of b,
+// which is quat_mul_exact's per-lane order (x + -y rounds as x - y).
+inline QuatF32 quat_mul(QuatF32 a, QuatF32 b) {
+    F32x4 vb = f32x4_load(b.v);
+    F32x4 acc = f32x4_mul(f32x4_set1(a.w), vb);
+    acc = f32x4_madd(f32x4_set1(a.x), f32x4_mul(f32x4_shuffle<3, 2, 1, 0>(vb), f32x4_set(1.0f, -1.0f, 1.0f, -1.0f)), acc);
+    acc = f32x4_madd(f32x4_set1(a.y), f32x4_mul(f32x4_shuffle<2, 3, 0, 1>(vb), f32x4_set(1.0f, 1.0f, -1.0f, -1.0f)), acc);
+    acc = f32x4_madd(f32x4_set1(a.z), f32x4_mul(f32x4_shuffle<1, 0, 3, 2>(vb), f32x4_set(-1.0f, 1.0f, 1.0f, -1.0f)), acc);
+    QuatF32 q;
+    f32x4_store(q.v, acc);
+    return q;
+}
+
+// Rotate v by the unit quaternion q: v + q.xyz x t with t = 2 (q.xyz x v
+// + q.w v), the rotation quat_to_mat4 expresses under v·M.
+inline Vec3F32 quat_rotate_exact(QuatF32 q, Vec3F32 v) {
+    F32 tx = 2.0f * (q.y * v.z - q.z * v.y + q.w * v.x);
+    F32 ty = 2.0f * (q.z * v.x - q.x * v.z + q.w * v.y);
+    F32 tz = 2.0f * (q.x * v.y - q.y * v.x + q.w * v.z);
+    Vec3F32 result;
+    result.x = v.x + q.y * tz - q.z * ty;
+    result.y = v.y + q.z * tx - q.x * tz;
+    result.z = v.z + q.x * ty - q.y * tx;
+    return result;
+}
+
+inline Vec3F32 quat_rotate(QuatF32 q, Vec3F32 v) {
+    F32x4 vq = f32x4_load(q.v);
+    F32x4 vv = f32x4_set(v.x, v.y, v.z, 0.0f);
+    F32x4 qYZX = f32x4_shuffle<1, 2, 0, 3>(vq);
+    F32x4 qZXY = f32x4_shuffle<2, 0, 1, 3>(vq);
+    F32x4 cross = f32x4_sub(f32x4_mul(qYZX, f32x4_shuffle<2, 0, 1, 3>(vv)),
+                            f32x4_mul(qZXY, f32x4_shuffle<1, 2, 0, 3>(vv)));
+    F32x4 t = f32x4_mul(f32x4_set1(2.0f), f32x4_madd(f32x4_splat<3>(vq), vv, cross));
+    F32x4 res = f32x4_sub(f32x4_madd(qYZX, f32x4_shuffle<2, 0, 1, 3>(t), vv),
+                          f32x4_mul(qZXY, f32x4_shuffle<1, 2, 0, 3>(t)));
+    F32 lanes[4];
+    f32x4_store(lanes, res);
+    Vec3F32 result;
+    result.x = lanes[0];
+    result.y = lanes[1];
+    result.z = lanes[2];
+    return result;
+}
+
 inline QuatF32 quat_normalize(QuatF32 q) {
     F32 len = SQRT_F32(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
     if (len > 0.0f) {
@@ -412,12 +597,16 @@ inline Mat4x4F32 mat4_scale(Vec3F32 scale) {
 }
 
 inline Mat4x4F32 mat4_transpose(Mat4x4F32 m) {
-    Mat4x4F32 t = {};
-    for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-            t.v[i][j] = m.v[j][i];
-        }
-    }
+    F32x4 r0 = f32x4_load(m.v[0]);
+    F32x4 r1 = f32x4_load(m.v[1]);
+    F32x4 r2 = f32x4_load(m.v[2]);
+    F32x4 r3 = f32x4_load(m.v[3]);
+    f32x4_transpose(&r0, &r1, &r2, &r3);
+    Mat4x4F32 t;
+    f32x4_store(t.v[0], r0);
+    f32x4_store(t.v[1], r1);
+    f32x4_store(t.v[2], r2);
+    f32x4_store(t.v[3], r3);
     return t;
 }
 
@@ -544,6 +733,99 @@ inline Mat4x4F32 mat4_inverse(Mat4x4F32 m) {
 }
 
 
+// ////////////////////////
+// Wide Vectors
+//
+// Structure-of-arrays Vec3s, one object per lane, for kernels that cull,
+// transform or test 4 or 8 objects at a time. Header-only and stateless,
+// so SPMD lanes can run them on their own slices. Each op keeps the order
+// of its scalar counterpart (dot is (x + y) + z, points go through
+// mat4_transform_point_exact's order), so a lane matches the scalar
+// result bit for bit on backends that do not contract.
+
+struct Vec3x4F32 {
+    F32x4 x, y, z;
+};
+
+struct Vec3x8F32 {
+    F32x8 x, y, z;
+};
+
+#define VEC3_WIDE_DEFINE_(Vec, vec, Lanes, lanes, Mask)                                         \
+    inline Vec vec##_set1(Vec3F32 v) noexcept {                                                 \
+        Vec r = {lanes##_set1(v.x), lanes##_set1(v.y), lanes##_set1(v.z)};                      \
+        return r;                                                                               \
+    }                                                                                           \
+    inline Vec vec##_load(const F32* xs, const F32* ys, const F32* zs) noexcept {               \
+        Vec r = {lanes##_load(xs), lanes##_load(ys), lanes##_load(zs)};                         \
+        return r;                                                                               \
+    }                                                                                           \
+    inline void vec##_store(Vec v, F32* xs, F32* ys, F32* zs) noexcept {                        \
+        lanes##_store(xs, v.x);                                                                 \
+        lanes##_store(ys, v.y);                                                                 \
+        lanes##_store(zs, v.z);                                                                 \
+    }                                                                                           \
+    inline Vec vec##_add(Vec a, Vec b) noexcept {                                               \
+        Vec r = {lanes##_add(a.x, b.x), lanes##_add(a.y, b.y), lanes##_add(a.z, b.z)};          \
+        return r;                                                                               \
+    }                                                                                           \
+    inline Vec vec##_sub(Vec a, Vec b) noexcept {                                               \
+        Vec r = {lanes##_sub(a.x, b.x), lanes##_sub(a.y, b.y), lanes##_sub(a.z, b.z)};          \
+        return r;                                                                               \
+    }                                                                                           \
+    inline Vec vec##_scale(Vec a, Lanes s) noexcept {                                           \
+        Vec r = {lanes##_mul(a.x, s), lanes##_mul(a.y, s), lanes##_mul(a.z, s)};                \
+        return r;                                                                               \
+    }                                                                                           \
+    inline Lanes vec##_dot(Vec a, Vec b) noexcept {                                             \
+        Lanes r = lanes##_mul(a.x, b.x);                                                        \
+        r = lanes##_madd(a.y, b.y, r);                                                          \
+        return lanes##_madd(a.z, b.z, r);                                                       \
+    }                                                                                           \
+    inline Vec vec##_select(Mask m, Vec a, Vec b) noexcept {                                    \
+        Vec r = {lanes##_select(m, a.x, b.x), lanes##_select(m, a.y, b.y),                      \
+                 lanes##_select(m, a.z, b.z)};                                                  \
+        return r;                                                                               \
+    }                                                                                           \
+    inline Vec vec##_transform_point(const Mat4x4F32& m, Vec p) noexcept {                      \
+        Vec r;                                                                                  \
+        r.x = lanes##_madd(p.z, lanes##_set1(m.v[2][0]),                                        \
+              lanes##_madd(p.y, lanes##_set1(m.v[1][0]), lanes##_mul(p.x, lanes##_set1(m.v[0][0])))); \
+        r.y = lanes##_madd(p.z, lanes##_set1(m.v[2][1]),                                        \
+              lanes##_madd(p.y, lanes##_set1(m.v[1][1]), lanes##_mul(p.x, lanes##_set1(m.v[0][1])))); \
+        r.z = lanes##_madd(p.z, lanes##_set1(m.v[2][2]),                                        \
+              lanes##_madd(p.y, lanes##_set1(m.v[1][2]), lanes##_mul(p.x, lanes##_set1(m.v[0][2])))); \
+        r.x = lanes##_add(r.x, lanes##_set1(m.v[3][0]));                                        \
+        r.y = lanes##_add(r.y, lanes##_set1(m.v[3][1]));                                        \
+        r.z = lanes##_add(r.z, lanes##_set1(m.v[3][2]));                                        \
+        return r;                                                                               \
+    }
+
+VEC3_WIDE_DEFINE_(Vec3x4F32, vec3x4, F32x4, f32x4, M32x4)
+VEC3_WIDE_DEFINE_(Vec3x8F32, vec3x8, F32x8, f32x8, M32x8)
+
+// p·M (w = 1) over SoA arrays, eight at a time, then four, then the scalar
+// tail. Out may alias in.
+inline void mat4_transform_points_soa(const Mat4x4F32& m, const F32* xs, const F32* ys, const F32* zs,
+                                      F32* outX, F32* outY, F32* outZ, U64 count) noexcept {
+    U64 at = 0u;
+    for (; at + 8u <= count; at += 8u) {
+        Vec3x8F32 p = vec3x8_load(xs + at, ys + at, zs + at);
+        vec3x8_store(vec3x8_transform_point(m, p), outX + at, outY + at, outZ + at);
+    }
+    for (; at + 4u <= count; at += 4u) {
+        Vec3x4F32 p = vec3x4_load(xs + at, ys + at, zs + at);
+        vec3x4_store(vec3x4_transform_point(m, p), outX + at, outY + at, outZ + at);
+    }
+    for (; at < count; ++at) {
+        Vec3F32 p = mat4_transform_point_exact(m, vec3_make(xs[at], ys[at], zs[at]));
+        outX[at] = p.x;
+        outY[at] = p.y;
+        outZ[at] = p.z;
+    }
+}
+
+
 // ////////////////////////
 // Min/Max
 
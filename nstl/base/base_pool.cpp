@@ -0,0 +1,268 @@
+//
+// Pool carving, the thread-cache slot table and batch refill / flush, and
+// the Heap's size-class mapping.
+//
+
+// ////////////////////////
+// Pool
+
+struct PoolBlock_ {
+    PoolBlock_* next;
+};
+
+// Cache slots are handed out at pool_init. A slot's generation is bumped on
+// every claim, so a thread-cache entry left behind by a destroyed pool never
+// matches the pool that reuses the slot.
+struct PoolCacheSlot_ {
+    Pool* pool;
+    U32 generation;
+};
+
+static PoolCacheSlot_ g_poolCacheSlots[POOL_MAX_CACHED];
+static U32 g_poolCacheSlotLock;
+
+struct PoolThreadCache_ {
+    PoolBlock_* head[POOL_MAX_CACHED];
+    U32 count[POOL_MAX_CACHED];
+    U32 generation[POOL_MAX_CACHED];
+};
+
+thread_local PoolThreadCache_ g_tlsPoolCache = {};
+
+// Same reason as job_tls_: a fiber may resume on another thread, so the TLS
+// address is never cached across calls.
+static NO_INLINE PoolThreadCache_* pool_tls_(void) {
+#if FIBER_SUPPORTED
+    __asm__ __volatile__("" ::: "memory");
+#endif
+    return &g_tlsPoolCache;
+}
+
+static void pool_lock_(U32* lock) {
+    while (ATOMIC_EXCHANGE(lock, 1u, MEMORY_ORDER_ACQUIRE) != 0u) {
+        while (ATOMIC_LOAD(lock, MEMORY_ORDER_RELAXED) != 0u) {
+            OS_cpu_pause();
+        }
+    }
+}
+
+static void pool_unlock_(U32* lock) {
+    ATOMIC_STORE(lock, 0u, MEMORY_ORDER_RELEASE);
+}
+
+void pool_init(Pool* pool, Arena* arena, U64 blockSize, U64 alignment) {
+    ASSERT_DEBUG(arena && "Pool needs an arena");
+    ASSERT_DEBUG(is_power_of_two(alignment) && "Alignment must be a power of two");
+    MEMSET(pool, 0, sizeof(*pool));
+    pool->arena = arena;
+    pool->lock = &pool->ownLock;
+    pool->alignment = MAX(alignment, (U64)alignof(PoolBlock_));
+    pool->blockSize = align_pow2(MAX(blockSize, (U64)sizeof(PoolBlock_)), pool->alignment);
+    pool->cacheSlot = POOL_INVALID_CACHE_SLOT;
+
+    pool_lock_(&g_poolCacheSlotLock);
+    for (U32 slot = 0u; slot < POOL_MAX_CACHED; ++slot) {
+        if (g_poolCacheSlots[slot].pool == 0) {
+            g_poolCacheSlots[slot].pool = pool;
+            g_poolCacheSlots[slot].generation += 1u;
+            pool->cacheSlot = slot;
+            pool->cacheGeneration = g_poolCacheSlots[slot].generation;
+            break;
+        }
+    }
+    pool_unlock_(&g_poolCacheSlotLock);
+    ASSERT_DEBUG(pool->cacheSlot != POOL_INVALID_CACHE_SLOT && "Out of pool thread-cache slots; raise POOL_MAX_CACHED");
+}
+
+void pool_destroy(Pool* pool) {
+    if (!pool || pool->cacheSlot == POOL_INVALID_CACHE_SLOT) {
+        return;
+    }
+    pool_lock_(&g_poolCacheSlotLock);
+    g_poolCacheSlots[pool->cacheSlot].pool = 0;
+    pool_unlock_(&g_poolCacheSlotLock);
+    pool->cacheSlot = POOL_INVALID_CACHE_SLOT;
+}
+
+// Caller holds pool->lock. Takes up to maxCount blocks off the shared list,
+// carving fresh ones from the arena when it runs dry.
+static U32 pool_take_locked_(Pool* pool, PoolBlock_** outHead, U32 maxCount) {
+    PoolBlock_* head = 0;
+    U32 count = 0u;
+    while (count < maxCount && pool->freeList) {
+        PoolBlock_* block = (PoolBlock_*)pool->freeList;
+        pool->freeList = block->next;
+        FREELIST_PUSH(head, block, next);
+        count += 1u;
+    }
+    if (count == 0u) {
+        U64 carveCount = CLAMP(POOL_CARVE_BYTES / pool->blockSize, 1u, (U64)maxCount);
+        U8* carved = (U8*)arena_push(pool->arena, pool->blockSize * carveCount, pool->alignment);
+        for (U64 at = carveCount; at > 0u; --at) {
+            PoolBlock_* block = (PoolBlock_*)(carved + (at - 1u) * pool->blockSize);
+            FREELIST_PUSH(head, block, next);
+        }
+        pool->blockCount += carveCount;
+        count = (U32)carveCount;
+    }
+    *outHead = head;
+    return count;
+}
+
+// Caller holds pool->lock.
+static void pool_give_locked_(Pool* pool, PoolBlock_* head, PoolBlock_* tail) {
+    tail->next = (PoolBlock_*)pool->freeList;
+    pool->freeList = head;
+}
+
+// The calling thread's entry for this pool, reset if a destroyed pool left it.
+static PoolThreadCache_* pool_cache_for_(Pool* pool) {
+    PoolThreadCache_* cache = pool_tls_();
+    U32 slot = pool->cacheSlot;
+    if (cache->generation[slot] != pool->cacheGeneration) {
+        cache->generation[slot] = pool->cacheGeneration;
+        cache->head[slot] = 0;
+        cache->count[slot] = 0u;
+    }
+    return cache;
+}
+
+void* pool_alloc(Pool* pool) {
+    if (pool->cacheSlot == POOL_INVALID_CACHE_SLOT) {
+        PoolBlock_* block = 0;
+        pool_lock_(pool->lock);
+        pool_take_locked_(pool, &block, 1u);
+        pool_unlock_(pool->lock);
+        return block;
+    }
+
+    PoolThreadCache_* cache = pool_cache_for_(pool);
+    U32 slot = pool->cacheSlot;
+    if (!cache->head[slot]) {
+        pool_lock_(pool->lock);
+        cache->count[slot] = pool_take_locked_(pool, &cache->head[slot], POOL_CACHE_BATCH);
+        pool_unlock_(pool->lock);
+    }
+    PoolBlock_* block = 0;
+    FREELIST_POP(cache->head[slot], block, next);
+    if (block) {
+        cache->count[slot] -= 1u;
+    }
+    return block;
+}
+
+void pool_free(Pool* pool, void* block) {
+    if (!block) {
+        return;
+    }
+    PoolBlock_* node = (PoolBlock_*)block;
+    if (pool->cacheSlot == POOL_INVALID_CACHE_SLOT) {
+        pool_lock_(pool->lock);
+        pool_give_locked_(pool, node, node);
+        pool_unlock_(pool->lock);
+        return;
+    }
+
+    PoolThreadCache_* cache = pool_cache_for_(pool);
+    U32 slot = pool->cacheSlot;
+    FREELIST_PUSH(cache->head[slot], node, next);
+    cache->count[slot] += 1u;
+
+    // Keep one batch for the next allocs, hand the rest back.
+    if (cache->count[slot] >= 2u * POOL_CACHE_BATCH) {
+        PoolBlock_* head = cache->head[slot];
+        PoolBlock_* tail = head;
+        for (U32 at = 1u; at < POOL_CACHE_BATCH; ++at) {
+            tail = tail->next;
+        }
+        cache->head[slot] = tail->next;
+        cache->count[slot] -= POOL_CACHE_BATCH;
+        pool_lock_(pool->lock);
+        pool_give_locked_(pool, head, tail);
+        pool_unlock_(pool->lock);
+    }
+}
+
+void pool_thread_cache_flush() {
+    PoolThreadCache_* cache = pool_tls_();
+    pool_lock_(&g_poolCacheSlotLock);
+    for (U32 slot = 0u; slot < POOL_MAX_CACHED; ++slot) {
+        PoolBlock_* head = cache->head[slot];
+        Pool* pool = g_poolCacheSlots[slot].pool;
+        if (head && pool && cache->generation[slot] == g_poolCacheSlots[slot].generation) {
+            PoolBlock_* tail = head;
+            while (tail->next) {
+                tail = tail->next;
+            }
+            pool_lock_(pool->lock);
+            pool_give_locked_(pool, head, tail);
+            pool_unlock_(pool->lock);
+        }
+        cache->head[slot] = 0;
+        cache->count[slot] = 0u;
+    }
+    pool_unlock_(&g_poolCacheSlotLock);
+}
+
+
+// ////////////////////////
+// Heap
+
+// Classes 0..7 step by 16 up to 128 B. Past that each power of two
+// (2^log, 2^(log+1)] splits into four classes of 2^(log-2).
+static U32 heap_class_index_(U64 size) {
+    if (size <= 128u) {
+        return (U32)((MAX(size, (U64)1u) + 15u) / 16u) - 1u;
+    }
+    U32 log = 7u;
+    while ((1ull << (log + 1u)) < size) {
+        log += 1u;
+    }
+    U32 quarter = (U32)((size - 1u - (1ull << log)) >> (log - 2u));
+    return 8u + (log - 7u) * 4u + quarter;
+}
+
+static U64 heap_class_bytes_(U32 index) {
+    if (index < 8u) {
+        return (U64)(index + 1u) * 16u;
+    }
+    U32 log = 7u + (index - 8u) / 4u;
+    U32 quarter = (index - 8u) % 4u;
+    return (1ull << log) + (U64)(quarter + 1u) * (1ull << (log - 2u));
+}
+
+void heap_init(Heap* heap, Arena* arena) {
+    heap->arena = arena;
+    heap->lock = 0u;
+    for (U32 index = 0u; index < HEAP_CLASS_COUNT; ++index) {
+        Pool* pool = &heap->classes[index];
+        pool_init(pool, arena, heap_class_bytes_(index), 16u);
+        pool->lock = &heap->lock;
+    }
+}
+
+void heap_destroy(Heap* heap) {
+    for (U32 index = 0u; index < HEAP_CLASS_COUNT; ++index) {
+        pool_destroy(&heap->classes[index]);
+    }
+}
+
+U64 heap_class_size(U64 size) {
+    return (size <= HEAP_MAX_SIZE) ? heap_class_bytes_(heap_class_index_(size)) : 0u;
+}
+
+void* heap_alloc(Heap* heap, U64 size) {
+    if (size > HEAP_MAX_SIZE) {
+        ASSERT_DEBUG(false && "heap_alloc is for blocks up to HEAP_MAX_SIZE");
+        return 0;
+    }
+    return pool_alloc(&heap->classes[heap_class_index_(size)]);
+}
+
+void heap_free(Heap* heap, void* block, U64 size) {
+    if (size > HEAP_MAX_SIZE) {
+        ASSERT_DEBUG(false && "heap_free size does not match any heap_alloc");
+        return;
+    }
+    pool_free(&heap->classes[heap_class_index_(size)], block);
+}
@@ -0,0 +1,453 @@
+//
+// Four-lane F32 SIMD for base_math, with SSE, AVX, NEON and scalar backends
+// that round exactly like the scalar code they replace.
+//
+
+#pragma once
+
+// ////////////////////////
+// SIMD
+//
+// A four-lane F32 register for base_math. The backend follows the target:
+// SSE2 on x86-64 (with SSE4.1 and AVX paths when the compiler is allowed
+// them), NEON on ARM64, and plain arrays otherwise or with MATH_SIMD=0.
+// Every op is a single IEEE mul, add or sub, never fused and never an
+// estimate, so a kernel written in the same order as its scalar form
+// rounds the same. That needs FP contraction off on both sides, which sob.c
+// passes to every engine target (-ffp-contract=off).
+
+#ifndef MATH_SIMD
+#define MATH_SIMD 1
+#endif
+
+#if MATH_SIMD && defined(PLATFORM_ARCH_X64)
+#define SIMD_SSE 1
+#include <emmintrin.h>
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define SIMD_SSE41 1
+#include <smmintrin.h>
+#endif
+#if defined(__AVX__)
+#define SIMD_AVX 1
+#include <immintrin.h>
+#endif
+#elif MATH_SIMD && defined(PLATFORM_ARCH_ARM64)
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define SIMD_SCALAR 1
+#endif
+
+struct F32x4 {
+#if SIMD_SSE
+    __m128 v;
+#elif SIMD_NEON
+    float32x4_t v;
+#else
+    F32 v[4];
+#endif
+};
+
+FORCE_INLINE F32x4 f32x4_load(const F32* source) {
+    F32x4 r;
+#if SIMD_SSE
+    r.v = _mm_loadu_ps(source);
+#elif SIMD_NEON
+    r.v = vld1q_f32(source);
+#else
+    r.v[0] = source[0];
+    r.v[1] = source[1];
+    r.v[2] = source[2];
+    r.v[3] = source[3];
+#endif
+    return r;
+}
+
+FORCE_INLINE void f32x4_store(F32* dest, F32x4 a) {
+#if SIMD_SSE
+    _mm_storeu_ps(dest, a.v);
+#elif SIMD_NEON
+    vst1q_f32(dest, a.v);
+#else
+    dest[0] = a.v[0];
+    dest[1] = a.v[1];
+    dest[2] = a.v[2];
+    dest[3] = a.v[3];
+#endif
+}
+
+FORCE_INLINE F32x4 f32x4_set(F32 x, F32 y, F32 z, F32 w) {
+    F32x4 r;
+#if SIMD_SSE
+    r.v = _mm_setr_ps(x, y, z, w);
+#elif SIMD_NEON
+    F32 lanes[4] = {x, y, z, w};
+    r.v = vld1q_f32(lanes);
+#else
+    r.v[0] = x;
+    r.v[1] = y;
+    r.v[2] = z;
+    r.v[3] = w;
+#endif
+    return r;
+}
+
+FORCE_INLINE F32x4 f32x4_set1(F32 s) {
+    F32x4 r;
+#if SIMD_SSE
+    r.v = _mm_set1_ps(s);
+#elif SIMD_NEON
+    r.v = vdupq_n_f32(s);
+#else
+    r.v[0] = s;
+    r.v[1] = s;
+    r.v[2] = s;
+    r.v[3] = s;
+#endif
+    return r;
+}
+
+#if SIMD_SSE
+#define F32X4_BINARY_(name, sseOp, neonOp, op) \
+    FORCE_INLINE F32x4 name(F32x4 a, F32x4 b) { F32x4 r; r.v = sseOp(a.v, b.v); return r; }
+#elif SIMD_NEON
+#define F32X4_BINARY_(name, sseOp, neonOp, op) \
+    FORCE_INLINE F32x4 name(F32x4 a, F32x4 b) { F32x4 r; r.v = neonOp(a.v, b.v); return r; }
+#else
+#define F32X4_BINARY_(name, sseOp, neonOp, op) \
+    FORCE_INLINE F32x4 name(F32x4 a, F32x4 b) { \
+        F32x4 r; \
+        r.v[0] = a.v[0] op b.v[0]; \
+        r.v[1] = a.v[1] op b.v[1]; \
+        r.v[2] = a.v[2] op b.v[2]; \
+        r.v[3] = a.v[3] op b.v[3]; \
+        return r; \
+    }
+#endif
+
+F32X4_BINARY_(f32x4_add, _mm_add_ps, vaddq_f32, +)
+F32X4_BINARY_(f32x4_sub, _mm_sub_ps, vsubq_f32, -)
+F32X4_BINARY_(f32x4_mul, _mm_mul_ps, vmulq_f32, *)
+F32X4_BINARY_(f32x4_div, _mm_div_ps, vdivq_f32, /)
+
+// a * b + c as two rounded ops, the order scalar code would write.
+FORCE_INLINE F32x4 f32x4_madd(F32x4 a, F32x4 b, F32x4 c) {
+    return f32x4_add(f32x4_mul(a, b), c);
+}
+
+// Lanes picked by index from a: result[i] = a[li].
+template <U32 l0, U32 l1, U32 l2, U32 l3>
+FORCE_INLINE F32x4 f32x4_shuffle(F32x4 a) {
+    static_assert(l0 < 4u && l1 < 4u && l2 < 4u && l3 < 4u, "lane out of range");
+    F32x4 r;
+#if SIMD_SSE
+    r.v = _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(l3, l2, l1, l0));
+#elif SIMD_NEON
+    F32 lanes[4] = {vgetq_lane_f32(a.v, l0), vgetq_lane_f32(a.v, l1),
+                    vgetq_lane_f32(a.v, l2), vgetq_lane_f32(a.v, l3)};
+    r.v = vld1q_f32(lanes);
+#else
+    r.v[0] = a.v[l0];
+    r.v[1] = a.v[l1];
+    r.v[2] = a.v[l2];
+    r.v[3] = a.v[l3];
+#endif
+    return r;
+}
+
+template <U32 lane>
+FORCE_INLINE F32x4 f32x4_splat(F32x4 a) {
+#if SIMD_NEON
+    F32x4 r;
+    r.v = vdupq_laneq_f32(a.v, lane);
+    return r;
+#else
+    return f32x4_shuffle<lane, lane, lane, lane>(a);
+#endif
+}
+
+// Rows in, columns out.
+FORCE_INLINE void f32x4_transpose(F32x4* r0, F32x4* r1, F32x4* r2, F32x4* r3) {
+#if SIMD_SSE
+    _MM_TRANSPOSE4_PS(r0->v, r1->v, r2->v, r3->v);
+#elif SIMD_NEON
+    float32x4x2_t t01 = vtrnq_f32(r0->v, r1->v);
+    float32x4x2_t t23 = vtrnq_f32(r2->v, r3->v);
+    r0->v = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1->v = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2->v = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3->v = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#else
+    F32x4* rows[4] = {r0, r1, r2, r3};
+    for (U32 row = 0u; row < 4u; ++row) {
+        for (U32 col = row + 1u; col < 4u; ++col) {
+            F32 swap = rows[row]->v[col];
+            rows[row]->v[col] = rows[col]->v[row];
+            rows[col]->v[row] = swap;
+        }
+    }
+#endif
+}
+
+FORCE_INLINE F32x4 f32x4_min(F32x4 a, F32x4 b) {
+    F32x4 r;
+#if SIMD_SSE
+    r.v = _mm_min_ps(a.v, b.v);
+#elif SIMD_NEON
+    r.v = vminq_f32(a.v, b.v);
+#else
+    for (U32 lane = 0u; lane < 4u; ++lane) {
+        r.v[lane] = (a.v[lane] < b.v[lane]) ? a.v[lane] : b.v[lane];
+    }
+#endif
+    return r;
+}
+
+FORCE_INLINE F32x4 f32x4_max(F32x4 a, F32x4 b) {
+    F32x4 r;
+#if SIMD_SSE
+    r.v = _mm_max_ps(a.v, b.v);
+#elif SIMD_NEON
+    r.v = vmaxq_f32(a.v, b.v);
+#else
+    for (U32 lane = 0u; lane < 4u; ++lane) {
+        r.v[lane] = (a.v[lane] > b.v[lane]) ? a.v[lane] : b.v[lane];
+    }
+#endif
+    return r;
+}
+
+
+// ////////////////////////
+// Masks
+//
+// A lane is all ones (true) or all zeros. Comparisons are ordered: a NaN
+// lane compares false, as the scalar operator would.
+
+struct M32x4 {
+#if SIMD_SSE
+    __m128 v;
+#elif SIMD_NEON
+    uint32x4_t v;
+#else
+    U32 v[4];
+#endif
+};
+
+#if SIMD_SSE
+#define F32X4_COMPARE_(name, sseOp, neonOp, op) \
+    FORCE_INLINE M32x4 name(F32x4 a, F32x4 b) { M32x4 r; r.v = sseOp(a.v, b.v); return r; }
+#elif SIMD_NEON
+#define F32X4_COMPARE_(name, sseOp, neonOp, op) \
+    FORCE_INLINE M32x4 name(F32x4 a, F32x4 b) { M32x4 r; r.v = neonOp(a.v, b.v); return r; }
+#else
+#define F32X4_COMPARE_(name, sseOp, neonOp, op) \
+    FORCE_INLINE M32x4 name(F32x4 a, F32x4 b) { \
+        M32x4 r; \
+        for (U32 lane = 0u; lane < 4u; ++lane) { \
+            r.v[lane] = (a.v[lane] op b.v[lane]) ? 0xFFFFFFFFu : 0u; \
+        } \
+        return r; \
+    }
+#endif
+
+F32X4_COMPARE_(f32x4_lt, _mm_cmplt_ps, vcltq_f32, <)
+F32X4_COMPARE_(f32x4_le, _mm_cmple_ps, vcleq_f32, <=)
+F32X4_COMPARE_(f32x4_gt, _mm_cmpgt_ps, vcgtq_f32, >)
+F32X4_COMPARE_(f32x4_ge, _mm_cmpge_ps, vcgeq_f32, >=)
+
+FORCE_INLINE M32x4 m32x4_and(M32x4 a, M32x4 b) {
+    M32x4 r;
+#if SIMD_SSE
+    r.v = _mm_and_ps(a.v, b.v);
+#elif SIMD_NEON
+    r.v = vandq_u32(a.v, b.v);
+#else
+    for (U32 lane = 0u; lane < 4u; ++lane) {
+        r.v[lane] = a.v[lane] & b.v[lane];
+    }
+#endif
+    return r;
+}
+
+FORCE_INLINE M32x4 m32x4_or(M32x4 a, M32x4 b) {
+    M32x4 r;
+#if SIMD_SSE
+    r.v = _mm_or_ps(a.v, b.v);
+#elif SIMD_NEON
+    r.v = vorrq_u32(a.v, b.v);
+#else
+    for (U32 lane = 0u; lane < 4u; ++lane) {
+        r.v[lane] = a.v[lane] | b.v[lane];
+    }
+#endif
+    return r;
+}
+
+FORCE_INLINE M32x4 m32x4_not(M32x4 a) {
+    M32x4 r;
+#if SIMD_SSE
+    r.v = _mm_xor_ps(a.v, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+#elif SIMD_NEON
+    r.v = vmvnq_u32(a.v);
+#else
+    for (U32 lane = 0u; lane < 4u; ++lane) {
+        r.v[lane] = ~a.v[lane];
+    }
+#endif
+    return r;
+}
+
+// Lane i set in the mask -> bit i set.
+FORCE_INLINE U32 m32x4_bits(M32x4 a) {
+#if SIMD_SSE
+    return (U32)_mm_movemask_ps(a.v);
+#elif SIMD_NEON
+    static const U32 weights[4] = {1u, 2u, 4u, 8u};
+    return vaddvq_u32(vandq_u32(a.v, vld1q_u32(weights)));
+#else
+    return (a.v[0] & 1u) | ((a.v[1] & 1u) << 1u) | ((a.v[2] & 1u) << 2u) | ((a.v[3] & 1u) << 3u);
+#endif
+}
+
+// mask ? a : b, per lane.
+FORCE_INLINE F32x4 f32x4_select(M32x4 mask, F32x4 a, F32x4 b) {
+    F32x4 r;
+#if SIMD_SSE41
+    r.v = _mm_blendv_ps(b.v, a.v, mask.v);
+#elif SIMD_SSE
+    r.v = _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+#elif SIMD_NEON
+    r.v = vbslq_f32(mask.v, a.v, b.v);
+#else
+    for (U32 lane = 0u; lane < 4u; ++lane) {
+        r.v[lane] = mask.v[lane] ? a.v[lane] : b.v[lane];
+    }
+#endif
+    return r;
+}
+
+
+// ////////////////////////
+// F32x8
+//
+// Eight lanes: one AVX register, or two four-lane halves everywhere else,
+// so kernels written against F32x8 run on every backend.
+
+struct F32x8 {
+#if SIMD_AVX
+    __m256 v;
+#else
+    F32x4 lo;
+    F32x4 hi;
+#endif
+};
+
+struct M32x8 {
+#if SIMD_AVX
+    __m256 v;
+#else
+    M32x4 lo;
+    M32x4 hi;
+#endif
+};
+
+FORCE_INLINE F32x8 f32x8_load(const F32* source) {
+    F32x8 r;
+#if SIMD_AVX
+    r.v = _mm256_loadu_ps(source);
+#else
+    r.lo = f32x4_load(source);
+    r.hi = f32x4_load(source + 4);
+#endif
+    return r;
+}
+
+FORCE_INLINE void f32x8_store(F32* dest, F32x8 a) {
+#if SIMD_AVX
+    _mm256_storeu_ps(dest, a.v);
+#else
+    f32x4_store(dest, a.lo);
+    f32x4_store(dest + 4, a.hi);
+#endif
+}
+
+FORCE_INLINE F32x8 f32x8_set1(F32 s) {
+    F32x8 r;
+#if SIMD_AVX
+    r.v = _mm256_set1_ps(s);
+#else
+    r.lo = f32x4_set1(s);
+    r.hi = r.lo;
+#endif
+    return r;
+}
+
+#if SIMD_AVX
+#define F32X8_BINARY_(name, avxOp, halfOp, type) \
+    FORCE_INLINE type name(F32x8 a, F32x8 b) { type r; r.v = avxOp; return r; }
+#define M32X8_BINARY_(name, avxOp, halfOp) \
+    FORCE_INLINE M32x8 name(M32x8 a, M32x8 b) { M32x8 r; r.v = avxOp(a.v, b.v); return r; }
+#else
+#define F32X8_BINARY_(name, avxOp, halfOp, type) \
+    FORCE_INLINE type name(F32x8 a, F32x8 b) { \
+        type r; \
+        r.lo = halfOp(a.lo, b.lo); \
+        r.hi = halfOp(a.hi, b.hi); \
+        return r; \
+    }
+#define M32X8_BINARY_(name, avxOp, halfOp) \
+    FORCE_INLINE M32x8 name(M32x8 a, M32x8 b) { \
+        M32x8 r; \
+        r.lo = halfOp(a.lo, b.lo); \
+        r.hi = halfOp(a.hi, b.hi); \
+        return r; \
+    }
+#endif
+
+F32X8_BINARY_(f32x8_add, _mm256_add_ps(a.v, b.v), f32x4_add, F32x8)
+F32X8_BINARY_(f32x8_sub, _mm256_sub_ps(a.v, b.v), f32x4_sub, F32x8)
+F32X8_BINARY_(f32x8_mul, _mm256_mul_ps(a.v, b.v), f32x4_mul, F32x8)
+F32X8_BINARY_(f32x8_div, _mm256_div_ps(a.v, b.v), f32x4_div, F32x8)
+F32X8_BINARY_(f32x8_min, _mm256_min_ps(a.v, b.v), f32x4_min, F32x8)
+F32X8_BINARY_(f32x8_max, _mm256_max_ps(a.v, b.v), f32x4_max, F32x8)
+F32X8_BINARY_(f32x8_lt, _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ), f32x4_lt, M32x8)
+F32X8_BINARY_(f32x8_le, _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ), f32x4_le, M32x8)
+F32X8_BINARY_(f32x8_gt, _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ), f32x4_gt, M32x8)
+F32X8_BINARY_(f32x8_ge, _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ), f32x4_ge, M32x8)
+M32X8_BINARY_(m32x8_and, _mm256_and_ps, m32x4_and)
+M32X8_BINARY_(m32x8_or, _mm256_or_ps, m32x4_or)
+
+FORCE_INLINE F32x8 f32x8_madd(F32x8 a, F32x8 b, F32x8 c) {
+    return f32x8_add(f32x8_mul(a, b), c);
+}
+
+FORCE_INLINE M32x8 m32x8_not(M32x8 a) {
+    M32x8 r;
+#if SIMD_AVX
+    r.v = _mm256_xor_ps(a.v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+#else
+    r.lo = m32x4_not(a.lo);
+    r.hi = m32x4_not(a.hi);
+#endif
+    return r;
+}
+
+FORCE_INLINE U32 m32x8_bits(M32x8 a) {
+#if SIMD_AVX
+    return (U32)_mm256_movemask_ps(a.v);
+#else
+    return m32x4_bits(a.lo) | (m32x4_bits(a.hi) << 4u);
+#endif
+}
+
+FORCE_INLINE F32x8 f32x8_select(M32x8 mask, F32x8 a, F32x8 b) {
+    F32x8 r;
+#if SIMD_AVX
+    r.v = _mm256_blendv_ps(b.v, a.v, mask.v);
+#else
+    r.lo = f32x4_select(mask.lo, a.lo, b.lo);
+    r.hi = f32x4_select(mask.hi, a.hi, b.hi);
+#endif
+    return r;
+}
@@ -2,58 +2,113 @@
 // Created by André Leite on 17/02/2026.
 //
 
-static B32 slot_map_grow_(SlotMap* map) {
-    ASSERT_ALWAYS(map != 0);
-    ASSERT_ALWAYS(map->arena != 0);
-    ASSERT_ALWAYS(map->itemSize > 0u);
+// Every per-slot array (items, bookkeeping, dense list, columns) grows the
+// same way, so grow / destroy walk them as one list.
+#define SLOT_MAP_MAX_ARRAYS (6u + SLOT_MAP_MAX_COLUMNS)
+
+struct SlotMapArray_ {
+    U8** data;
+    U64 elementSize;
+};
+
+static U32 slot_map_arrays_(SlotMap* map, SlotMapArray_* out) {
+    U32 count = 0u;
+    out[count++] = {&map->items, map->itemSize};
+    out[count++] = {(U8**)&map->generations, sizeof(U32)};
+    out[count++] = {(U8**)&map->freeNext, sizeof(U32)};
+    out[count++] = {&map->occupied, sizeof(U8)};
+    out[count++] = {(U8**)&map->dense, sizeof(U32)};
+    out[count++] = {(U8**)&map->denseIndex, sizeof(U32)};
+    for (U32 column = 0u; column < map->columnCount; ++column) {
+        out[count++] = {&map->columns[column], map->columnSizes[column]};
+    }
+    return count;
+}
 
-    U32 oldCapacity = map->capacity;
-    U32 newCapacity = (oldCapacity == 0u) ? 64u : (oldCapacity * 2u);
-    if (newCapacity < 64u) {
-        newCapacity = 64u;
+// Reserved maps give every array its own maxCapacity-sized reservation and
+// commit it page by page; fresh pages come back zeroed.
+static B32 slot_map_reserve_array_(U8** data, U64 elementSize, U32 maxCapacity) {
+    U64 pageSize = OS_get_system_info()->pageSize;
+    *data = (U8*)OS_reserve(align_pow2((U64)maxCapacity * elementSize, pageSize));
+    return *data != 0;
+}
+
+static void slot_map_release_array_(U8* data, U64 elementSize, U32 maxCapacity) {
+    if (data) {
+        U64 pageSize = OS_get_system_info()->pageSize;
+        OS_release(data, align_pow2((U64)maxCapacity * elementSize, pageSize));
     }
+}
 
-    U64 itemBytes = (U64)newCapacity * (U64)map->itemSize;
-    U8* newItems = (U8*)arena_push(map->arena, itemBytes, 8);
-    U32* newGenerations = ARENA_PUSH_ARRAY(map->arena, U32, newCapacity);
-    U32* newFreeNext = ARENA_PUSH_ARRAY(map->arena, U32, newCapacity);
-    U8* newOccupied = ARENA_PUSH_ARRAY(map->arena, U8, newCapacity);
+// Commits [oldCount, newCount) elements of one reserved array, rounded out to
+// whole pages. Pages already committed for oldCount are skipped.
+static B32 slot_map_commit_range_(U8* data, U64 elementSize, U32 oldCount, U32 newCount) {
+    U64 pageSize = OS_get_system_info()->pageSize;
+    U64 oldEnd = align_pow2((U64)oldCount * elementSize, pageSize);
+    U64 newEnd = align_pow2((U64)newCount * elementSize, pageSize);
+    if (newEnd <= oldEnd) {
+        return 1;
+    }
+    return OS_commit(data + oldEnd, newEnd - oldEnd);
+}
 
-    if (!newItems || !newGenerations || !newFreeNext || !newOccupied) {
+// Arena maps push a fresh copy of every array; the old ones stay in the
+// arena until it is released.
+static B32 slot_map_grow_arena_array_(SlotMap* map, SlotMapArray_ array, U32 oldCapacity, U32 newCapacity) {
+    U64 newBytes = (U64)newCapacity * array.elementSize;
+    U8* grown = (U8*)arena_push(map->arena, newBytes, 8);
+    if (!grown) {
         return 0;
     }
+    U64 oldBytes = (U64)oldCapacity * array.elementSize;
+    if (oldBytes > 0u) {
+        MEMCPY(grown, *array.data, oldBytes);
+    }
+    MEMSET(grown + oldBytes, 0, newBytes - oldBytes);
+    *array.data = grown;
+    return 1;
+}
 
-    MEMSET(newItems, 0, itemBytes);
-    MEMSET(newGenerations, 0, sizeof(U32) * newCapacity);
-    MEMSET(newFreeNext, 0, sizeof(U32) * newCapacity);
-    MEMSET(newOccupied, 0, sizeof(U8) * newCapacity);
-
-    if (oldCapacity > 0u) {
-        MEMCPY(newItems, map->items, (U64)oldCapacity * (U64)map->itemSize);
-        MEMCPY(newGenerations, map->generations, sizeof(U32) * oldCapacity);
-        MEMCPY(newFreeNext, map->freeNext, sizeof(U32) * oldCapacity);
-        MEMCPY(newOccupied, map->occupied, sizeof(U8) * oldCapacity);
+static B32 slot_map_grow_to_(SlotMap* map, U32 newCapacity) {
+    U32 oldCapacity = map->capacity;
+    SlotMapArray_ arrays[SLOT_MAP_MAX_ARRAYS];
+    U32 arrayCount = slot_map_arrays_(map, arrays);
+    for (U32 at = 0u; at < arrayCount; ++at) {
+        B32 ok = map->arena ? slot_map_grow_arena_array_(map, arrays[at], oldCapacity, newCapacity)
+                            : slot_map_commit_range_(*arrays[at].data, arrays[at].elementSize, oldCapacity, newCapacity);
+        if (!ok) {
+            return 0;
+        }
     }
 
     U32 oldFreeHead = map->freeHead;
-    U32 firstNewIndex = oldCapacity;
-    U32 lastNewIndex = (newCapacity > 0u) ? (newCapacity - 1u) : SLOT_MAP_INVALID_INDEX;
-
     for (U32 i = oldCapacity; i < newCapacity; ++i) {
-        U32 next = (i + 1u < newCapacity) ? (i + 1u) : oldFreeHead;
-        newFreeNext[i] = next;
+        map->freeNext[i] = (i + 1u < newCapacity) ? (i + 1u) : oldFreeHead;
     }
-
-    map->items = newItems;
-    map->generations = newGenerations;
-    map->freeNext = newFreeNext;
-    map->occupied = newOccupied;
     map->capacity = newCapacity;
-    map->freeHead = (firstNewIndex <= lastNewIndex) ? firstNewIndex : oldFreeHead;
-
+    map->freeHead = (oldCapacity < newCapacity) ? oldCapacity : oldFreeHead;
     return 1;
 }
 
+static B32 slot_map_grow_(SlotMap* map) {
+    ASSERT_ALWAYS(map != 0);
+    ASSERT_ALWAYS(map->itemSize > 0u);
+
+    if (!map->arena) {
+        if (map->capacity >= map->maxCapacity) {
+            return 0;
+        }
+        U32 newCapacity = (map->capacity > map->maxCapacity / 2u) ? map->maxCapacity : map->capacity * 2u;
+        return slot_map_grow_to_(map, newCapacity);
+    }
+
+    U32 newCapacity = (map->capacity == 0u) ? 64u : (map->capacity * 2u);
+    if (newCapacity < 64u) {
+        newCapacity = 64u;
+    }
+    return slot_map_grow_to_(map, newCapacity);
+}
+
 B32 slot_map_init(SlotMap* map, Arena* arena, U32 itemSize, U32 initialCapacity) {
     if (!map || !arena || itemSize == 0u) {
         return 0;
@@ -67,33 +122,84 @@ B32 slot_map_init(SlotMap* map, Arena* arena, U32 itemSize, U32 initialCapacity)
     if (initialCapacity == 0u) {
         initialCapacity = 64u;
     }
-
-    map->capacity = initialCapacity;
-
-    U64 itemBytes = (U64)initialCapacity * (U64)itemSize;
-    map->items = (U8*)arena_push(arena, itemBytes, 8);
-    map->generations = ARENA_PUSH_ARRAY(arena, U32, initialCapacity);
-    map->freeNext = ARENA_PUSH_ARRAY(arena, U32, initialCapacity);
-    map->occupied = ARENA_PUSH_ARRAY(arena, U8, initialCapacity);
-
-    if (!map->items || !map->generations || !map->freeNext || !map->occupied) {
+    if (!slot_map_grow_to_(map, initialCapacity)) {
         MEMSET(map, 0, sizeof(*map));
         return 0;
     }
+    return 1;
+}
+
+B32 slot_map_init_reserved(SlotMap* map, U32 itemSize, U32 initialCapacity, U32 maxCapacity) {
+    if (!map || itemSize == 0u || maxCapacity == 0u) {
+        return 0;
+    }
 
-    MEMSET(map->items, 0, itemBytes);
-    MEMSET(map->generations, 0, sizeof(U32) * initialCapacity);
-    MEMSET(map->freeNext, 0, sizeof(U32) * initialCapacity);
-    MEMSET(map->occupied, 0, sizeof(U8) * initialCapacity);
+    MEMSET(map, 0, sizeof(*map));
+    map->itemSize = itemSize;
+    map->maxCapacity = maxCapacity;
+    map->freeHead = SLOT_MAP_INVALID_INDEX;
 
-    for (U32 i = 0; i < initialCapacity; ++i) {
-        map->freeNext[i] = (i + 1u < initialCapacity) ? (i + 1u) : SLOT_MAP_INVALID_INDEX;
+    SlotMapArray_ arrays[SLOT_MAP_MAX_ARRAYS];
+    U32 arrayCount = slot_map_arrays_(map, arrays);
+    for (U32 at = 0u; at < arrayCount; ++at) {
+        if (!slot_map_reserve_array_(arrays[at].data, arrays[at].elementSize, maxCapacity)) {
+            slot_map_destroy(map);
+            return 0;
+        }
     }
-    map->freeHead = 0u;
 
+    if (initialCapacity == 0u) {
+        initialCapacity = 64u;
+    }
+    if (!slot_map_grow_to_(map, MIN(initialCapacity, maxCapacity))) {
+        slot_map_destroy(map);
+        return 0;
+    }
     return 1;
 }
 
+// Arena maps live and die with their arena; this only forgets them.
+void slot_map_destroy(SlotMap* map) {
+    if (!map) {
+        return;
+    }
+    if (!map->arena) {
+        SlotMapArray_ arrays[SLOT_MAP_MAX_ARRAYS];
+        U32 arrayCount = slot_map_arrays_(map, arrays);
+        for (U32 at = 0u; at < arrayCount; ++at) {
+            slot_map_release_array_(*arrays[at].data, arrays[at].elementSize, map->maxCapacity);
+        }
+    }
+    MEMSET(map, 0, sizeof(*map));
+}
+
+U32 slot_map_add_column(SlotMap* map, U32 elementSize) {
+    if (!map || elementSize == 0u || map->columnCount >= SLOT_MAP_MAX_COLUMNS || map->capacity == 0u) {
+        return SLOT_MAP_INVALID_INDEX;
+    }
+    ASSERT_DEBUG(map->count == 0u && "columns are added before the first alloc");
+
+    U32 column = map->columnCount;
+    SlotMapArray_ array = {&map->columns[column], elementSize};
+    B32 ok = 0;
+    if (map->arena) {
+        ok = slot_map_grow_arena_array_(map, array, 0u, map->capacity);
+    } else {
+        ok = slot_map_reserve_array_(array.data, elementSize, map->maxCapacity);
+        if (ok && !slot_map_commit_range_(*array.data, elementSize, 0u, map->capacity)) {
+            slot_map_release_array_(*array.data, elementSize, map->maxCapacity);
+            *array.data = 0;
+            ok = 0;
+        }
+    }
+    if (!ok) {
+        return SLOT_MAP_INVALID_INDEX;
+    }
+    map->columnSizes[column] = elementSize;
+    map->columnCount += 1u;
+    return column;
+}
+
 B32 slot_map_alloc(SlotMap* map, void** outItem, U32* outSlotIndex, U32* outGeneration) {
     if (!map || !outItem || !outSlotIndex || !outGeneration) {
         return 0;
@@ -114,6 +220,12 @@ B32 slot_map_alloc(SlotMap* map, void** outItem, U32* outSlotIndex, U32* outGene
         map->generations[slotIndex] = 1u;
     }
 
+    U32 denseAt = map->count;
+    map->dense[denseAt] = slotIndex;
+    map->denseIndex[slotIndex] = denseAt;
+    for (U32 column = 0u; column < map->columnCount; ++column) {
+        MEMSET(map->columns[column] + (U64)denseAt * map->columnSizes[column], 0, map->columnSizes[column]);
+    }
     map->count += 1u;
 
     U8* item = map->items + ((U64)slotIndex * (U64)map->itemSize);
@@ -151,9 +263,19 @@ B32 slot_map_release(SlotMap* map, U32 slotIndex, U32 generation, void** outItem
     }
     map->generations[slotIndex] = nextGeneration;
 
-    if (map->count > 0u) {
-        map->count -= 1u;
+    // Swap-remove: the last dense entry (and its column values) fills the hole.
+    U32 denseAt = map->denseIndex[slotIndex];
+    U32 lastAt = map->count - 1u;
+    if (denseAt != lastAt) {
+        U32 movedSlot = map->dense[lastAt];
+        map->dense[denseAt] = movedSlot;
+        map->denseIndex[movedSlot] = denseAt;
+        for (U32 column = 0u; column < map->columnCount; ++column) {
+            U64 size = map->columnSizes[column];
+            MEMCPY(map->columns[column] + (U64)denseAt * size, map->columns[column] + (U64)lastAt * size, size);
+        }
     }
+    map->count -= 1u;
 
     return 1;
 }
@@ -216,3 +338,10 @@ const void* slot_map_item_at_const(const SlotMap* map, U32 slotIndex) {
     }
     return map->items + ((U64)slotIndex * (U64)map->itemSize);
 }
+
+void* slot_map_column_at(SlotMap* map, U32 column, U32 slotIndex) {
+    if (!map || column >= map->columnCount || slotIndex >= map->capacity || !map->occupied[slotIndex]) {
+        return 0;
+    }
+    return map->columns[column] + (U64)map->denseIndex[slotIndex] * map->columnSizes[column];
+}
@@ -6,8 +6,25 @@
 
 static const U32 SLOT_MAP_INVALID_INDEX = 0xFFFFFFFFu;
 
+// Two storage modes. Arena maps (slot_map_init) double by pushing new
+// arrays and copying, so item pointers die on every grow. Reserved maps
+// (slot_map_init_reserved) reserve address space for maxCapacity slots up
+// front and commit pages as they grow: items never move, a grow costs only
+// the newly committed pages, and slot_map_destroy hands everything back.
+//
+// Live slots are also kept packed in dense[0, count), swap-removed on
+// release, so walking the map costs count rather than capacity:
+//
+//     for (U32 at = 0u; at < map.count; ++at) { U32 slot = map.dense[at]; ... }
+//
+// Releasing dense[at] moves the last entry into at, so loops that release
+// walk backwards. Columns are optional per-slot fields stored in dense
+// order (SoA): a scan over one hot field streams a single array instead of
+// striding through whole items. Items stay where they are.
+#define SLOT_MAP_MAX_COLUMNS 4u
+
 struct SlotMap {
-    Arena* arena;
+    Arena* arena; // 0 for reserved maps
     U8* items;
     U32 itemSize;
     U32 capacity;
@@ -16,9 +33,21 @@ struct SlotMap {
     U32* freeNext;
     U8* occupied;
     U32 freeHead;
+    U32 maxCapacity; // reserved maps only
+    U32* dense;      // [count] live slot indices
+    U32* denseIndex; // [capacity] slot -> position in dense, live slots only
+    U8* columns[SLOT_MAP_MAX_COLUMNS];
+    U32 columnSizes[SLOT_MAP_MAX_COLUMNS];
+    U32 columnCount;
 };
 
 UTILITIES_SHARED_API B32 slot_map_init(SlotMap* map, Arena* arena, U32 itemSize, U32 initialCapacity);
+UTILITIES_SHARED_API B32 slot_map_init_reserved(SlotMap* map, U32 itemSize, U32 initialCapacity, U32 maxCapacity);
+UTILITIES_SHARED_API void slot_map_destroy(SlotMap* map);
+// Adds a zero-initialized column of elementSize bytes per slot; call right
+// after init, before the first alloc. Returns the column index, or
+// SLOT_MAP_INVALID_INDEX.
+UTILITIES_SHARED_API U32 slot_map_add_column(SlotMap* map, U32 elementSize);
 UTILITIES_SHARED_API B32 slot_map_alloc(SlotMap* map, void** outItem, U32* outSlotIndex, U32* outGeneration);
 UTILITIES_SHARED_API B32 slot_map_release(SlotMap* map, U32 slotIndex, U32 generation, void** outItem);
 UTILITIES_SHARED_API void* slot_map_get(SlotMap* map, U32 slotIndex, U32 generation);
@@ -26,3 +55,8 @@ UTILITIES_SHARED_API void slot_map_clear(SlotMap* map);
 UTILITIES_SHARED_API B32 slot_map_is_occupied(const SlotMap* map, U32 slotIndex);
 UTILITIES_SHARED_API void* slot_map_item_at(SlotMap* map, U32 slotIndex);
 UTILITIES_SHARED_API const void* slot_map_item_at_const(const SlotMap* map, U32 slotIndex);
+// Column element of a live slot, or 0.
+UTILITIES_SHARED_API void* slot_map_column_at(SlotMap* map, U32 column, U32 slotIndex);
+
+// Whole column in dense order; element at matches map->dense[at].
+#define SLOT_MAP_COLUMN(map, T, column) ((T*)(map)->columns[(column)])
@@ -2,10 +2,11 @@
 // Created by André Leite on 02/09/2025.
 //
 
-// Bounded work-stealing deque implementation (Chase-Lev).
-// References: Chase & Lev (SPAA'05).
+// Growable work-stealing deque implementation (Chase-Lev).
+// References: Chase & Lev (SPAA'05); Lê et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models" (PPoPP'13).
 
-#define WSDQ_SLOT(dq, index) ((dq)->buffer + (((index) & (dq)->mask) * (dq)->elementSize))
+#define WSDQ_SLOT(dq, buf, index) ((buf)->slots + (((index) & (buf)->mask) * (dq)->elementSize))
 
 static
 WSDeque* wsdq_create(Arena* arena, U64 capacity, U64 elementSize) {
@@ -14,39 +15,151 @@ WSDeque* wsdq_create(Arena* arena, U64 capacity, U64 elementSize) {
 
     WSDeque* dq = (WSDeque*) arena_push(arena, sizeof(WSDeque), CACHE_LINE_SIZE);
     ASSERT_DEBUG(dq);
+    MEMSET(dq, 0, sizeof(WSDeque));
 
-    dq->capacity = capacity;
-    dq->mask = capacity - 1u;
-    dq->elementSize = elementSize;
-    dq->buffer = (U8*) arena_push(arena, capacity * elementSize, CACHE_LINE_SIZE);
-    ASSERT_DEBUG(dq->buffer);
-
-    MEMSET(dq->buffer, 0, capacity * elementSize);
+    WSDequeBuffer* buffer = ARENA_PUSH_STRUCT(arena, WSDequeBuffer);
+    ASSERT_DEBUG(buffer);
+    MEMSET(buffer, 0, sizeof(WSDequeBuffer));
+    buffer->capacity = capacity;
+    buffer->mask = capacity - 1u;
+    buffer->slots = (U8*) arena_push(arena, capacity * elementSize, CACHE_LINE_SIZE);
+    ASSERT_DEBUG(buffer->slots);
+    MEMSET(buffer->slots, 0, capacity * elementSize);
 
+    dq->elementSize = elementSize;
+    dq->retired = 0;
+    ATOMIC_STORE(&dq->buffer, buffer, MEMORY_ORDER_RELAXED);
     ATOMIC_STORE(&dq->bottom, 0u, MEMORY_ORDER_RELAXED);
     ATOMIC_STORE(&dq->top, 0u, MEMORY_ORDER_RELAXED);
+    ATOMIC_STORE(&dq->thieves, 0u, MEMORY_ORDER_RELAXED);
     return dq;
 }
 
+static void wsdq_release_buffer_(WSDequeBuffer* buffer) {
+    if (buffer->arena) {
+        arena_release(buffer->arena); // the header lives in it too
+    }
+}
+
+// Owner only. Retired rings are freed once no steal is in flight: thieves
+// announce themselves before loading the buffer pointer, and with the
+// announce, the swap and this check all sequentially consistent, seeing
+// zero thieves means every later thief loads the current ring.
+static void wsdq_reclaim_(WSDeque* dq) {
+    if (LIKELY(dq->retired == 0)) {
+        return;
+    }
+    if (ATOMIC_LOAD(&dq->thieves, MEMORY_ORDER_SEQ_CST) != 0u) {
+        return;
+    }
+    WSDequeBuffer* buffer = dq->retired;
+    dq->retired = 0;
+    while (buffer) {
+        WSDequeBuffer* next = buffer->retiredNext;
+        wsdq_release_buffer_(buffer);
+        buffer = next;
+    }
+}
+
+// Owner only. Doubles the ring until required elements fit and copies the
+// live range [t, b) to the same logical indices. The old ring is never
+// written again, so a thief still reading it sees intact slots, and its
+// CAS on top decides whether the copy it made counts.
+static B32 wsdq_grow_(WSDeque* dq, U64 b, U64 t, U64 required) {
+    WSDequeBuffer* old = ATOMIC_LOAD(&dq->buffer, MEMORY_ORDER_RELAXED);
+    U64 capacity = old->capacity * 2u;
+    while (capacity < required) {
+        capacity *= 2u;
+    }
+    U64 bytes = capacity * dq->elementSize;
+    U64 arenaSize = bytes + sizeof(WSDequeBuffer) + KB(64);
+    Arena* arena = arena_alloc(.arenaSize = arenaSize, .committedSize = arenaSize, .flags = ArenaFlags_None);
+    if (!arena) {
+        return 0;
+    }
+    WSDequeBuffer* grown = ARENA_PUSH_STRUCT(arena, WSDequeBuffer);
+    U8* slots = grown ? (U8*) arena_push(arena, bytes, CACHE_LINE_SIZE) : 0;
+    if (!slots) {
+        arena_release(arena);
+        return 0;
+    }
+    grown->capacity = capacity;
+    grown->mask = capacity - 1u;
+    grown->arena = arena;
+    grown->retiredNext = 0;
+    grown->slots = slots;
+
+    for (U64 index = t; index < b; ++index) {
+        MEMCPY(WSDQ_SLOT(dq, grown, index), WSDQ_SLOT(dq, old, index), dq->elementSize);
+    }
+    ATOMIC_STORE(&dq->buffer, grown, MEMORY_ORDER_SEQ_CST);
+
+    old->retiredNext = dq->retired;
+    dq->retired = old;
+    return 1;
+}
+
+static
+void wsdq_release(WSDeque* dq) {
+    if (!dq) {
+        return;
+    }
+    ASSERT_DEBUG(ATOMIC_LOAD(&dq->thieves, MEMORY_ORDER_ACQUIRE) == 0u);
+    wsdq_reclaim_(dq);
+    wsdq_release_buffer_(ATOMIC_LOAD(&dq->buffer, MEMORY_ORDER_RELAXED));
+    ATOMIC_STORE(&dq->buffer, (WSDequeBuffer*) 0, MEMORY_ORDER_RELAXED);
+}
+
 static
 B32 wsdq_push(WSDeque* dq, const void* value) {
     ASSERT_DEBUG(dq);
     ASSERT_DEBUG(value != nullptr);
+    wsdq_reclaim_(dq);
 
     U64 b = ATOMIC_LOAD(&dq->bottom, MEMORY_ORDER_RELAXED);
     U64 t = ATOMIC_LOAD(&dq->top, MEMORY_ORDER_ACQUIRE);
+    WSDequeBuffer* buffer = ATOMIC_LOAD(&dq->buffer, MEMORY_ORDER_RELAXED);
 
-    if ((b - t) >= dq->capacity) {
-        ASSERT_DEBUG(false && "WSDeque overflow");
-        return 0;
+    if (UNLIKELY((b - t) >= buffer->capacity)) {
+        if (!wsdq_grow_(dq, b, t, (b - t) + 1u)) {
+            return 0;
+        }
+        buffer = ATOMIC_LOAD(&dq->buffer, MEMORY_ORDER_RELAXED);
     }
 
-    U8* slot = WSDQ_SLOT(dq, b);
+    U8* slot = WSDQ_SLOT(dq, buffer, b);
     MEMCPY(slot, value, dq->elementSize);
     ATOMIC_STORE(&dq->bottom, b + 1u, MEMORY_ORDER_RELEASE);
     return 1;
 }
 
+// All-or-nothing: copies every slot first, then publishes the whole run
+// to thieves with a single release store of bottom.
+static
+B32 wsdq_push_many(WSDeque* dq, const void* values, U64 count) {
+    ASSERT_DEBUG(dq);
+    ASSERT_DEBUG(values != nullptr || count == 0u);
+    wsdq_reclaim_(dq);
+
+    U64 b = ATOMIC_LOAD(&dq->bottom, MEMORY_ORDER_RELAXED);
+    U64 t = ATOMIC_LOAD(&dq->top, MEMORY_ORDER_ACQUIRE);
+    WSDequeBuffer* buffer = ATOMIC_LOAD(&dq->buffer, MEMORY_ORDER_RELAXED);
+
+    if (UNLIKELY((b - t) + count > buffer->capacity)) {
+        if (!wsdq_grow_(dq, b, t, (b - t) + count)) {
+            return 0;
+        }
+        buffer = ATOMIC_LOAD(&dq->buffer, MEMORY_ORDER_RELAXED);
+    }
+
+    const U8* src = (const U8*) values;
+    for (U64 i = 0; i < count; ++i) {
+        MEMCPY(WSDQ_SLOT(dq, buffer, b + i), src + i * dq->elementSize, dq->elementSize);
+    }
+    ATOMIC_STORE(&dq->bottom, b + count, MEMORY_ORDER_RELEASE);
+    return 1;
+}
+
 static
 B32 wsdq_pop(WSDeque* dq, void* out_value) {
     ASSERT_DEBUG(dq);
@@ -64,7 +177,8 @@ B32 wsdq_pop(WSDeque* dq, void* out_value) {
     t = ATOMIC_LOAD(&dq->top, MEMORY_ORDER_RELAXED);
 
     if (t <= b) {
-        U8* slot = WSDQ_SLOT(dq, b);
+        WSDequeBuffer* buffer = ATOMIC_LOAD(&dq->buffer, MEMORY_ORDER_RELAXED);
+        U8* slot = WSDQ_SLOT(dq, buffer, b);
         MEMCPY(out_value, slot, dq->elementSize);
 
         if (t == b) {
@@ -93,11 +207,17 @@ B32 wsdq_steal(WSDeque* dq, void* out_value) {
     ASSERT_DEBUG(dq);
     ASSERT_DEBUG(out_value);
 
+    ATOMIC_FETCH_ADD(&dq->thieves, 1u, MEMORY_ORDER_SEQ_CST);
     U64 t = ATOMIC_LOAD(&dq->top, MEMORY_ORDER_ACQUIRE);
+    ATOMIC_THREAD_FENCE(MEMORY_ORDER_SEQ_CST);
     U64 b = ATOMIC_LOAD(&dq->bottom, MEMORY_ORDER_ACQUIRE);
 
+    B32 stolen = 0;
     if (t < b) {
-        U8* slot = WSDQ_SLOT(dq, t);
+        // Copy before claiming: once top moves past t the owner may reuse
+        // the slot, so a copy taken after the CAS could be a newer job.
+        WSDequeBuffer* buffer = ATOMIC_LOAD(&dq->buffer, MEMORY_ORDER_SEQ_CST);
+        MEMCPY(out_value, WSDQ_SLOT(dq, buffer, t), dq->elementSize);
         U64 expected = t;
         if (ATOMIC_COMPARE_EXCHANGE(&dq->top,
                                     &expected,
@@ -105,12 +225,12 @@ B32 wsdq_steal(WSDeque* dq, void* out_value) {
                                     false,
                                     MEMORY_ORDER_SEQ_CST,
                                     MEMORY_ORDER_RELAXED)) {
-            MEMCPY(out_value, slot, dq->elementSize);
-            return 1;
+            stolen = 1;
         }
     }
+    ATOMIC_FETCH_SUB(&dq->thieves, 1u, MEMORY_ORDER_RELEASE);
 
-    return 0;
+    return stolen;
 }
 
 static
@@ -121,3 +241,7 @@ S64 wsdq_count_approx(const WSDeque* dq) {
     return (S64) cnt;
 }
 
+static
+U64 wsdq_capacity(const WSDeque* dq) {
+    return ATOMIC_LOAD(&dq->buffer, MEMORY_ORDER_RELAXED)->capacity;
+}
@@ -3,22 +3,36 @@
 //
 
 // Work-stealing deque (single-owner bottom, multi-thief top)
-// Bounded, power-of-two capacity. Non-blocking try-ops.
+// Power-of-two ring that the owner grows on overflow. Non-blocking try-ops.
 
 #pragma once
 
+// Ring storage. The first buffer is carved from the creation arena; grown
+// ones live in their own arena so they can be released once retired.
+struct WSDequeBuffer {
+    U64 capacity;               // power of two
+    U64 mask;                   // capacity - 1
+    Arena* arena;               // null for the creation buffer
+    WSDequeBuffer* retiredNext; // owner-only list of replaced buffers
+    U8* slots;
+};
+
 struct alignas(CACHE_LINE_SIZE) WSDeque {
-    U64 capacity;                           // power of two
-    U64 mask;                               // capacity - 1
-    U64 elementSize;                        // size in bytes of each slot
-    alignas(CACHE_LINE_SIZE) U8* buffer;    // ring buffer of raw bytes
-    alignas(CACHE_LINE_SIZE) U64 bottom;    // owner index (only owner mutates)
-    alignas(CACHE_LINE_SIZE) U64 top;       // thieves CAS on this
+    U64 elementSize;                              // size in bytes of each slot
+    WSDequeBuffer* retired;                       // replaced buffers thieves may still read
+    alignas(CACHE_LINE_SIZE) WSDequeBuffer* buffer; // swapped by the owner on growth
+    alignas(CACHE_LINE_SIZE) U64 bottom;          // owner index (only owner mutates)
+    alignas(CACHE_LINE_SIZE) U64 top;             // thieves CAS on this
+    alignas(CACHE_LINE_SIZE) U64 thieves;         // steals in flight, gates buffer reclaim
 };
 
 static WSDeque* wsdq_create(Arena* arena, U64 capacity, U64 elementSize);
+// Releases grown buffers; the deque itself lives in the creation arena.
+static void wsdq_release(WSDeque* dq);
+// Pushes fail only when a grown buffer cannot be allocated.
 static B32 wsdq_push(WSDeque* dq, const void* value);
+static B32 wsdq_push_many(WSDeque* dq, const void* values, U64 count);
 static B32 wsdq_pop(WSDeque* dq, void* out_value);
 static B32 wsdq_steal(WSDeque* dq, void* out_value);
 static S64 wsdq_count_approx(const WSDeque* dq);
-
+static U64 wsdq_capacity(const WSDeque* dq);
@@ -27,7 +27,9 @@ static void barrier_wait(Barrier barrier) {
 thread_local ThreadContext* g_threadContext = nullptr;
 
 ThreadContext* thread_context_alloc() {
-    Arena* arena = arena_alloc(.debugName = "scratch");
+    // Scratch keeps 1 MB committed; anything above that is returned once a
+    // spike has not recurred for a second.
+    Arena* arena = arena_alloc(.debugName = "scratch", .decommitKeepSize = MB(1));
     g_threadContext = ARENA_PUSH_STRUCT(arena, ThreadContext);
     {
         ScratchArenas* scratch = ARENA_PUSH_STRUCT(arena, ScratchArenas);
@@ -35,7 +37,7 @@ ThreadContext* thread_context_alloc() {
 
         scratch->slots[0] = arena;
         for (U32 i = 1; i < SCRATCH_TLS_ARENA_COUNT; ++i) {
-            scratch->slots[i] = arena_alloc(.debugName = "scratch");
+            scratch->slots[i] = arena_alloc(.debugName = "scratch", .decommitKeepSize = MB(1));
         }
         scratch->nextIndex = 0;
         scratch->initialized = true;
@@ -52,6 +54,7 @@ void thread_context_release() {
         ASSERT_DEBUG(false && "Trying to destroy null g_threadContext");
         return;
     }
+    pool_thread_cache_flush();
     ScratchArenas* scratch = g_threadContext->arenas;
     for (S32 i = SCRATCH_TLS_ARENA_COUNT - 1; i >= 0 ; i--) { // Inverse order since the first arena holds the actual struct
         if (scratch->slots[i]) {
@@ -283,6 +286,17 @@ SPMDGroup* spmd_dispatch_(JobSystem* jobSystem, Arena* arena, const SPMDDispatch
 #endif
     }
 
+    Job* laneJobs = ARENA_PUSH_ARRAY(arena, Job, laneCount);
+    ASSERT_DEBUG(laneJobs != nullptr);
+    if (!laneJobs) {
+#ifdef NDEBUG
+        LOG_ERROR("spmd_dispatch", "Failed to allocate lane job array.");
+        return nullptr;
+#else
+        ASSERT_DEBUG(laneJobs != nullptr && "Failed to allocate lane job array");
+#endif
+    }
+
     Job rootJob = {};
     rootJob.remainingJobs = 0;
 
@@ -293,8 +307,13 @@ SPMDGroup* spmd_dispatch_(JobSystem* jobSystem, Arena* arena, const SPMDDispatch
         params->kernel = options.kernel;
         params->kernelParameters = options.kernelParameters;
 
-        job_system_submit((.function = spmd_dispatch_lane_job, .parent = &rootJob), *params);
+        Job* job = &laneJobs[i];
+        MEMSET(job, 0, sizeof(Job));
+        job->function = spmd_dispatch_lane_job;
+        job->parent = &rootJob;
+        job_set_parameters(job, *params);
     }
+    job_system_submit_batch(laneJobs, laneCount);
 
     job_system_wait(jobSystem, &rootJob);
 
@@ -1,5 +1,15 @@
 #define CONTENT_DEFAULT_BLOB_CAPACITY 64u
 #define CONTENT_DEFAULT_KEY_CAPACITY 64u
+#define CONTENT_DEFAULT_MAX_BLOB_CAPACITY (1u << 20)
+#define CONTENT_DEFAULT_MAX_KEY_CAPACITY (1u << 20)
+#define CONTENT_DEFAULT_SHARD_COUNT 16u
+#define CONTENT_MAX_SHARD_COUNT 256u
+#define CONTENT_MIN_SHARD_CAPACITY 16u
+// Blobs up to this size, NUL included, are carved from the store's
+// size-classed heap; past it page rounding wastes less than the classes do,
+// so larger blobs keep a mapping of their own.
+#define CONTENT_SLAB_MAX_SIZE KB(16)
+#define CONTENT_SLAB_ARENA_SIZE MB(64)
 #define CONTENT_KEY_HASH_HISTORY_COUNT 64u
 #define CONTENT_KEY_HASH_STRONG_REF_COUNT 2u
 #define CONTENT_TABLE_MAX_LOAD_PERCENT 70u
@@ -14,12 +24,18 @@ struct ContentBlobNode {
     ContentHash hash;
     U8* data;
     U64 size;
-    U64 reservedSize;
-    U64 committedSize;
-    U64 lastTouchFrame;
+    U64 reservedSize;  // 0 for slab blobs
+    U64 committedSize; // bytes the blob really holds: its heap class or its pages
+    OS_FileMapping mapping; // set when data points into an adopted file mapping
     U64 keyRefCount;
     U64 downstreamRefCount;
     StringU8 debugName;
+    U32 slot;
+    U32 lruPrev;
+    U32 lruNext;
+    B32 lruLinked;
+    B32 invalid; // bytes no longer match the hash; views miss until resubmitted
+    U64 lastTouchFrame;
 };
 
 struct ContentKeyNode {
@@ -41,20 +57,21 @@ struct ContentKeyEntry {
     U8 state;
 };
 
-struct ContentStore {
-    Arena* arena;
+// Blobs and keys are split into shards by hash, each with its own lock, so
+// lookups from worker threads only contend when they land on the same
+// shard. Lock order: a key shard may take blob shard locks (key refs pin
+// blobs), never the other way round, and nobody holds two shards of the
+// same kind.
+struct alignas(CACHE_LINE_SIZE) ContentBlobShard {
     OS_Handle mutex;
     SlotMap blobs;
-    SlotMap keys;
     ContentBlobEntry* blobTable;
     U32 blobTableCapacity;
     U32 blobTableCount;
     U32 blobTableTombstones;
-    ContentKeyEntry* keyTable;
-    U32 keyTableCapacity;
-    U32 keyTableCount;
-    U32 keyTableTombstones;
-    U64 rootIdGen;
+    U32 lruHead; // unreferenced blobs, oldest touch first
+    U32 lruTail;
+    U64 lruFrame; // newest frame seen by touch or GC, stamped on blobs as they are linked
     U64 payloadBytes;
     U64 committedBytes;
     U32 evictCount;
@@ -62,6 +79,26 @@ struct ContentStore {
     U32 missCount;
 };
 
+struct alignas(CACHE_LINE_SIZE) ContentKeyShard {
+    OS_Handle mutex;
+    SlotMap keys;
+    ContentKeyEntry* keyTable;
+    U32 keyTableCapacity;
+    U32 keyTableCount;
+    U32 keyTableTombstones;
+};
+
+struct ContentStore {
+    Arena* arena;
+    OS_Handle arenaMutex; // shards push tables and debug names from under their own locks
+    Arena* slabArena;     // owned by slabHeap
+    Heap slabHeap;        // thread-safe; small blob bytes
+    ContentBlobShard* blobShards;
+    ContentKeyShard* keyShards;
+    U32 shardCount; // power of two, same for blobs and keys
+    U64 rootIdGen;
+};
+
 static U32 content_table_capacity_from_count_(U32 requested) {
     U32 result = MAX(requested, 64u);
     return is_power_of_two(result) ? result : u32_next_power_of_two(result);
@@ -69,7 +106,7 @@ static U32 content_table_capacity_from_count_(U32 requested) {
 
 static U64 content_hash_u64_pair_(U64 a, U64 b, U64 seed) {
     U64 values[2] = {a, b};
-    return hash_fnv1a(values, sizeof(values), seed);
+    return hash64_from_bytes(values, sizeof(values), seed);
 }
 
 static U64 content_hash_hash_(ContentHash hash) {
@@ -78,7 +115,20 @@ static U64 content_hash_hash_(ContentHash hash) {
 
 static U64 content_hash_key_(ContentKey key) {
     U64 values[3] = {key.root.id, key.id.u64[0], key.id.u64[1]};
-    return hash_fnv1a(values, sizeof(values), 1099511628211ull ^ 0x517CC1B727220A95ull);
+    return hash64_from_bytes(values, sizeof(values), 0x517CC1B727220A95ull);
+}
+
+// Tables probe from the low bits, shards come from the high ones.
+static U32 content_shard_index_(ContentStore* store, U64 tableHash) {
+    return (U32)(tableHash >> 40u) & (store->shardCount - 1u);
+}
+
+static ContentBlobShard* content_blob_shard_(ContentStore* store, ContentHash hash) {
+    return store->blobShards + content_shard_index_(store, content_hash_hash_(hash));
+}
+
+static ContentKeyShard* content_key_shard_(ContentStore* store, ContentKey key) {
+    return store->keyShards + content_shard_index_(store, content_hash_key_(key));
 }
 
 B32 content_hash_equal(ContentHash a, ContentHash b) {
@@ -90,9 +140,8 @@ B32 content_hash_is_zero(ContentHash hash) {
 }
 
 ContentHash content_hash_from_bytes(const void* data, U64 size) {
-    ContentHash result = CONTENT_HASH_ZERO;
-    result.hash[0] = hash_fnv1a(data, size, 1469598103934665603ull);
-    result.hash[1] = hash_fnv1a(data, size, 1099511628211ull ^ 0x9E3779B97F4A7C15ull);
+    Hash128 hash = hash128_from_bytes(data, size, 0x9E3779B97F4A7C15ull);
+    ContentHash result = {{hash.u64[0], hash.u64[1]}};
     return result;
 }
 
@@ -133,29 +182,72 @@ static U64 content_page_aligned_size_(U64 size) {
     return result;
 }
 
-static void content_lock_(ContentStore* store) {
-    if (store && store->mutex.handle) {
-        OS_mutex_lock(store->mutex);
+static U8* content_blob_alloc_(ContentStore* store, U64 size, U64* outReservedSize, U64* outCommittedSize) {
+    U64 allocSize = size + 1u;
+    if (allocSize <= CONTENT_SLAB_MAX_SIZE) {
+        *outReservedSize = 0u;
+        *outCommittedSize = heap_class_size(allocSize);
+        return (U8*)heap_alloc(&store->slabHeap, allocSize);
     }
+
+    U64 mappedSize = content_page_aligned_size_(allocSize);
+    U8* bytes = (U8*)OS_reserve(mappedSize);
+    if (bytes && !OS_commit(bytes, mappedSize)) {
+        OS_release(bytes, mappedSize);
+        bytes = 0;
+    }
+    *outReservedSize = mappedSize;
+    *outCommittedSize = mappedSize;
+    return bytes;
 }
 
-static void content_unlock_(ContentStore* store) {
-    if (store && store->mutex.handle) {
-        OS_mutex_unlock(store->mutex);
+static void content_blob_free_(ContentStore* store, U8* bytes, U64 size, U64 reservedSize, OS_FileMapping mapping) {
+    if (mapping.ptr) {
+        OS_file_unmap(mapping);
+    } else if (reservedSize == 0u) {
+        heap_free(&store->slabHeap, bytes, size + 1u);
+    } else {
+        OS_release(bytes, reservedSize);
     }
 }
 
-static B32 content_blob_table_find_(ContentStore* store, ContentHash hash, U32* outIndex, B32* outFound) {
-    if (!store || !store->blobTable || store->blobTableCapacity == 0u || content_hash_is_zero(hash)) {
+static void content_mutex_lock_(OS_Handle mutex) {
+    if (mutex.handle) {
+        OS_mutex_lock(mutex);
+    }
+}
+
+static void content_mutex_unlock_(OS_Handle mutex) {
+    if (mutex.handle) {
+        OS_mutex_unlock(mutex);
+    }
+}
+
+static void* content_arena_push_(ContentStore* store, U64 size, U64 alignment) {
+    content_mutex_lock_(store->arenaMutex);
+    void* result = arena_push(store->arena, size, alignment);
+    content_mutex_unlock_(store->arenaMutex);
+    return result;
+}
+
+static StringU8 content_arena_copy_name_(ContentStore* store, StringU8 name) {
+    content_mutex_lock_(store->arenaMutex);
+    StringU8 result = str8_cpy(store->arena, name);
+    content_mutex_unlock_(store->arenaMutex);
+    return result;
+}
+
+static B32 content_blob_table_find_(ContentBlobShard* shard, ContentHash hash, U32* outIndex, B32* outFound) {
+    if (!shard || !shard->blobTable || shard->blobTableCapacity == 0u || content_hash_is_zero(hash)) {
         return 0;
     }
 
-    U32 mask = store->blobTableCapacity - 1u;
+    U32 mask = shard->blobTableCapacity - 1u;
     U32 start = (U32)(content_hash_hash_(hash) & (U64)mask);
     U32 firstTombstone = SLOT_MAP_INVALID_INDEX;
-    for (U32 probe = 0u; probe < store->blobTableCapacity; ++probe) {
+    for (U32 probe = 0u; probe < shard->blobTableCapacity; ++probe) {
         U32 index = (start + probe) & mask;
-        ContentBlobEntry* entry = store->blobTable + index;
+        ContentBlobEntry* entry = shard->blobTable + index;
         if (entry->state == ContentTableEntryState_Empty) {
             if (outIndex) {
                 *outIndex = (firstTombstone != SLOT_MAP_INVALID_INDEX) ? firstTombstone : index;
@@ -194,17 +286,17 @@ static B32 content_blob_table_find_(ContentStore* store, ContentHash hash, U32*
     return 0;
 }
 
-static B32 content_key_table_find_(ContentStore* store, ContentKey key, U32* outIndex, B32* outFound) {
-    if (!store || !store->keyTable || store->keyTableCapacity == 0u || content_key_is_zero(key)) {
+static B32 content_key_table_find_(ContentKeyShard* shard, ContentKey key, U32* outIndex, B32* outFound) {
+    if (!shard || !shard->keyTable || shard->keyTableCapacity == 0u || content_key_is_zero(key)) {
         return 0;
     }
 
-    U32 mask = store->keyTableCapacity - 1u;
+    U32 mask = shard->keyTableCapacity - 1u;
     U32 start = (U32)(content_hash_key_(key) & (U64)mask);
     U32 firstTombstone = SLOT_MAP_INVALID_INDEX;
-    for (U32 probe = 0u; probe < store->keyTableCapacity; ++probe) {
+    for (U32 probe = 0u; probe < shard->keyTableCapacity; ++probe) {
         U32 index = (start + probe) & mask;
-        ContentKeyEntry* entry = store->keyTable + index;
+        ContentKeyEntry* entry = shard->keyTable + index;
         if (entry->state == ContentTableEntryState_Empty) {
             if (outIndex) {
                 *outIndex = (firstTombstone != SLOT_MAP_INVALID_INDEX) ? firstTombstone : index;
@@ -243,20 +335,21 @@ static B32 content_key_table_find_(ContentStore* store, ContentKey key, U32* out
     return 0;
 }
 
-static B32 content_blob_table_rebuild_(ContentStore* store, U32 requestedCapacity) {
+static B32 content_blob_table_rebuild_(ContentStore* store, ContentBlobShard* shard, U32 requestedCapacity) {
     U32 newCapacity = content_table_capacity_from_count_(requestedCapacity);
-    ContentBlobEntry* newTable = ARENA_PUSH_ARRAY(store->arena, ContentBlobEntry, newCapacity);
+    ContentBlobEntry* newTable = (ContentBlobEntry*)content_arena_push_(store, sizeof(ContentBlobEntry) * newCapacity,
+                                                                        alignof(ContentBlobEntry));
     if (!newTable) {
         return 0;
     }
     MEMSET(newTable, 0, sizeof(ContentBlobEntry) * newCapacity);
 
-    ContentBlobEntry* oldTable = store->blobTable;
-    U32 oldCapacity = store->blobTableCapacity;
-    store->blobTable = newTable;
-    store->blobTableCapacity = newCapacity;
-    store->blobTableCount = 0u;
-    store->blobTableTombstones = 0u;
+    ContentBlobEntry* oldTable = shard->blobTable;
+    U32 oldCapacity = shard->blobTableCapacity;
+    shard->blobTable = newTable;
+    shard->blobTableCapacity = newCapacity;
+    shard->blobTableCount = 0u;
+    shard->blobTableTombstones = 0u;
 
     for (U32 oldIndex = 0u; oldIndex < oldCapacity; ++oldIndex) {
         ContentBlobEntry* oldEntry = oldTable + oldIndex;
@@ -266,32 +359,33 @@ static B32 content_blob_table_rebuild_(ContentStore* store, U32 requestedCapacit
 
         U32 index = 0u;
         B32 found = 0;
-        if (!content_blob_table_find_(store, oldEntry->hash, &index, &found)) {
+        if (!content_blob_table_find_(shard, oldEntry->hash, &index, &found)) {
             return 0;
         }
-        ContentBlobEntry* entry = store->blobTable + index;
+        ContentBlobEntry* entry = shard->blobTable + index;
         entry->hash = oldEntry->hash;
         entry->slot = oldEntry->slot;
         entry->state = ContentTableEntryState_Occupied;
-        store->blobTableCount += 1u;
+        shard->blobTableCount += 1u;
     }
     return 1;
 }
 
-static B32 content_key_table_rebuild_(ContentStore* store, U32 requestedCapacity) {
+static B32 content_key_table_rebuild_(ContentStore* store, ContentKeyShard* shard, U32 requestedCapacity) {
     U32 newCapacity = content_table_capacity_from_count_(requestedCapacity);
-    ContentKeyEntry* newTable = ARENA_PUSH_ARRAY(store->arena, ContentKeyEntry, newCapacity);
+    ContentKeyEntry* newTable = (ContentKeyEntry*)content_arena_push_(store, sizeof(ContentKeyEntry) * newCapacity,
+                                                                      alignof(ContentKeyEntry));
     if (!newTable) {
         return 0;
     }
     MEMSET(newTable, 0, sizeof(ContentKeyEntry) * newCapacity);
 
-    ContentKeyEntry* oldTable = store->keyTable;
-    U32 oldCapacity = store->keyTableCapacity;
-    store->keyTable = newTable;
-    store->keyTableCapacity = newCapacity;
-    store->keyTableCount = 0u;
-    store->keyTableTombstones = 0u;
+    ContentKeyEntry* oldTable = shard->keyTable;
+    U32 oldCapacity = shard->keyTableCapacity;
+    shard->keyTable = newTable;
+    shard->keyTableCapacity = newCapacity;
+    shard->keyTableCount = 0u;
+    shard->keyTableTombstones = 0u;
 
     for (U32 oldIndex = 0u; oldIndex < oldCapacity; ++oldIndex) {
         ContentKeyEntry* oldEntry = oldTable + oldIndex;
@@ -301,122 +395,185 @@ static B32 content_key_table_rebuild_(ContentStore* store, U32 requestedCapacity
 
         U32 index = 0u;
         B32 found = 0;
-        if (!content_key_table_find_(store, oldEntry->key, &index, &found)) {
+        if (!content_key_table_find_(shard, oldEntry->key, &index, &found)) {
             return 0;
         }
-        ContentKeyEntry* entry = store->keyTable + index;
+        ContentKeyEntry* entry = shard->keyTable + index;
         entry->key = oldEntry->key;
         entry->slot = oldEntry->slot;
         entry->state = ContentTableEntryState_Occupied;
-        store->keyTableCount += 1u;
+        shard->keyTableCount += 1u;
     }
     return 1;
 }
 
-static B32 content_blob_table_ensure_(ContentStore* store, U32 addCount) {
-    U32 used = store->blobTableCount + store->blobTableTombstones + addCount;
-    if (store->blobTableCapacity == 0u ||
-        used * 100u >= store->blobTableCapacity * CONTENT_TABLE_MAX_LOAD_PERCENT) {
-        U32 requested = store->blobTableCapacity ? store->blobTableCapacity * 2u : CONTENT_DEFAULT_BLOB_CAPACITY;
+static B32 content_blob_table_ensure_(ContentStore* store, ContentBlobShard* shard, U32 addCount) {
+    U32 used = shard->blobTableCount + shard->blobTableTombstones + addCount;
+    if (shard->blobTableCapacity == 0u ||
+        used * 100u >= shard->blobTableCapacity * CONTENT_TABLE_MAX_LOAD_PERCENT) {
+        U32 requested = shard->blobTableCapacity ? shard->blobTableCapacity * 2u : CONTENT_DEFAULT_BLOB_CAPACITY;
         while (used * 100u >= requested * CONTENT_TABLE_MAX_LOAD_PERCENT) {
             requested *= 2u;
         }
-        return content_blob_table_rebuild_(store, requested);
+        return content_blob_table_rebuild_(store, shard, requested);
     }
     return 1;
 }
 
-static B32 content_key_table_ensure_(ContentStore* store, U32 addCount) {
-    U32 used = store->keyTableCount + store->keyTableTombstones + addCount;
-    if (store->keyTableCapacity == 0u ||
-        used * 100u >= store->keyTableCapacity * CONTENT_TABLE_MAX_LOAD_PERCENT) {
-        U32 requested = store->keyTableCapacity ? store->keyTableCapacity * 2u : CONTENT_DEFAULT_KEY_CAPACITY;
+static B32 content_key_table_ensure_(ContentStore* store, ContentKeyShard* shard, U32 addCount) {
+    U32 used = shard->keyTableCount + shard->keyTableTombstones + addCount;
+    if (shard->keyTableCapacity == 0u ||
+        used * 100u >= shard->keyTableCapacity * CONTENT_TABLE_MAX_LOAD_PERCENT) {
+        U32 requested = shard->keyTableCapacity ? shard->keyTableCapacity * 2u : CONTENT_DEFAULT_KEY_CAPACITY;
         while (used * 100u >= requested * CONTENT_TABLE_MAX_LOAD_PERCENT) {
             requested *= 2u;
         }
-        return content_key_table_rebuild_(store, requested);
+        return content_key_table_rebuild_(store, shard, requested);
     }
     return 1;
 }
 
-static ContentBlobNode* content_blob_from_hash_locked_(ContentStore* store, ContentHash hash, U32* outTableIndex) {
+static ContentBlobNode* content_blob_from_hash_locked_(ContentBlobShard* shard, ContentHash hash, U32* outTableIndex) {
     U32 index = 0u;
     B32 found = 0;
-    if (!content_blob_table_find_(store, hash, &index, &found) || !found) {
+    if (!content_blob_table_find_(shard, hash, &index, &found) || !found) {
         return 0;
     }
     if (outTableIndex) {
         *outTableIndex = index;
     }
-    ContentBlobEntry* entry = store->blobTable + index;
-    return (ContentBlobNode*)slot_map_item_at(&store->blobs, entry->slot);
+    ContentBlobEntry* entry = shard->blobTable + index;
+    return (ContentBlobNode*)slot_map_item_at(&shard->blobs, entry->slot);
 }
 
-static void content_blob_remove_locked_(ContentStore* store, ContentHash hash) {
+static void content_blob_remove_locked_(ContentBlobShard* shard, ContentHash hash) {
     U32 index = 0u;
     B32 found = 0;
-    if (!content_blob_table_find_(store, hash, &index, &found) || !found) {
+    if (!content_blob_table_find_(shard, hash, &index, &found) || !found) {
         return;
     }
-    ContentBlobEntry* entry = store->blobTable + index;
+    ContentBlobEntry* entry = shard->blobTable + index;
     entry->state = ContentTableEntryState_Tombstone;
     entry->hash = CONTENT_HASH_ZERO;
     entry->slot = 0u;
-    if (store->blobTableCount > 0u) {
-        store->blobTableCount -= 1u;
+    if (shard->blobTableCount > 0u) {
+        shard->blobTableCount -= 1u;
     }
-    store->blobTableTombstones += 1u;
+    shard->blobTableTombstones += 1u;
 }
 
-static ContentKeyNode* content_key_from_key_locked_(ContentStore* store, ContentKey key, U32* outTableIndex) {
+static ContentKeyNode* content_key_from_key_locked_(ContentKeyShard* shard, ContentKey key, U32* outTableIndex) {
     U32 index = 0u;
     B32 found = 0;
-    if (!content_key_table_find_(store, key, &index, &found) || !found) {
+    if (!content_key_table_find_(shard, key, &index, &found) || !found) {
         return 0;
     }
     if (outTableIndex) {
         *outTableIndex = index;
     }
-    ContentKeyEntry* entry = store->keyTable + index;
-    return (ContentKeyNode*)slot_map_item_at(&store->keys, entry->slot);
+    ContentKeyEntry* entry = shard->keyTable + index;
+    return (ContentKeyNode*)slot_map_item_at(&shard->keys, entry->slot);
 }
 
-static void content_blob_ref_key_locked_(ContentStore* store, ContentHash hash, S64 delta) {
-    ContentBlobNode* blob = content_blob_from_hash_locked_(store, hash, 0);
-    if (!blob) {
+// Blobs nobody references sit on one intrusive list per shard. Linking
+// stamps the newest frame seen, so the list stays sorted by lastTouchFrame
+// and GC pops from the head instead of scanning.
+static void content_lru_unlink_locked_(ContentBlobShard* shard, ContentBlobNode* node) {
+    if (!node->lruLinked) {
         return;
     }
+    if (node->lruPrev != SLOT_MAP_INVALID_INDEX) {
+        ((ContentBlobNode*)slot_map_item_at(&shard->blobs, node->lruPrev))->lruNext = node->lruNext;
+    } else {
+        shard->lruHead = node->lruNext;
+    }
+    if (node->lruNext != SLOT_MAP_INVALID_INDEX) {
+        ((ContentBlobNode*)slot_map_item_at(&shard->blobs, node->lruNext))->lruPrev = node->lruPrev;
+    } else {
+        shard->lruTail = node->lruPrev;
+    }
+    node->lruPrev = SLOT_MAP_INVALID_INDEX;
+    node->lruNext = SLOT_MAP_INVALID_INDEX;
+    node->lruLinked = 0;
+}
+
+static void content_lru_push_locked_(ContentBlobShard* shard, ContentBlobNode* node) {
+    node->lastTouchFrame = MAX(node->lastTouchFrame, shard->lruFrame);
+    node->lruPrev = shard->lruTail;
+    node->lruNext = SLOT_MAP_INVALID_INDEX;
+    if (shard->lruTail != SLOT_MAP_INVALID_INDEX) {
+        ((ContentBlobNode*)slot_map_item_at(&shard->blobs, shard->lruTail))->lruNext = node->slot;
+    } else {
+        shard->lruHead = node->slot;
+    }
+    shard->lruTail = node->slot;
+    node->lruLinked = 1;
+}
+
+// Call after anything that changes a ref count.
+static void content_lru_update_locked_(ContentBlobShard* shard, ContentBlobNode* node) {
+    B32 evictable = (node->keyRefCount == 0u && node->downstreamRefCount == 0u) ? 1 : 0;
+    if (evictable && !node->lruLinked) {
+        content_lru_push_locked_(shard, node);
+    } else if (!evictable && node->lruLinked) {
+        content_lru_unlink_locked_(shard, node);
+    }
+}
+
+static void content_blob_ref_key_locked_(ContentBlobShard* shard, ContentBlobNode* blob, S64 delta) {
     if (delta >= 0) {
         blob->keyRefCount += (U64)delta;
     } else {
         U64 amount = (U64)(-delta);
         blob->keyRefCount = (blob->keyRefCount >= amount) ? (blob->keyRefCount - amount) : 0u;
     }
+    content_lru_update_locked_(shard, blob);
+}
+
+// Takes the blob's shard lock; callers may hold a key shard lock.
+static void content_blob_ref_key_(ContentStore* store, ContentHash hash, S64 delta) {
+    ContentBlobShard* shard = content_blob_shard_(store, hash);
+    content_mutex_lock_(shard->mutex);
+    ContentBlobNode* blob = content_blob_from_hash_locked_(shard, hash, 0);
+    if (blob) {
+        content_blob_ref_key_locked_(shard, blob, delta);
+    }
+    content_mutex_unlock_(shard->mutex);
 }
 
-static B32 content_key_push_hash_locked_(ContentStore* store, ContentKey key, ContentHash hash) {
+// Records hash as the key's latest. Blob refs are left to the caller, which
+// may already hold the new blob's shard: *outPushed says whether hash gains
+// a key ref, *outExpired (zero if none) the hash that loses one.
+static B32 content_key_push_hash_locked_(ContentStore* store,
+                                         ContentKeyShard* shard,
+                                         ContentKey key,
+                                         ContentHash hash,
+                                         B32* outPushed,
+                                         ContentHash* outExpired) {
+    *outPushed = 0;
+    *outExpired = CONTENT_HASH_ZERO;
     if (content_key_is_zero(key) || content_hash_is_zero(hash)) {
         return 1;
     }
-    if (!content_key_table_ensure_(store, 1u)) {
+    if (!content_key_table_ensure_(store, shard, 1u)) {
         return 0;
     }
 
     U32 tableIndex = 0u;
     B32 found = 0;
-    if (!content_key_table_find_(store, key, &tableIndex, &found)) {
+    if (!content_key_table_find_(shard, key, &tableIndex, &found)) {
         return 0;
     }
 
     ContentKeyNode* node = 0;
     if (found) {
-        ContentKeyEntry* entry = store->keyTable + tableIndex;
-        node = (ContentKeyNode*)slot_map_item_at(&store->keys, entry->slot);
+        ContentKeyEntry* entry = shard->keyTable + tableIndex;
+        node = (ContentKeyNode*)slot_map_item_at(&shard->keys, entry->slot);
     } else {
         void* slotItem = 0;
         U32 slotIndex = 0u;
         U32 slotGeneration = 0u;
-        if (!slot_map_alloc(&store->keys, &slotItem, &slotIndex, &slotGeneration)) {
+        if (!slot_map_alloc(&shard->keys, &slotItem, &slotIndex, &slotGeneration)) {
             return 0;
         }
         (void)slotGeneration;
@@ -424,14 +581,14 @@ static B32 content_key_push_hash_locked_(ContentStore* store, ContentKey key, Co
         node->key = key;
         node->alive = 1;
 
-        ContentKeyEntry* entry = store->keyTable + tableIndex;
-        if (entry->state == ContentTableEntryState_Tombstone && store->keyTableTombstones > 0u) {
-            store->keyTableTombstones -= 1u;
+        ContentKeyEntry* entry = shard->keyTable + tableIndex;
+        if (entry->state == ContentTableEntryState_Tombstone && shard->keyTableTombstones > 0u) {
+            shard->keyTableTombstones -= 1u;
         }
         entry->key = key;
         entry->slot = slotIndex;
         entry->state = ContentTableEntryState_Occupied;
-        store->keyTableCount += 1u;
+        shard->keyTableCount += 1u;
     }
 
     if (node->historyGen != 0u) {
@@ -442,13 +599,12 @@ static B32 content_key_push_hash_locked_(ContentStore* store, ContentKey key, Co
     }
 
     if (node->historyGen >= CONTENT_KEY_HASH_STRONG_REF_COUNT) {
-        ContentHash expired = node->history[(node->historyGen - CONTENT_KEY_HASH_STRONG_REF_COUNT) %
-                                            CONTENT_KEY_HASH_HISTORY_COUNT];
-        content_blob_ref_key_locked_(store, expired, -1);
+        *outExpired = node->history[(node->historyGen - CONTENT_KEY_HASH_STRONG_REF_COUNT) %
+                                    CONTENT_KEY_HASH_HISTORY_COUNT];
     }
     node->history[node->historyGen % CONTENT_KEY_HASH_HISTORY_COUNT] = hash;
     node->historyGen += 1u;
-    content_blob_ref_key_locked_(store, hash, 1);
+    *outPushed = 1;
     return 1;
 }
 
@@ -460,31 +616,65 @@ static void content_key_close_locked_(ContentStore* store, ContentKeyNode* node)
     U64 strongCount = MIN(node->historyGen, CONTENT_KEY_HASH_STRONG_REF_COUNT);
     for (U64 index = 0u; index < strongCount; ++index) {
         ContentHash hash = node->history[(node->historyGen - 1u - index) % CONTENT_KEY_HASH_HISTORY_COUNT];
-        content_blob_ref_key_locked_(store, hash, -1);
+        content_blob_ref_key_(store, hash, -1);
     }
     node->alive = 0;
 }
 
-static void content_node_release_blob_(ContentStore* store, ContentBlobNode* node) {
-    if (!store || !node || !node->data) {
+static void content_node_release_blob_(ContentStore* store, ContentBlobShard* shard, ContentBlobNode* node) {
+    if (!shard || !node || !node->data) {
         return;
     }
 
-    OS_release(node->data, node->reservedSize);
-    if (store->payloadBytes >= node->size) {
-        store->payloadBytes -= node->size;
+    content_blob_free_(store, node->data, node->size, node->reservedSize, node->mapping);
+    if (shard->payloadBytes >= node->size) {
+        shard->payloadBytes -= node->size;
     } else {
-        store->payloadBytes = 0u;
+        shard->payloadBytes = 0u;
     }
-    if (store->committedBytes >= node->committedSize) {
-        store->committedBytes -= node->committedSize;
+    if (shard->committedBytes >= node->committedSize) {
+        shard->committedBytes -= node->committedSize;
     } else {
-        store->committedBytes = 0u;
+        shard->committedBytes = 0u;
     }
     node->data = 0;
     node->size = 0u;
     node->reservedSize = 0u;
     node->committedSize = 0u;
+    node->mapping.ptr = 0;
+    node->mapping.length = 0u;
+}
+
+// Each shard reserves twice its fair share of the requested maximum, so an
+// uneven hash spread does not run one shard dry early.
+static U32 content_shard_capacity_(U32 total, U32 shardCount, U32 minimum) {
+    if (shardCount == 1u) {
+        return MAX(total, minimum);
+    }
+    U64 result = ((U64)total * 2u + shardCount - 1u) / shardCount;
+    return (U32)MAX(result, (U64)minimum);
+}
+
+static void content_store_release_(ContentStore* store) {
+    for (U32 index = 0u; index < store->shardCount; ++index) {
+        ContentBlobShard* blobShard = store->blobShards + index;
+        ContentKeyShard* keyShard = store->keyShards + index;
+        slot_map_destroy(&blobShard->blobs);
+        slot_map_destroy(&keyShard->keys);
+        if (blobShard->mutex.handle) {
+            OS_mutex_destroy(blobShard->mutex);
+        }
+        if (keyShard->mutex.handle) {
+            OS_mutex_destroy(keyShard->mutex);
+        }
+    }
+    if (store->arenaMutex.handle) {
+        OS_mutex_destroy(store->arenaMutex);
+    }
+    if (store->slabArena) {
+        heap_destroy(&store->slabHeap);
+        arena_release(store->slabArena);
+    }
 }
 
 B32 content_store_create(const ContentStoreDesc* desc, ContentStore* outStore) {
@@ -494,19 +684,52 @@ B32 content_store_create(const ContentStoreDesc* desc, ContentStore* outStore) {
 
     MEMSET(outStore, 0, sizeof(*outStore));
     outStore->arena = desc->arena;
-    outStore->mutex = OS_mutex_create();
-    if (!outStore->mutex.handle) {
+    U32 shardCount = CLAMP(desc->shardCount ? desc->shardCount : CONTENT_DEFAULT_SHARD_COUNT, 1u, CONTENT_MAX_SHARD_COUNT);
+    shardCount = is_power_of_two(shardCount) ? shardCount : u32_next_power_of_two(shardCount);
+    outStore->blobShards = ARENA_PUSH_ARRAY(desc->arena, ContentBlobShard, shardCount);
+    outStore->keyShards = ARENA_PUSH_ARRAY(desc->arena, ContentKeyShard, shardCount);
+    if (!outStore->blobShards || !outStore->keyShards) {
         MEMSET(outStore, 0, sizeof(*outStore));
         return 0;
     }
-
-    U32 blobCapacity = desc->initialBlobCapacity ? desc->initialBlobCapacity : CONTENT_DEFAULT_BLOB_CAPACITY;
-    U32 keyCapacity = desc->initialKeyCapacity ? desc->initialKeyCapacity : CONTENT_DEFAULT_KEY_CAPACITY;
-    if (!slot_map_init(&outStore->blobs, outStore->arena, sizeof(ContentBlobNode), blobCapacity) ||
-        !slot_map_init(&outStore->keys, outStore->arena, sizeof(ContentKeyNode), keyCapacity) ||
-        !content_blob_table_rebuild_(outStore, blobCapacity * 2u) ||
-        !content_key_table_rebuild_(outStore, keyCapacity * 2u)) {
-        OS_mutex_destroy(outStore->mutex);
+    MEMSET(outStore->blobShards, 0, sizeof(ContentBlobShard) * shardCount);
+    MEMSET(outStore->keyShards, 0, sizeof(ContentKeyShard) * shardCount);
+    outStore->shardCount = shardCount;
+
+    U32 maxBlobCapacity = content_shard_capacity_(desc->maxBlobCapacity ? desc->maxBlobCapacity : CONTENT_DEFAULT_MAX_BLOB_CAPACITY,
+                                                  shardCount, CONTENT_MIN_SHARD_CAPACITY);
+    U32 maxKeyCapacity = content_shard_capacity_(desc->maxKeyCapacity ? desc->maxKeyCapacity : CONTENT_DEFAULT_MAX_KEY_CAPACITY,
+                                                 shardCount, CONTENT_MIN_SHARD_CAPACITY);
+    U32 blobCapacity = MIN(MAX((desc->initialBlobCapacity ? desc->initialBlobCapacity : CONTENT_DEFAULT_BLOB_CAPACITY) / shardCount,
+                               CONTENT_MIN_SHARD_CAPACITY),
+                           maxBlobCapacity);
+    U32 keyCapacity = MIN(MAX((desc->initialKeyCapacity ? desc->initialKeyCapacity : CONTENT_DEFAULT_KEY_CAPACITY) / shardCount,
+                              CONTENT_MIN_SHARD_CAPACITY),
+                          maxKeyCapacity);
+
+    outStore->arenaMutex = OS_mutex_create();
+    outStore->slabArena = arena_alloc(.arenaSize = CONTENT_SLAB_ARENA_SIZE, .debugName = "content slabs");
+    if (outStore->slabArena) {
+        heap_init(&outStore->slabHeap, outStore->slabArena);
+    }
+    B32 ready = (outStore->arenaMutex.handle && outStore->slabArena) ? 1 : 0;
+    for (U32 index = 0u; ready && index < shardCount; ++index) {
+        ContentBlobShard* blobShard = outStore->blobShards + index;
+        ContentKeyShard* keyShard = outStore->keyShards + index;
+        blobShard->lruHead = SLOT_MAP_INVALID_INDEX;
+        blobShard->lruTail = SLOT_MAP_INVALID_INDEX;
+        blobShard->mutex = OS_mutex_create();
+        keyShard->mutex = OS_mutex_create();
+        // Reserved slot maps: growing under a shard lock commits pages
+        // instead of copying every node.
+        ready = blobShard->mutex.handle && keyShard->mutex.handle &&
+                slot_map_init_reserved(&blobShard->blobs, sizeof(ContentBlobNode), blobCapacity, maxBlobCapacity) &&
+                slot_map_init_reserved(&keyShard->keys, sizeof(ContentKeyNode), keyCapacity, maxKeyCapacity) &&
+                content_blob_table_rebuild_(outStore, blobShard, blobCapacity * 2u) &&
+                content_key_table_rebuild_(outStore, keyShard, keyCapacity * 2u);
+    }
+    if (!ready) {
+        content_store_release_(outStore);
         MEMSET(outStore, 0, sizeof(*outStore));
         return 0;
     }
@@ -531,19 +754,17 @@ void content_store_destroy(ContentStore* store) {
         return;
     }
 
-    content_lock_(store);
-    for (U32 slot = 0u; slot < store->blobs.capacity; ++slot) {
-        if (!slot_map_is_occupied(&store->blobs, slot)) {
-            continue;
+    for (U32 index = 0u; index < store->shardCount; ++index) {
+        ContentBlobShard* shard = store->blobShards + index;
+        content_mutex_lock_(shard->mutex);
+        for (U32 at = 0u; at < shard->blobs.count; ++at) {
+            ContentBlobNode* node = (ContentBlobNode*)slot_map_item_at(&shard->blobs, shard->blobs.dense[at]);
+            content_node_release_blob_(store, shard, node);
         }
-        ContentBlobNode* node = (ContentBlobNode*)slot_map_item_at(&store->blobs, slot);
-        content_node_release_blob_(store, node);
+        content_mutex_unlock_(shard->mutex);
     }
-    content_unlock_(store);
 
-    if (store->mutex.handle) {
-        OS_mutex_destroy(store->mutex);
-    }
+    content_store_release_(store);
     MEMSET(store, 0, sizeof(*store));
 }
 
@@ -553,13 +774,9 @@ ContentRoot content_root_alloc(ContentStore* store) {
         return result;
     }
 
-    content_lock_(store);
-    store->rootIdGen += 1u;
-    if (store->rootIdGen == 0u) {
-        store->rootIdGen = 1u;
-    }
-    result.id = store->rootIdGen;
-    content_unlock_(store);
+    do {
+        result.id = ATOMIC_FETCH_ADD(&store->rootIdGen, 1u, MEMORY_ORDER_RELAXED) + 1u;
+    } while (result.id == 0u);
     return result;
 }
 
@@ -568,139 +785,244 @@ void content_root_release(ContentStore* store, ContentRoot root) {
         return;
     }
 
-    content_lock_(store);
-    for (U32 slot = 0u; slot < store->keys.capacity; ++slot) {
-        if (!slot_map_is_occupied(&store->keys, slot)) {
-            continue;
-        }
-        ContentKeyNode* node = (ContentKeyNode*)slot_map_item_at(&store->keys, slot);
-        if (!node || node->key.root.id != root.id) {
-            continue;
-        }
+    for (U32 index = 0u; index < store->shardCount; ++index) {
+        ContentKeyShard* shard = store->keyShards + index;
+        content_mutex_lock_(shard->mutex);
+        // Backwards: releasing dense[at] swaps the last entry into at.
+        for (U32 at = shard->keys.count; at-- > 0u;) {
+            U32 slot = shard->keys.dense[at];
+            ContentKeyNode* node = (ContentKeyNode*)slot_map_item_at(&shard->keys, slot);
+            if (!node || node->key.root.id != root.id) {
+                continue;
+            }
 
-        content_key_close_locked_(store, node);
-        U32 tableIndex = 0u;
-        if (content_key_from_key_locked_(store, node->key, &tableIndex)) {
-            ContentKeyEntry* entry = store->keyTable + tableIndex;
-            entry->state = ContentTableEntryState_Tombstone;
-            entry->key = CONTENT_KEY_ZERO;
-            entry->slot = 0u;
-            if (store->keyTableCount > 0u) {
-                store->keyTableCount -= 1u;
+            content_key_close_locked_(store, node);
+            U32 tableIndex = 0u;
+            if (content_key_from_key_locked_(shard, node->key, &tableIndex)) {
+                ContentKeyEntry* entry = shard->keyTable + tableIndex;
+                entry->state = ContentTableEntryState_Tombstone;
+                entry->key = CONTENT_KEY_ZERO;
+                entry->slot = 0u;
+                if (shard->keyTableCount > 0u) {
+                    shard->keyTableCount -= 1u;
+                }
+                shard->keyTableTombstones += 1u;
             }
-            store->keyTableTombstones += 1u;
+            void* released = 0;
+            slot_map_release(&shard->keys, slot, shard->keys.generations[slot], &released);
         }
-        void* released = 0;
-        slot_map_release(&store->keys, slot, store->keys.generations[slot], &released);
+        content_mutex_unlock_(shard->mutex);
     }
-    content_unlock_(store);
 }
 
-ContentHash content_submit_bytes(ContentStore* store, ContentKey key, const void* data, U64 size, StringU8 debugName) {
-    if (!store || (!data && size != 0u)) {
-        return CONTENT_HASH_ZERO;
-    }
-
-    ContentHash hash = content_hash_from_bytes(data, size);
-    U64 committedSize = content_page_aligned_size_(size + 1u);
-    U8* bytes = (U8*)OS_reserve(committedSize);
-    if (!bytes) {
-        return CONTENT_HASH_ZERO;
-    }
-    if (!OS_commit(bytes, committedSize)) {
-        OS_release(bytes, committedSize);
-        return CONTENT_HASH_ZERO;
-    }
-    if (size != 0u) {
-        MEMCPY(bytes, data, size);
+// Publishes blob storage the caller already filled and hashed. The storage
+// is owned from here on: freed on a dedupe or a failure.
+// outAdopted says whether blob's bytes became the stored blob; when not
+// (a dedupe or a failure) they were freed here.
+static ContentHash content_submit_owned_(ContentStore* store,
+                                         ContentKey key,
+                                         ContentHash hash,
+                                         const ContentBlobNode* blob,
+                                         StringU8 debugName,
+                                         B32* outAdopted) {
+    // The key shard is held across the insert so the new blob gets its key
+    // ref before GC can see it unreferenced.
+    ContentKeyShard* keyShard = content_key_is_zero(key) ? 0 : content_key_shard_(store, key);
+    ContentBlobShard* shard = content_blob_shard_(store, hash);
+    if (keyShard) {
+        content_mutex_lock_(keyShard->mutex);
+    }
+    content_mutex_lock_(shard->mutex);
+    if (outAdopted) {
+        *outAdopted = 0;
+    }
+
+    B32 pushed = 0;
+    ContentHash expired = CONTENT_HASH_ZERO;
+    ContentBlobNode* existing = content_blob_from_hash_locked_(shard, hash, 0);
+    if (existing && existing->invalid) {
+        // Refill an invalidated blob in place, unless a retained reader
+        // still holds its stale bytes; the caller retries later then.
+        if (existing->data) {
+            content_mutex_unlock_(shard->mutex);
+            if (keyShard) {
+                content_mutex_unlock_(keyShard->mutex);
+            }
+            content_blob_free_(store, blob->data, blob->size, blob->reservedSize, blob->mapping);
+            return CONTENT_HASH_ZERO;
+        }
+        existing->data = blob->data;
+        existing->size = blob->size;
+        existing->reservedSize = blob->reservedSize;
+        existing->committedSize = blob->committedSize;
+        existing->mapping = blob->mapping;
+        existing->invalid = 0;
+        shard->payloadBytes += blob->size;
+        shard->committedBytes += blob->committedSize;
+        blob = 0;
+        if (outAdopted) {
+            *outAdopted = 1;
+        }
     }
-    bytes[size] = 0;
-
-    content_lock_(store);
-    ContentBlobNode* existing = content_blob_from_hash_locked_(store, hash, 0);
     if (existing) {
 #if !defined(NDEBUG)
-        ASSERT_DEBUG(existing->size == size);
-        if (existing->size == size && size != 0u) {
-            ASSERT_DEBUG(MEMCMP(existing->data, data, size) == 0);
+        // Mapped bytes may already be mid-rewrite when the file has not been
+        // rechecked yet, so only owned copies are compared.
+        if (blob && !existing->mapping.ptr) {
+            ASSERT_DEBUG(existing->size == blob->size);
+            if (existing->size == blob->size && blob->size != 0u) {
+                ASSERT_DEBUG(MEMCMP(existing->data, blob->data, blob->size) == 0);
+            }
         }
 #endif
-        OS_release(bytes, committedSize);
-        if (!content_key_is_zero(key)) {
-            content_key_push_hash_locked_(store, key, hash);
+        if (keyShard && content_key_push_hash_locked_(store, keyShard, key, hash, &pushed, &expired) && pushed) {
+            content_blob_ref_key_locked_(shard, existing, 1);
+        }
+        content_mutex_unlock_(shard->mutex);
+        if (!content_hash_is_zero(expired)) {
+            content_blob_ref_key_(store, expired, -1);
+        }
+        if (keyShard) {
+            content_mutex_unlock_(keyShard->mutex);
+        }
+        if (blob) {
+            content_blob_free_(store, blob->data, blob->size, blob->reservedSize, blob->mapping);
         }
-        content_unlock_(store);
         return hash;
     }
 
-    if (!content_blob_table_ensure_(store, 1u)) {
-        content_unlock_(store);
-        OS_release(bytes, committedSize);
-        return CONTENT_HASH_ZERO;
-    }
-
     void* slotItem = 0;
     U32 slotIndex = 0u;
     U32 slotGeneration = 0u;
-    if (!slot_map_alloc(&store->blobs, &slotItem, &slotIndex, &slotGeneration)) {
-        content_unlock_(store);
-        OS_release(bytes, committedSize);
+    if (!content_blob_table_ensure_(store, shard, 1u) ||
+        !slot_map_alloc(&shard->blobs, &slotItem, &slotIndex, &slotGeneration)) {
+        content_mutex_unlock_(shard->mutex);
+        if (keyShard) {
+            content_mutex_unlock_(keyShard->mutex);
+        }
+        content_blob_free_(store, blob->data, blob->size, blob->reservedSize, blob->mapping);
         return CONTENT_HASH_ZERO;
     }
     (void)slotGeneration;
 
     ContentBlobNode* node = (ContentBlobNode*)slotItem;
     node->hash = hash;
-    node->data = bytes;
-    node->size = size;
-    node->reservedSize = committedSize;
-    node->committedSize = committedSize;
-    node->lastTouchFrame = 0u;
-    node->debugName = str8_cpy(store->arena, debugName);
+    node->data = blob->data;
+    node->size = blob->size;
+    node->reservedSize = blob->reservedSize;
+    node->committedSize = blob->committedSize;
+    node->mapping = blob->mapping;
+    node->debugName = content_arena_copy_name_(store, debugName);
+    node->slot = slotIndex;
+    node->lruPrev = SLOT_MAP_INVALID_INDEX;
+    node->lruNext = SLOT_MAP_INVALID_INDEX;
 
     U32 tableIndex = 0u;
     B32 found = 0;
-    if (!content_blob_table_find_(store, hash, &tableIndex, &found) || found) {
-        slot_map_release(&store->blobs, slotIndex, store->blobs.generations[slotIndex], 0);
-        content_unlock_(store);
-        OS_release(bytes, committedSize);
+    if (!content_blob_table_find_(shard, hash, &tableIndex, &found) || found) {
+        slot_map_release(&shard->blobs, slotIndex, shard->blobs.generations[slotIndex], 0);
+        content_mutex_unlock_(shard->mutex);
+        if (keyShard) {
+            content_mutex_unlock_(keyShard->mutex);
+        }
+        content_blob_free_(store, blob->data, blob->size, blob->reservedSize, blob->mapping);
         return CONTENT_HASH_ZERO;
     }
-    ContentBlobEntry* entry = store->blobTable + tableIndex;
-    if (entry->state == ContentTableEntryState_Tombstone && store->blobTableTombstones > 0u) {
-        store->blobTableTombstones -= 1u;
+    ContentBlobEntry* entry = shard->blobTable + tableIndex;
+    if (entry->state == ContentTableEntryState_Tombstone && shard->blobTableTombstones > 0u) {
+        shard->blobTableTombstones -= 1u;
     }
     entry->hash = hash;
     entry->slot = slotIndex;
     entry->state = ContentTableEntryState_Occupied;
-    store->blobTableCount += 1u;
-    store->payloadBytes += size;
-    store->committedBytes += committedSize;
-
-    if (!content_key_is_zero(key) && !content_key_push_hash_locked_(store, key, hash)) {
-        content_blob_remove_locked_(store, hash);
-        content_node_release_blob_(store, node);
-        slot_map_release(&store->blobs, slotIndex, store->blobs.generations[slotIndex], 0);
-        content_unlock_(store);
-        return CONTENT_HASH_ZERO;
+    shard->blobTableCount += 1u;
+    shard->payloadBytes += node->size;
+    shard->committedBytes += node->committedSize;
+    content_lru_push_locked_(shard, node);
+
+    if (keyShard) {
+        if (!content_key_push_hash_locked_(store, keyShard, key, hash, &pushed, &expired)) {
+            content_lru_unlink_locked_(shard, node);
+            content_blob_remove_locked_(shard, hash);
+            content_node_release_blob_(store, shard, node);
+            slot_map_release(&shard->blobs, slotIndex, shard->blobs.generations[slotIndex], 0);
+            content_mutex_unlock_(shard->mutex);
+            content_mutex_unlock_(keyShard->mutex);
+            return CONTENT_HASH_ZERO;
+        }
+        if (pushed) {
+            content_blob_ref_key_locked_(shard, node, 1);
+        }
+    }
+    content_mutex_unlock_(shard->mutex);
+    if (outAdopted) {
+        *outAdopted = 1;
     }
 
-    content_unlock_(store);
+    if (!content_hash_is_zero(expired)) {
+        content_blob_ref_key_(store, expired, -1);
+    }
+    if (keyShard) {
+        content_mutex_unlock_(keyShard->mutex);
+    }
     return hash;
 }
 
+ContentHash content_submit_bytes(ContentStore* store, ContentKey key, const void* data, U64 size, StringU8 debugName) {
+    if (!store || (!data && size != 0u)) {
+        return CONTENT_HASH_ZERO;
+    }
+
+    ContentHash hash = content_hash_from_bytes(data, size);
+    ContentBlobNode blob = {};
+    blob.size = size;
+    blob.data = content_blob_alloc_(store, size, &blob.reservedSize, &blob.committedSize);
+    if (!blob.data) {
+        return CONTENT_HASH_ZERO;
+    }
+    if (size != 0u) {
+        MEMCPY(blob.data, data, size);
+    }
+    blob.data[size] = 0;
+    return content_submit_owned_(store, key, hash, &blob, debugName, 0);
+}
+
+ContentHash content_submit_mapping(ContentStore* store,
+                                   ContentKey key,
+                                   OS_FileMapping mapping,
+                                   RangeU64 range,
+                                   StringU8 debugName,
+                                   B32* outAdopted) {
+    if (outAdopted) {
+        *outAdopted = 0;
+    }
+    if (!store || !mapping.ptr || range.max < range.min || range.max > mapping.length) {
+        OS_file_unmap(mapping);
+        return CONTENT_HASH_ZERO;
+    }
+
+    ContentBlobNode blob = {};
+    blob.data = (U8*)mapping.ptr + range.min;
+    blob.size = range.max - range.min;
+    blob.committedSize = content_page_aligned_size_(mapping.length);
+    blob.mapping = mapping;
+    ContentHash hash = content_hash_from_bytes(blob.data, blob.size);
+    return content_submit_owned_(store, key, hash, &blob, debugName, outAdopted);
+}
+
 ContentHash content_hash_from_key(ContentStore* store, ContentKey key, U64 rewindCount) {
     ContentHash result = CONTENT_HASH_ZERO;
     if (!store || content_key_is_zero(key)) {
         return result;
     }
 
-    content_lock_(store);
-    ContentKeyNode* node = content_key_from_key_locked_(store, key, 0);
+    ContentKeyShard* shard = content_key_shard_(store, key);
+    content_mutex_lock_(shard->mutex);
+    ContentKeyNode* node = content_key_from_key_locked_(shard, key, 0);
     if (node && node->alive && node->historyGen != 0u && node->historyGen > rewindCount) {
         result = node->history[(node->historyGen - 1u - rewindCount) % CONTENT_KEY_HASH_HISTORY_COUNT];
     }
-    content_unlock_(store);
+    content_mutex_unlock_(shard->mutex);
     return result;
 }
 
@@ -710,18 +1032,20 @@ ContentView content_view_hash(ContentStore* store, ContentHash hash) {
         return result;
     }
 
-    content_lock_(store);
-    ContentBlobNode* node = content_blob_from_hash_locked_(store, hash, 0);
-    if (node && node->data) {
+    ContentBlobShard* shard = content_blob_shard_(store, hash);
+    content_mutex_lock_(shard->mutex);
+    ContentBlobNode* node = content_blob_from_hash_locked_(shard, hash, 0);
+    if (node && node->data && !node->invalid) {
         result.data = node->data;
         result.size = node->size;
         result.hash = node->hash;
+        result.flags = node->mapping.ptr ? ContentViewFlags_Mapped : ContentViewFlags_None;
         result.valid = 1;
-        store->hitCount += 1u;
+        shard->hitCount += 1u;
     } else {
-        store->missCount += 1u;
+        shard->missCount += 1u;
     }
-    content_unlock_(store);
+    content_mutex_unlock_(shard->mutex);
     return result;
 }
 
@@ -731,13 +1055,15 @@ B32 content_retain_hash(ContentStore* store, ContentHash hash) {
         return result;
     }
 
-    content_lock_(store);
-    ContentBlobNode* node = content_blob_from_hash_locked_(store, hash, 0);
+    ContentBlobShard* shard = content_blob_shard_(store, hash);
+    content_mutex_lock_(shard->mutex);
+    ContentBlobNode* node = content_blob_from_hash_locked_(shard, hash, 0);
     if (node) {
         node->downstreamRefCount += 1u;
+        content_lru_update_locked_(shard, node);
         result = 1;
     }
-    content_unlock_(store);
+    content_mutex_unlock_(shard->mutex);
     return result;
 }
 
@@ -746,12 +1072,36 @@ void content_release_hash(ContentStore* store, ContentHash hash) {
         return;
     }
 
-    content_lock_(store);
-    ContentBlobNode* node = content_blob_from_hash_locked_(store, hash, 0);
+    ContentBlobShard* shard = content_blob_shard_(store, hash);
+    content_mutex_lock_(shard->mutex);
+    ContentBlobNode* node = content_blob_from_hash_locked_(shard, hash, 0);
     if (node && node->downstreamRefCount > 0u) {
         node->downstreamRefCount -= 1u;
+        if (node->invalid && node->downstreamRefCount == 0u) {
+            content_node_release_blob_(store, shard, node);
+        }
+        content_lru_update_locked_(shard, node);
     }
-    content_unlock_(store);
+    content_mutex_unlock_(shard->mutex);
+}
+
+void content_invalidate_hash(ContentStore* store, ContentHash hash) {
+    if (!store || content_hash_is_zero(hash)) {
+        return;
+    }
+
+    // The node keeps its key and downstream refs so their bookkeeping stays
+    // balanced; only the bytes go, once nothing retains them.
+    ContentBlobShard* shard = content_blob_shard_(store, hash);
+    content_mutex_lock_(shard->mutex);
+    ContentBlobNode* node = content_blob_from_hash_locked_(shard, hash, 0);
+    if (node) {
+        node->invalid = 1;
+        if (node->downstreamRefCount == 0u) {
+            content_node_release_blob_(store, shard, node);
+        }
+    }
+    content_mutex_unlock_(shard->mutex);
 }
 
 void content_touch_hash(ContentStore* store, ContentHash hash, U64 frameIndex) {
@@ -759,12 +1109,26 @@ void content_touch_hash(ContentStore* store, ContentHash hash, U64 frameIndex) {
         return;
     }
 
-    content_lock_(store);
-    ContentBlobNode* node = content_blob_from_hash_locked_(store, hash, 0);
+    ContentBlobShard* shard = content_blob_shard_(store, hash);
+    content_mutex_lock_(shard->mutex);
+    ContentBlobNode* node = content_blob_from_hash_locked_(shard, hash, 0);
     if (node) {
-        node->lastTouchFrame = frameIndex;
+        shard->lruFrame = MAX(shard->lruFrame, frameIndex);
+        node->lastTouchFrame = shard->lruFrame;
+        if (node->lruLinked) {
+            content_lru_unlink_locked_(shard, node);
+            content_lru_push_locked_(shard, node);
+        }
+    }
+    content_mutex_unlock_(shard->mutex);
+}
+
+// Oldest head of the shard's list, UINT64_MAX if empty. Caller holds the lock.
+static U64 content_shard_head_frame_locked_(ContentBlobShard* shard) {
+    if (shard->lruHead == SLOT_MAP_INVALID_INDEX) {
+        return UINT64_MAX;
     }
-    content_unlock_(store);
+    return ((ContentBlobNode*)slot_map_item_at(&shard->blobs, shard->lruHead))->lastTouchFrame;
 }
 
 void content_tick_gc(ContentStore* store, U64 frameIndex, U64 targetBytes) {
@@ -772,39 +1136,51 @@ void content_tick_gc(ContentStore* store, U64 frameIndex, U64 targetBytes) {
         return;
     }
 
-    content_lock_(store);
-    while (store->committedBytes > targetBytes) {
-        U32 bestSlot = SLOT_MAP_INVALID_INDEX;
-        U64 bestFrame = UINT64_MAX;
-        for (U32 slot = 0u; slot < store->blobs.capacity; ++slot) {
-            if (!slot_map_is_occupied(&store->blobs, slot)) {
-                continue;
-            }
-            ContentBlobNode* node = (ContentBlobNode*)slot_map_item_at(&store->blobs, slot);
-            if (!node ||
-                node->lastTouchFrame == frameIndex ||
-                node->keyRefCount != 0u ||
-                node->downstreamRefCount != 0u) {
-                continue;
-            }
-            if (node->lastTouchFrame < bestFrame) {
-                bestFrame = node->lastTouchFrame;
-                bestSlot = slot;
+    // One pass to read every shard's size and oldest head, then evict the
+    // oldest head across shards until under target. Only the shard being
+    // evicted from is locked, one blob at a time, so readers elsewhere
+    // never wait on GC.
+    U64 headFrames[CONTENT_MAX_SHARD_COUNT];
+    U64 committedBytes = 0u;
+    for (U32 index = 0u; index < store->shardCount; ++index) {
+        ContentBlobShard* shard = store->blobShards + index;
+        content_mutex_lock_(shard->mutex);
+        shard->lruFrame = MAX(shard->lruFrame, frameIndex);
+        committedBytes += shard->committedBytes;
+        headFrames[index] = content_shard_head_frame_locked_(shard);
+        content_mutex_unlock_(shard->mutex);
+    }
+
+    while (committedBytes > targetBytes) {
+        // Lists are sorted, so once the oldest head was touched this frame
+        // every blob behind it was too.
+        U32 oldest = 0u;
+        for (U32 index = 1u; index < store->shardCount; ++index) {
+            if (headFrames[index] < headFrames[oldest]) {
+                oldest = index;
             }
         }
-        if (bestSlot == SLOT_MAP_INVALID_INDEX) {
+        if (headFrames[oldest] >= frameIndex) {
             break;
         }
 
-        ContentBlobNode* node = (ContentBlobNode*)slot_map_item_at(&store->blobs, bestSlot);
-        ContentHash hash = node->hash;
-        content_blob_remove_locked_(store, hash);
-        content_node_release_blob_(store, node);
-        void* released = 0;
-        slot_map_release(&store->blobs, bestSlot, store->blobs.generations[bestSlot], &released);
-        store->evictCount += 1u;
+        ContentBlobShard* shard = store->blobShards + oldest;
+        content_mutex_lock_(shard->mutex);
+        if (content_shard_head_frame_locked_(shard) < frameIndex) {
+            U32 slot = shard->lruHead;
+            ContentBlobNode* node = (ContentBlobNode*)slot_map_item_at(&shard->blobs, slot);
+            U64 freedBytes = node->committedSize;
+            content_lru_unlink_locked_(shard, node);
+            content_blob_remove_locked_(shard, node->hash);
+            content_node_release_blob_(store, shard, node);
+            void* released = 0;
+            slot_map_release(&shard->blobs, slot, shard->blobs.generations[slot], &released);
+            shard->evictCount += 1u;
+            committedBytes = (committedBytes >= freedBytes) ? (committedBytes - freedBytes) : 0u;
+        }
+        headFrames[oldest] = content_shard_head_frame_locked_(shard);
+        content_mutex_unlock_(shard->mutex);
     }
-    content_unlock_(store);
 }
 
 ContentStats content_stats(ContentStore* store) {
@@ -813,14 +1189,21 @@ ContentStats content_stats(ContentStore* store) {
         return result;
     }
 
-    content_lock_(store);
-    result.payloadBytes = store->payloadBytes;
-    result.committedBytes = store->committedBytes;
-    result.blobCount = store->blobs.count;
-    result.keyCount = store->keys.count;
-    result.evictCount = store->evictCount;
-    result.hitCount = store->hitCount;
-    result.missCount = store->missCount;
-    content_unlock_(store);
+    for (U32 index = 0u; index < store->shardCount; ++index) {
+        ContentBlobShard* blobShard = store->blobShards + index;
+        content_mutex_lock_(blobShard->mutex);
+        result.payloadBytes += blobShard->payloadBytes;
+        result.committedBytes += blobShard->committedBytes;
+        result.blobCount += blobShard->blobs.count;
+        result.evictCount += blobShard->evictCount;
+        result.hitCount += blobShard->hitCount;
+        result.missCount += blobShard->missCount;
+        content_mutex_unlock_(blobShard->mutex);
+
+        ContentKeyShard* keyShard = store->keyShards + index;
+        content_mutex_lock_(keyShard->mutex);
+        result.keyCount += keyShard->keys.count;
+        content_mutex_unlock_(keyShard->mutex);
+    }
     return result;
 }
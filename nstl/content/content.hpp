@@ -24,8 +24,12 @@ static const ContentRoot CONTENT_ROOT_ZERO = {0u};
 static const ContentId CONTENT_ID_ZERO = {{0u, 0u}};
 static const ContentKey CONTENT_KEY_ZERO = {{0u}, {{0u, 0u}}};
 
+// Mapped views come from content_submit_mapping, which FileStream uses on
+// Linux and macOS only: on Windows a live view pins its file against
+// deletion and rename-over, so FileStream copies every file there.
 enum ContentViewFlags {
     ContentViewFlags_None = 0,
+    ContentViewFlags_Mapped = (1u << 0), // read-only file pages, no trailing NUL
 };
 
 struct ContentView {
@@ -40,11 +44,14 @@ struct ContentStoreDesc {
     Arena* arena;
     U32 initialBlobCapacity;
     U32 initialKeyCapacity;
+    U32 maxBlobCapacity; // 0 = CONTENT_DEFAULT_MAX_BLOB_CAPACITY; address space is reserved for this many
+    U32 maxKeyCapacity;  // 0 = CONTENT_DEFAULT_MAX_KEY_CAPACITY
+    U32 shardCount;      // 0 = CONTENT_DEFAULT_SHARD_COUNT; rounded up to a power of two, 1 = one lock for everything
 };
 
 struct ContentStats {
     U64 payloadBytes;
-    U64 committedBytes;
+    U64 committedBytes; // what blobs hold: their heap size class when small, whole pages when mapped
     U32 blobCount;
     U32 keyCount;
     U32 evictCount;
@@ -68,10 +75,25 @@ void content_store_destroy(ContentStore* store);
 ContentRoot content_root_alloc(ContentStore* store);
 void content_root_release(ContentStore* store, ContentRoot root);
 ContentHash content_submit_bytes(ContentStore* store, ContentKey key, const void* data, U64 size, StringU8 debugName);
+// Adopts a read-only file mapping as the blob for the bytes in range and
+// hashes them in place; the store unmaps it when the blob goes. On a dedupe
+// or failure it is unmapped right away and outAdopted (optional) stays 0:
+// the hash then names a blob the caller does not own. The bytes are only as
+// stable as the file, and a truncation faults readers past the new end.
+ContentHash content_submit_mapping(ContentStore* store,
+                                   ContentKey key,
+                                   OS_FileMapping mapping,
+                                   RangeU64 range,
+                                   StringU8 debugName,
+                                   B32* outAdopted);
 ContentHash content_hash_from_key(ContentStore* store, ContentKey key, U64 rewindCount);
 ContentView content_view_hash(ContentStore* store, ContentHash hash);
 B32 content_retain_hash(ContentStore* store, ContentHash hash);
 void content_release_hash(ContentStore* store, ContentHash hash);
+// For blobs whose bytes stopped matching their hash, i.e. a mapped file
+// rewritten in place. Views miss from now on, the bytes go once nothing
+// retains them, and submitting the same bytes again refills the blob.
+void content_invalidate_hash(ContentStore* store, ContentHash hash);
 void content_touch_hash(ContentStore* store, ContentHash hash, U64 frameIndex);
 void content_tick_gc(ContentStore* store, U64 frameIndex, U64 targetBytes);
 ContentStats content_stats(ContentStore* store);
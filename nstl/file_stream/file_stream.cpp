@@ -1,4 +1,8 @@
 #define FILE_STREAM_DEFAULT_CHECK_INTERVAL_NS (250ull * 1000000ull)
+#define FILE_STREAM_MAX_WATCH_DIRS 64u
+#define FILE_STREAM_MAX_WATCH_EVENTS 256u
+#define FILE_STREAM_NO_WATCH 0xFFFFFFFFu
+#define FILE_STREAM_WATCHED_POLL_FACTOR 8u
 
 static const RangeU64 FILE_STREAM_FULL_RANGE = {0u, UINT64_MAX};
 
@@ -13,8 +17,26 @@ struct FileNode {
     U64 checkIntervalNs;
     U64 lastWriteTimestampNs;
     U64 lastWriteSize;
+    U64 fileId; // OS_FileInfo::fileId at the last publish
     FileStatus status;
     U32 flags;
+    B32 mapped;    // hash is this file's own adopted mapping, so rewriting the file rewrites the blob
+    B32 replaced;  // seen replaced by a new file (rename over) since the first load
+    B32 rewritten; // seen rewritten in place; copied from then on
+    B32 stale;     // blob was invalidated under it by another path; reload even if unchanged
+    U32 watchIndex; // into FileStream::watches, FILE_STREAM_NO_WATCH past the directory cap
+    U64 nameHash;   // of the entry name inside that directory, matched against watch events
+    B32 changed;    // named by a watch event since its last check
+};
+
+// One per directory holding watched files. Files whose directory has a live
+// watch are re-checked when an event names them, when their last load
+// failed, and otherwise only every FILE_STREAM_WATCHED_POLL_FACTOR intervals:
+// some filesystems (NFS, SMB, many bind mounts) accept a watch and never
+// report. The rest keep polling on their interval.
+struct FileStreamWatch {
+    StringU8 directory;
+    OS_Handle watch; // zero: no notification here, poll
 };
 
 struct FileStream {
@@ -24,6 +46,9 @@ struct FileStream {
     SlotMap files;
     U32 scanCursor;
     U64 defaultCheckIntervalNs;
+    U64 mapMinSize;
+    FileStreamWatch watches[FILE_STREAM_MAX_WATCH_DIRS];
+    U32 watchCount;
     FileStreamStats stats;
 };
 
@@ -37,13 +62,13 @@ static B32 file_stream_range_equal_(RangeU64 a, RangeU64 b) {
 }
 
 static ContentId file_stream_content_id_from_path_range_(StringU8 path, RangeU64 range) {
-    ContentId result = CONTENT_ID_ZERO;
     U64 rangeValues[2] = {range.min, range.max};
-    result.u64[0] = hash_fnv1a(path.data, path.size, 1469598103934665603ull ^ 0xD6E8FEB86659FD93ull);
-    result.u64[1] = hash_fnv1a(rangeValues, sizeof(rangeValues), result.u64[0] ^ 0xA0761D6478BD642Full);
-    if (result.u64[0] == 0u && result.u64[1] == 0u) {
-        result.u64[0] = 1u;
-    }
+    Hash128State state;
+    hash128_begin(&state, 0xD6E8FEB86659FD93ull);
+    hash128_update(&state, path.data, path.size);
+    hash128_update(&state, rangeValues, sizeof(rangeValues));
+    Hash128 hash = hash128_end(&state);
+    ContentId result = {{hash.u64[0], hash.u64[1]}};
     return result;
 }
 
@@ -62,11 +87,8 @@ static FileNode* file_stream_find_path_range_(FileStream* stream,
         return 0;
     }
 
-    for (U32 slot = 0u; slot < stream->files.capacity; ++slot) {
-        if (!slot_map_is_occupied(&stream->files, slot)) {
-            continue;
-        }
-
+    for (U32 at = 0u; at < stream->files.count; ++at) {
+        U32 slot = stream->files.dense[at];
         FileNode* node = (FileNode*)slot_map_item_at(&stream->files, slot);
         if (node && str8_equal(node->path, path) && file_stream_range_equal_(node->range, range)) {
             if (outHandle) {
@@ -80,6 +102,85 @@ static FileNode* file_stream_find_path_range_(FileStream* stream,
     return 0;
 }
 
+static U64 file_stream_name_hash_(StringU8 name) {
+    return hash64_from_bytes(name.data, name.size, 0x9E3779B97F4A7C15ull);
+}
+
+// Splits path at its last separator; a bare name lives in ".".
+static StringU8 file_stream_split_path_(StringU8 path, StringU8* outName) {
+    U64 split = path.size;
+    while (split > 0u && path.data[split - 1u] != '/' && path.data[split - 1u] != '\\') {
+        split -= 1u;
+    }
+    *outName = str8(path.data + split, path.size - split);
+    if (split == 0u) {
+        return str8(".");
+    }
+    return str8(path.data, (split == 1u) ? 1u : split - 1u);
+}
+
+static void file_stream_attach_watch_(FileStream* stream, FileNode* node) {
+    StringU8 name = STR8_NIL;
+    StringU8 directory = file_stream_split_path_(node->path, &name);
+    node->nameHash = file_stream_name_hash_(name);
+    node->watchIndex = FILE_STREAM_NO_WATCH;
+    for (U32 index = 0u; index < stream->watchCount; ++index) {
+        if (str8_equal(stream->watches[index].directory, directory)) {
+            node->watchIndex = index;
+            return;
+        }
+    }
+    if (stream->watchCount == FILE_STREAM_MAX_WATCH_DIRS) {
+        return;
+    }
+
+    // A failed watch is kept too, so the directory is not retried per file.
+    FileStreamWatch* watch = stream->watches + stream->watchCount;
+    watch->directory = str8_cpy(stream->arena, directory);
+    watch->watch = OS_watch_directory((const char*)watch->directory.data);
+    node->watchIndex = stream->watchCount;
+    stream->watchCount += 1u;
+}
+
+static B32 file_stream_node_watched_(FileStream* stream, FileNode* node) {
+    return (node->watchIndex != FILE_STREAM_NO_WATCH && stream->watches[node->watchIndex].watch.handle) ? 1 : 0;
+}
+
+static void file_stream_mark_changed_(FileStream* stream, U32 watchIndex, U64 nameHash, B32 wholeDirectory) {
+    for (U32 at = 0u; at < stream->files.count; ++at) {
+        FileNode* node = (FileNode*)slot_map_item_at(&stream->files, stream->files.dense[at]);
+        if (node && node->watchIndex == watchIndex && (wholeDirectory || node->nameHash == nameHash)) {
+            node->changed = 1;
+        }
+    }
+}
+
+static void file_stream_poll_watches_(FileStream* stream) {
+    Temp scratch = get_scratch(0, 0);
+    if (!scratch.arena) {
+        return;
+    }
+    DEFER_REF(temp_end(&scratch));
+
+    OS_WatchEvent* events = ARENA_PUSH_ARRAY(scratch.arena, OS_WatchEvent, FILE_STREAM_MAX_WATCH_EVENTS);
+    for (U32 index = 0u; index < stream->watchCount; ++index) {
+        FileStreamWatch* watch = stream->watches + index;
+        if (!watch->watch.handle) {
+            continue;
+        }
+        U32 eventCount = OS_poll_watch_events(watch->watch, scratch.arena, events, FILE_STREAM_MAX_WATCH_EVENTS);
+        for (U32 at = 0u; at < eventCount; ++at) {
+            B32 wholeDirectory = (events[at].flags & (OS_WatchEvent_Rescan | OS_WatchEvent_Closed)) ? 1 : 0;
+            file_stream_mark_changed_(stream, index, file_stream_name_hash_(events[at].name), wholeDirectory);
+            // The directory went away; its files drop back to polling.
+            if (events[at].flags & OS_WatchEvent_Closed) {
+                OS_unwatch_directory(watch->watch);
+                watch->watch.handle = 0;
+            }
+        }
+    }
+}
+
 static RangeU64 file_stream_read_range_from_info_(RangeU64 requested, OS_FileInfo info) {
     RangeU64 result = {};
     U64 fileSize = info.size;
@@ -96,6 +197,46 @@ static RangeU64 file_stream_read_range_from_info_(RangeU64 requested, OS_FileInf
     return result;
 }
 
+// Other paths may have deduped onto the same mapped blob; they reload too
+// rather than wait for an event of their own.
+static void file_stream_invalidate_mapped_(FileStream* stream, ContentHash hash) {
+    content_invalidate_hash(stream->content, hash);
+    for (U32 at = 0u; at < stream->files.count; ++at) {
+        FileNode* node = (FileNode*)slot_map_item_at(&stream->files, stream->files.dense[at]);
+        if (node && content_hash_equal(node->hash, hash)) {
+            node->changed = 1;
+            node->stale = 1;
+        }
+    }
+}
+
+// Mapping a file that is later truncated in place faults every reader past
+// the new end (SIGBUS). So only paths seen replaced by rename are mapped:
+// the mapping then pins the old file, whose bytes never change. The first
+// in-place rewrite of a mapped path is caught at its next check; the path
+// is copied from then on. Without a file identity nothing is mapped.
+// Windows never maps: a live view keeps the old file from being deleted or
+// renamed over, so the next save of the path would fail.
+static B32 file_stream_may_map_(FileStream* stream, FileNode* node, OS_FileInfo info, U64 readSize) {
+#if defined(PLATFORM_OS_WINDOWS)
+    (void)stream;
+    (void)node;
+    (void)info;
+    (void)readSize;
+    return 0;
+#else
+    return (stream->mapMinSize != 0u && readSize != 0u && readSize >= stream->mapMinSize &&
+            info.fileId != 0u && node->replaced && !node->rewritten) ? 1 : 0;
+#endif
+}
+
+static B32 file_stream_info_matches_(OS_FileInfo a, OS_FileInfo b) {
+    return (a.exists && b.exists &&
+            a.lastWriteTimestampNs == b.lastWriteTimestampNs &&
+            a.size == b.size &&
+            a.fileId == b.fileId) ? 1 : 0;
+}
+
 static void file_stream_mark_error_(FileNode* node) {
     if (node) {
         node->status = FileStatus_Error;
@@ -103,6 +244,67 @@ static void file_stream_mark_error_(FileNode* node) {
     }
 }
 
+static void file_stream_publish_(FileStream* stream, FileNode* node, ContentHash hash, OS_FileInfo info, U64 nowNs) {
+    node->lastCheckNs = nowNs;
+    node->lastWriteTimestampNs = info.lastWriteTimestampNs;
+    node->lastWriteSize = info.size;
+    node->fileId = info.fileId;
+    node->stale = 0;
+    node->status = FileStatus_Ready;
+    node->flags &= ~FileViewFlags_ReloadFailed;
+
+    if (!content_hash_equal(node->hash, hash)) {
+        node->hash = hash;
+        node->lastGoodHash = hash;
+        node->generation += 1u;
+        if (node->generation == 0u) {
+            node->generation = 1u;
+        }
+        stream->stats.publishCount += 1u;
+    }
+}
+
+// Zero-copy load: the blob is the file's own read-only pages, hashed in
+// place. A write landing while they are hashed shows up in the stat taken
+// after, and the just-published hash is dropped again. When the bytes
+// dedupe onto a blob that already existed the mapping is gone and the node
+// is not marked mapped: that blob is not this file's to invalidate. Caller
+// opened file.
+static B32 file_stream_load_mapped_(FileStream* stream,
+                                    FileNode* node,
+                                    OS_Handle file,
+                                    OS_FileInfo preInfo,
+                                    RangeU64 readRange,
+                                    U64 nowNs) {
+    OS_FileMapping mapping = OS_file_map_ro(file);
+    OS_file_close(file);
+    if (!mapping.ptr || mapping.length != preInfo.size) {
+        OS_file_unmap(mapping);
+        file_stream_mark_error_(node);
+        return 0;
+    }
+
+    B32 adopted = 0;
+    ContentHash hash = content_submit_mapping(stream->content, node->key, mapping, readRange, node->path, &adopted);
+    if (content_hash_is_zero(hash)) {
+        file_stream_mark_error_(node);
+        return 0;
+    }
+
+    OS_FileInfo postInfo = OS_get_file_info((const char*)node->path.data);
+    if (!file_stream_info_matches_(preInfo, postInfo)) {
+        if (adopted) {
+            file_stream_invalidate_mapped_(stream, hash);
+        }
+        file_stream_mark_error_(node);
+        return 0;
+    }
+
+    file_stream_publish_(stream, node, hash, postInfo, nowNs);
+    node->mapped = adopted;
+    return 1;
+}
+
 static B32 file_stream_load_stable_(FileStream* stream, FileNode* node, U64 nowNs) {
     if (!stream || !stream->content || !node || str8_is_nil(node->path) || node->path.size == 0u) {
         return 0;
@@ -114,13 +316,36 @@ static B32 file_stream_load_stable_(FileStream* stream, FileNode* node, U64 nowN
         return 0;
     }
 
-    if (node->status == FileStatus_Ready &&
-        preInfo.lastWriteTimestampNs == node->lastWriteTimestampNs &&
-        preInfo.size == node->lastWriteSize) {
+    // A mapped blob shared with another path is dropped when that path's
+    // file is rewritten, so an unchanged file still reloads if marked stale.
+    B32 unchanged = (preInfo.lastWriteTimestampNs == node->lastWriteTimestampNs &&
+                     preInfo.size == node->lastWriteSize &&
+                     preInfo.fileId == node->fileId) ? 1 : 0;
+    if (node->status == FileStatus_Ready && unchanged && !node->stale) {
         node->lastCheckNs = nowNs;
         return 1;
     }
 
+    // How the file changed decides whether it may be mapped from now on.
+    if (!unchanged && node->fileId != 0u && preInfo.fileId != 0u) {
+        if (preInfo.fileId != node->fileId) {
+            node->replaced = 1;
+        } else {
+            node->rewritten = 1;
+        }
+    }
+
+    // Rewritten in place under the mapping: it may already show the new
+    // bytes (or none past a truncation), so it cannot stand in as the last
+    // good version. A replaced file's mapping still holds the old bytes.
+    if (node->mapped) {
+        if (preInfo.fileId == node->fileId) {
+            file_stream_invalidate_mapped_(stream, node->hash);
+            node->changed = 0;
+        }
+        node->mapped = 0;
+    }
+
     RangeU64 readRange = file_stream_read_range_from_info_(node->range, preInfo);
     U64 readSize = readRange.max - readRange.min;
 
@@ -130,6 +355,10 @@ static B32 file_stream_load_stable_(FileStream* stream, FileNode* node, U64 nowN
         return 0;
     }
 
+    if (file_stream_may_map_(stream, node, preInfo, readSize)) {
+        return file_stream_load_mapped_(stream, node, file, preInfo, readRange, nowNs);
+    }
+
     Temp scratch = get_scratch(0, 0);
     if (!scratch.arena) {
         OS_file_close(file);
@@ -152,10 +381,7 @@ static B32 file_stream_load_stable_(FileStream* stream, FileNode* node, U64 nowN
     OS_file_close(file);
 
     OS_FileInfo postInfo = OS_get_file_info((const char*)node->path.data);
-    if (bytesRead != readSize ||
-        !postInfo.exists ||
-        postInfo.lastWriteTimestampNs != preInfo.lastWriteTimestampNs ||
-        postInfo.size != preInfo.size) {
+    if (bytesRead != readSize || !file_stream_info_matches_(preInfo, postInfo)) {
         file_stream_mark_error_(node);
         return 0;
     }
@@ -167,22 +393,7 @@ static B32 file_stream_load_stable_(FileStream* stream, FileNode* node, U64 nowN
         return 0;
     }
 
-    node->lastCheckNs = nowNs;
-    node->lastWriteTimestampNs = postInfo.lastWriteTimestampNs;
-    node->lastWriteSize = postInfo.size;
-    node->status = FileStatus_Ready;
-    node->flags &= ~FileViewFlags_ReloadFailed;
-
-    if (!content_hash_equal(node->hash, hash)) {
-        node->hash = hash;
-        node->lastGoodHash = hash;
-        node->generation += 1u;
-        if (node->generation == 0u) {
-            node->generation = 1u;
-        }
-        stream->stats.publishCount += 1u;
-    }
-
+    file_stream_publish_(stream, node, hash, postInfo, nowNs);
     return 1;
 }
 
@@ -198,6 +409,7 @@ B32 file_stream_create(const FileStreamDesc* desc, FileStream* outStream) {
     outStream->defaultCheckIntervalNs = desc->defaultCheckIntervalNs ?
         desc->defaultCheckIntervalNs :
         FILE_STREAM_DEFAULT_CHECK_INTERVAL_NS;
+    outStream->mapMinSize = desc->mapMinSize;
 
     if (outStream->root.id == 0u) {
         MEMSET(outStream, 0, sizeof(*outStream));
@@ -231,6 +443,12 @@ void file_stream_destroy(FileStream* stream) {
         return;
     }
 
+    for (U32 index = 0u; index < stream->watchCount; ++index) {
+        if (stream->watches[index].watch.handle) {
+            OS_unwatch_directory(stream->watches[index].watch);
+        }
+    }
+
     if (stream->content && stream->root.id != 0u) {
         content_root_release(stream->content, stream->root);
     }
@@ -263,6 +481,7 @@ ContentKey file_key_from_path_range(FileStream* stream, StringU8 path, RangeU64
     node->checkIntervalNs = checkIntervalNs ? checkIntervalNs : stream->defaultCheckIntervalNs;
     node->generation = 0u;
     node->status = FileStatus_Null;
+    file_stream_attach_watch_(stream, node);
 
     (void)slotIndex;
     (void)generation;
@@ -308,6 +527,7 @@ FileHandle file_watch(FileStream* stream, StringU8 path, U64 checkIntervalNs) {
     node->checkIntervalNs = checkIntervalNs ? checkIntervalNs : stream->defaultCheckIntervalNs;
     node->generation = 0u;
     node->status = FileStatus_Null;
+    file_stream_attach_watch_(stream, node);
 
     result.index = slotIndex;
     result.generation = generation;
@@ -316,28 +536,37 @@ FileHandle file_watch(FileStream* stream, StringU8 path, U64 checkIntervalNs) {
 }
 
 void file_stream_tick(FileStream* stream, U64 nowNs, U32 maxChecks) {
-    if (!stream || stream->files.capacity == 0u || maxChecks == 0u) {
+    if (!stream || stream->files.count == 0u || maxChecks == 0u) {
         return;
     }
 
+    file_stream_poll_watches_(stream);
+
+    // Round-robin over the dense live list; a release in between only
+    // shifts the cursor onto a neighbour. Watched files wait for an event
+    // or the slow safety poll unless their last load failed, polled ones
+    // for their interval.
     U32 checked = 0u;
     U32 attempts = 0u;
-    while (checked < maxChecks && attempts < stream->files.capacity) {
-        U32 slot = stream->scanCursor % stream->files.capacity;
-        stream->scanCursor = (slot + 1u) % stream->files.capacity;
+    while (checked < maxChecks && attempts < stream->files.count) {
+        U32 at = stream->scanCursor % stream->files.count;
+        stream->scanCursor = (at + 1u) % stream->files.count;
         attempts += 1u;
 
-        if (!slot_map_is_occupied(&stream->files, slot)) {
-            continue;
-        }
-
+        U32 slot = stream->files.dense[at];
         FileNode* node = (FileNode*)slot_map_item_at(&stream->files, slot);
         if (!node) {
             continue;
         }
-        if (node->lastCheckNs != 0u && nowNs - node->lastCheckNs < node->checkIntervalNs) {
+        U64 intervalNs = node->checkIntervalNs;
+        if (file_stream_node_watched_(stream, node) && node->status == FileStatus_Ready) {
+            intervalNs *= FILE_STREAM_WATCHED_POLL_FACTOR;
+        }
+        B32 intervalDue = (node->lastCheckNs == 0u || nowNs - node->lastCheckNs >= intervalNs) ? 1 : 0;
+        if (!node->changed && !intervalDue) {
             continue;
         }
+        node->changed = 0;
 
         checked += 1u;
         stream->stats.checkedCount += 1u;
@@ -356,14 +585,17 @@ FileView file_view(FileStream* stream, FileHandle handle) {
 
     ContentHash hash = content_hash_is_zero(node->hash) ? node->lastGoodHash : node->hash;
     ContentView content = content_view_hash(stream->content, hash);
+    result.flags = node->flags;
     if (content.valid) {
         result.data = content.data;
         result.size = content.size;
         result.key = node->key;
         result.hash = content.hash;
         result.generation = node->generation;
+        if (content.flags & ContentViewFlags_Mapped) {
+            result.flags |= FileViewFlags_Mapped;
+        }
     }
-    result.flags = node->flags;
     result.status = node->status;
     return result;
 }
@@ -18,6 +18,7 @@ enum FileStatus {
 enum FileViewFlags {
     FileViewFlags_None = 0,
     FileViewFlags_ReloadFailed = (1u << 0),
+    FileViewFlags_Mapped = (1u << 1), // data is the file's own pages, no trailing NUL
 };
 
 struct FileView {
@@ -35,6 +36,12 @@ struct FileStreamDesc {
     ContentStore* content;
     U32 initialFileCapacity;
     U64 defaultCheckIntervalNs;
+    // 0 = always copy. Files at least this big are published as read-only
+    // mappings once their path has been seen replaced by rename (a new file
+    // identity) and never rewritten in place, so a truncating save cannot
+    // fault readers. Ignored on Windows, where a live view would block the
+    // next save of the path (see ContentViewFlags_Mapped).
+    U64 mapMinSize;
 };
 
 struct FileStreamStats {
@@ -0,0 +1,1270 @@
+//
+// Linux os_core backend: memory with transparent and explicit huge pages,
+// threads, futex mutexes, condition variables and barriers, file I/O and
+// mappings, inotify directory watches, sysfs core topology, entry point.
+//
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <errno.h>
+
+// ////////////////////////
+// Globals
+
+OS_LINUX_State g_OS_LinuxState = {};
+
+// ////////////////////////
+// System Info
+
+OS_SystemInfo* OS_get_system_info() {
+    return &g_OS_LinuxState.systemInfo;
+}
+
+
+// ////////////////////////
+// Executable Path
+
+StringU8 OS_get_executable_directory(Arena* arena) {
+    if (!arena) {
+        return STR8_NIL;
+    }
+
+    Arena* excludes[] = {arena};
+    Temp scratch = get_scratch(excludes, ARRAY_COUNT(excludes));
+    if (!scratch.arena) {
+        return STR8_NIL;
+    }
+
+    DEFER_REF(temp_end(&scratch));
+
+    char* pathBuffer = ARENA_PUSH_ARRAY(scratch.arena, char, PATH_MAX + 1);
+    ssize_t length = readlink("/proc/self/exe", pathBuffer, PATH_MAX);
+    if (length <= 0) {
+        return STR8_NIL;
+    }
+    pathBuffer[length] = 0;
+
+    U64 pathLength = (U64) C_STR_LEN(pathBuffer);
+    S64 slashIndex = (S64) pathLength - 1;
+    while (slashIndex >= 0 && pathBuffer[slashIndex] != '/') {
+        slashIndex -= 1;
+    }
+
+    U64 directoryLength = 0;
+    if (slashIndex >= 0) {
+        pathBuffer[slashIndex] = '\0';
+        directoryLength = (U64) slashIndex;
+    } else {
+        pathBuffer[0] = '\0';
+        directoryLength = 0;
+    }
+
+    StringU8 directory = str8((U8*) pathBuffer, directoryLength);
+    return str8_cpy(arena, directory);
+}
+
+void OS_set_environment_variable(StringU8 name, StringU8 value) {
+    if (str8_is_nil(name) || str8_is_empty(name)) {
+        return;
+    }
+    if (str8_is_nil(value)) {
+        return;
+    }
+
+    setenv((const char*) name.data, (const char*) value.data, 1);
+}
+
+StringU8 OS_get_environment_variable(Arena* arena, StringU8 name) {
+    if (!arena || !name.data || name.size == 0) {
+        return STR8_NIL;
+    }
+
+    const char* rawValue = getenv((const char*) name.data);
+    if (!rawValue) {
+        return STR8_NIL;
+    }
+
+    return str8_cpy(arena, str8(rawValue));
+}
+
+
+B32 OS_library_open(StringU8 path, OS_SharedLibrary* outLibrary) {
+    if (!outLibrary) {
+        return 0;
+    }
+
+    outLibrary->handle = 0;
+    if (!path.data || path.size == 0) {
+        return 0;
+    }
+
+    void* handle = dlopen((const char*) path.data, RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        return 0;
+    }
+
+    outLibrary->handle = handle;
+    return 1;
+}
+
+void OS_library_close(OS_SharedLibrary library) {
+    if (!library.handle) {
+        return;
+    }
+
+    dlclose(library.handle);
+}
+
+void* OS_library_load_symbol(OS_SharedLibrary library, StringU8 symbolName) {
+    if (!library.handle || !symbolName.data || symbolName.size == 0) {
+        return 0;
+    }
+
+    return dlsym(library.handle, (const char*) symbolName.data);
+}
+
+StringU8 OS_library_last_error(Arena* arena) {
+    const char* error = dlerror();
+    if (!error) {
+        return STR8_NIL;
+    }
+
+    if (!arena) {
+        return str8(error);
+    }
+
+    return str8_cpy(arena, str8(error));
+}
+
+S32 OS_execute(StringU8 command) {
+    if (!command.data || command.size == 0) {
+        return -1;
+    }
+
+    return (S32) system((const char*) command.data);
+}
+
+
+// ////////////////////////
+// Time
+
+U64 OS_get_time_microseconds() {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    U64 result = ((U64) t.tv_nsec / THOUSAND(1ULL)) + ((U64) t.tv_sec * MILLION(1ULL));
+    return result;
+}
+
+U64 OS_get_time_nanoseconds() {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    U64 result = (U64) t.tv_sec * BILLION(1ULL) + (U64) t.tv_nsec;
+    return result;
+}
+
+#if defined(PLATFORM_ARCH_X64)
+U64 OS_rdtsc_relaxed() { return __builtin_ia32_rdtsc(); }
+U64 OS_rdtscp_serialized() { U32 aux; return __builtin_ia32_rdtscp(&aux); }
+#endif
+#if defined(PLATFORM_ARCH_ARM64)
+U64 OS_rdtsc_relaxed() {
+    U64 value = 0;
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+#else
+#error "ARM64 counter reads require Clang or GCC inline assembly"
+#endif
+    return value;
+}
+
+U64 OS_rdtscp_serialized() {
+    U64 value = 0;
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+    __asm__ __volatile__("isb");
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    __asm__ __volatile__("isb");
+#else
+#error "ARM64 counter reads require Clang or GCC inline assembly"
+#endif
+    return value;
+}
+#endif
+
+U64 OS_get_counter_frequency_hz() {
+#if defined(PLATFORM_ARCH_ARM64)
+    U64 freq = 0;
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(freq));
+#endif
+    return freq;
+#else
+    return g_OS_LinuxState.counterFrequencyHz;
+#endif
+}
+
+// The kernel does not export the TSC rate, so measure it against
+// CLOCK_MONOTONIC_RAW over a short window. Invariant TSCs make one
+// measurement good for the process lifetime.
+static U64 OS_LINUX_measure_tsc_frequency_() {
+#if defined(PLATFORM_ARCH_X64)
+    timespec start;
+    timespec end;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+    U64 tscStart = OS_rdtscp_serialized();
+    U64 elapsedNs = 0;
+    U64 tscEnd = tscStart;
+    do {
+        clock_gettime(CLOCK_MONOTONIC_RAW, &end);
+        tscEnd = OS_rdtscp_serialized();
+        elapsedNs = (U64) (end.tv_sec - start.tv_sec) * BILLION(1ULL) + (U64) end.tv_nsec - (U64) start.tv_nsec;
+    } while (elapsedNs < MILLION(10ULL));
+    return (tscEnd - tscStart) * BILLION(1ULL) / elapsedNs;
+#else
+    return 0;
+#endif
+}
+
+void OS_sleep_milliseconds(U32 milliseconds) {
+    struct timespec req = {0, 0};
+    req.tv_sec = (time_t)(milliseconds / 1000);
+    req.tv_nsec = (long)((milliseconds % 1000) * MILLION(1ULL));
+    while (nanosleep(&req, &req) == -1 && errno == EINTR) {
+    }
+}
+
+
+// ////////////////////////
+// Aborting
+
+void OS_abort(S32 exit_code) {
+    exit(exit_code);
+}
+
+
+// ////////////////////////
+// Memory allocation
+
+// Reserved ranges are PROT_NONE and MAP_NORESERVE, so they count against
+// neither RSS nor the overcommit limit until committed.
+void* OS_reserve(U64 size) {
+    void* result = mmap(0, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (result == MAP_FAILED) {
+        result = 0;
+    }
+    return result;
+}
+
+B32 OS_commit(void* ptr, U64 size) {
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+// MADV_DONTNEED drops the pages immediately; a later commit sees zeroes.
+void OS_decommit(void* ptr, U64 size) {
+    madvise(ptr, size, MADV_DONTNEED);
+    mprotect(ptr, size, PROT_NONE);
+}
+
+void OS_release(void* ptr, U64 size) {
+    munmap(ptr, size);
+}
+
+// hugetlbfs pages come out of the pool set aside with vm.nr_hugepages and are
+// accounted at mmap time, so a short pool fails here instead of SIGBUSing on
+// first touch. Without a pool the range is aligned to the PMD size and
+// madvised, and the fault path backs each committed 2 MB step with a huge
+// page when it can find one.
+void* OS_reserve_large(U64 size, U32* outKind) {
+    U64 largePageSize = g_OS_LinuxState.systemInfo.largePageSize;
+    *outKind = OS_LargePageKind_None;
+    if (largePageSize == 0u || (size & (largePageSize - 1u)) != 0u) {
+        return OS_reserve(size);
+    }
+
+    void* pinned = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (pinned != MAP_FAILED) {
+        *outKind = OS_LargePageKind_Explicit;
+        return pinned;
+    }
+    if (!g_OS_LinuxState.transparentHugePages) {
+        return OS_reserve(size);
+    }
+
+    U8* raw = (U8*)OS_reserve(size + largePageSize);
+    if (!raw) {
+        return 0;
+    }
+    U8* aligned = (U8*)align_pow2((U64)raw, largePageSize);
+    if (aligned != raw) {
+        munmap(raw, (U64)(aligned - raw));
+    }
+    munmap(aligned + size, (U64)(raw + largePageSize - aligned));
+    if (madvise(aligned, size, MADV_HUGEPAGE) == 0) {
+        *outKind = OS_LargePageKind_Transparent;
+    }
+    return aligned;
+}
+
+
+// ////////////////////////
+// Threads and Synchronization
+
+static void* _OS_thread_entry_point(void* arg) {
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) arg;
+
+    thread_entry_point(entity->thread.func, entity->thread.args);
+    return 0;
+}
+
+OS_Handle OS_thread_create(OS_ThreadFunc* func, void* arg) {
+    OS_LINUX_Entity* entity = alloc_OS_entity();
+    entity->type = OS_LINUX_EntityType_Thread;
+    entity->thread.func = func;
+    entity->thread.args = arg;
+
+    int ret = pthread_create(&entity->thread.handle, NULL, _OS_thread_entry_point, (void*) entity);
+    if (ret != 0) {
+        free_OS_entity(entity);
+        entity = 0;
+    }
+
+    OS_Handle handle = {(U64*) entity};
+    return handle;
+}
+
+B32 OS_thread_join(OS_Handle thread) {
+    ASSERT_DEBUG(thread.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) (thread.handle);
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Thread);
+    int ret = pthread_join(entity->thread.handle, NULL);
+    free_OS_entity(entity);
+    return ret == 0;
+}
+
+void OS_thread_detach(OS_Handle thread) {
+    ASSERT_DEBUG(thread.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) (thread.handle);
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Thread);
+    pthread_detach(entity->thread.handle);
+    free_OS_entity(entity);
+}
+
+B32 OS_thread_set_affinity(OS_Handle thread, U32 osCoreIndex) {
+    ASSERT_DEBUG(thread.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) (thread.handle);
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Thread);
+    if (osCoreIndex >= CPU_SETSIZE) {
+        return 0;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(osCoreIndex, &set);
+    return pthread_setaffinity_np(entity->thread.handle, sizeof(set), &set) == 0;
+}
+
+void OS_thread_yield() {
+    sched_yield();
+}
+
+void OS_cpu_pause() {
+#if defined(PLATFORM_ARCH_ARM64)
+    __builtin_arm_yield();
+#elif defined(PLATFORM_ARCH_X64)
+    __builtin_ia32_pause();
+#else
+    __asm__ __volatile__("nop");
+#endif
+}
+
+U32 OS_get_thread_id_u32() {
+    return (U32) gettid();
+}
+
+// ////////////////////////
+// Futex Primitives
+
+static long OS_LINUX_futex_(U32* address, int op, U32 value) {
+    return syscall(SYS_futex, address, op, value, 0, 0, 0);
+}
+
+// Drepper's three-state mutex ("Futexes Are Tricky"): the uncontended
+// lock and unlock are one atomic each, and only a contended unlock pays
+// for the wake syscall.
+static void OS_LINUX_lock_(U32* state) {
+    U32 expected = OS_LINUX_MutexState_Unlocked;
+    if (ATOMIC_COMPARE_EXCHANGE(state, &expected, OS_LINUX_MutexState_Locked, 0, MEMORY_ORDER_ACQUIRE,
+                                MEMORY_ORDER_RELAXED)) {
+        return;
+    }
+    for (U32 spin = 0; spin < 64 && expected != OS_LINUX_MutexState_Contended; ++spin) {
+        OS_cpu_pause();
+        expected = OS_LINUX_MutexState_Unlocked;
+        if (ATOMIC_COMPARE_EXCHANGE(state, &expected, OS_LINUX_MutexState_Locked, 0, MEMORY_ORDER_ACQUIRE,
+                                    MEMORY_ORDER_RELAXED)) {
+            return;
+        }
+    }
+    while (ATOMIC_EXCHANGE(state, OS_LINUX_MutexState_Contended, MEMORY_ORDER_ACQUIRE) != OS_LINUX_MutexState_Unlocked) {
+        OS_LINUX_futex_(state, FUTEX_WAIT_PRIVATE, OS_LINUX_MutexState_Contended);
+    }
+}
+
+static void OS_LINUX_unlock_(U32* state) {
+    if (ATOMIC_EXCHANGE(state, OS_LINUX_MutexState_Unlocked, MEMORY_ORDER_RELEASE) == OS_LINUX_MutexState_Contended) {
+        OS_LINUX_futex_(state, FUTEX_WAKE_PRIVATE, 1);
+    }
+}
+
+OS_Handle OS_mutex_create() {
+    OS_LINUX_Entity* entity = alloc_OS_entity();
+    entity->type = OS_LINUX_EntityType_Mutex;
+    entity->mutex.state = OS_LINUX_MutexState_Unlocked;
+    OS_Handle handle = {(U64*) entity};
+    return handle;
+}
+
+void OS_mutex_destroy(OS_Handle mutex) {
+    ASSERT_DEBUG(mutex.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) (mutex.handle);
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Mutex);
+    ASSERT_DEBUG(entity->mutex.state == OS_LINUX_MutexState_Unlocked);
+    free_OS_entity(entity);
+}
+
+void OS_mutex_lock(OS_Handle mutex) {
+    ASSERT_DEBUG(mutex.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) (mutex.handle);
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Mutex);
+    OS_LINUX_lock_(&entity->mutex.state);
+}
+
+void OS_mutex_unlock(OS_Handle mutex) {
+    ASSERT_DEBUG(mutex.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) (mutex.handle);
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Mutex);
+    OS_LINUX_unlock_(&entity->mutex.state);
+}
+
+OS_Handle OS_condition_variable_create() {
+    OS_LINUX_Entity* entity = alloc_OS_entity();
+    entity->type = OS_LINUX_EntityType_ConditionVariable;
+    entity->conditionVariable.sequence = 0;
+
+    OS_Handle handle = {(U64*) entity};
+    return handle;
+}
+
+void OS_condition_variable_destroy(OS_Handle conditionVariable) {
+    ASSERT_DEBUG(conditionVariable.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) conditionVariable.handle;
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_ConditionVariable);
+    free_OS_entity(entity);
+}
+
+// The sequence is sampled while the mutex is still held, so a signal sent
+// between the unlock and the futex wait changes it and the wait returns at
+// once. Wakes may be spurious, as with pthread. The mutex is re-taken as
+// contended because other waiters may still be parked on it.
+void OS_condition_variable_wait(OS_Handle conditionVariable, OS_Handle mutex) {
+    ASSERT_DEBUG(conditionVariable.handle != 0);
+    ASSERT_DEBUG(mutex.handle != 0);
+
+    OS_LINUX_Entity* conditionEntity = (OS_LINUX_Entity*) conditionVariable.handle;
+    OS_LINUX_Entity* mutexEntity = (OS_LINUX_Entity*) mutex.handle;
+
+    ASSERT_DEBUG(conditionEntity->type == OS_LINUX_EntityType_ConditionVariable);
+    ASSERT_DEBUG(mutexEntity->type == OS_LINUX_EntityType_Mutex);
+
+    U32* sequence = &conditionEntity->conditionVariable.sequence;
+    U32 observed = ATOMIC_LOAD(sequence, MEMORY_ORDER_RELAXED);
+    OS_LINUX_unlock_(&mutexEntity->mutex.state);
+    OS_LINUX_futex_(sequence, FUTEX_WAIT_PRIVATE, observed);
+    while (ATOMIC_EXCHANGE(&mutexEntity->mutex.state, OS_LINUX_MutexState_Contended, MEMORY_ORDER_ACQUIRE) !=
+           OS_LINUX_MutexState_Unlocked) {
+        OS_LINUX_futex_(&mutexEntity->mutex.state, FUTEX_WAIT_PRIVATE, OS_LINUX_MutexState_Contended);
+    }
+}
+
+void OS_condition_variable_signal(OS_Handle conditionVariable) {
+    ASSERT_DEBUG(conditionVariable.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) conditionVariable.handle;
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_ConditionVariable);
+    ATOMIC_FETCH_ADD(&entity->conditionVariable.sequence, 1u, MEMORY_ORDER_RELEASE);
+    OS_LINUX_futex_(&entity->conditionVariable.sequence, FUTEX_WAKE_PRIVATE, 1);
+}
+
+void OS_condition_variable_broadcast(OS_Handle conditionVariable) {
+    ASSERT_DEBUG(conditionVariable.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) conditionVariable.handle;
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_ConditionVariable);
+    ATOMIC_FETCH_ADD(&entity->conditionVariable.sequence, 1u, MEMORY_ORDER_RELEASE);
+    OS_LINUX_futex_(&entity->conditionVariable.sequence, FUTEX_WAKE_PRIVATE, INT_MAX);
+}
+
+OS_Handle OS_barrier_create(U32 threadCount) {
+    ASSERT_DEBUG(threadCount > 0);
+    OS_LINUX_Entity* entity = alloc_OS_entity();
+    entity->type = OS_LINUX_EntityType_Barrier;
+    entity->barrier.threadCount = threadCount;
+    entity->barrier.arrived = 0;
+    entity->barrier.generation = 0;
+
+    OS_Handle handle = {(U64*) entity};
+    return handle;
+}
+
+void OS_barrier_destroy(OS_Handle barrierHandle) {
+    ASSERT_DEBUG(barrierHandle.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) barrierHandle.handle;
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Barrier);
+    free_OS_entity(entity);
+}
+
+// The generation is read before arriving, so the last arriver's reset of
+// the count can never be mistaken for the next round by a slow waiter.
+void OS_barrier_wait(OS_Handle barrierHandle) {
+    ASSERT_DEBUG(barrierHandle.handle != 0);
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) barrierHandle.handle;
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Barrier);
+
+    U32 generation = ATOMIC_LOAD(&entity->barrier.generation, MEMORY_ORDER_ACQUIRE);
+    U32 arrived = ATOMIC_FETCH_ADD(&entity->barrier.arrived, 1u, MEMORY_ORDER_ACQ_REL) + 1u;
+    if (arrived == entity->barrier.threadCount) {
+        ATOMIC_STORE(&entity->barrier.arrived, 0u, MEMORY_ORDER_RELAXED);
+        ATOMIC_FETCH_ADD(&entity->barrier.generation, 1u, MEMORY_ORDER_RELEASE);
+        OS_LINUX_futex_(&entity->barrier.generation, FUTEX_WAKE_PRIVATE, INT_MAX);
+        return;
+    }
+    while (ATOMIC_LOAD(&entity->barrier.generation, MEMORY_ORDER_ACQUIRE) == generation) {
+        OS_LINUX_futex_(&entity->barrier.generation, FUTEX_WAIT_PRIVATE, generation);
+    }
+}
+
+void OS_address_wait(U32* address, U32 expected) {
+    OS_LINUX_futex_(address, FUTEX_WAIT_PRIVATE, expected);
+}
+
+void OS_address_wake_one(U32* address) {
+    OS_LINUX_futex_(address, FUTEX_WAKE_PRIVATE, 1);
+}
+
+void OS_address_wake_all(U32* address) {
+    OS_LINUX_futex_(address, FUTEX_WAKE_PRIVATE, INT_MAX);
+}
+
+
+// ////////////////////////
+// File I/O
+
+B32 OS_create_directory(const char* path) {
+    if (!path) {
+        return 0;
+    }
+    if (mkdir(path, 0755) == 0) {
+        return 1;
+    }
+    return (errno == EEXIST) ? 1 : 0;
+}
+
+OS_Handle OS_file_open(const char* path, OS_FileOpenMode mode) {
+    int flags = 0;
+    // Permission bits for newly created files: 0666 = rw-rw-rw-.
+    int modeBits = 0666;
+
+    if (mode == OS_FileOpenMode_Read) {
+        flags |= O_RDONLY;
+    } else if (mode == OS_FileOpenMode_Write) {
+        flags |= O_WRONLY;
+    } else if (mode == OS_FileOpenMode_Create) {
+        flags |= (O_CREAT | O_WRONLY | O_TRUNC);
+    } else {
+        ASSERT_ALWAYS(false && "Invalid OS_FileOpenMode");
+    }
+
+    int fd = open(path, flags, modeBits);
+    if (fd == -1) {
+        OS_Handle empty = {0};
+        return empty;
+    }
+
+    OS_LINUX_Entity* fileEntity = alloc_OS_entity();
+    fileEntity->type = OS_LINUX_EntityType_File;
+    fileEntity->file.fd = fd;
+    OS_Handle handle = {};
+    handle.handle = (U64*) fileEntity;
+    return handle;
+}
+
+void OS_file_close(OS_Handle fileHandle) {
+    if (!fileHandle.handle) {
+        return;
+    }
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) fileHandle.handle;
+    if (entity->type == OS_LINUX_EntityType_File) {
+        if (entity->file.fd != -1) {
+            close(entity->file.fd);
+        }
+    }
+    free_OS_entity(entity);
+}
+
+U64 OS_file_size(OS_Handle fileHandle) {
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) fileHandle.handle;
+    ASSERT_DEBUG(entity && entity->type == OS_LINUX_EntityType_File);
+    struct stat fileStat;
+    if (fstat(entity->file.fd, &fileStat) != 0) {
+        return 0;
+    }
+    return (U64) fileStat.st_size;
+}
+
+void OS_file_set_hints(OS_Handle fileHandle, U64 hints) {
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) fileHandle.handle;
+    ASSERT_DEBUG(entity && entity->type == OS_LINUX_EntityType_File);
+    // No per-descriptor cache bypass short of O_DIRECT, so NoCache is ignored.
+    posix_fadvise(entity->file.fd, 0, 0,
+                  FLAGS_HAS(hints, OS_FileHint_Sequential) ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_NORMAL);
+}
+
+OS_FileMapping OS_file_map_ro(OS_Handle fileHandle) {
+    OS_FileMapping mapping = {0, 0};
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) fileHandle.handle;
+    ASSERT_DEBUG(entity && entity->type == OS_LINUX_EntityType_File);
+    U64 length = OS_file_size(fileHandle);
+    if (length == 0) {
+        return mapping;
+    }
+    void* mappedPtr = mmap(0, length, PROT_READ, MAP_PRIVATE, entity->file.fd, 0);
+    if (mappedPtr == MAP_FAILED) {
+        return mapping;
+    }
+    mapping.ptr = mappedPtr;
+    mapping.length = length;
+    return mapping;
+}
+
+void OS_file_unmap(OS_FileMapping mapping) {
+    if (mapping.ptr && mapping.length) {
+        munmap(mapping.ptr, mapping.length);
+    }
+}
+
+static B32 OS_is_seekable(int fd) {
+    return lseek(fd, 0, SEEK_CUR) != -1;
+}
+
+U64 OS_file_read(OS_Handle fileHandle, RangeU64 range, void* dst) {
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) fileHandle.handle;
+    ASSERT_DEBUG(entity && entity->type == OS_LINUX_EntityType_File);
+    ASSERT_DEBUG(OS_is_seekable(entity->file.fd));
+
+    U8* destinationBytes = (U8*) dst;
+    U64 totalTransferred = 0;
+    U64 bytesToTransfer = (range.max >= range.min) ? (range.max - range.min) : 0;
+
+    while (totalTransferred < bytesToTransfer) {
+        size_t chunkSize = (size_t) MIN(bytesToTransfer - totalTransferred, (U64)SSIZE_MAX);
+        ssize_t bytesRead = pread(entity->file.fd, destinationBytes + totalTransferred,
+                                  chunkSize, (off_t) (range.min + totalTransferred));
+        if (bytesRead < 0)
+            return totalTransferred;
+        if (bytesRead == 0)
+            break;
+        totalTransferred += (U64) bytesRead;
+    }
+    return totalTransferred;
+}
+
+U64 OS_file_read(OS_Handle fileHandle, U64 size, void* dst) {
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) fileHandle.handle;
+    ASSERT_DEBUG(entity && entity->type == OS_LINUX_EntityType_File);
+    ASSERT_DEBUG(!OS_is_seekable(entity->file.fd));
+
+    U8* destinationBytes = (U8*) dst;
+    U64 totalTransferred = 0;
+
+    while (totalTransferred < size) {
+        size_t chunkSize = (size_t) MIN(size - totalTransferred, (U64)SSIZE_MAX);
+        ssize_t bytesRead = read(entity->file.fd, destinationBytes + totalTransferred, chunkSize);
+        if (bytesRead < 0)
+            return totalTransferred;
+        if (bytesRead == 0)
+            break;
+        totalTransferred += (U64) bytesRead;
+    }
+    return totalTransferred;
+}
+
+U64 OS_file_write(OS_Handle fileHandle, RangeU64 range, const void* src) {
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) fileHandle.handle;
+    ASSERT_DEBUG(entity && entity->type == OS_LINUX_EntityType_File);
+    ASSERT_DEBUG(OS_is_seekable(entity->file.fd));
+
+    const U8* sourceBytes = (const U8*) src;
+    U64 totalTransferred = 0;
+    U64 bytesToTransfer = (range.max >= range.min) ? (range.max - range.min) : 0;
+
+    while (totalTransferred < bytesToTransfer) {
+        size_t chunkSize = (size_t) MIN(bytesToTransfer - totalTransferred, (U64)SSIZE_MAX);
+        ssize_t bytesWritten = pwrite(entity->file.fd, sourceBytes + totalTransferred,
+                                      chunkSize, (off_t) (range.min + totalTransferred));
+        if (bytesWritten < 0)
+            return totalTransferred;
+        if (bytesWritten == 0)
+            break;
+        totalTransferred += (U64) bytesWritten;
+    }
+    return totalTransferred;
+}
+
+U64 OS_file_write(OS_Handle fileHandle, U64 size, const void* src) {
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) fileHandle.handle;
+    ASSERT_DEBUG(entity && entity->type == OS_LINUX_EntityType_File);
+
+    const U8* sourceBytes = (const U8*) src;
+    U64 totalTransferred = 0;
+
+    while (totalTransferred < size) {
+        size_t chunkSize = (size_t) MIN(size - totalTransferred, (U64)SSIZE_MAX);
+        ssize_t bytesWritten = write(entity->file.fd, sourceBytes + totalTransferred, chunkSize);
+        if (bytesWritten < 0)
+            return totalTransferred;
+        if (bytesWritten == 0)
+            break;
+        totalTransferred += (U64) bytesWritten;
+    }
+    return totalTransferred;
+}
+
+OS_Handle OS_get_log_handle() {
+    static OS_LINUX_Entity entity{
+        .next = 0,
+        .type = OS_LINUX_EntityType_File,
+        .file{
+            .fd = STDOUT_FILENO,
+        },
+    };
+    static OS_Handle handle{
+        .handle = (U64*) &entity,
+    };
+    return handle;
+}
+
+B32 OS_terminal_supports_color() {
+    if (getenv("NO_COLOR") != NULL) {
+        return false;
+    }
+    if (!isatty(STDOUT_FILENO)) {
+        return false;
+    }
+
+    const char* term = getenv("TERM");
+    if (term && c_str_cmp(term, "dumb") == 0) {
+        return false;
+    }
+
+    return true;
+}
+
+
+// ////////////////////////
+// File Metadata / Copy
+
+OS_FileInfo OS_get_file_info(const char* path) {
+    OS_FileInfo info = {};
+    if (!path) {
+        return info;
+    }
+
+    struct stat fileStat;
+    if (stat(path, &fileStat) != 0) {
+        return info;
+    }
+
+    info.exists = 1;
+    info.size = (U64) fileStat.st_size;
+    info.lastWriteTimestampNs = ((U64) fileStat.st_mtim.tv_sec * BILLION(1ULL)) + (U64) fileStat.st_mtim.tv_nsec;
+    info.fileId = ((U64) fileStat.st_dev << 32) ^ (U64) fileStat.st_ino;
+    return info;
+}
+
+B32 OS_file_copy_contents(const char* srcPath, const char* dstPath) {
+    if (!srcPath || !dstPath) {
+        return 0;
+    }
+
+    OS_FileInfo sourceInfo = OS_get_file_info(srcPath);
+    if (!sourceInfo.exists) {
+        errno = ENOENT;
+        return 0;
+    }
+
+    Temp scratch = get_scratch(0, 0);
+    if (!scratch.arena) {
+        return 0;
+    }
+    DEFER_REF(temp_end(&scratch));
+
+    Arena* scratchArena = scratch.arena;
+
+    const U64 chunkSize = 64u * 1024u;
+    U8* buffer = ARENA_PUSH_ARRAY(scratchArena, U8, chunkSize);
+    if (!buffer) {
+        return 0;
+    }
+
+    OS_Handle source = OS_file_open(srcPath, OS_FileOpenMode_Read);
+    if (!source.handle) {
+        return 0;
+    }
+
+    OS_Handle destination = OS_file_open(dstPath, OS_FileOpenMode_Create);
+    if (!destination.handle) {
+        int openErrno = errno;
+        OS_file_close(source);
+        errno = openErrno;
+        return 0;
+    }
+
+    U64 offset = 0;
+    B32 ok = 1;
+    int savedErrno = 0;
+
+    while (offset < sourceInfo.size && ok) {
+        U64 remaining = sourceInfo.size - offset;
+        U64 toTransfer = (remaining > chunkSize) ? chunkSize : remaining;
+
+        RangeU64 range = {offset, offset + toTransfer};
+
+        U64 readBytes = OS_file_read(source, range, buffer);
+        if (readBytes != toTransfer) {
+            ok = 0;
+            savedErrno = errno;
+            break;
+        }
+
+        U64 writtenBytes = OS_file_write(destination, range, buffer);
+        if (writtenBytes != toTransfer) {
+            ok = 0;
+            savedErrno = errno;
+            break;
+        }
+
+        offset += toTransfer;
+    }
+
+    OS_file_close(destination);
+    OS_file_close(source);
+
+    if (!ok) {
+        unlink(dstPath);
+        errno = savedErrno;
+        return 0;
+    }
+
+    return 1;
+}
+
+
+// ////////////////////////
+// File Watching
+
+static OS_LINUX_WatchQueue* OS_LINUX_watch_queue_alloc_locked_() {
+    OS_LINUX_WatchQueue* queue = g_OS_LinuxState.freeWatchQueues;
+    if (queue) {
+        g_OS_LinuxState.freeWatchQueues = queue->next;
+    } else {
+        OS_LINUX_lock_(&g_OS_LinuxState.entityLock);
+        queue = (OS_LINUX_WatchQueue*) arena_push(g_OS_LinuxState.osEntityArena, sizeof(OS_LINUX_WatchQueue),
+                                                 alignof(OS_LINUX_WatchQueue));
+        OS_LINUX_unlock_(&g_OS_LinuxState.entityLock);
+    }
+    if (queue) {
+        MEMSET(queue, 0, sizeof(OS_LINUX_WatchQueue));
+    }
+    return queue;
+}
+
+static void OS_LINUX_watch_queue_push_(OS_LINUX_WatchQueue* queue, const char* name, U32 length) {
+    if (queue->used > 0u && c_str_cmp(queue->names + queue->last, name) == 0) {
+        return;
+    }
+    if (queue->used + length + 1u > OS_LINUX_WATCH_QUEUE_BYTES) {
+        queue->flags |= OS_WatchEvent_Rescan;
+        return;
+    }
+    queue->last = queue->used;
+    MEMCPY(queue->names + queue->used, name, length);
+    queue->names[queue->used + length] = 0;
+    queue->used += length + 1u;
+}
+
+static void OS_LINUX_watch_drain_locked_() {
+    alignas(struct inotify_event) char buffer[4096];
+    for (;;) {
+        ssize_t length = read(g_OS_LinuxState.watchFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;
+        }
+        for (char* at = buffer; at < buffer + length;) {
+            struct inotify_event* event = (struct inotify_event*) at;
+            at += sizeof(struct inotify_event) + event->len;
+            for (OS_LINUX_WatchQueue* queue = g_OS_LinuxState.watchQueues; queue; queue = queue->next) {
+                if (event->mask & IN_Q_OVERFLOW) {
+                    queue->flags |= OS_WatchEvent_Rescan;
+                } else if (queue->wd != event->wd || queue->closed) {
+                    continue;
+                } else if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                    queue->flags |= OS_WatchEvent_Rescan | OS_WatchEvent_Closed;
+                    queue->closed = 1;
+                    if (event->mask & IN_IGNORED) {
+                        queue->wd = -1;
+                    }
+                } else if (event->len != 0u) {
+                    OS_LINUX_watch_queue_push_(queue, event->name, (U32) c_str_len(event->name));
+                }
+            }
+        }
+    }
+}
+
+OS_Handle OS_watch_directory(const char* path) {
+    OS_Handle result = {0};
+    if (!path) {
+        return result;
+    }
+
+    OS_LINUX_lock_(&g_OS_LinuxState.watchLock);
+    DEFER_REF(OS_LINUX_unlock_(&g_OS_LinuxState.watchLock));
+
+    if (!g_OS_LinuxState.watchQueues) {
+        g_OS_LinuxState.watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (g_OS_LinuxState.watchFd == -1) {
+            return result;
+        }
+    }
+    // IN_MODIFY catches writers that keep the file open, IN_CLOSE_WRITE the
+    // end of a save, the moves editors that save through a rename.
+    U32 mask = IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+               IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+    int wd = inotify_add_watch(g_OS_LinuxState.watchFd, path, mask);
+    OS_LINUX_WatchQueue* queue = (wd == -1) ? 0 : OS_LINUX_watch_queue_alloc_locked_();
+    OS_LINUX_Entity* entity = queue ? alloc_OS_entity() : 0;
+    if (!entity) {
+        if (queue) {
+            queue->next = g_OS_LinuxState.freeWatchQueues;
+            g_OS_LinuxState.freeWatchQueues = queue;
+        }
+        // wd may already serve another watch on the same directory; a
+        // stray kernel watch only costs events nobody routes.
+        if (!g_OS_LinuxState.watchQueues) {
+            close(g_OS_LinuxState.watchFd);
+        }
+        return result;
+    }
+
+    queue->wd = wd;
+    queue->next = g_OS_LinuxState.watchQueues;
+    g_OS_LinuxState.watchQueues = queue;
+    entity->type = OS_LINUX_EntityType_Watch;
+    entity->watch.queue = queue;
+    result.handle = (U64*) entity;
+    return result;
+}
+
+void OS_unwatch_directory(OS_Handle watch) {
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) watch.handle;
+    if (!entity) {
+        return;
+    }
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Watch);
+    OS_LINUX_WatchQueue* queue = entity->watch.queue;
+
+    OS_LINUX_lock_(&g_OS_LinuxState.watchLock);
+    B32 shared = 0;
+    for (OS_LINUX_WatchQueue** link = &g_OS_LinuxState.watchQueues; *link;) {
+        if (*link == queue) {
+            *link = queue->next;
+            continue;
+        }
+        if ((*link)->wd == queue->wd) {
+            shared = 1;
+        }
+        link = &(*link)->next;
+    }
+    if (!g_OS_LinuxState.watchQueues) {
+        close(g_OS_LinuxState.watchFd);
+    } else if (queue->wd != -1 && !shared) {
+        inotify_rm_watch(g_OS_LinuxState.watchFd, queue->wd);
+    }
+    queue->next = g_OS_LinuxState.freeWatchQueues;
+    g_OS_LinuxState.freeWatchQueues = queue;
+    OS_LINUX_unlock_(&g_OS_LinuxState.watchLock);
+
+    free_OS_entity(entity);
+}
+
+U32 OS_poll_watch_events(OS_Handle watch, Arena* arena, OS_WatchEvent* outEvents, U32 maxEvents) {
+    OS_LINUX_Entity* entity = (OS_LINUX_Entity*) watch.handle;
+    if (!entity || !arena || !outEvents) {
+        return 0;
+    }
+    ASSERT_DEBUG(entity->type == OS_LINUX_EntityType_Watch);
+    OS_LINUX_WatchQueue* queue = entity->watch.queue;
+
+    OS_LINUX_lock_(&g_OS_LinuxState.watchLock);
+    DEFER_REF(OS_LINUX_unlock_(&g_OS_LinuxState.watchLock));
+    OS_LINUX_watch_drain_locked_();
+
+    OS_WatchEventList list = {arena, outEvents, 0u, maxEvents, queue->flags};
+    for (U32 at = 0u; at < queue->used;) {
+        StringU8 name = str8((const char*) queue->names + at);
+        OS_watch_events_push_(&list, name);
+        at += (U32) name.size + 1u;
+    }
+    queue->used = 0u;
+    queue->flags = 0u;
+    return OS_watch_events_finish_(&list);
+}
+
+
+// ////////////////////////
+// State
+
+static OS_LINUX_Entity* alloc_OS_entity() {
+    OS_LINUX_lock_(&g_OS_LinuxState.entityLock);
+    DEFER_REF(OS_LINUX_unlock_(&g_OS_LinuxState.entityLock));
+
+    OS_LINUX_Entity* entity = g_OS_LinuxState.freeEntities;
+    if (entity) {
+        g_OS_LinuxState.freeEntities = entity->next;
+        MEMSET(entity, 0, sizeof(OS_LINUX_Entity));
+    } else {
+        Arena* arena = g_OS_LinuxState.osEntityArena;
+        entity = (OS_LINUX_Entity*) arena_push(arena, sizeof(OS_LINUX_Entity), alignof(OS_LINUX_Entity));
+        if (entity) {
+            MEMSET(entity, 0, sizeof(OS_LINUX_Entity));
+        }
+    }
+    return entity;
+}
+
+static void free_OS_entity(OS_LINUX_Entity* entity) {
+    if (!entity) {
+        return;
+    }
+    OS_LINUX_lock_(&g_OS_LinuxState.entityLock);
+    DEFER_REF(OS_LINUX_unlock_(&g_OS_LinuxState.entityLock));
+
+    entity->next = g_OS_LinuxState.freeEntities;
+    g_OS_LinuxState.freeEntities = entity;
+}
+
+
+// ////////////////////////
+// Topology
+//
+// Everything comes from /sys/devices/system/cpu. Groups are named by the
+// first cpu of the sysfs list that shares them; OS_topology_finalize_
+// renumbers them densely.
+
+#define OS_LINUX_MAX_CPUS 1024u
+#define OS_LINUX_SYSFS_CPU "/sys/devices/system/cpu/"
+
+static B32 OS_LINUX_read_sysfs_(const char* path, char* buffer, U32 capacity) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+    ssize_t length = read(fd, buffer, capacity - 1u);
+    close(fd);
+    if (length <= 0) {
+        return 0;
+    }
+    buffer[length] = 0;
+    return 1;
+}
+
+static const char* OS_LINUX_parse_u32_(const char* at, U32* out) {
+    U32 value = 0u;
+    while (*at >= '0' && *at <= '9') {
+        value = value * 10u + (U32) (*at - '0');
+        ++at;
+    }
+    *out = value;
+    return at;
+}
+
+// Cpu lists look like "0-3,8,10-11".
+static B32 OS_LINUX_cpu_list_contains_(const char* list, U32 cpu) {
+    const char* at = list;
+    while (*at >= '0' && *at <= '9') {
+        U32 first = 0u;
+        U32 last = 0u;
+        at = OS_LINUX_parse_u32_(at, &first);
+        last = first;
+        if (*at == '-') {
+            at = OS_LINUX_parse_u32_(at + 1, &last);
+        }
+        if (cpu >= first && cpu <= last) {
+            return 1;
+        }
+        if (*at == ',') {
+            ++at;
+        }
+    }
+    return 0;
+}
+
+static U32 OS_LINUX_cpu_list_first_(const char* list, U32 fallback) {
+    if (!(*list >= '0' && *list <= '9')) {
+        return fallback;
+    }
+    U32 first = 0u;
+    OS_LINUX_parse_u32_(list, &first);
+    return first;
+}
+
+// OS_LINUX_SYSFS_CPU "cpu<N>/<suffix>"
+static void OS_LINUX_cpu_path_(char* out, U32 capacity, U32 cpu, const char* suffix) {
+    const char* prefix = OS_LINUX_SYSFS_CPU "cpu";
+    U32 length = 0u;
+    for (const char* at = prefix; *at && length + 1u < capacity; ++at) {
+        out[length++] = *at;
+    }
+    char digits[10];
+    U32 digitCount = 0u;
+    do {
+        digits[digitCount++] = (char) ('0' + cpu % 10u);
+        cpu /= 10u;
+    } while (cpu != 0u);
+    while (digitCount != 0u && length + 1u < capacity) {
+        out[length++] = digits[--digitCount];
+    }
+    if (length + 1u < capacity) {
+        out[length++] = '/';
+    }
+    for (const char* at = suffix; *at && length + 1u < capacity; ++at) {
+        out[length++] = *at;
+    }
+    out[length] = 0;
+}
+
+// The PMD size is what both THP and the default hugetlbfs pool hand out.
+static void OS_LINUX_discover_large_pages_(OS_SystemInfo* info) {
+    char text[64];
+    if (!OS_LINUX_read_sysfs_("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", text, sizeof(text))) {
+        return;
+    }
+    U64 size = 0u;
+    for (const char* at = text; *at >= '0' && *at <= '9'; ++at) {
+        size = size * 10u + (U64)(*at - '0');
+    }
+    if (!is_power_of_two(size) || size <= info->pageSize) {
+        return;
+    }
+    info->largePageSize = size;
+    if (OS_LINUX_read_sysfs_("/sys/kernel/mm/transparent_hugepage/enabled", text, sizeof(text))) {
+        // "always [madvise] never": the bracketed word is the active mode.
+        const char* at = text;
+        while (*at && *at != '[') {
+            ++at;
+        }
+        g_OS_LinuxState.transparentHugePages = *at == '[' && at[1] != 'n';
+    }
+}
+
+static void OS_LINUX_discover_topology_(OS_SystemInfo* info) {
+    char online[256];
+    if (!OS_LINUX_read_sysfs_(OS_LINUX_SYSFS_CPU "online", online, sizeof(online))) {
+        return;
+    }
+    // Hybrid Intel parts list their small cores under cpu_atom; ARM big.LITTLE
+    // reports a per-cpu capacity where the small cores sit below the maximum.
+    char atoms[256];
+    B32 hasAtoms = OS_LINUX_read_sysfs_("/sys/devices/cpu_atom/cpus", atoms, sizeof(atoms));
+
+    char path[128];
+    char text[256];
+    U32 maxCapacity = 0u;
+    U32 capacities[OS_MAX_TOPOLOGY_CORES];
+    U32 count = 0u;
+    for (U32 cpu = 0u; cpu < OS_LINUX_MAX_CPUS && count < OS_MAX_TOPOLOGY_CORES; ++cpu) {
+        if (!OS_LINUX_cpu_list_contains_(online, cpu)) {
+            continue;
+        }
+        OS_CoreInfo* core = &info->cores[count];
+        core->osIndex = cpu;
+        core->physicalCore = cpu;
+        OS_LINUX_cpu_path_(path, sizeof(path), cpu, "topology/thread_siblings_list");
+        if (OS_LINUX_read_sysfs_(path, text, sizeof(text))) {
+            core->physicalCore = OS_LINUX_cpu_list_first_(text, cpu);
+        }
+        core->l2Group = core->physicalCore;
+        core->l3Group = 0u;
+        for (U32 index = 0u; index < 8u; ++index) {
+            char suffix[] = "cache/index0/level";
+            suffix[11] = (char) ('0' + index);
+            OS_LINUX_cpu_path_(path, sizeof(path), cpu, suffix);
+            if (!OS_LINUX_read_sysfs_(path, text, sizeof(text))) {
+                break;
+            }
+            U32 level = 0u;
+            OS_LINUX_parse_u32_(text, &level);
+            if (level != 2u && level != 3u) {
+                continue;
+            }
+            char sharedSuffix[] = "cache/index0/shared_cpu_list";
+            sharedSuffix[11] = (char) ('0' + index);
+            OS_LINUX_cpu_path_(path, sizeof(path), cpu, sharedSuffix);
+            if (OS_LINUX_read_sysfs_(path, text, sizeof(text))) {
+                U32 owner = OS_LINUX_cpu_list_first_(text, cpu);
+                if (level == 2u) {
+                    core->l2Group = owner;
+                } else {
+                    core->l3Group = owner;
+                }
+            }
+        }
+        capacities[count] = 0u;
+        OS_LINUX_cpu_path_(path, sizeof(path), cpu, "cpu_capacity");
+        if (OS_LINUX_read_sysfs_(path, text, sizeof(text))) {
+            OS_LINUX_parse_u32_(text, &capacities[count]);
+            maxCapacity = MAX(maxCapacity, capacities[count]);
+        }
+        core->kind = (hasAtoms && OS_LINUX_cpu_list_contains_(atoms, cpu)) ? OS_CoreKind_Efficiency
+                                                                            : OS_CoreKind_Performance;
+        count += 1u;
+    }
+    for (U32 at = 0u; at < count && !hasAtoms; ++at) {
+        if (capacities[at] != 0u && capacities[at] < maxCapacity) {
+            info->cores[at].kind = OS_CoreKind_Efficiency;
+        }
+    }
+    info->coreCount = count;
+}
+
+
+// ////////////////////////
+// Entry Point
+
+int main(int argc, char** argv) {
+    {
+        OS_SystemInfo* info = &g_OS_LinuxState.systemInfo;
+        info->pageSize = static_cast<U64>(sysconf(_SC_PAGESIZE));
+        info->logicalCores = static_cast<U32>(sysconf(_SC_NPROCESSORS_ONLN));
+        OS_LINUX_discover_large_pages_(info);
+        OS_LINUX_discover_topology_(info);
+        OS_topology_finalize_(info);
+    }
+    g_OS_LinuxState.counterFrequencyHz = OS_LINUX_measure_tsc_frequency_();
+
+    thread_context_alloc();
+
+    Arena* arena = arena_alloc();
+    g_OS_LinuxState.arena = arena;
+
+    Arena* entityArena = arena_alloc();
+    g_OS_LinuxState.osEntityArena = entityArena;
+
+    base_entry_point(argc, argv);
+}
@@ -0,0 +1,120 @@
+//
+// Linux os_core backend state: entity records behind OS_Handle, the futex
+// word states, the shared inotify queues and the process-wide globals.
+//
+
+#pragma once
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/inotify.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+
+
+// ////////////////////////
+// State
+
+enum OS_LINUX_EntityType : U64 {
+    OS_LINUX_EntityType_Invalid = (0),
+    OS_LINUX_EntityType_Thread = (1 << 0),
+    OS_LINUX_EntityType_Mutex = (2 << 0),
+    OS_LINUX_EntityType_File = (3 << 0),
+    OS_LINUX_EntityType_ConditionVariable = (4 << 0),
+    OS_LINUX_EntityType_Barrier = (5 << 0),
+    OS_LINUX_EntityType_Watch = (6 << 0),
+};
+
+// One inotify instance serves every watch in the process, since
+// fs.inotify.max_user_instances is per user (128 by default). Whoever polls
+// drains it and routes each event by watch descriptor into the queue of
+// every watch on that directory; two watches on one directory share a wd.
+#define OS_LINUX_WATCH_QUEUE_BYTES 4096u
+
+struct OS_LINUX_WatchQueue {
+    OS_LINUX_WatchQueue* next; // live list, or free list once unwatched
+    int wd;                    // -1 once the kernel dropped the watch
+    U32 flags;                 // Rescan / Closed owed at the next poll
+    B32 closed;                // nothing more is queued after Closed
+    U32 used;                  // bytes of NUL-terminated names below
+    U32 last;                  // offset of the newest name, to fold bursts
+    char names[OS_LINUX_WATCH_QUEUE_BYTES];
+};
+
+// Mutex, condition variable and barrier are plain words parked on with
+// futex(2); none of them go through pthread.
+struct OS_LINUX_Entity {
+    OS_LINUX_Entity* next;
+    OS_LINUX_EntityType type;
+
+    union {
+        struct {
+            pthread_t handle;
+            OS_ThreadFunc* func;
+            void* args;
+        } thread;
+
+        struct {
+            U32 state; // OS_LINUX_MutexState
+        } mutex;
+
+        struct {
+            int fd;
+        } file;
+
+        struct {
+            OS_LINUX_WatchQueue* queue;
+        } watch;
+
+        struct {
+            U32 sequence; // bumped by every signal / broadcast
+        } conditionVariable;
+
+        struct {
+            U32 threadCount;
+            U32 arrived;
+            U32 generation; // bumped by the last arriver, waited on by the rest
+        } barrier;
+    };
+};
+
+enum OS_LINUX_MutexState : U32 {
+    OS_LINUX_MutexState_Unlocked = 0,
+    OS_LINUX_MutexState_Locked = 1,
+    OS_LINUX_MutexState_Contended = 2, // locked, and someone may be parked
+};
+
+static OS_LINUX_Entity* alloc_OS_entity();
+static void free_OS_entity(OS_LINUX_Entity* entity);
+
+struct OS_LINUX_State {
+    OS_SystemInfo systemInfo;
+
+    Arena* arena;
+
+    Arena* osEntityArena;
+    OS_LINUX_Entity* freeEntities;
+    U32 entityLock; // OS_LINUX_MutexState
+
+    int watchFd; // shared inotify instance, open while watchQueues is non-empty
+    OS_LINUX_WatchQueue* watchQueues;
+    OS_LINUX_WatchQueue* freeWatchQueues;
+    U32 watchLock; // OS_LINUX_MutexState, guards the three above
+
+    U64 counterFrequencyHz; // rdtsc ticks per second, measured at startup
+    B32 transparentHugePages; // THP is "always" or "madvise"
+};
+
+
+// ////////////////////////
+// Globals
+
+extern OS_LINUX_State g_OS_LinuxState;
@@ -252,6 +252,13 @@ void OS_release(void* ptr, U64 size) {
     munmap(ptr, size);
 }
 
+// Superpages are Intel-only (VM_FLAGS_SUPERPAGE_SIZE_2MB) and Apple silicon
+// already maps 16 KB pages, so largePageSize stays 0 and this always falls back.
+void* OS_reserve_large(U64 size, U32* outKind) {
+    *outKind = OS_LargePageKind_None;
+    return OS_reserve(size);
+}
+
 
 // ////////////////////////
 // Threads and Synchronization
@@ -296,6 +303,14 @@ void OS_thread_detach(OS_Handle thread) {
     free_OS_entity(entity);
 }
 
+// macOS only takes affinity tags as scheduler hints (and ignores them on
+// Apple silicon), so there is nothing to pin to.
+B32 OS_thread_set_affinity(OS_Handle thread, U32 osCoreIndex) {
+    (void) thread;
+    (void) osCoreIndex;
+    return 0;
+}
+
 void OS_thread_yield() {
     sched_yield();
 }
@@ -440,6 +455,30 @@ void OS_barrier_wait(OS_Handle barrierHandle) {
     OS_mutex_unlock(entity->barrier.mutexHandle);
 }
 
+// Darwin's wait-on-address syscalls; the same pair backs libc++'s
+// std::atomic::wait. Private but ABI-stable since 10.12.
+EXTERN_C int __ulock_wait(U32 operation, void* address, U64 value, U32 timeoutMicroseconds);
+EXTERN_C int __ulock_wake(U32 operation, void* address, U64 wakeValue);
+
+#define OS_MACOS_UL_COMPARE_AND_WAIT 1u
+#define OS_MACOS_ULF_WAKE_ALL 0x00000100u
+#define OS_MACOS_ULF_NO_ERRNO 0x01000000u
+
+void OS_address_wait(U32* address, U32 expected) {
+    ASSERT_DEBUG(address != 0);
+    __ulock_wait(OS_MACOS_UL_COMPARE_AND_WAIT | OS_MACOS_ULF_NO_ERRNO, address, expected, 0u);
+}
+
+void OS_address_wake_one(U32* address) {
+    ASSERT_DEBUG(address != 0);
+    __ulock_wake(OS_MACOS_UL_COMPARE_AND_WAIT | OS_MACOS_ULF_NO_ERRNO, address, 0u);
+}
+
+void OS_address_wake_all(U32* address) {
+    ASSERT_DEBUG(address != 0);
+    __ulock_wake(OS_MACOS_UL_COMPARE_AND_WAIT | OS_MACOS_ULF_WAKE_ALL | OS_MACOS_ULF_NO_ERRNO, address, 0u);
+}
+
 // ////////////////////////
 // File I/O
 
@@ -670,6 +709,7 @@ OS_FileInfo OS_get_file_info(const char* path) {
     info.exists = 1;
     info.size = (U64) fileStat.st_size;
     info.lastWriteTimestampNs = ((U64) fileStat.st_mtimespec.tv_sec * BILLION(1ULL)) + (U64) fileStat.st_mtimespec.tv_nsec;
+    info.fileId = ((U64) fileStat.st_dev << 32) ^ (U64) fileStat.st_ino;
     return info;
 }
 
@@ -751,6 +791,202 @@ B32 OS_file_copy_contents(const char* srcPath, const char* dstPath) {
 }
 
 
+// ////////////////////////
+// File Watching
+
+#define OS_MACOS_FSEVENT_SINCE_NOW 0xFFFFFFFFFFFFFFFFull
+#define OS_MACOS_FSEVENT_CREATE_NO_DEFER 0x02u
+#define OS_MACOS_FSEVENT_CREATE_WATCH_ROOT 0x04u
+#define OS_MACOS_FSEVENT_CREATE_FILE_EVENTS 0x10u
+#define OS_MACOS_FSEVENT_MUST_SCAN_SUBDIRS 0x01u
+#define OS_MACOS_FSEVENT_USER_DROPPED 0x02u
+#define OS_MACOS_FSEVENT_KERNEL_DROPPED 0x04u
+#define OS_MACOS_FSEVENT_ROOT_CHANGED 0x20u
+#define OS_MACOS_CF_STRING_ENCODING_UTF8 0x08000100u
+
+static OS_MACOS_FSEvents g_OS_MACOS_FSEvents;
+static pthread_once_t g_OS_MACOS_FSEventsOnce = PTHREAD_ONCE_INIT;
+
+static void OS_MACOS_load_fsevents_(void) {
+    void* coreFoundation = dlopen("/System/Library/Frameworks/CoreFoundation.framework/CoreFoundation", RTLD_LAZY);
+    void* coreServices = dlopen("/System/Library/Frameworks/CoreServices.framework/CoreServices", RTLD_LAZY);
+    if (!coreFoundation || !coreServices) {
+        return;
+    }
+
+    OS_MACOS_FSEvents* api = &g_OS_MACOS_FSEvents;
+    api->typeArrayCallBacks = dlsym(coreFoundation, "kCFTypeArrayCallBacks");
+    api->stringCreate = (PFN_CFStringCreateWithCString)dlsym(coreFoundation, "CFStringCreateWithCString");
+    api->arrayCreate = (PFN_CFArrayCreate)dlsym(coreFoundation, "CFArrayCreate");
+    api->release = (PFN_CFRelease)dlsym(coreFoundation, "CFRelease");
+    api->streamCreate = (PFN_FSEventStreamCreate)dlsym(coreServices, "FSEventStreamCreate");
+    api->streamSetDispatchQueue =
+        (PFN_FSEventStreamSetDispatchQueue)dlsym(coreServices, "FSEventStreamSetDispatchQueue");
+    api->streamStart = (PFN_FSEventStreamStart)dlsym(coreServices, "FSEventStreamStart");
+    api->streamStop = (PFN_FSEventStreamStream)dlsym(coreServices, "FSEventStreamStop");
+    api->streamInvalidate = (PFN_FSEventStreamStream)dlsym(coreServices, "FSEventStreamInvalidate");
+    api->streamRelease = (PFN_FSEventStreamStream)dlsym(coreServices, "FSEventStreamRelease");
+    api->loaded = (api->typeArrayCallBacks && api->stringCreate && api->arrayCreate && api->release &&
+                   api->streamCreate && api->streamSetDispatchQueue && api->streamStart && api->streamStop &&
+                   api->streamInvalidate && api->streamRelease) ? 1 : 0;
+}
+
+static void OS_MACOS_watch_callback_(const void* stream, void* info, size_t eventCount, void* eventPaths,
+                                     const U32* eventFlags, const U64* eventIds) {
+    OS_MACOS_Watch* watch = (OS_MACOS_Watch*) info;
+    const char** paths = (const char**) eventPaths;
+    pthread_mutex_lock(&watch->lock);
+    for (size_t at = 0; at < eventCount; ++at) {
+        U32 flags = eventFlags[at];
+        if (flags & (OS_MACOS_FSEVENT_MUST_SCAN_SUBDIRS | OS_MACOS_FSEVENT_USER_DROPPED |
+                     OS_MACOS_FSEVENT_KERNEL_DROPPED)) {
+            watch->pendingFlags |= OS_WatchEvent_Rescan;
+            continue;
+        }
+        if (flags & OS_MACOS_FSEVENT_ROOT_CHANGED) {
+            watch->pendingFlags |= OS_WatchEvent_Rescan | OS_WatchEvent_Closed;
+            continue;
+        }
+
+        // Streams are recursive; only direct children are reported.
+        StringU8 path = str8(paths[at]);
+        if (path.size <= watch->rootSize + 1u || MEMCMP(path.data, watch->root, watch->rootSize) != 0 ||
+            path.data[watch->rootSize] != '/') {
+            continue;
+        }
+        StringU8 name = str8(path.data + watch->rootSize + 1u, path.size - watch->rootSize - 1u);
+        B32 nested = 0;
+        for (U64 index = 0u; index < name.size; ++index) {
+            nested |= (name.data[index] == '/') ? 1 : 0;
+        }
+        if (nested) {
+            continue;
+        }
+        if (watch->namesSize + name.size + 1u > sizeof(watch->names)) {
+            watch->pendingFlags |= OS_WatchEvent_Rescan;
+            continue;
+        }
+        MEMCPY(watch->names + watch->namesSize, name.data, name.size);
+        watch->names[watch->namesSize + name.size] = 0;
+        watch->namesSize += (U32) name.size + 1u;
+    }
+    pthread_mutex_unlock(&watch->lock);
+}
+
+static void OS_MACOS_watch_drain_(void* context) {
+}
+
+OS_Handle OS_watch_directory(const char* path) {
+    OS_Handle result = {0};
+    pthread_once(&g_OS_MACOS_FSEventsOnce, OS_MACOS_load_fsevents_);
+    OS_MACOS_FSEvents* api = &g_OS_MACOS_FSEvents;
+    if (!path || !api->loaded) {
+        return result;
+    }
+
+    U64 stateSize = sizeof(OS_MACOS_Watch);
+    OS_MACOS_Watch* watch = (OS_MACOS_Watch*) OS_reserve(stateSize);
+    if (watch && !OS_commit(watch, stateSize)) {
+        OS_release(watch, stateSize);
+        watch = 0;
+    }
+    if (!watch) {
+        return result;
+    }
+    if (!realpath(path, watch->root)) {
+        OS_release(watch, stateSize);
+        return result;
+    }
+    StringU8 root = str8(watch->root);
+    watch->rootSize = (root.size == 1u) ? 0u : (U32) root.size; // "/" itself
+    pthread_mutex_init(&watch->lock, 0);
+    watch->queue = dispatch_queue_create("nstl.watch", DISPATCH_QUEUE_SERIAL);
+
+    OS_MACOS_FSEventContext context = {0, watch, 0, 0, 0};
+    OS_MACOS_CFRef pathString = api->stringCreate(0, watch->root, OS_MACOS_CF_STRING_ENCODING_UTF8);
+    const void* pathValues[1] = {pathString};
+    OS_MACOS_CFRef pathArray = pathString ? api->arrayCreate(0, pathValues, 1, api->typeArrayCallBacks) : 0;
+    if (pathArray) {
+        U32 flags = OS_MACOS_FSEVENT_CREATE_NO_DEFER | OS_MACOS_FSEVENT_CREATE_WATCH_ROOT |
+                    OS_MACOS_FSEVENT_CREATE_FILE_EVENTS;
+        watch->stream = api->streamCreate(0, OS_MACOS_watch_callback_, &context, pathArray,
+                                          OS_MACOS_FSEVENT_SINCE_NOW, 0.05, flags);
+    }
+    if (pathArray) {
+        api->release(pathArray);
+    }
+    if (pathString) {
+        api->release(pathString);
+    }
+
+    OS_MACOS_Entity* entity = watch->stream ? alloc_OS_entity() : 0;
+    if (entity) {
+        api->streamSetDispatchQueue(watch->stream, watch->queue);
+        if (!api->streamStart(watch->stream)) {
+            api->streamInvalidate(watch->stream);
+            free_OS_entity(entity);
+            entity = 0;
+        }
+    }
+    if (!entity) {
+        if (watch->stream) {
+            api->streamRelease(watch->stream);
+        }
+        dispatch_release(watch->queue);
+        pthread_mutex_destroy(&watch->lock);
+        OS_release(watch, stateSize);
+        return result;
+    }
+
+    entity->type = OS_MACOS_EntityType_Watch;
+    entity->watch.state = watch;
+    result.handle = (U64*) entity;
+    return result;
+}
+
+void OS_unwatch_directory(OS_Handle watchHandle) {
+    OS_MACOS_Entity* entity = (OS_MACOS_Entity*) watchHandle.handle;
+    if (!entity) {
+        return;
+    }
+    ASSERT_DEBUG(entity->type == OS_MACOS_EntityType_Watch);
+
+    OS_MACOS_FSEvents* api = &g_OS_MACOS_FSEvents;
+    OS_MACOS_Watch* watch = entity->watch.state;
+    api->streamStop(watch->stream);
+    api->streamInvalidate(watch->stream);
+    api->streamRelease(watch->stream);
+    // A callback already running on the queue finishes before this returns.
+    dispatch_sync_f(watch->queue, 0, OS_MACOS_watch_drain_);
+    dispatch_release(watch->queue);
+    pthread_mutex_destroy(&watch->lock);
+    OS_release(watch, sizeof(OS_MACOS_Watch));
+    free_OS_entity(entity);
+}
+
+U32 OS_poll_watch_events(OS_Handle watchHandle, Arena* arena, OS_WatchEvent* outEvents, U32 maxEvents) {
+    OS_MACOS_Entity* entity = (OS_MACOS_Entity*) watchHandle.handle;
+    if (!entity || !arena || !outEvents) {
+        return 0;
+    }
+    ASSERT_DEBUG(entity->type == OS_MACOS_EntityType_Watch);
+
+    OS_MACOS_Watch* watch = entity->watch.state;
+    OS_WatchEventList list = {arena, outEvents, 0u, maxEvents, 0u};
+    pthread_mutex_lock(&watch->lock);
+    for (U32 at = 0u; at < watch->namesSize;) {
+        StringU8 name = str8(watch->names + at);
+        OS_watch_events_push_(&list, name);
+        at += (U32) name.size + 1u;
+    }
+    list.trailingFlags |= watch->pendingFlags;
+    watch->namesSize = 0u;
+    watch->pendingFlags = 0u;
+    pthread_mutex_unlock(&watch->lock);
+    return OS_watch_events_finish_(&list);
+}
+
+
 // ////////////////////////
 // State
 
@@ -784,6 +1020,51 @@ static void free_OS_entity(OS_MACOS_Entity* entity) {
 }
 
 
+// ////////////////////////
+// Topology
+
+static U32 OS_MACOS_sysctl_u32_(const char* name, U32 fallback) {
+    S32 value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname(name, &value, &size, 0, 0) != 0 || value <= 0) {
+        return fallback;
+    }
+    return (U32) value;
+}
+
+// There is no per-cpu topology query, so cores are laid out per perf level
+// (level 0 is the fastest): SMT siblings adjacent, cpusperl2 to an L2
+// cluster, and one last-level group per level. Without hw.nperflevels
+// (Intel) the whole machine is level 0 with a private L2 per core.
+static void OS_MACOS_discover_topology_(OS_SystemInfo* info) {
+    static const char* levelNames[2][4] = {
+        {"hw.perflevel0.logicalcpu", "hw.perflevel0.physicalcpu", "hw.perflevel0.cpusperl2", "hw.perflevel0.cpusperl3"},
+        {"hw.perflevel1.logicalcpu", "hw.perflevel1.physicalcpu", "hw.perflevel1.cpusperl2", "hw.perflevel1.cpusperl3"},
+    };
+    U32 levelCount = MIN(OS_MACOS_sysctl_u32_("hw.nperflevels", 0u), 2u);
+    U32 count = 0u;
+    for (U32 level = 0u; level < MAX(levelCount, 1u); ++level) {
+        U32 logical = (levelCount != 0u) ? OS_MACOS_sysctl_u32_(levelNames[level][0], 0u)
+                                         : OS_MACOS_sysctl_u32_("hw.logicalcpu", info->logicalCores);
+        U32 physical = (levelCount != 0u) ? OS_MACOS_sysctl_u32_(levelNames[level][1], logical)
+                                          : OS_MACOS_sysctl_u32_("hw.physicalcpu", logical);
+        U32 smt = MAX(logical / MAX(physical, 1u), 1u);
+        U32 perL2 = (levelCount != 0u) ? OS_MACOS_sysctl_u32_(levelNames[level][2], smt) : smt;
+        U32 perL3 = (levelCount != 0u) ? OS_MACOS_sysctl_u32_(levelNames[level][3], logical) : logical;
+        for (U32 at = 0u; at < logical && count < OS_MAX_TOPOLOGY_CORES; ++at) {
+            OS_CoreInfo* core = &info->cores[count];
+            core->osIndex = count;
+            core->physicalCore = (level << 16) | (at / smt);
+            core->l2Group = (level << 16) | (at / perL2);
+            core->l3Group = (level << 16) | (at / perL3);
+            core->kind = (level == 0u) ? OS_CoreKind_Performance : OS_CoreKind_Efficiency;
+            count += 1u;
+        }
+    }
+    info->coreCount = count;
+}
+
+
 // ////////////////////////
 // Entry Point
 
@@ -792,6 +1073,8 @@ int main(int argc, char** argv) {
         OS_SystemInfo* info = &g_OS_MacOSState.systemInfo;
         info->pageSize = static_cast<U64>(sysconf(_SC_PAGESIZE));
         info->logicalCores = static_cast<U32>(sysconf(_SC_NPROCESSORS_ONLN));
+        OS_MACOS_discover_topology_(info);
+        OS_topology_finalize_(info);
     }
 
     thread_context_alloc();
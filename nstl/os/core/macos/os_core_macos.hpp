@@ -13,7 +13,9 @@
 #include <time.h>
 #include <pthread.h>
 #include <sched.h>
+#include <sys/sysctl.h>
 #include <mach-o/dyld.h>
+#include <dispatch/dispatch.h>
 #include <errno.h>
 
 
@@ -27,6 +29,58 @@ enum OS_MACOS_EntityType : U64 {
     OS_MACOS_EntityType_File = (3 << 0),
     OS_MACOS_EntityType_ConditionVariable = (4 << 0),
     OS_MACOS_EntityType_Barrier = (5 << 0),
+    OS_MACOS_EntityType_Watch = (6 << 0),
+};
+
+// FSEvents is reached through dlopen so nothing has to link CoreServices;
+// the few CoreFoundation / FSEvents types it needs are declared by hand.
+typedef void* OS_MACOS_CFRef;
+typedef void OS_MACOS_FSEventCallback(const void* stream, void* info, size_t eventCount, void* eventPaths,
+                                      const U32* eventFlags, const U64* eventIds);
+typedef OS_MACOS_CFRef (*PFN_CFStringCreateWithCString)(const void* allocator, const char* text, U32 encoding);
+typedef OS_MACOS_CFRef (*PFN_CFArrayCreate)(const void* allocator, const void** values, long count,
+                                             const void* callBacks);
+typedef void (*PFN_CFRelease)(const void* ref);
+typedef OS_MACOS_CFRef (*PFN_FSEventStreamCreate)(const void* allocator, OS_MACOS_FSEventCallback* callback,
+                                                   void* context, OS_MACOS_CFRef paths, U64 sinceWhen,
+                                                   double latencySeconds, U32 flags);
+typedef void (*PFN_FSEventStreamSetDispatchQueue)(OS_MACOS_CFRef stream, dispatch_queue_t queue);
+typedef U8 (*PFN_FSEventStreamStart)(OS_MACOS_CFRef stream);
+typedef void (*PFN_FSEventStreamStream)(OS_MACOS_CFRef stream);
+
+struct OS_MACOS_FSEventContext {
+    long version;
+    void* info;
+    const void* (*retain)(const void*);
+    void (*release)(const void*);
+    const void* (*copyDescription)(const void*);
+};
+
+struct OS_MACOS_FSEvents {
+    B32 loaded;
+    const void* typeArrayCallBacks; // &kCFTypeArrayCallBacks
+    PFN_CFStringCreateWithCString stringCreate;
+    PFN_CFArrayCreate arrayCreate;
+    PFN_CFRelease release;
+    PFN_FSEventStreamCreate streamCreate;
+    PFN_FSEventStreamSetDispatchQueue streamSetDispatchQueue;
+    PFN_FSEventStreamStart streamStart;
+    PFN_FSEventStreamStream streamStop;
+    PFN_FSEventStreamStream streamInvalidate;
+    PFN_FSEventStreamStream streamRelease;
+};
+
+// The stream calls back on its own queue; names wait here, NUL-separated,
+// until the next poll.
+struct OS_MACOS_Watch {
+    OS_MACOS_CFRef stream;
+    dispatch_queue_t queue;
+    pthread_mutex_t lock;
+    U32 rootSize;
+    U32 namesSize;
+    U32 pendingFlags; // OS_WatchEventFlags seen by the callback
+    char root[PATH_MAX]; // resolved, as FSEvents reports paths
+    char names[KB(16)];
 };
 
 struct OS_MACOS_Entity {
@@ -46,6 +100,10 @@ struct OS_MACOS_Entity {
             int fd;
         } file;
 
+        struct {
+            OS_MACOS_Watch* state;
+        } watch;
+
         struct {
             pthread_cond_t cond;
         } conditionVariable;
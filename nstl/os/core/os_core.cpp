@@ -1,3 +1,99 @@
 //
 // Created by André Leite on 26/07/2025.
 //
+
+// ////////////////////////
+// System Info
+
+// Renumbers one OS_CoreInfo field densely, in order of first appearance.
+static void OS_topology_compact_(OS_CoreInfo* cores, U32 count, U32 fieldIndex) {
+    U32 raw[OS_MAX_TOPOLOGY_CORES];
+    U32* fields = (U32*) cores;
+    U32 stride = sizeof(OS_CoreInfo) / sizeof(U32);
+    for (U32 at = 0u; at < count; ++at) {
+        raw[at] = fields[at * stride + fieldIndex];
+    }
+    U32 next = 0u;
+    for (U32 at = 0u; at < count; ++at) {
+        U32 id = next;
+        for (U32 prior = 0u; prior < at; ++prior) {
+            if (raw[prior] == raw[at]) {
+                id = fields[prior * stride + fieldIndex];
+                break;
+            }
+        }
+        fields[at * stride + fieldIndex] = id;
+        next += (id == next) ? 1u : 0u;
+    }
+}
+
+// Backends fill cores[] with raw OS ids (core ids, the first cpu sharing a
+// cache, ...) or leave coreCount at 0 when the OS reports nothing, in which
+// case every logical core stands alone.
+static void OS_topology_finalize_(OS_SystemInfo* info) {
+    if (info->logicalCores == 0u) {
+        info->logicalCores = 1u;
+    }
+    if (info->coreCount == 0u) {
+        info->coreCount = MIN(info->logicalCores, OS_MAX_TOPOLOGY_CORES);
+        for (U32 at = 0u; at < info->coreCount; ++at) {
+            OS_CoreInfo* core = &info->cores[at];
+            core->osIndex = at;
+            core->physicalCore = at;
+            core->l2Group = at;
+            core->l3Group = 0u;
+            core->kind = OS_CoreKind_Performance;
+        }
+    }
+
+    OS_topology_compact_(info->cores, info->coreCount, offsetof(OS_CoreInfo, physicalCore) / sizeof(U32));
+    OS_topology_compact_(info->cores, info->coreCount, offsetof(OS_CoreInfo, l2Group) / sizeof(U32));
+    OS_topology_compact_(info->cores, info->coreCount, offsetof(OS_CoreInfo, l3Group) / sizeof(U32));
+
+    info->physicalCores = 0u;
+    info->efficiencyCores = 0u;
+    for (U32 at = 0u; at < info->coreCount; ++at) {
+        info->physicalCores = MAX(info->physicalCores, info->cores[at].physicalCore + 1u);
+        info->efficiencyCores += (info->cores[at].kind == OS_CoreKind_Efficiency) ? 1u : 0u;
+    }
+}
+
+// ////////////////////////
+// File Watching
+
+// Backends push entry names as they drain the OS queue; once outEvents is
+// full the rest collapse into one trailing Rescan.
+struct OS_WatchEventList {
+    Arena* arena;
+    OS_WatchEvent* events;
+    U32 count;
+    U32 capacity;
+    U32 trailingFlags; // Rescan / Closed, appended by OS_watch_events_finish_
+};
+
+static void OS_watch_events_push_(OS_WatchEventList* list, StringU8 name) {
+    // Writes arrive in bursts against one entry; keep one event per run.
+    if (list->count > 0u && str8_equal(list->events[list->count - 1u].name, name)) {
+        return;
+    }
+    if (list->count == list->capacity) {
+        list->trailingFlags |= OS_WatchEvent_Rescan;
+        return;
+    }
+    OS_WatchEvent* event = list->events + list->count++;
+    event->name = str8_cpy(list->arena, name);
+    event->flags = OS_WatchEvent_Changed;
+}
+
+static U32 OS_watch_events_finish_(OS_WatchEventList* list) {
+    if (list->trailingFlags != 0u && list->capacity > 0u) {
+        if (list->count == list->capacity) {
+            list->count -= 1u;
+            list->trailingFlags |= OS_WatchEvent_Rescan;
+        }
+        OS_WatchEvent* event = list->events + list->count++;
+        event->name = STR8_NIL;
+        event->flags = list->trailingFlags;
+    }
+    return list->count;
+}
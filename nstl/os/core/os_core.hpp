@@ -7,9 +7,33 @@
 // ////////////////////////
 // System Info
 
+#define OS_MAX_TOPOLOGY_CORES 256u
+
+enum OS_CoreKind {
+    OS_CoreKind_Performance = 0,
+    OS_CoreKind_Efficiency = 1,
+};
+
+// One logical core. Group ids are small dense numbers: cores with the same
+// physicalCore are SMT siblings, cores with the same l2Group / l3Group share
+// that cache. Hybrid parts report their small cores as efficiency cores;
+// everything else is a performance core.
+struct OS_CoreInfo {
+    U32 osIndex; // what OS_thread_set_affinity takes
+    U32 physicalCore;
+    U32 l2Group;
+    U32 l3Group;
+    U32 kind; // OS_CoreKind
+};
+
 struct OS_SystemInfo {
     U32 logicalCores;
+    U32 physicalCores;
+    U32 efficiencyCores; // logical cores of OS_CoreKind_Efficiency
+    U32 coreCount;       // entries in cores: logicalCores capped at OS_MAX_TOPOLOGY_CORES
     U64 pageSize;
+    U64 largePageSize;   // 0 when OS_reserve_large can only fall back to normal pages
+    OS_CoreInfo cores[OS_MAX_TOPOLOGY_CORES];
 };
 
 UTILITIES_SHARED_API OS_SystemInfo* OS_get_system_info();
@@ -52,6 +76,19 @@ UTILITIES_SHARED_API B32 OS_commit(void* addr, U64 size);
 UTILITIES_SHARED_API void OS_decommit(void* addr, U64 size);
 UTILITIES_SHARED_API void OS_release(void* addr, U64 size);
 
+// Large pages. Explicit pages (hugetlbfs, MEM_LARGE_PAGES) come back already
+// committed and stay resident until OS_release: do not commit or decommit
+// them. Transparent pages commit and decommit like normal memory, in
+// largePageSize steps to keep the kernel's huge pages whole. When neither is
+// granted this is OS_reserve. size must be a multiple of largePageSize.
+enum OS_LargePageKind {
+    OS_LargePageKind_None = 0,
+    OS_LargePageKind_Explicit = 1,
+    OS_LargePageKind_Transparent = 2,
+};
+
+UTILITIES_SHARED_API void* OS_reserve_large(U64 size, U32* outKind); // OS_LargePageKind
+
 
 // ////////////////////////
 // Threads and Synchronization
@@ -76,6 +113,9 @@ typedef void OS_ThreadFunc(void* ptr);
 UTILITIES_SHARED_API OS_Handle OS_thread_create(OS_ThreadFunc* func, void* arg);
 UTILITIES_SHARED_API B32 OS_thread_join(OS_Handle thread);
 UTILITIES_SHARED_API void OS_thread_detach(OS_Handle thread);
+// Pins thread to one logical core (OS_CoreInfo::osIndex). Returns 0 where
+// the OS has no hard affinity (macOS) or the call fails.
+UTILITIES_SHARED_API B32 OS_thread_set_affinity(OS_Handle thread, U32 osCoreIndex);
 UTILITIES_SHARED_API void OS_thread_yield();
 UTILITIES_SHARED_API void OS_cpu_pause();
 
@@ -95,6 +135,13 @@ UTILITIES_SHARED_API OS_Handle OS_barrier_create(U32 threadCount);
 UTILITIES_SHARED_API void OS_barrier_destroy(OS_Handle barrier);
 UTILITIES_SHARED_API void OS_barrier_wait(OS_Handle barrier);
 
+// Wait-on-address (futex-style parking). OS_address_wait sleeps only while
+// *address still equals expected; wakes may be spurious, so callers
+// re-check their condition in a loop.
+UTILITIES_SHARED_API void OS_address_wait(U32* address, U32 expected);
+UTILITIES_SHARED_API void OS_address_wake_one(U32* address);
+UTILITIES_SHARED_API void OS_address_wake_all(U32* address);
+
 // ////////////////////////
 // File I/O
 
@@ -113,6 +160,10 @@ struct OS_FileInfo {
     B32 exists;
     U64 size;
     U64 lastWriteTimestampNs;
+    // Identity of the file behind the path (inode): changes when the path is
+    // replaced (rename over, delete and create), not when it is rewritten in
+    // place. 0 when it cannot be read.
+    U64 fileId;
 };
 
 UTILITIES_SHARED_API B32 OS_create_directory(const char* path);
@@ -139,6 +190,31 @@ enum OS_FileHintFlags {
 
 UTILITIES_SHARED_API void OS_file_set_hints(OS_Handle h, U64 hints);
 
+// ////////////////////////
+// File Watching
+//
+// A watch covers the entries directly inside one directory, not below it.
+// Polling never blocks. A Rescan event stands for changes that were lost
+// (queue overflow, or more than maxEvents pending): treat every entry as
+// changed. Closed means the directory itself went away and the watch will
+// report nothing more. A zero handle from OS_watch_directory means this
+// platform or filesystem cannot notify; fall back to stat polling.
+
+enum OS_WatchEventFlags {
+    OS_WatchEvent_Changed = (1u << 0),
+    OS_WatchEvent_Rescan = (1u << 1),
+    OS_WatchEvent_Closed = (1u << 2),
+};
+
+struct OS_WatchEvent {
+    StringU8 name; // entry name inside the watched directory; empty for Rescan / Closed
+    U32 flags;     // OS_WatchEventFlags
+};
+
+UTILITIES_SHARED_API OS_Handle OS_watch_directory(const char* path);
+UTILITIES_SHARED_API void OS_unwatch_directory(OS_Handle watch);
+UTILITIES_SHARED_API U32 OS_poll_watch_events(OS_Handle watch, Arena* arena, OS_WatchEvent* outEvents, U32 maxEvents);
+
 
 // ////////////////////////
 // Entry Point
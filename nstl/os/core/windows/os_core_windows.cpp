@@ -274,6 +274,22 @@ void OS_release(void* ptr, U64 size) {
     }
 }
 
+// Large pages must be reserved and committed in one call and cannot be
+// decommitted, so the whole range is resident from here on. They only exist
+// when the account holds SeLockMemoryPrivilege; see OS_WINDOWS_enable_large_pages_.
+void* OS_reserve_large(U64 size, U32* outKind) {
+    U64 largePageSize = g_OS_WindowsState.systemInfo.largePageSize;
+    *outKind = OS_LargePageKind_None;
+    if (largePageSize != 0u && (size & (largePageSize - 1u)) == 0u) {
+        void* result = VirtualAlloc(0, (SIZE_T)size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (result) {
+            *outKind = OS_LargePageKind_Explicit;
+            return result;
+        }
+    }
+    return OS_reserve(size);
+}
+
 static DWORD WINAPI _OS_thread_entry_point(void* arg) {
     OS_WINDOWS_Entity* entity = (OS_WINDOWS_Entity*)arg;
 #if defined(OS_WINDOWS_STANDALONE_THREAD_ENTRY)
@@ -331,6 +347,15 @@ void OS_thread_detach(OS_Handle thread) {
     free_OS_entity(entity);
 }
 
+B32 OS_thread_set_affinity(OS_Handle thread, U32 osCoreIndex) {
+    if (!thread.handle || osCoreIndex >= 64u) {
+        return 0;
+    }
+    OS_WINDOWS_Entity* entity = (OS_WINDOWS_Entity*)thread.handle;
+    ASSERT_DEBUG(entity->type == OS_WINDOWS_EntityType_Thread);
+    return SetThreadAffinityMask(entity->thread.handle, (DWORD_PTR)1 << osCoreIndex) != 0;
+}
+
 void OS_thread_yield() {
     SwitchToThread();
 }
@@ -485,6 +510,24 @@ void OS_barrier_wait(OS_Handle barrierHandle) {
     OS_mutex_unlock(entity->barrier.mutexHandle);
 }
 
+// WaitOnAddress lives in the API set behind Synchronization.lib.
+#pragma comment(lib, "Synchronization.lib")
+
+void OS_address_wait(U32* address, U32 expected) {
+    ASSERT_DEBUG(address != 0);
+    WaitOnAddress((volatile VOID*)address, &expected, sizeof(U32), INFINITE);
+}
+
+void OS_address_wake_one(U32* address) {
+    ASSERT_DEBUG(address != 0);
+    WakeByAddressSingle((PVOID)address);
+}
+
+void OS_address_wake_all(U32* address) {
+    ASSERT_DEBUG(address != 0);
+    WakeByAddressAll((PVOID)address);
+}
+
 B32 OS_create_directory(const char* path) {
     if (!path) {
         return 0;
@@ -697,6 +740,19 @@ OS_FileInfo OS_get_file_info(const char* path) {
     info.exists = 1;
     info.size = size.QuadPart;
     info.lastWriteTimestampNs = writeTime.QuadPart * 100u;
+
+    // The file index needs a handle; attribute-only access opens even files
+    // another process holds without sharing. Failing that the id stays 0.
+    HANDLE file = CreateFileA(path, FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 0,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file != INVALID_HANDLE_VALUE) {
+        BY_HANDLE_FILE_INFORMATION byHandle = {};
+        if (GetFileInformationByHandle(file, &byHandle)) {
+            U64 index = ((U64) byHandle.nFileIndexHigh << 32) | (U64) byHandle.nFileIndexLow;
+            info.fileId = ((U64) byHandle.dwVolumeSerialNumber << 32) ^ index;
+        }
+        CloseHandle(file);
+    }
     return info;
 }
 
@@ -707,6 +763,124 @@ B32 OS_file_copy_contents(const char* srcPath, const char* dstPath) {
     return CopyFileA(srcPath, dstPath, FALSE) ? 1 : 0;
 }
 
+static B32 OS_WINDOWS_watch_read_(OS_WINDOWS_Watch* watch) {
+    DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE |
+                   FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_CREATION;
+    ResetEvent(watch->overlapped.hEvent);
+    watch->reading = ReadDirectoryChangesW(watch->directory, watch->buffer, sizeof(watch->buffer), FALSE, filter, 0,
+                                           &watch->overlapped, 0) ? 1 : 0;
+    return watch->reading;
+}
+
+OS_Handle OS_watch_directory(const char* path) {
+    OS_Handle result = {};
+    if (!path) {
+        return result;
+    }
+
+    HANDLE directory = CreateFileA(path, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 0,
+                                   OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, 0);
+    if (directory == INVALID_HANDLE_VALUE) {
+        return result;
+    }
+
+    U64 stateSize = sizeof(OS_WINDOWS_Watch);
+    OS_WINDOWS_Watch* watch = (OS_WINDOWS_Watch*)OS_reserve(stateSize);
+    if (watch && !OS_commit(watch, stateSize)) {
+        OS_release(watch, stateSize);
+        watch = 0;
+    }
+    if (!watch) {
+        CloseHandle(directory);
+        return result;
+    }
+    watch->directory = directory;
+    watch->overlapped.hEvent = CreateEventA(0, TRUE, FALSE, 0);
+    OS_WINDOWS_Entity* entity = watch->overlapped.hEvent ? alloc_OS_entity() : 0;
+    if (!entity || !OS_WINDOWS_watch_read_(watch)) {
+        if (entity) {
+            free_OS_entity(entity);
+        }
+        if (watch->overlapped.hEvent) {
+            CloseHandle(watch->overlapped.hEvent);
+        }
+        CloseHandle(directory);
+        OS_release(watch, stateSize);
+        return result;
+    }
+
+    entity->type = OS_WINDOWS_EntityType_Watch;
+    entity->watch.state = watch;
+    result.handle = (U64*)entity;
+    return result;
+}
+
+void OS_unwatch_directory(OS_Handle watchHandle) {
+    OS_WINDOWS_Entity* entity = (OS_WINDOWS_Entity*)watchHandle.handle;
+    if (!entity) {
+        return;
+    }
+    ASSERT_DEBUG(entity->type == OS_WINDOWS_EntityType_Watch);
+
+    OS_WINDOWS_Watch* watch = entity->watch.state;
+    if (watch->reading) {
+        DWORD bytes = 0u;
+        CancelIoEx(watch->directory, &watch->overlapped);
+        GetOverlappedResult(watch->directory, &watch->overlapped, &bytes, TRUE);
+    }
+    CloseHandle(watch->overlapped.hEvent);
+    CloseHandle(watch->directory);
+    OS_release(watch, sizeof(OS_WINDOWS_Watch));
+    free_OS_entity(entity);
+}
+
+U32 OS_poll_watch_events(OS_Handle watchHandle, Arena* arena, OS_WatchEvent* outEvents, U32 maxEvents) {
+    OS_WINDOWS_Entity* entity = (OS_WINDOWS_Entity*)watchHandle.handle;
+    if (!entity || !arena || !outEvents) {
+        return 0;
+    }
+    ASSERT_DEBUG(entity->type == OS_WINDOWS_EntityType_Watch);
+
+    OS_WINDOWS_Watch* watch = entity->watch.state;
+    OS_WatchEventList list = {arena, outEvents, 0u, maxEvents, 0u};
+    while (watch->reading) {
+        DWORD bytes = 0u;
+        if (!GetOverlappedResult(watch->directory, &watch->overlapped, &bytes, FALSE)) {
+            if (GetLastError() != ERROR_IO_INCOMPLETE) {
+                // Typically the directory was deleted.
+                watch->reading = 0;
+                list.trailingFlags |= OS_WatchEvent_Rescan | OS_WatchEvent_Closed;
+            }
+            break;
+        }
+
+        // Zero bytes: the buffer overflowed and the batch was dropped.
+        if (bytes == 0u) {
+            list.trailingFlags |= OS_WatchEvent_Rescan;
+        } else {
+            U8* at = (U8*)watch->buffer;
+            for (;;) {
+                FILE_NOTIFY_INFORMATION* info = (FILE_NOTIFY_INFORMATION*)at;
+                char name[MAX_PATH * 3];
+                int length = WideCharToMultiByte(CP_UTF8, 0, info->FileName, (int)(info->FileNameLength / sizeof(WCHAR)),
+                                                 name, (int)sizeof(name), 0, 0);
+                if (length > 0) {
+                    OS_watch_events_push_(&list, str8(name, (U64)length));
+                }
+                if (info->NextEntryOffset == 0u) {
+                    break;
+                }
+                at += info->NextEntryOffset;
+            }
+        }
+
+        if (!OS_WINDOWS_watch_read_(watch)) {
+            list.trailingFlags |= OS_WatchEvent_Rescan | OS_WatchEvent_Closed;
+        }
+    }
+    return OS_watch_events_finish_(&list);
+}
+
 static OS_WINDOWS_Entity* alloc_OS_entity() {
     EnterCriticalSection(&g_OS_WindowsState.entityMutex);
     DEFER_REF(LeaveCriticalSection(&g_OS_WindowsState.entityMutex));
@@ -742,12 +916,114 @@ static void free_OS_entity(OS_WINDOWS_Entity* entity) {
     g_OS_WindowsState.freeEntities = entity;
 }
 
+// Only processor group 0 is walked: affinity masks past 64 cores need group
+// affinity, which nothing here uses. Raw ids are the lowest set bit of the
+// core's / cache's mask; OS_topology_finalize_ makes them dense.
+static void OS_WINDOWS_discover_topology_(OS_SystemInfo* info) {
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, 0, &length);
+    if (length == 0 || GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+        return;
+    }
+    Temp scratch = get_scratch(0, 0);
+    DEFER_REF(temp_end(&scratch));
+    U8* buffer = (U8*)arena_push(scratch.arena, length, 8u);
+    if (!buffer || !GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer,
+                                                     &length)) {
+        return;
+    }
+
+    U32 coreOfCpu[64];
+    U32 l2OfCpu[64];
+    U32 l3OfCpu[64];
+    U32 classOfCpu[64];
+    U64 cpuMask = 0u;
+    U32 maxClass = 0u;
+    for (U32 cpu = 0u; cpu < 64u; ++cpu) {
+        coreOfCpu[cpu] = cpu;
+        l2OfCpu[cpu] = cpu;
+        l3OfCpu[cpu] = 0u;
+        classOfCpu[cpu] = 0u;
+    }
+    for (DWORD offset = 0; offset < length;) {
+        PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX entry = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+        offset += entry->Size;
+        if (entry->Relationship == RelationProcessorCore) {
+            if (entry->Processor.GroupMask[0].Group != 0) {
+                continue;
+            }
+            U64 mask = (U64)entry->Processor.GroupMask[0].Mask;
+            if (mask == 0u) {
+                continue;
+            }
+            unsigned long owner = 0;
+            _BitScanForward64(&owner, mask);
+            for (U32 cpu = 0u; cpu < 64u; ++cpu) {
+                if (mask & (1ull << cpu)) {
+                    coreOfCpu[cpu] = (U32)owner;
+                    classOfCpu[cpu] = entry->Processor.EfficiencyClass;
+                }
+            }
+            cpuMask |= mask;
+            maxClass = MAX(maxClass, (U32)entry->Processor.EfficiencyClass);
+        } else if (entry->Relationship == RelationCache &&
+                   (entry->Cache.Level == 2 || entry->Cache.Level == 3) && entry->Cache.GroupMask.Group == 0) {
+            U64 mask = (U64)entry->Cache.GroupMask.Mask;
+            if (mask == 0u) {
+                continue;
+            }
+            unsigned long owner = 0;
+            _BitScanForward64(&owner, mask);
+            U32* groupOfCpu = (entry->Cache.Level == 2) ? l2OfCpu : l3OfCpu;
+            for (U32 cpu = 0u; cpu < 64u; ++cpu) {
+                if (mask & (1ull << cpu)) {
+                    groupOfCpu[cpu] = (U32)owner;
+                }
+            }
+        }
+    }
+
+    // A higher EfficiencyClass is a faster core; uniform parts report 0.
+    U32 count = 0u;
+    for (U32 cpu = 0u; cpu < 64u && count < OS_MAX_TOPOLOGY_CORES; ++cpu) {
+        if (!(cpuMask & (1ull << cpu))) {
+            continue;
+        }
+        OS_CoreInfo* core = &info->cores[count++];
+        core->osIndex = cpu;
+        core->physicalCore = coreOfCpu[cpu];
+        core->l2Group = l2OfCpu[cpu];
+        core->l3Group = l3OfCpu[cpu];
+        core->kind = (maxClass != 0u && classOfCpu[cpu] < maxClass) ? OS_CoreKind_Efficiency
+                                                                     : OS_CoreKind_Performance;
+    }
+    info->coreCount = count;
+}
+
 #if !defined(OS_WINDOWS_NO_ENTRY_POINT)
+// Returns the large page size, or 0 when the privilege is not held (the
+// default for non-admin accounts; grant "Lock pages in memory" to enable).
+static U64 OS_WINDOWS_enable_large_pages_() {
+    HANDLE token = 0;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+        return 0u;
+    }
+    TOKEN_PRIVILEGES privileges = {};
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    B32 enabled = LookupPrivilegeValueA(0, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid) &&
+                  AdjustTokenPrivileges(token, FALSE, &privileges, 0, 0, 0) &&
+                  GetLastError() == ERROR_SUCCESS; // ERROR_NOT_ALL_ASSIGNED when not held
+    CloseHandle(token);
+    return enabled ? (U64)GetLargePageMinimum() : 0u;
+}
+
 int main(int argc, char** argv) {
     SYSTEM_INFO systemInfo = {};
     GetSystemInfo(&systemInfo);
     g_OS_WindowsState.systemInfo.logicalCores = systemInfo.dwNumberOfProcessors;
     g_OS_WindowsState.systemInfo.pageSize = systemInfo.dwPageSize;
+    g_OS_WindowsState.systemInfo.largePageSize = OS_WINDOWS_enable_large_pages_();
     QueryPerformanceFrequency(&g_OS_WindowsState.counterFrequency);
     LARGE_INTEGER processStartCounter = {};
     QueryPerformanceCounter(&processStartCounter);
@@ -761,6 +1037,9 @@ int main(int argc, char** argv) {
     g_OS_WindowsState.osEntityArena = arena_alloc();
     InitializeCriticalSection(&g_OS_WindowsState.entityMutex);
 
+    OS_WINDOWS_discover_topology_(&g_OS_WindowsState.systemInfo);
+    OS_topology_finalize_(&g_OS_WindowsState.systemInfo);
+
     base_entry_point(argc, argv);
     return 0;
 }
@@ -21,6 +21,16 @@ enum OS_WINDOWS_EntityType : U64 {
     OS_WINDOWS_EntityType_File = (3 << 0),
     OS_WINDOWS_EntityType_ConditionVariable = (4 << 0),
     OS_WINDOWS_EntityType_Barrier = (5 << 0),
+    OS_WINDOWS_EntityType_Watch = (6 << 0),
+};
+
+// ReadDirectoryChangesW fills buffer in the background; one read stays in
+// flight between polls so nothing is missed while the caller is away.
+struct OS_WINDOWS_Watch {
+    HANDLE directory;
+    OVERLAPPED overlapped;
+    B32 reading;
+    DWORD buffer[KB(16)]; // 64 KB, the most a network share accepts
 };
 
 struct OS_WINDOWS_Entity {
@@ -41,6 +51,10 @@ struct OS_WINDOWS_Entity {
             HANDLE handle;
         } file;
 
+        struct {
+            OS_WINDOWS_Watch* state;
+        } watch;
+
         CONDITION_VARIABLE conditionVariable;
 
         struct {
@@ -14,5 +14,5 @@
 #include "graphics/macos/os_graphics_macos.mm"
 #include "audio/macos/os_audio_macos.mm"
 #elif defined(PLATFORM_OS_LINUX)
-#error "not supported"
+#include "core/linux/os_core_linux.cpp"
 #endif
@@ -15,5 +15,5 @@
 #include "core/macos/os_core_macos.hpp"
 #include "graphics/macos/os_graphics_macos.hpp"
 #elif defined(PLATFORM_OS_LINUX)
-#error "not supported"
+#include "core/linux/os_core_linux.hpp"
 #endif
@@ -2,7 +2,7 @@
 
 #define PROF_EVENT_SITE_MASK 0x3FFFull
 #define PROF_TICK_SPAN (1ull << 48u)
-#define PROF_CAT_ALL (PROF_CAT_DEFAULT | PROF_CAT_GPU)
+#define PROF_CAT_ALL (PROF_CAT_DEFAULT | PROF_CAT_GPU | PROF_CAT_ALLOC)
 #define PROF_NIL_INDEX 0xFFFFFFFFu
 
 struct ProfSiteEntry {
@@ -68,6 +68,9 @@ struct ProfSiteAccum {
     U64 sumExclNs;
     U64 maxInclNs;
     U64 sumHits;
+    U64 sumAllocBytes;
+    U64 maxAllocBytes;
+    U64 sumAllocs;
 };
 
 struct ProfGlobal {
@@ -101,6 +104,8 @@ struct ProfGlobal {
     U64 frameInclNs[PROF_MAX_SITES];
     S64 frameExclNs[PROF_MAX_SITES];
     U32 frameHits[PROF_MAX_SITES];
+    U64 frameAllocBytes[PROF_MAX_SITES];
+    U32 frameAllocs[PROF_MAX_SITES];
 
     ProfSiteAccum windowAccum[PROF_MAX_SITES];
     U32 windowFrames;
@@ -115,6 +120,7 @@ struct ProfGlobal {
     U64 framePathInclNs[PROF_MAX_PATHS];
     S64 framePathExclNs[PROF_MAX_PATHS];
     U32 framePathHits[PROF_MAX_PATHS];
+    U64 framePathAllocBytes[PROF_MAX_PATHS];
     ProfSiteAccum pathAccum[PROF_MAX_PATHS];
     ProfPathStats* pathStats;
 
@@ -218,6 +224,20 @@ static void prof_measure_clock_() {
     g_prof.resolutionNs = (F32)prof_mul_div_(minDelta, 1000000000ull, g_prof.tickFrequencyHz);
 }
 
+// Tracked arena pushes made while holding the mutex (site strings, rings)
+// must not come back in through prof_alloc.
+thread_local B32 t_profLocked = 0;
+
+static void prof_lock_() {
+    OS_mutex_lock(g_prof.mutex);
+    t_profLocked = 1;
+}
+
+static void prof_unlock_() {
+    t_profLocked = 0;
+    OS_mutex_unlock(g_prof.mutex);
+}
+
 static ProfThreadEntry* prof_thread_entry_for_current_() {
     U32 threadId = OS_get_thread_id_u32();
     for (U32 index = 0u; index < g_prof.threadCount; ++index) {
@@ -238,15 +258,10 @@ static ProfThreadEntry* prof_thread_entry_for_current_() {
     entry->used = 1;
     entry->threadId = threadId;
     entry->lastFullTick = prof_tick();
-    Temp scratch = get_scratch(0, 0);
-    if (scratch.arena) {
-        StringU8 name = str8_fmt(scratch.arena, "thread {}", threadId);
-        StringU8 copy = str8_cpy(g_prof.arena, name);
-        entry->name = (const char*)copy.data;
-        temp_end(&scratch);
-    } else {
-        entry->name = "thread";
-    }
+    // Straight into the prof arena: a tracked push can bind a thread that
+    // has no thread context (and so no scratch) yet.
+    StringU8 name = str8_fmt(g_prof.arena, "thread {}", threadId);
+    entry->name = name.data ? (const char*)name.data : "thread";
     g_prof.threadCount += 1u;
     return entry;
 }
@@ -260,9 +275,9 @@ void prof_thread_bind(ProfTls* outTls) {
         return;
     }
 
-    OS_mutex_lock(g_prof.mutex);
+    prof_lock_();
     ProfThreadEntry* entry = prof_thread_entry_for_current_();
-    OS_mutex_unlock(g_prof.mutex);
+    prof_unlock_();
     if (!entry) {
         return;
     }
@@ -276,12 +291,37 @@ void prof_thread_name(const char* name) {
     if (!g_prof.initialized || !name) {
         return;
     }
-    OS_mutex_lock(g_prof.mutex);
+    prof_lock_();
     ProfThreadEntry* entry = prof_thread_entry_for_current_();
     if (entry) {
         entry->name = prof_intern_string_(name);
     }
-    OS_mutex_unlock(g_prof.mutex);
+    prof_unlock_();
+}
+
+void prof_begin(U32 site) {
+    prof_emit(PROF_EVENT_KIND_BEGIN, site, PROF_CAT_DEFAULT);
+}
+
+void prof_end() {
+    prof_emit(PROF_EVENT_KIND_END, 0ull, PROF_CAT_DEFAULT);
+}
+
+void prof_alloc(U32* site, const char* label, const char* file, U32 line, U64 size) {
+    if (t_profLocked) {
+        return;
+    }
+    U32 id = ATOMIC_LOAD(site, MEMORY_ORDER_RELAXED);
+    if (id == 0u) {
+        id = prof_require_site(label, file, line, PROF_CAT_ALLOC);
+        ATOMIC_STORE(site, id, MEMORY_ORDER_RELAXED);
+    }
+    ProfTls* tls = (id != 0u) ? prof_tls_recording(PROF_CAT_ALLOC) : 0;
+    if (!tls) {
+        return;
+    }
+    U64 clamped = MIN(size, PROF_EVENT_TICK_MASK);
+    prof_push_packed(tls, (PROF_EVENT_KIND_ALLOC << 62u) | ((U64)id << 48u) | clamped);
 }
 
 U32 prof_require_site(const char* label, const char* file, U32 line, U32 category) {
@@ -290,15 +330,15 @@ U32 prof_require_site(const char* label, const char* file, U32 line, U32 categor
     }
 
     U64 key = prof_hash_site_(label, file ? file : "", line);
-    OS_mutex_lock(g_prof.mutex);
+    prof_lock_();
     for (U32 index = 1u; index < g_prof.siteCount; ++index) {
         if (g_prof.sites[index].key == key) {
-            OS_mutex_unlock(g_prof.mutex);
+            prof_unlock_();
             return index;
         }
     }
     if (g_prof.siteCount >= PROF_MAX_SITES) {
-        OS_mutex_unlock(g_prof.mutex);
+        prof_unlock_();
         return 0u;
     }
 
@@ -318,7 +358,7 @@ U32 prof_require_site(const char* label, const char* file, U32 line, U32 categor
     stats->category = category;
 
     g_prof.siteCount = index + 1u;
-    OS_mutex_unlock(g_prof.mutex);
+    prof_unlock_();
     return index;
 }
 
@@ -357,7 +397,10 @@ void prof_init() {
     }
     MEMSET(&g_prof, 0, sizeof(g_prof));
 
-    g_prof.arena = arena_alloc(.arenaSize = MB(96), .committedSize = MB(1), .flags = ArenaFlags_DoChain, .debugName = "prof");
+    // Holds the per-thread event rings, written on every scope and swept at
+    // collation.
+    g_prof.arena = arena_alloc(.arenaSize = MB(96), .committedSize = MB(1),
+                               .flags = ArenaFlags_DoChain | ArenaFlags_LargePages, .debugName = "prof");
     if (!g_prof.arena) {
         return;
     }
@@ -554,6 +597,21 @@ static void prof_collate_thread_(ProfThreadEntry* thread, ProfFrameSlot* slot, U
         U64 packed = thread->entries[at & (PROF_RING_ENTRIES - 1u)];
         U64 kind = packed >> 62u;
         U32 site = (U32)((packed >> 48u) & PROF_EVENT_SITE_MASK);
+
+        // Charged to the callsite and to a leaf for it under the open scope.
+        if (kind == PROF_EVENT_KIND_ALLOC) {
+            if (site == 0u || site >= g_prof.siteCount) {
+                continue;
+            }
+            U64 bytes = packed & PROF_EVENT_TICK_MASK;
+            U32 parentPath = (thread->openDepth > 0u) ? thread->open[thread->openDepth - 1u].path : PROF_PATH_NIL;
+            U32 path = prof_path_require_(parentPath, site, (U32)(thread - g_prof.threads));
+            g_prof.frameAllocBytes[site] += bytes;
+            g_prof.frameAllocs[site] += 1u;
+            g_prof.framePathAllocBytes[path] += bytes;
+            continue;
+        }
+
         U64 tick = prof_reconstruct_tick_(thread, packed & PROF_EVENT_TICK_MASK);
         U64 ns = prof_tick_to_ns(tick);
 
@@ -643,10 +701,26 @@ void prof_frame_advance() {
             if (inclNs > accum->maxInclNs) {
                 accum->maxInclNs = inclNs;
             }
+            U64 allocBytes = g_prof.frameAllocBytes[site];
+            stats->lastAllocBytes = allocBytes;
+            accum->sumAllocBytes += allocBytes;
+            accum->sumAllocs += g_prof.frameAllocs[site];
+            accum->maxAllocBytes = MAX(accum->maxAllocBytes, allocBytes);
 
             g_prof.frameInclNs[site] = 0u;
             g_prof.frameExclNs[site] = 0;
             g_prof.frameHits[site] = 0u;
+            g_prof.frameAllocBytes[site] = 0u;
+            g_prof.frameAllocs[site] = 0u;
+        }
+
+        // Children always come after their parent, so one backward pass
+        // makes alloc bytes inclusive.
+        for (U32 path = g_prof.pathCount; path-- > 1u;) {
+            U32 parent = g_prof.pathStats[path].parent;
+            if (parent != PROF_PATH_NIL) {
+                g_prof.framePathAllocBytes[parent] += g_prof.framePathAllocBytes[path];
+            }
         }
 
         for (U32 path = 1u; path < g_prof.pathCount; ++path) {
@@ -662,10 +736,15 @@ void prof_frame_advance() {
             if (inclNs > accum->maxInclNs) {
                 accum->maxInclNs = inclNs;
             }
+            U64 allocBytes = g_prof.framePathAllocBytes[path];
+            g_prof.pathStats[path].lastAllocBytes = allocBytes;
+            accum->sumAllocBytes += allocBytes;
+            accum->maxAllocBytes = MAX(accum->maxAllocBytes, allocBytes);
 
             g_prof.framePathInclNs[path] = 0u;
             g_prof.framePathExclNs[path] = 0;
             g_prof.framePathHits[path] = 0u;
+            g_prof.framePathAllocBytes[path] = 0u;
         }
 
         g_prof.frameHistoryMs[frame % PROF_HISTORY_FRAMES] =
@@ -681,6 +760,9 @@ void prof_frame_advance() {
                 stats->avgExclMs = (F32)((F64)accum->sumExclNs / 1.0e6) * inverse;
                 stats->maxInclMs = (F32)((F64)accum->maxInclNs / 1.0e6);
                 stats->avgHits = (F32)accum->sumHits * inverse;
+                stats->avgAllocBytes = accum->sumAllocBytes / g_prof.windowFrames;
+                stats->maxAllocBytes = accum->maxAllocBytes;
+                stats->avgAllocs = (F32)accum->sumAllocs * inverse;
                 MEMSET(accum, 0, sizeof(*accum));
             }
             for (U32 path = 1u; path < g_prof.pathCount; ++path) {
@@ -690,6 +772,8 @@ void prof_frame_advance() {
                 stats->avgExclMs = (F32)((F64)accum->sumExclNs / 1.0e6) * inverse;
                 stats->maxInclMs = (F32)((F64)accum->maxInclNs / 1.0e6);
                 stats->avgHits = (F32)accum->sumHits * inverse;
+                stats->avgAllocBytes = accum->sumAllocBytes / g_prof.windowFrames;
+                stats->maxAllocBytes = accum->maxAllocBytes;
                 MEMSET(accum, 0, sizeof(*accum));
             }
             g_prof.windowFrames = 0u;
@@ -1089,6 +1173,9 @@ void prof_shutdown() {}
 U32 prof_require_site(const char*, const char*, U32, U32) { return 0u; }
 void prof_thread_bind(ProfTls* outTls) { if (outTls) { MEMSET(outTls, 0, sizeof(*outTls)); } }
 void prof_thread_name(const char*) {}
+void prof_begin(U32) {}
+void prof_end() {}
+void prof_alloc(U32*, const char*, const char*, U32, U64) {}
 void prof_frame_advance() {}
 U64 prof_current_frame() { return 0u; }
 void prof_pause(B32) {}
@@ -17,6 +17,7 @@
 
 #define PROF_CAT_DEFAULT (1u << 0u)
 #define PROF_CAT_GPU (1u << 1u)
+#define PROF_CAT_ALLOC (1u << 2u) // arena pushes, see ARENA_TRACKING
 
 #define PROF_MAX_PATHS 1024u
 #define PROF_PATH_NIL 0xFFFFFFFFu
@@ -55,6 +56,11 @@ struct ProfPathStats {
     F32 maxInclMs;
     F32 avgHits;
     F32 lastInclMs;
+    // Arena bytes pushed under this path per frame, children included. Only
+    // filled with ARENA_TRACKING; callsites are leaf paths.
+    U64 lastAllocBytes;
+    U64 avgAllocBytes;
+    U64 maxAllocBytes;
 };
 
 struct ProfFrameView {
@@ -76,6 +82,11 @@ struct ProfSiteStats {
     F32 avgHits;
     F32 lastInclMs;
     F32 historyMs[PROF_HISTORY_FRAMES];
+    // Arena bytes and pushes per frame for PROF_CAT_ALLOC callsites.
+    U64 lastAllocBytes;
+    U64 avgAllocBytes;
+    U64 maxAllocBytes;
+    F32 avgAllocs;
 };
 
 struct ProfInfo {
@@ -96,6 +107,13 @@ UTILITIES_SHARED_API void prof_shutdown();
 UTILITIES_SHARED_API U32 prof_require_site(const char* label, const char* file, U32 line, U32 category);
 UTILITIES_SHARED_API void prof_thread_bind(ProfTls* outTls);
 UTILITIES_SHARED_API void prof_thread_name(const char* name);
+// Out-of-line begin/end for modules below prof (the job system's worker
+// timeline); instrumented code above prof uses the PROF_* macros instead.
+UTILITIES_SHARED_API void prof_begin(U32 site);
+UTILITIES_SHARED_API void prof_end();
+// One tracked arena push (ARENA_TRACKING). *site caches the PROF_CAT_ALLOC
+// site for label/file/line, registered on first use.
+UTILITIES_SHARED_API void prof_alloc(U32* site, const char* label, const char* file, U32 line, U64 size);
 UTILITIES_SHARED_API void prof_frame_advance();
 UTILITIES_SHARED_API U64 prof_current_frame();
 UTILITIES_SHARED_API void prof_pause(B32 paused);
@@ -132,27 +150,40 @@ static inline U64 prof_tick() {
 
 #define PROF_EVENT_KIND_BEGIN 1ull
 #define PROF_EVENT_KIND_END 2ull
+#define PROF_EVENT_KIND_ALLOC 3ull // low 48 bits hold the size, not a tick
 #define PROF_EVENT_TICK_MASK 0x0000FFFFFFFFFFFFull
 
 static thread_local ProfTls t_profTls;
 
-static inline void prof_emit(U64 kind, U64 site, U32 category) {
+// The calling thread's ring if the category is recording, else 0.
+static inline ProfTls* prof_tls_recording(U32 category) {
     ProfTls* tls = &t_profTls;
     if (!tls->entries) {
         prof_thread_bind(tls);
         if (!tls->entries) {
-            return;
+            return 0;
         }
     }
     if ((*tls->enableMask & category) == 0u) {
-        return;
+        return 0;
     }
-    U64 packed = (kind << 62u) | (site << 48u) | (prof_tick() & PROF_EVENT_TICK_MASK);
+    return tls;
+}
+
+static inline void prof_push_packed(ProfTls* tls, U64 packed) {
     U64 head = *tls->head;
     tls->entries[head & (PROF_RING_ENTRIES - 1u)] = packed;
     ATOMIC_STORE(tls->head, head + 1u, MEMORY_ORDER_RELEASE);
 }
 
+static inline void prof_emit(U64 kind, U64 site, U32 category) {
+    ProfTls* tls = prof_tls_recording(category);
+    if (!tls) {
+        return;
+    }
+    prof_push_packed(tls, (kind << 62u) | (site << 48u) | (prof_tick() & PROF_EVENT_TICK_MASK));
+}
+
 struct ProfScope {
     U32 site;
     U32 category;
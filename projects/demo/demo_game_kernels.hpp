@@ -80,15 +80,9 @@ struct DemoTickStats {
 
 // Rotate v by the unit quaternion q — the same rotation quat_to_mat4
 // expresses (row-vector v·M); the suite pins the two against each other.
+// The exact form: tick results must not depend on the SIMD backend.
 static Vec3F32 demo_collider_quat_rotate_(QuatF32 q, Vec3F32 v) {
-    F32 tx = 2.0f * (q.y * v.z - q.z * v.y + q.w * v.x);
-    F32 ty = 2.0f * (q.z * v.x - q.x * v.z + q.w * v.y);
-    F32 tz = 2.0f * (q.x * v.y - q.y * v.x + q.w * v.z);
-    Vec3F32 result;
-    result.x = v.x + q.y * tz - q.z * ty;
-    result.y = v.y + q.z * tx - q.x * tz;
-    result.z = v.z + q.x * ty - q.y * tx;
-    return result;
+    return quat_rotate_exact(q, v);
 }
 
 static Vec3F32 demo_collider_quat_unrotate_(QuatF32 q, Vec3F32 v) {
@@ -191,6 +185,34 @@ static B32 demo_collider_sphere_contact_(const DemoCollider* collider, Vec3F32 c
     return 1;
 }
 
+// Broad phase, four colliders per call: a lane drops out only when the
+// collider's bounding sphere cannot reach the player sphere, so the exact
+// narrow phase above still decides every contact and the tick stays
+// bit-identical. (r + b)^2 <= 2 (r^2 + b^2) keeps it free of sqrt; the
+// extra slack covers rounding.
+static U32 demo_collider_candidates_x4_(const DemoCollider* colliders, U32 count,
+                                        Vec3F32 center, F32 radius) {
+    F32 xs[4] = {};
+    F32 ys[4] = {};
+    F32 zs[4] = {};
+    F32 boundsSq[4] = {};
+    for (U32 lane = 0u; lane < count; ++lane) {
+        const DemoCollider* collider = colliders + lane;
+        xs[lane] = collider->center.x;
+        ys[lane] = collider->center.y;
+        zs[lane] = collider->center.z;
+        Vec3F32 h = collider->halfExtents;
+        boundsSq[lane] = (collider->kind == DemoCollider_Sphere)
+            ? collider->radius * collider->radius
+            : h.x * h.x + h.y * h.y + h.z * h.z;
+    }
+    Vec3x4F32 delta = vec3x4_sub(vec3x4_load(xs, ys, zs), vec3x4_set1(center));
+    F32x4 distSq = vec3x4_dot(delta, delta);
+    F32x4 reachSq = f32x4_mul(f32x4_add(f32x4_set1(radius * radius), f32x4_load(boundsSq)),
+                              f32x4_set1(2.01f));
+    return m32x4_bits(m32x4_not(f32x4_gt(distSq, reachSq))) & ((1u << count) - 1u);
+}
+
 static void demo_game_tick_(DemoPlayerState* player, const DemoActions* actions,
                            const DemoColliderSet* colliders, U64 tickIndex,
                            DemoTickStats* outStats) {
@@ -258,12 +280,18 @@ static void demo_game_tick_(DemoPlayerState* player, const DemoActions* actions,
     B32 contactGrounded = 0;
     for (U32 iteration = 0u; iteration < DEMO_GAME_RESOLVE_MAX_ITERATIONS; ++iteration) {
         DemoContact deepest = {};
-        for (U32 at = 0u; at < colliders->count; ++at) {
-            DemoContact contact;
-            if (demo_collider_sphere_contact_(colliders->colliders + at, player->position,
-                                             DEMO_GAME_PLAYER_RADIUS, &contact) &&
-                contact.depth > deepest.depth) {
-                deepest = contact;
+        for (U32 at = 0u; at < colliders->count; at += 4u) {
+            U32 lanes = MIN(colliders->count - at, 4u);
+            U32 candidates = demo_collider_candidates_x4_(colliders->colliders + at, lanes,
+                                                          player->position, DEMO_GAME_PLAYER_RADIUS);
+            for (U32 lane = 0u; lane < lanes; ++lane) {
+                DemoContact contact;
+                if ((candidates & (1u << lane)) &&
+                    demo_collider_sphere_contact_(colliders->colliders + at + lane, player->position,
+                                                  DEMO_GAME_PLAYER_RADIUS, &contact) &&
+                    contact.depth > deepest.depth) {
+                    deepest = contact;
+                }
             }
         }
         if (deepest.depth <= 0.0f) {
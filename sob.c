@@ -91,6 +91,7 @@ typedef enum BuildTarget {
     BuildTarget_Shaders,
     BuildTarget_Cook,
     BuildTarget_Test,
+    BuildTarget_Bench,
     BuildTarget_Clean,
 } BuildTarget;
 
@@ -109,6 +110,7 @@ static void print_usage(void) {
     printf("  shaders  Build reloadable shader artifacts\n");
     printf("  cook     Build the asset cooker and cook projects/<project>/assets/src\n");
     printf("  test     Build and run the CPU seam tests\n");
+    printf("  bench    Build and run the CPU microbenchmarks (use release)\n");
     printf("  clean    Remove build artifacts\n");
     printf("\n");
     printf("Modes:\n");
@@ -179,6 +181,10 @@ static int parse_target(const char* value, BuildTarget* outTarget) {
         *outTarget = BuildTarget_Test;
         return 1;
     }
+    if (strcmp(value, "bench") == 0) {
+        *outTarget = BuildTarget_Bench;
+        return 1;
+    }
     if (strcmp(value, "shaders") == 0) {
         *outTarget = BuildTarget_Shaders;
         return 1;
@@ -220,6 +226,9 @@ static const char* build_target_name(BuildTarget target) {
     if (target == BuildTarget_Test) {
         return "test";
     }
+    if (target == BuildTarget_Bench) {
+        return "bench";
+    }
     if (target == BuildTarget_Shaders) {
         return "shaders";
     }
@@ -316,6 +325,17 @@ static void apply_cpp_runtime_flags(Sob_Target* target) {
 #endif
 }
 
+// The _exact math forms and the SIMD layer only round alike when no side is
+// contracted into FMAs; clang contracts by default on arm64. MSVC leaves
+// contraction off unless /fp:contract or /fp:fast asks for it.
+static void apply_float_model_flags(Sob_Target* target) {
+#if !SOB_WINDOWS
+    sob_target_add_cflags(target, "-ffp-contract=off");
+#else
+    (void)target;
+#endif
+}
+
 static void apply_third_party_warning_flags(Sob_Target* target) {
 #if SOB_WINDOWS
     const char* flags[] = {
@@ -401,6 +421,7 @@ static int tool_build_begin(ToolBuild* tool, const char* name, const char* exeBa
 
     sob_target_set_standard(tool->target, Sob_Standard_Cpp20);
     apply_cpp_runtime_flags(tool->target);
+    apply_float_model_flags(tool->target);
 #if !SOB_WINDOWS
     sob_target_add_cflags(tool->target, "-pthread");
     sob_target_add_ldflags(tool->target, "-pthread");
@@ -719,7 +740,7 @@ static int build_slang_shaders(Sob_Arena* arena) {
         sob_cmd_append(cmd, shaders[i].src);
         sob_cmd_append(cmd, "-I");
         sob_cmd_append(cmd, "engine/shaders");
-#if SOB_WINDOWS
+#if SOB_WINDOWS || SOB_LINUX
         sob_cmd_append(cmd, "-DGFX_SHADER_TARGET_VULKAN=1");
         sob_cmd_append(cmd, "-target");
         sob_cmd_append(cmd, "spirv");
@@ -808,6 +829,7 @@ static int configure_runtime_executable(Sob_Arena* arena, Sob_Target* target, Bu
     sob_target_add_include(target, "third_party/freetype/include");
     sob_target_set_standard(target, Sob_Standard_Cpp20);
     apply_cpp_runtime_flags(target);
+    apply_float_model_flags(target);
     apply_common_warning_flags(target);
     apply_third_party_warning_flags(target);
     apply_mode_target_flags(target, mode);
@@ -1031,15 +1053,21 @@ static S32 build_and_run_cooker(BuildMode mode) {
 }
 
 #define TEST_EXE_BASENAME "utilities_tests"
+#define BENCH_EXE_BASENAME "utilities_bench"
 #if SOB_WINDOWS
 #define TEST_RUN_PATH BUILD_DIR "\\tools\\" TEST_EXE_BASENAME ".exe"
+#define BENCH_RUN_PATH BUILD_DIR "\\tools\\" BENCH_EXE_BASENAME ".exe"
 #else
 #define TEST_RUN_PATH BUILD_DIR "/tools/" TEST_EXE_BASENAME
+#define BENCH_RUN_PATH BUILD_DIR "/tools/" BENCH_EXE_BASENAME
 #endif
 
-static S32 build_and_run_tests(BuildMode mode) {
+// Tests and benchmarks share one shape: a single tests/ TU that unity-
+// includes nstl, linked against the vendor lib, then run in place.
+static S32 build_and_run_test_tool(BuildMode mode, const char* name, const char* exeBasename,
+                                   const char* source, const char* runPath) {
     ToolBuild tool;
-    if (!tool_build_begin(&tool, "tests", TEST_EXE_BASENAME, mode)) {
+    if (!tool_build_begin(&tool, name, exeBasename, mode)) {
         return 1;
     }
     Sob_Target* vendor = configure_vendor_lib(tool.ctx);
@@ -1047,7 +1075,7 @@ static S32 build_and_run_tests(BuildMode mode) {
         sob_arena_destroy(tool.arena);
         return 1;
     }
-    sob_target_add_source(tool.target, "tests/test_main.cpp");
+    sob_target_add_source(tool.target, source);
     sob_target_add_include(tool.target, ".");
     sob_target_add_include(tool.target, "third_party/freetype_local/include");
     sob_target_add_include(tool.target, "third_party/freetype/include");
@@ -1057,7 +1085,7 @@ static S32 build_and_run_tests(BuildMode mode) {
     apply_common_warning_flags(tool.target);
     apply_third_party_warning_flags(tool.target);
 
-    S32 buildResult = tool_build_finish(&tool, "tests", mode);
+    S32 buildResult = tool_build_finish(&tool, name, mode);
     if (buildResult != 0) {
         return buildResult;
     }
@@ -1071,13 +1099,21 @@ static S32 build_and_run_tests(BuildMode mode) {
         sob_arena_destroy(cmdArena);
         return 1;
     }
-    sob_cmd_append(cmd, TEST_RUN_PATH);
-    printf("==> Running tests...\n");
+    sob_cmd_append(cmd, runPath);
+    printf("==> Running %s...\n", name);
     S32 result = sob_cmd_run(cmd);
     sob_arena_destroy(cmdArena);
     return result;
 }
 
+static S32 build_and_run_tests(BuildMode mode) {
+    return build_and_run_test_tool(mode, "tests", TEST_EXE_BASENAME, "tests/test_main.cpp", TEST_RUN_PATH);
+}
+
+static S32 build_and_run_benchmarks(BuildMode mode) {
+    return build_and_run_test_tool(mode, "bench", BENCH_EXE_BASENAME, "tests/bench_main.cpp", BENCH_RUN_PATH);
+}
+
 // The host's hot-reload watch list, generated per module build by a
 // compiler dep scan of the active project's TU. The host polls exactly
 // these paths; nothing is hand-listed.
@@ -1221,6 +1257,10 @@ static S32 build_project_targets(BuildTarget requestedTarget, BuildMode mode) {
         sob_arena_destroy(arena);
         return build_and_run_tests(mode);
     }
+    if (requestedTarget == BuildTarget_Bench) {
+        sob_arena_destroy(arena);
+        return build_and_run_benchmarks(mode);
+    }
     if (requestedTarget == BuildTarget_Shaders) {
         S32 shaderResult = build_slang_shaders(arena);
         sob_arena_destroy(arena);
@@ -1269,6 +1309,7 @@ static S32 build_project_targets(BuildTarget requestedTarget, BuildMode mode) {
         configure_common_includes(moduleTarget);
         sob_target_set_standard(moduleTarget, Sob_Standard_Cpp20);
         apply_cpp_runtime_flags(moduleTarget);
+        apply_float_model_flags(moduleTarget);
 #if SOB_WINDOWS
         sob_target_define(moduleTarget, "UTILITIES_SHARED_IMPORT", .value = "1");
         sob_target_link(moduleTarget, HOST_IMPORT_LIB_PATH, .kind = Sob_LibKind_Static);
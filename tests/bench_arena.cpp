@@ -0,0 +1,56 @@
+//
+// Arena page size on a 256 MB random walk. Every step is a dependent load
+// from a different cache line, so with 4 KB pages nearly every step also
+// misses the TLB; ArenaFlags_LargePages is meant to take that away. The
+// "large" variant prints what the OS actually granted.
+//
+
+#define BENCH_ARENA_WALK_BYTES MB(256)
+#define BENCH_ARENA_WALK_STEPS (1u << 24)
+
+struct BenchArenaNode {
+    U64 next;
+    U8 pad[56]; // one node per cache line
+};
+
+static void bench_arena_walk_(B32 largePages) {
+    Arena* arena = arena_alloc(.arenaSize = BENCH_ARENA_WALK_BYTES + KB(64), .committedSize = KB(32),
+                               .flags = largePages ? (U64)ArenaFlags_LargePages : (U64)ArenaFlags_None);
+    U64 nodeCount = BENCH_ARENA_WALK_BYTES / sizeof(BenchArenaNode);
+    BenchArenaNode* nodes = ARENA_PUSH_ARRAY_ALIGNED(arena, BenchArenaNode, nodeCount, 64u);
+
+    // Sattolo's shuffle: a single cycle through every node.
+    for (U64 at = 0u; at < nodeCount; ++at) {
+        nodes[at].next = at;
+    }
+    U64 rng = 0x9E3779B97F4A7C15ull;
+    for (U64 at = nodeCount - 1u; at > 0u; --at) {
+        rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+        U64 swap = (rng >> 33) % at;
+        U64 next = nodes[at].next;
+        nodes[at].next = nodes[swap].next;
+        nodes[swap].next = next;
+    }
+
+    const char* variant = "4K pages";
+    if (largePages) {
+        variant = (arena->largePages == OS_LargePageKind_Explicit)      ? "large (explicit)"
+                  : (arena->largePages == OS_LargePageKind_Transparent) ? "large (THP)"
+                                                                        : "large (not granted)";
+    }
+
+    U64 cursor = 0u;
+    U64 start = bench_now_ns_();
+    for (U32 step = 0u; step < BENCH_ARENA_WALK_STEPS; ++step) {
+        cursor = nodes[cursor].next;
+    }
+    bench_report_("arena random walk 256MB", variant, BENCH_ARENA_WALK_STEPS, bench_now_ns_() - start);
+    g_benchSink = cursor;
+
+    arena_release(arena);
+}
+
+static void bench_arena_(void) {
+    bench_arena_walk_(0);
+    bench_arena_walk_(1);
+}
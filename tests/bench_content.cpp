@@ -0,0 +1,111 @@
+//
+// ContentStore read contention: 16 reader threads hammer content_view_hash
+// and content_touch_hash over a resident working set while one writer keeps
+// submitting fresh blobs under rotating keys and collecting the ones they
+// drop (what file_stream_tick does while artifact builds read). Reported
+// per variant: aggregate reader throughput and writer submit cost, with one
+// lock for everything versus the default shard count.
+//
+
+#define BENCH_CONTENT_READERS 16u
+#define BENCH_CONTENT_RESIDENT 4096u
+#define BENCH_CONTENT_READS_PER_THREAD (1u << 17)
+#define BENCH_CONTENT_WRITER_KEYS 256u
+
+struct BenchContentShared {
+    ContentStore* store;
+    ContentHash* hashes;
+    U64 startFlag;
+    U64 readersDone;
+    U64 writerOps;
+    U64 writerNs;
+};
+
+static void bench_content_reader_(void* ptr) {
+    BenchContentShared* shared = (BenchContentShared*)ptr;
+    while (ATOMIC_LOAD(&shared->startFlag, MEMORY_ORDER_ACQUIRE) == 0u) {
+        OS_cpu_pause();
+    }
+    U64 rng = (U64)(uintptr)&rng;
+    U64 bytes = 0u;
+    for (U32 op = 0u; op < BENCH_CONTENT_READS_PER_THREAD; ++op) {
+        rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+        ContentHash hash = shared->hashes[(rng >> 33) % BENCH_CONTENT_RESIDENT];
+        if ((op & 7u) == 0u) {
+            content_touch_hash(shared->store, hash, 1u);
+        } else {
+            bytes += content_view_hash(shared->store, hash).size;
+        }
+    }
+    g_benchSink = g_benchSink + bytes;
+    ATOMIC_FETCH_ADD(&shared->readersDone, 1u, MEMORY_ORDER_RELEASE);
+}
+
+static void bench_content_writer_(void* ptr) {
+    BenchContentShared* shared = (BenchContentShared*)ptr;
+    while (ATOMIC_LOAD(&shared->startFlag, MEMORY_ORDER_ACQUIRE) == 0u) {
+        OS_cpu_pause();
+    }
+    ContentRoot root = content_root_alloc(shared->store);
+    U64 payload[32] = {};
+    U64 ops = 0u;
+    U64 start = bench_now_ns_();
+    while (ATOMIC_LOAD(&shared->readersDone, MEMORY_ORDER_ACQUIRE) < BENCH_CONTENT_READERS) {
+        payload[0] = ops + BENCH_CONTENT_RESIDENT;
+        ContentKey key = content_key_make(root, content_id_from_u64(ops % BENCH_CONTENT_WRITER_KEYS));
+        content_submit_bytes(shared->store, key, payload, sizeof(payload), str8("bench"));
+        ops += 1u;
+        if (ops % BENCH_CONTENT_WRITER_KEYS == 0u) {
+            content_tick_gc(shared->store, 2u + ops / BENCH_CONTENT_WRITER_KEYS, 0u);
+        }
+    }
+    shared->writerNs = bench_now_ns_() - start;
+    shared->writerOps = ops;
+    content_root_release(shared->store, root);
+}
+
+static void bench_content_run_(const char* name, U32 shardCount) {
+    Arena* arena = arena_alloc(.arenaSize = MB(64));
+    ContentStoreDesc desc = {};
+    desc.arena = arena;
+    desc.shardCount = shardCount;
+    desc.initialBlobCapacity = BENCH_CONTENT_RESIDENT * 2u;
+    ContentStore* store = content_store_alloc(&desc);
+
+    BenchContentShared shared = {};
+    shared.store = store;
+    shared.hashes = ARENA_PUSH_ARRAY(arena, ContentHash, BENCH_CONTENT_RESIDENT);
+    for (U64 at = 0u; at < BENCH_CONTENT_RESIDENT; ++at) {
+        U64 payload[8] = {at};
+        shared.hashes[at] = content_submit_bytes(store, CONTENT_KEY_ZERO, payload, sizeof(payload), str8("bench"));
+        content_retain_hash(store, shared.hashes[at]);
+    }
+    ContentStats stats = content_stats(store);
+    printf("  resident %u blobs: %llu B payload, %llu B committed (%s)\n", BENCH_CONTENT_RESIDENT,
+           (unsigned long long)stats.payloadBytes, (unsigned long long)stats.committedBytes, name);
+
+    OS_Handle threads[BENCH_CONTENT_READERS + 1u];
+    for (U32 at = 0u; at < BENCH_CONTENT_READERS; ++at) {
+        threads[at] = OS_thread_create(bench_content_reader_, &shared);
+    }
+    threads[BENCH_CONTENT_READERS] = OS_thread_create(bench_content_writer_, &shared);
+
+    U64 start = bench_now_ns_();
+    ATOMIC_STORE(&shared.startFlag, 1u, MEMORY_ORDER_RELEASE);
+    for (U32 at = 0u; at < BENCH_CONTENT_READERS; ++at) {
+        OS_thread_join(threads[at]);
+    }
+    U64 readNs = bench_now_ns_() - start;
+    OS_thread_join(threads[BENCH_CONTENT_READERS]);
+
+    bench_report_("16 readers, views", name, (U64)BENCH_CONTENT_READERS * BENCH_CONTENT_READS_PER_THREAD, readNs);
+    bench_report_("1 writer, submits", name, shared.writerOps, shared.writerNs);
+
+    content_store_destroy(store);
+    arena_release(arena);
+}
+
+static void bench_content_(void) {
+    bench_content_run_("1 lock", 1u);
+    bench_content_run_("16 shards", 16u);
+}
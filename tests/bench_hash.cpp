@@ -0,0 +1,43 @@
+//
+// Bulk hashing throughput: byte-wise FNV-1a (what content hashes paid,
+// twice per payload) against hash128, one-shot and streamed in 64 KB
+// reads. One op is one MB hashed.
+//
+
+#define BENCH_HASH_BYTES MB(16)
+#define BENCH_HASH_ROUNDS 4u
+
+static void bench_hash_(void) {
+    U8* bytes = (U8*)malloc(BENCH_HASH_BYTES);
+    U64 rng = 0x9E3779B97F4A7C15ull;
+    for (U64 at = 0u; at < BENCH_HASH_BYTES; ++at) {
+        rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+        bytes[at] = (U8)(rng >> 56);
+    }
+    U64 megabytes = BENCH_HASH_ROUNDS * (BENCH_HASH_BYTES / MB(1));
+
+    U64 start = bench_now_ns_();
+    for (U32 round = 0u; round < BENCH_HASH_ROUNDS; ++round) {
+        g_benchSink += hash_fnv1a(bytes, BENCH_HASH_BYTES, round);
+    }
+    bench_report_("hash 1 MB", "fnv1a", megabytes, bench_now_ns_() - start);
+
+    start = bench_now_ns_();
+    for (U32 round = 0u; round < BENCH_HASH_ROUNDS; ++round) {
+        g_benchSink += hash128_from_bytes(bytes, BENCH_HASH_BYTES, round).u64[1];
+    }
+    bench_report_("hash 1 MB", "hash128", megabytes, bench_now_ns_() - start);
+
+    start = bench_now_ns_();
+    for (U32 round = 0u; round < BENCH_HASH_ROUNDS; ++round) {
+        Hash128State state;
+        hash128_begin(&state, round);
+        for (U64 at = 0u; at < BENCH_HASH_BYTES; at += KB(64)) {
+            hash128_update(&state, bytes + at, KB(64));
+        }
+        g_benchSink += hash128_end(&state).u64[1];
+    }
+    bench_report_("hash 1 MB", "hash128 streamed", megabytes, bench_now_ns_() - start);
+
+    free(bytes);
+}
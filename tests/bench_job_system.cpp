@@ -0,0 +1,180 @@
+//
+// Job submission throughput versus worker count. Three fan-out shapes:
+// the main thread submitting everything one job at a time, the same from
+// one job_system_submit_batch call, and one seed job per worker each
+// submitting its share from inside a job (the parallel fan-out that the
+// old wake mutex serialized). job_parallel_for is measured per item over a
+// loop whose cost grows with the index, so static slicing would leave
+// threads idle. The nested tree has every inner job wait on its own
+// children, comparing thread-stack waits against the fiber backend.
+//
+
+#define BENCH_JOB_BATCH 4096u
+#define BENCH_JOB_ROUNDS 64u
+#define BENCH_JOB_FOR_ITEMS (1u << 16)
+#define BENCH_JOB_TREE_DEPTH 6u
+#define BENCH_JOB_TREE_FANOUT 4u
+#define BENCH_JOB_TREE_ROUNDS 16u
+
+static void bench_job_noop_(void* params) {
+    (void)params;
+}
+
+static void bench_job_for_range_(void* userData, U64 begin, U64 end) {
+    U64 acc = 0u;
+    for (U64 at = begin; at < end; ++at) {
+        U64 x = at;
+        for (U64 step = 0u; step < (at >> 10); ++step) {
+            x = x * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        acc += x;
+    }
+    ATOMIC_FETCH_ADD((U64*)userData, acc, MEMORY_ORDER_RELAXED);
+}
+
+struct BenchJobSeedParams {
+    Job* root;
+    U32 childCount;
+};
+
+static void bench_job_seed_(void* params) {
+    BenchJobSeedParams* seed = (BenchJobSeedParams*)params;
+    for (U32 at = 0u; at < seed->childCount; ++at) {
+        job_system_submit((.function = bench_job_noop_, .parent = seed->root));
+    }
+}
+
+struct BenchJobTreeParams {
+    JobSystem* jobSystem;
+    U32 depth;
+};
+
+static void bench_job_tree_(void* params) {
+    BenchJobTreeParams* node = (BenchJobTreeParams*)params;
+    if (node->depth == 0u) {
+        return;
+    }
+    Job root = {};
+    BenchJobTreeParams child = {};
+    child.jobSystem = node->jobSystem;
+    child.depth = node->depth - 1u;
+    for (U32 at = 0u; at < BENCH_JOB_TREE_FANOUT; ++at) {
+        job_system_submit((.function = bench_job_tree_, .parent = &root), child);
+    }
+    job_system_wait(node->jobSystem, &root);
+}
+
+static void bench_job_system_tree_(U32 workerCount, U64 flags) {
+    Arena* arena = arena_alloc(.arenaSize = MB(64));
+    JobSystem* jobSystem = job_system_create(arena, .workerCount = workerCount, .flags = flags);
+
+    char variant[48];
+    snprintf(variant, sizeof(variant), "workers=%u %s", workerCount,
+             (flags & JobSystemFlags_Fibers) ? "fibers" : "thread-stack");
+
+    U64 nodeCount = 0u;
+    U64 levelCount = 1u;
+    for (U32 level = 0u; level <= BENCH_JOB_TREE_DEPTH; ++level) {
+        nodeCount += levelCount;
+        levelCount *= BENCH_JOB_TREE_FANOUT;
+    }
+
+    U64 startNs = bench_now_ns_();
+    for (U32 round = 0u; round < BENCH_JOB_TREE_ROUNDS; ++round) {
+        BenchJobTreeParams top = {};
+        top.jobSystem = jobSystem;
+        top.depth = BENCH_JOB_TREE_DEPTH;
+        Job root = {};
+        job_system_submit((.function = bench_job_tree_, .parent = &root), top);
+        job_system_wait(jobSystem, &root);
+    }
+    U64 totalNs = bench_now_ns_() - startNs;
+    bench_report_("nested fan-out/fan-in", variant, nodeCount * BENCH_JOB_TREE_ROUNDS, totalNs);
+
+    job_system_destroy(jobSystem);
+    arena_release(arena);
+}
+
+static void bench_job_system_run_(U32 workerCount) {
+    Arena* arena = arena_alloc(.arenaSize = MB(64));
+    JobSystem* jobSystem = job_system_create(arena, .workerCount = workerCount);
+
+    char variant[32];
+    snprintf(variant, sizeof(variant), "workers=%u", workerCount);
+
+    U64 submitNs = 0u;
+    U64 startNs = bench_now_ns_();
+    for (U32 round = 0u; round < BENCH_JOB_ROUNDS; ++round) {
+        Job root = {};
+        U64 submitStartNs = bench_now_ns_();
+        for (U32 at = 0u; at < BENCH_JOB_BATCH; ++at) {
+            job_system_submit((.function = bench_job_noop_, .parent = &root));
+        }
+        submitNs += bench_now_ns_() - submitStartNs;
+        job_system_wait(jobSystem, &root);
+    }
+    U64 totalNs = bench_now_ns_() - startNs;
+    U64 jobCount = (U64)BENCH_JOB_BATCH * BENCH_JOB_ROUNDS;
+    bench_report_("submit (main thread)", variant, jobCount, submitNs);
+    bench_report_("fan-out end-to-end", variant, jobCount, totalNs);
+
+    Job* batch = ARENA_PUSH_ARRAY(arena, Job, BENCH_JOB_BATCH);
+    submitNs = 0u;
+    startNs = bench_now_ns_();
+    for (U32 round = 0u; round < BENCH_JOB_ROUNDS; ++round) {
+        Job root = {};
+        U64 submitStartNs = bench_now_ns_();
+        for (U32 at = 0u; at < BENCH_JOB_BATCH; ++at) {
+            MEMSET(&batch[at], 0, sizeof(Job));
+            batch[at].function = bench_job_noop_;
+            batch[at].parent = &root;
+        }
+        job_system_submit_batch(batch, BENCH_JOB_BATCH);
+        submitNs += bench_now_ns_() - submitStartNs;
+        job_system_wait(jobSystem, &root);
+    }
+    totalNs = bench_now_ns_() - startNs;
+    bench_report_("submit_batch (main thread)", variant, jobCount, submitNs);
+    bench_report_("batch fan-out end-to-end", variant, jobCount, totalNs);
+
+    startNs = bench_now_ns_();
+    for (U32 round = 0u; round < BENCH_JOB_ROUNDS; ++round) {
+        Job root = {};
+        BenchJobSeedParams seed = {};
+        seed.root = &root;
+        seed.childCount = BENCH_JOB_BATCH / workerCount;
+        for (U32 at = 0u; at < workerCount; ++at) {
+            job_system_submit((.function = bench_job_seed_, .parent = &root), seed);
+        }
+        job_system_wait(jobSystem, &root);
+    }
+    totalNs = bench_now_ns_() - startNs;
+    jobCount = (U64)(BENCH_JOB_BATCH / workerCount) * workerCount * BENCH_JOB_ROUNDS;
+    bench_report_("fan-out from workers", variant, jobCount, totalNs);
+
+    U64 forSink = 0u;
+    startNs = bench_now_ns_();
+    for (U32 round = 0u; round < BENCH_JOB_ROUNDS; ++round) {
+        job_parallel_for(jobSystem, BENCH_JOB_FOR_ITEMS, 0u, bench_job_for_range_, &forSink);
+    }
+    totalNs = bench_now_ns_() - startNs;
+    g_benchSink = forSink;
+    bench_report_("parallel_for (skewed items)", variant, (U64)BENCH_JOB_FOR_ITEMS * BENCH_JOB_ROUNDS, totalNs);
+
+    job_system_destroy(jobSystem);
+    arena_release(arena);
+
+    bench_job_system_tree_(workerCount, JobSystemFlags_None);
+#if FIBER_SUPPORTED
+    bench_job_system_tree_(workerCount, JobSystemFlags_Fibers);
+#endif
+}
+
+static void bench_job_system_(void) {
+    U32 logicalCores = OS_get_system_info()->logicalCores;
+    U32 maxWorkers = (logicalCores > 1u) ? (logicalCores - 1u) : 1u;
+    for (U32 workerCount = 1u; workerCount < maxWorkers; workerCount *= 2u) {
+        bench_job_system_run_(workerCount);
+    }
+    bench_job_system_run_(maxWorkers);
+}
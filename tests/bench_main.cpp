@@ -0,0 +1,83 @@
+//
+// CPU microbenchmarks. Same tool-TU shape as test_main.cpp (no window, no
+// GPU) but kept out of `./sob test` so the seam tests stay fast. Build and
+// run with `./sob bench [mode]`; numbers only mean something in release.
+//
+
+#include "nstl/base/base_include.hpp"
+
+#include "nstl/os/core/os_core.hpp"
+#if defined(PLATFORM_OS_WINDOWS)
+#include "nstl/os/core/windows/os_core_windows.hpp"
+#elif defined(PLATFORM_OS_MACOS)
+#include "nstl/os/core/macos/os_core_macos.hpp"
+#elif defined(PLATFORM_OS_LINUX)
+#include "nstl/os/core/linux/os_core_linux.hpp"
+#endif
+
+#include "nstl/os/core/os_core.cpp"
+#if defined(PLATFORM_OS_WINDOWS)
+#include "nstl/os/core/windows/os_core_windows.cpp"
+#elif defined(PLATFORM_OS_MACOS)
+#include "nstl/os/core/macos/os_core_macos.cpp"
+#elif defined(PLATFORM_OS_LINUX)
+#include "nstl/os/core/linux/os_core_linux.cpp"
+#endif
+#include "nstl/base/base_include.cpp"
+
+#include "nstl/prof/prof_include.hpp"
+#include "nstl/prof/prof_include.cpp"
+
+#include "nstl/content/content_include.hpp"
+#include "nstl/content/content_include.cpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Defeats dead-code elimination of benchmark results.
+static volatile U64 g_benchSink;
+
+static U64 bench_now_ns_(void) {
+    return OS_get_time_nanoseconds();
+}
+
+static void bench_report_(const char* name, const char* variant, U64 ops, U64 elapsedNs) {
+    F64 nsPerOp = (ops != 0u) ? (F64)elapsedNs / (F64)ops : 0.0;
+    F64 opsPerSecond = (elapsedNs != 0u) ? (F64)ops * 1e9 / (F64)elapsedNs : 0.0;
+    printf("  %-28s %-18s %10.2f ns/op %14.0f op/s\n", name, variant, nsPerOp, opsPerSecond);
+}
+
+#include "bench_arena.cpp"
+#include "bench_content.cpp"
+#include "bench_hash.cpp"
+#include "bench_job_system.cpp"
+#include "bench_math.cpp"
+#include "bench_pool.cpp"
+#include "bench_slot_map.cpp"
+
+typedef void BenchSuiteProc(void);
+
+struct BenchSuite {
+    const char* name;
+    BenchSuiteProc* proc;
+};
+
+void entry_point(void) {
+    static const BenchSuite suites[] = {
+        {"arena", bench_arena_},
+        {"content", bench_content_},
+        {"hash", bench_hash_},
+        {"job_system", bench_job_system_},
+        {"math", bench_math_},
+        {"pool", bench_pool_},
+        {"slot_map", bench_slot_map_},
+    };
+
+#if !defined(NDEBUG)
+    printf("bench: debug build — run `./sob bench release` for meaningful numbers\n");
+#endif
+    for (U32 at = 0u; at < (U32)(sizeof(suites) / sizeof(suites[0])); ++at) {
+        printf("%s\n", suites[at].name);
+        suites[at].proc();
+    }
+}
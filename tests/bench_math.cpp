@@ -0,0 +1,107 @@
+//
+// base_math kernels, SIMD form against the scalar _exact twin the
+// deterministic sim uses. Each op works on a small array so the loop is
+// bound by the math, not by memory.
+//
+
+#define BENCH_MATH_COUNT 256u
+#define BENCH_MATH_ROUNDS 4096u
+
+static F32 bench_math_value_(U32* rng) {
+    *rng = *rng * 1664525u + 1013904223u;
+    return (F32)(*rng >> 8) * (1.0f / 16777216.0f) * 2.0f - 1.0f;
+}
+
+static void bench_math_mat4_(void) {
+    static Mat4x4F32 matrices[BENCH_MATH_COUNT];
+    U32 rng = 0x9E3779B9u;
+    for (U32 at = 0u; at < BENCH_MATH_COUNT; ++at) {
+        for (U32 cell = 0u; cell < 16u; ++cell) {
+            matrices[at].v[cell / 4u][cell % 4u] = bench_math_value_(&rng);
+        }
+    }
+
+    for (U32 variant = 0u; variant < 2u; ++variant) {
+        Mat4x4F32 acc = mat4_identity();
+        U64 start = bench_now_ns_();
+        for (U32 round = 0u; round < BENCH_MATH_ROUNDS; ++round) {
+            for (U32 at = 0u; at < BENCH_MATH_COUNT; ++at) {
+                acc = variant ? mat4_mul_exact(matrices[at], acc) : mat4_mul(matrices[at], acc);
+                acc.v[3][3] = 1.0f;
+            }
+        }
+        bench_report_("mat4 * mat4", variant ? "exact" : "simd",
+                      (U64)BENCH_MATH_ROUNDS * BENCH_MATH_COUNT, bench_now_ns_() - start);
+        g_benchSink += (U64)acc.v[0][0];
+    }
+}
+
+static void bench_math_points_(void) {
+    static Vec3F32 points[BENCH_MATH_COUNT];
+    U32 rng = 0x85EBCA6Bu;
+    Mat4x4F32 m;
+    for (U32 cell = 0u; cell < 16u; ++cell) {
+        m.v[cell / 4u][cell % 4u] = bench_math_value_(&rng);
+    }
+    for (U32 at = 0u; at < BENCH_MATH_COUNT; ++at) {
+        points[at] = vec3_make(bench_math_value_(&rng), bench_math_value_(&rng), bench_math_value_(&rng));
+    }
+
+    for (U32 variant = 0u; variant < 2u; ++variant) {
+        F32 sum = 0.0f;
+        U64 start = bench_now_ns_();
+        for (U32 round = 0u; round < BENCH_MATH_ROUNDS; ++round) {
+            for (U32 at = 0u; at < BENCH_MATH_COUNT; ++at) {
+                Vec3F32 p = variant ? mat4_transform_point_exact(m, points[at]) : mat4_transform_point(m, points[at]);
+                sum += p.x + p.y + p.z;
+            }
+        }
+        bench_report_("mat4 transform point", variant ? "exact" : "simd",
+                      (U64)BENCH_MATH_ROUNDS * BENCH_MATH_COUNT, bench_now_ns_() - start);
+        g_benchSink += (U64)(sum != 0.0f);
+    }
+}
+
+static void bench_math_quat_(void) {
+    static QuatF32 rotations[BENCH_MATH_COUNT];
+    static Vec3F32 vectors[BENCH_MATH_COUNT];
+    U32 rng = 0xC2B2AE35u;
+    for (U32 at = 0u; at < BENCH_MATH_COUNT; ++at) {
+        Vec3F32 axis = vec3_make(bench_math_value_(&rng), bench_math_value_(&rng), 0.5f);
+        rotations[at] = quat_from_axis_angle(axis, bench_math_value_(&rng) * 3.0f);
+        vectors[at] = vec3_make(bench_math_value_(&rng), bench_math_value_(&rng), bench_math_value_(&rng));
+    }
+
+    for (U32 variant = 0u; variant < 2u; ++variant) {
+        QuatF32 acc = quat_identity();
+        U64 start = bench_now_ns_();
+        for (U32 round = 0u; round < BENCH_MATH_ROUNDS; ++round) {
+            for (U32 at = 0u; at < BENCH_MATH_COUNT; ++at) {
+                acc = variant ? quat_mul_exact(acc, rotations[at]) : quat_mul(acc, rotations[at]);
+            }
+        }
+        bench_report_("quat * quat", variant ? "exact" : "simd",
+                      (U64)BENCH_MATH_ROUNDS * BENCH_MATH_COUNT, bench_now_ns_() - start);
+        g_benchSink += (U64)(acc.w != 0.0f);
+    }
+
+    for (U32 variant = 0u; variant < 2u; ++variant) {
+        F32 sum = 0.0f;
+        U64 start = bench_now_ns_();
+        for (U32 round = 0u; round < BENCH_MATH_ROUNDS; ++round) {
+            for (U32 at = 0u; at < BENCH_MATH_COUNT; ++at) {
+                Vec3F32 v = variant ? quat_rotate_exact(rotations[at], vectors[at]) : quat_rotate(rotations[at], vectors[at]);
+                sum += v.x + v.y + v.z;
+            }
+        }
+        bench_report_("quat rotate", variant ? "exact" : "simd",
+                      (U64)BENCH_MATH_ROUNDS * BENCH_MATH_COUNT, bench_now_ns_() - start);
+        g_benchSink += (U64)(sum != 0.0f);
+    }
+}
+
+static void bench_math_(void) {
+    bench_math_mat4_();
+    bench_math_points_();
+    bench_math_quat_();
+}
@@ -0,0 +1,74 @@
+//
+// Small-blob churn: what a content blob costs today (one OS mapping each)
+// against the segregated-fit Heap and the C heap. Each op frees one random
+// live blob and allocates a new one of random size in [16, 4096).
+//
+
+#define BENCH_POOL_LIVE 4096u
+#define BENCH_POOL_CHURN (1u << 18)
+
+static U64 bench_pool_size_(U64* rng) {
+    *rng = *rng * 6364136223846793005ull + 1442695040888963407ull;
+    return 16u + (*rng >> 33) % 4080u;
+}
+
+enum BenchPoolVariant {
+    BenchPoolVariant_Mapping,
+    BenchPoolVariant_Heap,
+    BenchPoolVariant_Malloc,
+};
+
+static void* bench_pool_alloc_(U32 variant, Heap* heap, U64 size) {
+    if (variant == BenchPoolVariant_Mapping) {
+        U64 mapped = align_pow2(size + 1u, OS_get_system_info()->pageSize);
+        void* bytes = OS_reserve(mapped);
+        OS_commit(bytes, mapped);
+        return bytes;
+    }
+    return (variant == BenchPoolVariant_Heap) ? heap_alloc(heap, size) : malloc(size);
+}
+
+static void bench_pool_free_(U32 variant, Heap* heap, void* bytes, U64 size) {
+    if (variant == BenchPoolVariant_Mapping) {
+        OS_release(bytes, align_pow2(size + 1u, OS_get_system_info()->pageSize));
+    } else if (variant == BenchPoolVariant_Heap) {
+        heap_free(heap, bytes, size);
+    } else {
+        free(bytes);
+    }
+}
+
+static void bench_pool_run_(const char* name, U32 variant) {
+    Arena* arena = arena_alloc(.arenaSize = MB(64));
+    Heap heap = {};
+    heap_init(&heap, arena);
+    void* blobs[BENCH_POOL_LIVE];
+    U64 sizes[BENCH_POOL_LIVE];
+    U64 rng = 0x2545F4914F6CDD1Dull;
+    for (U32 at = 0u; at < BENCH_POOL_LIVE; ++at) {
+        sizes[at] = bench_pool_size_(&rng);
+        blobs[at] = bench_pool_alloc_(variant, &heap, sizes[at]);
+    }
+
+    U64 start = bench_now_ns_();
+    for (U32 op = 0u; op < BENCH_POOL_CHURN; ++op) {
+        U32 at = (U32)(rng >> 40) % BENCH_POOL_LIVE;
+        bench_pool_free_(variant, &heap, blobs[at], sizes[at]);
+        sizes[at] = bench_pool_size_(&rng);
+        blobs[at] = bench_pool_alloc_(variant, &heap, sizes[at]);
+        ((U8*)blobs[at])[0] = (U8)op;
+    }
+    bench_report_("small blob churn", name, BENCH_POOL_CHURN, bench_now_ns_() - start);
+
+    for (U32 at = 0u; at < BENCH_POOL_LIVE; ++at) {
+        bench_pool_free_(variant, &heap, blobs[at], sizes[at]);
+    }
+    heap_destroy(&heap);
+    arena_release(arena);
+}
+
+static void bench_pool_(void) {
+    bench_pool_run_("OS mapping", BenchPoolVariant_Mapping);
+    bench_pool_run_("heap", BenchPoolVariant_Heap);
+    bench_pool_run_("malloc", BenchPoolVariant_Malloc);
+}
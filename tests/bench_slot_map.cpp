@@ -0,0 +1,65 @@
+//
+// SlotMap storage modes at 1M slots. "fill" grows an empty map to full
+// capacity, which is where the arena mode pays for its copy-on-double and
+// the reserved mode only commits pages. "churn" then releases and
+// re-allocates random live slots on the full map, the steady state of the
+// content and artifact tables.
+//
+
+#define BENCH_SLOT_MAP_COUNT (1u << 20)
+#define BENCH_SLOT_MAP_CHURN (1u << 22)
+
+struct BenchSlotMapItem {
+    U64 key;
+    U64 value;
+};
+
+struct BenchSlotMapHandle {
+    U32 slot;
+    U32 generation;
+};
+
+static void bench_slot_map_run_(const char* variant, B32 reserved) {
+    Arena* arena = arena_alloc(.arenaSize = MB(256));
+    BenchSlotMapHandle* handles = ARENA_PUSH_ARRAY(arena, BenchSlotMapHandle, BENCH_SLOT_MAP_COUNT);
+
+    SlotMap map = {};
+    B32 ok = reserved ? slot_map_init_reserved(&map, sizeof(BenchSlotMapItem), 64u, BENCH_SLOT_MAP_COUNT)
+                      : slot_map_init(&map, arena, sizeof(BenchSlotMapItem), 64u);
+    if (!ok || !handles) {
+        printf("  slot_map %s: init failed\n", variant);
+        arena_release(arena);
+        return;
+    }
+
+    U64 start = bench_now_ns_();
+    for (U32 at = 0u; at < BENCH_SLOT_MAP_COUNT; ++at) {
+        void* item = 0;
+        slot_map_alloc(&map, &item, &handles[at].slot, &handles[at].generation);
+        ((BenchSlotMapItem*)item)->key = at;
+    }
+    bench_report_("slot_map fill to 1M", variant, BENCH_SLOT_MAP_COUNT, bench_now_ns_() - start);
+
+    U64 rng = 0x9E3779B97F4A7C15ull;
+    U64 sum = 0u;
+    start = bench_now_ns_();
+    for (U32 at = 0u; at < BENCH_SLOT_MAP_CHURN; ++at) {
+        rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+        BenchSlotMapHandle* handle = &handles[(rng >> 33) % BENCH_SLOT_MAP_COUNT];
+        slot_map_release(&map, handle->slot, handle->generation, 0);
+        void* item = 0;
+        slot_map_alloc(&map, &item, &handle->slot, &handle->generation);
+        ((BenchSlotMapItem*)item)->value = at;
+        sum += handle->slot;
+    }
+    bench_report_("slot_map churn at 1M", variant, BENCH_SLOT_MAP_CHURN, bench_now_ns_() - start);
+    g_benchSink = sum;
+
+    slot_map_destroy(&map);
+    arena_release(arena);
+}
+
+static void bench_slot_map_(void) {
+    bench_slot_map_run_("arena (copy)", 0);
+    bench_slot_map_run_("reserved (commit)", 1);
+}
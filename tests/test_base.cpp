@@ -1,8 +1,327 @@
 //
-// Base seams: arena temp scoping, SlotMap generation invalidation,
-// spmd_split_range partition exactness.
+// Base seams: arena temp scoping, decommit policy and large pages, SlotMap
+// generation invalidation, reserved-mode pointer stability and dense/column
+// packing, Pool / Heap recycling across threads, AtomicArena lanes sharing
+// one range, spmd_split_range partition exactness, OS mutex / condition
+// variable / barrier under contention.
 //
 
+#define TEST_SYNC_THREADS 4u
+#define TEST_SYNC_ROUNDS 64u
+#define TEST_SYNC_INCREMENTS 256u
+
+struct TestSyncShared {
+    OS_Handle mutex;
+    OS_Handle conditionVariable;
+    OS_Handle barrier;
+    B32 go;
+    U64 counter;
+    U32 arrivals[TEST_SYNC_ROUNDS];
+    U32 barrierFailures;
+};
+
+static void test_base_sync_worker_(void* arg) {
+    TestSyncShared* shared = (TestSyncShared*) arg;
+    OS_mutex_lock(shared->mutex);
+    while (!shared->go) {
+        OS_condition_variable_wait(shared->conditionVariable, shared->mutex);
+    }
+    OS_mutex_unlock(shared->mutex);
+
+    for (U32 round = 0u; round < TEST_SYNC_ROUNDS; ++round) {
+        for (U32 at = 0u; at < TEST_SYNC_INCREMENTS; ++at) {
+            OS_mutex_lock(shared->mutex);
+            shared->counter += 1u;
+            OS_mutex_unlock(shared->mutex);
+        }
+        ATOMIC_FETCH_ADD(&shared->arrivals[round], 1u, MEMORY_ORDER_RELAXED);
+        OS_barrier_wait(shared->barrier);
+        if (ATOMIC_LOAD(&shared->arrivals[round], MEMORY_ORDER_RELAXED) != TEST_SYNC_THREADS) {
+            ATOMIC_FETCH_ADD(&shared->barrierFailures, 1u, MEMORY_ORDER_RELAXED);
+        }
+    }
+}
+
+#define TEST_POOL_THREADS 4u
+#define TEST_POOL_BLOCKS 500u
+#define TEST_POOL_ROUNDS 20u
+
+struct TestPoolShared {
+    Pool pool;
+    U32 corruptions;
+};
+
+// Each round a thread fills its blocks with its own tag, checks nobody else
+// wrote them, and frees them in a different order than it took them.
+static void test_base_pool_worker_(void* arg) {
+    TestPoolShared* shared = (TestPoolShared*) arg;
+    U64 tag = (U64)OS_get_thread_id_u32() << 32;
+    U64* blocks[TEST_POOL_BLOCKS];
+    for (U32 round = 0u; round < TEST_POOL_ROUNDS; ++round) {
+        for (U32 at = 0u; at < TEST_POOL_BLOCKS; ++at) {
+            blocks[at] = (U64*)pool_alloc(&shared->pool);
+            blocks[at][0] = tag | at;
+            blocks[at][3] = tag | at;
+        }
+        for (U32 at = 0u; at < TEST_POOL_BLOCKS; ++at) {
+            U32 pick = (at * 7u) % TEST_POOL_BLOCKS;
+            if (blocks[pick][0] != (tag | pick) || blocks[pick][3] != (tag | pick)) {
+                ATOMIC_FETCH_ADD(&shared->corruptions, 1u, MEMORY_ORDER_RELAXED);
+            }
+            pool_free(&shared->pool, blocks[pick]);
+        }
+    }
+}
+
+static void test_base_pool_(void) {
+    Arena* arena = arena_alloc(.arenaSize = MB(16));
+
+    // Heap: sizes land in the smallest class that fits, with under 25% waste
+    // past 128 B, and freed blocks come straight back.
+    B32 classesFit = 1;
+    U64 sizes[] = {1u, 16u, 17u, 128u, 129u, 1000u, 4096u, 40000u, HEAP_MAX_SIZE};
+    for (U32 at = 0u; at < ARRAY_COUNT(sizes); ++at) {
+        U64 classSize = heap_class_size(sizes[at]);
+        if (classSize < sizes[at] || (classSize & 15u) != 0u ||
+            (sizes[at] > 128u && (classSize - sizes[at]) * 4u > sizes[at])) {
+            classesFit = 0;
+        }
+    }
+    TEST_CHECK(classesFit && heap_class_size(HEAP_MAX_SIZE + 1u) == 0u);
+
+    Heap heap = {};
+    heap_init(&heap, arena);
+    void* small = heap_alloc(&heap, 40u);
+    void* big = heap_alloc(&heap, KB(20));
+    TEST_CHECK(small && big && ((U64)small & 15u) == 0u && small != big);
+    heap_free(&heap, small, 40u);
+    TEST_CHECK(heap_alloc(&heap, 48u) == small);
+    heap_destroy(&heap);
+
+    // Sixteen live Heaps (one per ContentStore) all keep their thread caches.
+    Heap* heaps = ARENA_PUSH_ARRAY(arena, Heap, 16u);
+    B32 allCached = 1;
+    for (U32 at = 0u; at < 16u; ++at) {
+        heap_init(&heaps[at], arena);
+        for (U32 index = 0u; index < HEAP_CLASS_COUNT; ++index) {
+            allCached = allCached && heaps[at].classes[index].cacheSlot != POOL_INVALID_CACHE_SLOT;
+        }
+    }
+    TEST_CHECK(allCached);
+    for (U32 at = 0u; at < 16u; ++at) {
+        heap_destroy(&heaps[at]);
+    }
+
+    // Pool under contention: no block is handed to two threads at once, and
+    // recycled blocks keep the carve count near the live peak.
+    TestPoolShared shared = {};
+    pool_init(&shared.pool, arena, 32u, 8u);
+    OS_Handle threads[TEST_POOL_THREADS];
+    for (U32 at = 0u; at < TEST_POOL_THREADS; ++at) {
+        threads[at] = OS_thread_create(test_base_pool_worker_, &shared);
+    }
+    for (U32 at = 0u; at < TEST_POOL_THREADS; ++at) {
+        TEST_CHECK(OS_thread_join(threads[at]));
+    }
+    TEST_CHECK(shared.corruptions == 0u);
+    TEST_CHECK(shared.pool.blockCount <= TEST_POOL_THREADS * (TEST_POOL_BLOCKS + 2u * POOL_CACHE_BATCH) + KB(64) / 32u);
+    pool_destroy(&shared.pool);
+
+    arena_release(arena);
+}
+
+#define TEST_ATOMIC_LANES 4u
+#define TEST_ATOMIC_CAPACITY 4096u
+
+struct TestAtomicLane {
+    AtomicArena* atomic;
+    AtomicArenaCursor cursor;
+    U32 lane;
+    U32 pushed;
+};
+
+// Lane 0 carries most of the load, the split an even slicing would drop.
+static void test_base_atomic_lane_(void* arg) {
+    TestAtomicLane* lane = (TestAtomicLane*) arg;
+    U32 want = (lane->lane == 0u) ? 3000u : 300u;
+    for (U32 at = 0u; at < want; ++at) {
+        U64* value = (U64*)atomic_arena_push(lane->atomic, &lane->cursor, sizeof(U64), alignof(U64));
+        if (value) {
+            *value = ((U64)lane->lane << 32) | at;
+            lane->pushed += 1u;
+        }
+    }
+}
+
+static void test_base_atomic_arena_(void) {
+    Arena* arena = arena_alloc(.arenaSize = MB(1));
+    AtomicArena atomic = {};
+    TEST_CHECK(atomic_arena_init(&atomic, arena, TEST_ATOMIC_CAPACITY * sizeof(U64), 64u * sizeof(U64)));
+
+    TestAtomicLane lanes[TEST_ATOMIC_LANES] = {};
+    OS_Handle threads[TEST_ATOMIC_LANES];
+    for (U32 at = 0u; at < TEST_ATOMIC_LANES; ++at) {
+        lanes[at].atomic = &atomic;
+        lanes[at].lane = at;
+        threads[at] = OS_thread_create(test_base_atomic_lane_, &lanes[at]);
+    }
+    for (U32 at = 0u; at < TEST_ATOMIC_LANES; ++at) {
+        TEST_CHECK(OS_thread_join(threads[at]));
+    }
+
+    // Every push survives, and the filled ranges hold exactly those values,
+    // each lane's in push order.
+    AtomicArenaCursor cursors[TEST_ATOMIC_LANES];
+    U32 expected = 0u;
+    for (U32 at = 0u; at < TEST_ATOMIC_LANES; ++at) {
+        cursors[at] = lanes[at].cursor;
+        expected += lanes[at].pushed;
+    }
+    TEST_CHECK(expected == 3900u);
+    RangeU64 ranges[TEST_ATOMIC_LANES + 1u];
+    U32 rangeCount = atomic_arena_filled_ranges(&atomic, cursors, TEST_ATOMIC_LANES, ranges);
+    U32 seen = 0u;
+    U32 nextPerLane[TEST_ATOMIC_LANES] = {};
+    B32 ordered = 1;
+    for (U32 rangeAt = 0u; rangeAt < rangeCount; ++rangeAt) {
+        for (U64 at = ranges[rangeAt].min; at < ranges[rangeAt].max; at += sizeof(U64)) {
+            U64 value = *(U64*)(atomic.base + at);
+            U32 lane = (U32)(value >> 32);
+            if (lane >= TEST_ATOMIC_LANES || (U32)value != nextPerLane[lane]) {
+                ordered = 0;
+                break;
+            }
+            nextPerLane[lane] += 1u;
+            seen += 1u;
+        }
+    }
+    TEST_CHECK(ordered && seen == expected);
+
+    // A full range refuses pushes instead of overrunning, and reset rewinds it.
+    AtomicArenaCursor cursor = {};
+    U32 filled = 0u;
+    while (atomic_arena_push(&atomic, &cursor, sizeof(U64), alignof(U64))) {
+        filled += 1u;
+    }
+    TEST_CHECK(filled < TEST_ATOMIC_CAPACITY - expected + 64u);
+    atomic_arena_reset(&atomic);
+    cursor = {};
+    TEST_CHECK(atomic_arena_push(&atomic, &cursor, sizeof(U64), alignof(U64)) == atomic.base);
+
+    arena_release(arena);
+}
+
+// Tracked pushes as ARENA_TRACKING reports them: charged to the callsite and
+// to its leaf under the open scope, inclusive up the tree, for one frame.
+static void test_base_alloc_tracking_(void) {
+    U32 scope = prof_require_site("test alloc scope", __FILE__, (U32)__LINE__, PROF_CAT_DEFAULT);
+    if (scope == 0u) {
+        return;
+    }
+    U32 callsite = 0u;
+    U32 line = (U32)__LINE__;
+    prof_frame_advance();
+    prof_begin(scope);
+    prof_alloc(&callsite, "test alloc", __FILE__, line, 1000u);
+    prof_alloc(&callsite, "test alloc", __FILE__, line, 24u);
+    prof_end();
+    prof_frame_advance();
+
+    U32 siteCount = 0u;
+    const ProfSiteStats* sites = prof_site_stats(&siteCount);
+    TEST_CHECK(callsite != 0u && callsite < siteCount);
+    TEST_CHECK(sites[callsite].category == PROF_CAT_ALLOC && sites[callsite].lastAllocBytes == 1024u);
+
+    U32 pathCount = 0u;
+    const ProfPathStats* paths = prof_path_stats(&pathCount);
+    U32 leaf = PROF_PATH_NIL;
+    for (U32 path = 1u; path < pathCount; ++path) {
+        if (paths[path].site == callsite) {
+            leaf = path;
+        }
+    }
+    TEST_CHECK(leaf != PROF_PATH_NIL && paths[leaf].lastAllocBytes == 1024u);
+    if (leaf != PROF_PATH_NIL) {
+        const ProfPathStats* parent = paths + paths[leaf].parent;
+        TEST_CHECK(parent->site == scope && parent->lastAllocBytes == 1024u);
+    }
+
+    prof_frame_advance();
+    TEST_CHECK(sites[callsite].lastAllocBytes == 0u);
+}
+
+// hash128: pinned vectors (the value is persisted as content identity, so
+// a change here is a format change), streaming == one-shot for every split,
+// and seed / single-byte sensitivity across the short and long paths.
+static void test_base_hash_(void) {
+    U8 bytes[1000];
+    for (U32 at = 0u; at < 1000u; ++at) {
+        bytes[at] = (U8)(at * 7u + 3u);
+    }
+    Hash128 empty = hash128_from_bytes(0, 0u, 0u);
+    Hash128 word = hash128_from_bytes("nstl", 4u, 0u);
+    Hash128 kilo = hash128_from_bytes(bytes, 1000u, 0u);
+    TEST_CHECK(empty.u64[0] == 0xDC78604D514032F8ull && empty.u64[1] == 0xF85718032E1E5B83ull);
+    TEST_CHECK(word.u64[0] == 0xE9A1F135761E360Dull && word.u64[1] == 0xD3950726C6DA57FBull);
+    TEST_CHECK(kilo.u64[0] == 0x230C98FCBF3B2CCCull && kilo.u64[1] == 0x9DC7462187D6A9F3ull);
+
+    static const U32 splits[] = {1u, 7u, 64u, 100u, 256u, 257u};
+    B32 streamingMatches = 1;
+    B32 sensitive = 1;
+    for (U32 size = 0u; size <= 1000u; size += (size < 300u) ? 1u : 37u) {
+        Hash128 oneShot = hash128_from_bytes(bytes, size, 42u);
+        for (U32 split = 0u; split < (U32)(sizeof(splits) / sizeof(splits[0])); ++split) {
+            Hash128State state;
+            hash128_begin(&state, 42u);
+            for (U32 at = 0u; at < size; at += splits[split]) {
+                hash128_update(&state, bytes + at, MIN(splits[split], size - at));
+            }
+            Hash128 streamed = hash128_end(&state);
+            if (streamed.u64[0] != oneShot.u64[0] || streamed.u64[1] != oneShot.u64[1]) {
+                streamingMatches = 0;
+            }
+        }
+        if (size > 0u) {
+            Hash128 reseeded = hash128_from_bytes(bytes, size, 43u);
+            bytes[size / 2u] ^= 0x10u;
+            Hash128 flipped = hash128_from_bytes(bytes, size, 42u);
+            bytes[size / 2u] ^= 0x10u;
+            if (reseeded.u64[0] == oneShot.u64[0] || reseeded.u64[1] == oneShot.u64[1] ||
+                flipped.u64[0] == oneShot.u64[0] || flipped.u64[1] == oneShot.u64[1]) {
+                sensitive = 0;
+            }
+        }
+    }
+    TEST_CHECK(streamingMatches);
+    TEST_CHECK(sensitive);
+}
+
+static void test_base_sync_(void) {
+    TestSyncShared shared = {};
+    shared.mutex = OS_mutex_create();
+    shared.conditionVariable = OS_condition_variable_create();
+    shared.barrier = OS_barrier_create(TEST_SYNC_THREADS);
+
+    OS_Handle threads[TEST_SYNC_THREADS];
+    for (U32 at = 0u; at < TEST_SYNC_THREADS; ++at) {
+        threads[at] = OS_thread_create(test_base_sync_worker_, &shared);
+    }
+    OS_mutex_lock(shared.mutex);
+    shared.go = 1;
+    OS_condition_variable_broadcast(shared.conditionVariable);
+    OS_mutex_unlock(shared.mutex);
+    for (U32 at = 0u; at < TEST_SYNC_THREADS; ++at) {
+        TEST_CHECK(OS_thread_join(threads[at]));
+    }
+
+    TEST_CHECK(shared.counter == (U64) TEST_SYNC_THREADS * TEST_SYNC_ROUNDS * TEST_SYNC_INCREMENTS);
+    TEST_CHECK(shared.barrierFailures == 0u);
+
+    OS_barrier_destroy(shared.barrier);
+    OS_condition_variable_destroy(shared.conditionVariable);
+    OS_mutex_destroy(shared.mutex);
+}
+
 static void test_base_(void) {
     Arena* arena = arena_alloc();
     TEST_CHECK(arena != 0);
@@ -19,6 +338,53 @@ static void test_base_(void) {
     U8* after = ARENA_PUSH_ARRAY(arena, U8, 64u);
     TEST_CHECK(after == inside);
 
+    // Decommit policy: a spike survives the window it happened in, is
+    // trimmed back to the keep size after a quiet one, and the pages come
+    // back on the next push.
+    Arena* trimmed = arena_alloc(.arenaSize = MB(8), .decommitKeepSize = KB(64), .decommitWindowNs = 0);
+    U64 trimmedBase = arena_get_pos(trimmed);
+    MEMSET(arena_push(trimmed, MB(4)), 0xAB, MB(4));
+    arena_pop_to(trimmed, trimmedBase);
+    TEST_CHECK(trimmed->committed >= MB(4) && trimmed->reclaimed == 0u);
+    arena_push(trimmed, KB(1));
+    arena_pop_to(trimmed, trimmedBase);
+    TEST_CHECK(trimmed->committed <= KB(64) + OS_get_system_info()->pageSize);
+    TEST_CHECK(trimmed->reclaimed >= MB(3));
+    U8* regrown = (U8*)arena_push(trimmed, MB(2));
+    regrown[MB(2) - 1u] = 1u;
+    TEST_CHECK(regrown[MB(2) - 1u] == 1u && trimmed->committed >= MB(2));
+    arena_release(trimmed);
+
+    // Large pages: whatever the OS grants, the arena works and reports it.
+    U64 largePageSize = OS_get_system_info()->largePageSize;
+    Arena* large = arena_alloc(.arenaSize = MB(8), .flags = ArenaFlags_LargePages);
+    U8* largeBytes = (U8*)arena_push(large, MB(3));
+    largeBytes[0] = 1u;
+    largeBytes[MB(3) - 1u] = 2u;
+    TEST_CHECK(largeBytes[0] == 1u && largeBytes[MB(3) - 1u] == 2u);
+    TEST_CHECK(largePageSize != 0u || large->largePages == OS_LargePageKind_None);
+    if (large->largePages == OS_LargePageKind_Transparent) {
+        TEST_CHECK(((U64)large & (largePageSize - 1u)) == 0u && (large->committed & (largePageSize - 1u)) == 0u);
+    }
+    arena_release(large);
+    Arena* chained = arena_alloc(.arenaSize = MB(64), .committedSize = KB(64),
+                                 .flags = ArenaFlags_DoChain | ArenaFlags_LargePages);
+    TEST_CHECK(chained->largePages != OS_LargePageKind_Explicit || chained->reserved == largePageSize);
+    arena_release(chained);
+    // A frame-style arena that outgrows its first block every frame reuses
+    // the chained block it popped instead of mapping a new one.
+    Arena* frame = arena_alloc(.arenaSize = MB(16), .committedSize = MB(1),
+                               .flags = ArenaFlags_DoChain | ArenaFlags_LargePages);
+    U64 frameSpill = frame->reserved + MB(1);
+    U8* frameFirst = (U8*)arena_push(frame, frameSpill);
+    Arena* frameBlock = frame->current;
+    arena_pop_to(frame, 0);
+    TEST_CHECK(frame->current == frame);
+    U8* frameAgain = (U8*)arena_push(frame, frameSpill);
+    TEST_CHECK(frameAgain == frameFirst && frame->current == frameBlock);
+    TEST_CHECK(frame->largePages != OS_LargePageKind_Explicit || frameBlock != frame);
+    arena_release(frame);
+
     // SlotMap: stale generations resolve to null; released slots are
     // reused with a bumped generation.
     SlotMap map = {};
@@ -43,6 +409,53 @@ static void test_base_(void) {
         TEST_CHECK(slot_map_get(&map, slot2, generation2) == item2);
     }
 
+    // Reserved SlotMap: grows commit in place, so item pointers survive
+    // them; allocation fails cleanly at maxCapacity.
+    SlotMap reserved = {};
+    TEST_CHECK(slot_map_init_reserved(&reserved, sizeof(U64), 4u, 300u));
+    void* firstItem = 0;
+    U32 firstSlot = 0u;
+    U32 firstGeneration = 0u;
+    TEST_CHECK(slot_map_alloc(&reserved, &firstItem, &firstSlot, &firstGeneration));
+    *(U64*)firstItem = 0xC0FFEEull;
+    U32 reservedAllocs = 1u;
+    void* extra = 0;
+    U32 extraSlot = 0u;
+    U32 extraGeneration = 0u;
+    while (slot_map_alloc(&reserved, &extra, &extraSlot, &extraGeneration)) {
+        reservedAllocs += 1u;
+    }
+    TEST_CHECK(reservedAllocs == 300u && reserved.capacity == 300u);
+    TEST_CHECK(slot_map_get(&reserved, firstSlot, firstGeneration) == firstItem);
+    TEST_CHECK(*(U64*)firstItem == 0xC0FFEEull);
+    slot_map_destroy(&reserved);
+
+    // Dense list + column: live slots stay packed in dense[0, count) with
+    // their column values alongside, through swap-removes.
+    SlotMap packed = {};
+    TEST_CHECK(slot_map_init(&packed, arena, sizeof(U32), 8u));
+    U32 column = slot_map_add_column(&packed, sizeof(U32));
+    TEST_CHECK(column != SLOT_MAP_INVALID_INDEX);
+    U32 packedSlots[6] = {};
+    U32 packedGenerations[6] = {};
+    for (U32 at = 0u; at < 6u; ++at) {
+        void* packedItem = 0;
+        TEST_CHECK(slot_map_alloc(&packed, &packedItem, &packedSlots[at], &packedGenerations[at]));
+        *(U32*)slot_map_column_at(&packed, column, packedSlots[at]) = packedSlots[at] * 10u;
+    }
+    TEST_CHECK(slot_map_release(&packed, packedSlots[1], packedGenerations[1], 0));
+    TEST_CHECK(slot_map_release(&packed, packedSlots[4], packedGenerations[4], 0));
+    B32 denseConsistent = packed.count == 4u;
+    const U32* columnValues = SLOT_MAP_COLUMN(&packed, U32, column);
+    for (U32 at = 0u; at < packed.count; ++at) {
+        U32 packedSlot = packed.dense[at];
+        if (!slot_map_is_occupied(&packed, packedSlot) || columnValues[at] != packedSlot * 10u) {
+            denseConsistent = 0;
+        }
+    }
+    TEST_CHECK(denseConsistent);
+    TEST_CHECK(slot_map_column_at(&packed, column, packedSlots[1]) == 0);
+
     // split_range: lanes cover [0, total) exactly once, contiguously,
     // with lane sizes differing by at most one.
     U64 totals[6] = {0ull, 1ull, 7ull, 16ull, 100ull, 1000ull};
@@ -74,4 +487,10 @@ static void test_base_(void) {
         }
     }
     TEST_CHECK(partitionsExact);
+
+    test_base_pool_();
+    test_base_atomic_arena_();
+    test_base_alloc_tracking_();
+    test_base_hash_();
+    test_base_sync_();
 }
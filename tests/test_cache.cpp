@@ -0,0 +1,210 @@
+//
+// Eviction seams: content GC and artifact eviction take the least recently
+// touched entries first, never take pinned (referenced / retained) entries
+// or ones touched this frame, and artifact type budgets are enforced before
+// the global target. Small blobs live in slabs charged by size class.
+//
+
+static U32 g_testCacheDestroyed;
+
+static B32 test_cache_build_(ArtifactBuildContext* ctx, ArtifactValue* outValue, U64* outBytes) {
+    MEMSET(outValue, 0, sizeof(*outValue));
+    outValue->u64[0] = 1u;
+    *outBytes = 100u;
+    return 1;
+}
+
+static void test_cache_destroy_(void* typeUserData, ArtifactValue value) {
+    g_testCacheDestroyed += 1u;
+}
+
+static ContentHash test_cache_submit_(ContentStore* store, U8 byte) {
+    return content_submit_bytes(store, CONTENT_KEY_ZERO, &byte, 1u, str8("test"));
+}
+
+static B32 test_cache_content_alive_(ContentStore* store, ContentHash hash) {
+    return content_view_hash(store, hash).valid;
+}
+
+static void test_cache_content_(Arena* arena) {
+    ContentStoreDesc desc = {};
+    desc.arena = arena;
+    desc.maxBlobCapacity = 1024u;
+    desc.maxKeyCapacity = 1024u;
+    ContentStore store = {};
+    TEST_CHECK(content_store_create(&desc, &store));
+
+    // d is never touched; a, b, c are touched on frames 1, 2, 3.
+    ContentHash d = test_cache_submit_(&store, 'd');
+    ContentHash a = test_cache_submit_(&store, 'a');
+    ContentHash b = test_cache_submit_(&store, 'b');
+    ContentHash c = test_cache_submit_(&store, 'c');
+    content_touch_hash(&store, a, 1u);
+    content_touch_hash(&store, b, 2u);
+    content_touch_hash(&store, c, 3u);
+    TEST_CHECK(content_retain_hash(&store, b));
+
+    content_tick_gc(&store, 3u, 0u);
+    TEST_CHECK(content_stats(&store).evictCount == 2u);
+    TEST_CHECK(!test_cache_content_alive_(&store, d));
+    TEST_CHECK(!test_cache_content_alive_(&store, a));
+    TEST_CHECK(test_cache_content_alive_(&store, b)); // retained
+    TEST_CHECK(test_cache_content_alive_(&store, c)); // touched this frame
+
+    content_release_hash(&store, b);
+    content_tick_gc(&store, 4u, 0u);
+    ContentStats stats = content_stats(&store);
+    TEST_CHECK(stats.blobCount == 0u);
+    TEST_CHECK(stats.committedBytes == 0u);
+
+    // A key pins its latest two hashes, whichever shards they land in.
+    ContentRoot root = content_root_alloc(&store);
+    ContentKey key = content_key_make(root, content_id_from_u64(7u));
+    ContentHash versions[3] = {};
+    for (U32 at = 0u; at < 3u; ++at) {
+        U8 byte = (U8)('x' + at);
+        versions[at] = content_submit_bytes(&store, key, &byte, 1u, str8("test"));
+    }
+    content_tick_gc(&store, 5u, 0u);
+    TEST_CHECK(!test_cache_content_alive_(&store, versions[0]));
+    TEST_CHECK(test_cache_content_alive_(&store, versions[1]));
+    TEST_CHECK(test_cache_content_alive_(&store, versions[2]));
+    TEST_CHECK(content_hash_equal(content_hash_from_key(&store, key, 0u), versions[2]));
+    content_root_release(&store, root);
+    content_tick_gc(&store, 6u, 0u);
+    TEST_CHECK(content_stats(&store).blobCount == 0u);
+
+    // An invalidated blob misses at once, keeps its bytes while retained and
+    // is refilled by the same bytes once they are gone.
+    ContentHash e = test_cache_submit_(&store, 'e');
+    TEST_CHECK(content_retain_hash(&store, e));
+    content_invalidate_hash(&store, e);
+    TEST_CHECK(!test_cache_content_alive_(&store, e));
+    TEST_CHECK(content_hash_is_zero(test_cache_submit_(&store, 'e')));
+    content_release_hash(&store, e);
+    TEST_CHECK(content_stats(&store).committedBytes == 0u);
+    TEST_CHECK(content_hash_equal(test_cache_submit_(&store, 'e'), e));
+    TEST_CHECK(test_cache_content_alive_(&store, e));
+
+    content_store_destroy(&store);
+}
+
+// Small blobs are charged their heap class, not a page; large ones their
+// pages. Slab space freed by GC is reused rather than carved again.
+static void test_cache_slab_(Arena* arena) {
+    ContentStoreDesc desc = {};
+    desc.arena = arena;
+    desc.maxBlobCapacity = 1024u;
+    desc.maxKeyCapacity = 1024u;
+    ContentStore store = {};
+    TEST_CHECK(content_store_create(&desc, &store));
+
+    // Round 1 submits different bytes of the same class into what round 0
+    // freed, so the slab arena does not move past where round 0 left it.
+    U8 payload[100] = {};
+    U64 carved = 0u;
+    for (U32 round = 0u; round < 2u; ++round) {
+        for (U32 at = 0u; at < 64u; ++at) {
+            payload[0] = (U8)at;
+            payload[1] = (U8)round;
+            content_submit_bytes(&store, CONTENT_KEY_ZERO, payload, sizeof(payload), str8("small"));
+        }
+        ContentStats stats = content_stats(&store);
+        TEST_CHECK(stats.payloadBytes == 64u * sizeof(payload));
+        TEST_CHECK(stats.committedBytes == 64u * heap_class_size(sizeof(payload) + 1u));
+        if (round == 0u) {
+            carved = arena_get_pos(store.slabArena);
+        } else {
+            TEST_CHECK(arena_get_pos(store.slabArena) == carved);
+        }
+        content_tick_gc(&store, round + 1u, 0u);
+        TEST_CHECK(content_stats(&store).committedBytes == 0u);
+    }
+
+    U64 largeSize = CONTENT_SLAB_MAX_SIZE * 2u;
+    U8* large = ARENA_PUSH_ARRAY(arena, U8, largeSize);
+    MEMSET(large, 7, largeSize);
+    ContentHash hash = content_submit_bytes(&store, CONTENT_KEY_ZERO, large, largeSize, str8("large"));
+    ContentView view = content_view_hash(&store, hash);
+    TEST_CHECK(view.valid && view.size == largeSize && view.data[largeSize - 1u] == 7u && view.data[largeSize] == 0u);
+    TEST_CHECK(content_stats(&store).committedBytes == align_pow2(largeSize + 1u, OS_get_system_info()->pageSize));
+
+    content_store_destroy(&store);
+}
+
+static ArtifactKey test_cache_key_(U64 value) {
+    return artifact_key_from_bytes(&value, sizeof(value));
+}
+
+static B32 test_cache_artifact_alive_(ArtifactCache* cache, ArtifactTypeId typeId, U64 key) {
+    return (artifact_view(cache, typeId, test_cache_key_(key)).status == ArtifactStatus_Ready) ? 1 : 0;
+}
+
+static void test_cache_artifact_(Arena* arena) {
+    ArtifactCacheDesc desc = {};
+    desc.arena = arena;
+    desc.maxSlotCapacity = 1024u;
+    ArtifactCache cache = {};
+    TEST_CHECK(artifact_cache_create(&desc, &cache));
+
+    // Type 1 holds 250 bytes; each build reports 100.
+    ArtifactTypeDesc budgeted = {};
+    budgeted.typeId = 1u;
+    budgeted.buildProc = test_cache_build_;
+    budgeted.destroyProc = test_cache_destroy_;
+    budgeted.evictionTargetBytes = 250u;
+    ArtifactTypeDesc open = budgeted;
+    open.typeId = 2u;
+    open.evictionTargetBytes = 0u;
+    TEST_CHECK(artifact_register_type(&cache, &budgeted));
+    TEST_CHECK(artifact_register_type(&cache, &open));
+
+    // No job system: builds run inline from the WaitFresh tick.
+    for (U64 key = 1u; key <= 3u; ++key) {
+        for (ArtifactTypeId typeId = 1u; typeId <= 2u; ++typeId) {
+            ArtifactResult result = artifact_get(&cache, typeId, test_cache_key_(key), 1u, 0, 0u,
+                                                 ArtifactGetFlags_WaitFresh, 0u);
+            TEST_CHECK(result.status == ArtifactStatus_Ready);
+        }
+    }
+    g_testCacheDestroyed = 0u;
+
+    // Type 2 touched on frames 1..3, type 1 on frames 4..6.
+    for (U64 key = 1u; key <= 3u; ++key) {
+        artifact_touch(&cache, 2u, test_cache_key_(key), key);
+    }
+    for (U64 key = 1u; key <= 3u; ++key) {
+        artifact_touch(&cache, 1u, test_cache_key_(key), 3u + key);
+    }
+    TEST_CHECK(artifact_retain(&cache, 2u, test_cache_key_(1u)));
+
+    // Type 1's budget takes its oldest, then the global target takes the
+    // oldest unretained across both types.
+    artifact_cache_evict(&cache, 10u, 3u);
+    TEST_CHECK(artifact_cache_stats(&cache).evicted == 3u);
+    TEST_CHECK(g_testCacheDestroyed == 3u);
+    TEST_CHECK(!test_cache_artifact_alive_(&cache, 1u, 1u));
+    TEST_CHECK(test_cache_artifact_alive_(&cache, 1u, 2u));
+    TEST_CHECK(test_cache_artifact_alive_(&cache, 1u, 3u));
+    TEST_CHECK(test_cache_artifact_alive_(&cache, 2u, 1u)); // retained
+    TEST_CHECK(!test_cache_artifact_alive_(&cache, 2u, 2u));
+    TEST_CHECK(!test_cache_artifact_alive_(&cache, 2u, 3u));
+
+    artifact_release(&cache, 2u, test_cache_key_(1u));
+    artifact_touch(&cache, 1u, test_cache_key_(3u), 11u);
+    artifact_cache_evict(&cache, 11u, 0u);
+    ArtifactStats stats = artifact_cache_stats(&cache);
+    TEST_CHECK(stats.liveCount == 1u);
+    TEST_CHECK(stats.bytesLive == 100u);
+    TEST_CHECK(test_cache_artifact_alive_(&cache, 1u, 3u)); // touched this frame
+
+    artifact_cache_destroy(&cache);
+}
+
+static void test_cache_(void) {
+    Arena* arena = arena_alloc(.arenaSize = MB(4));
+    test_cache_content_(arena);
+    test_cache_slab_(arena);
+    test_cache_artifact_(arena);
+    arena_release(arena);
+}
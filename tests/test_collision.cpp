@@ -467,4 +467,35 @@ static void test_collision_(void) {
         TEST_CHECK(MEMCMP(&first, &second, sizeof(first)) == 0);
         TEST_CHECK(MEMCMP(firstTrail, secondTrail, sizeof(firstTrail)) == 0);
     }
+
+    // ── Wide broad phase: over a probe grid spanning the side-4 world, a
+    // collider the exact kernel touches is never dropped, and most far
+    // ones are (the x4 pass is doing work).
+    {
+        demo_scene_build_colliders_(4u, &test_collision_set_);
+        U32 missed = 0u;
+        U32 rejected = 0u;
+        U32 tested = 0u;
+        for (S32 gz = -16; gz <= 16; ++gz) {
+            for (S32 gx = -16; gx <= 16; ++gx) {
+                Vec3F32 probe = test_vec3_((F32)gx * 0.8f, 0.95f + (F32)((gx + gz) & 3) * 0.6f, (F32)gz * 0.8f);
+                for (U32 at = 0u; at < test_collision_set_.count; at += 4u) {
+                    U32 lanes = MIN(test_collision_set_.count - at, 4u);
+                    U32 candidates = demo_collider_candidates_x4_(test_collision_set_.colliders + at, lanes,
+                                                                  probe, DEMO_GAME_PLAYER_RADIUS);
+                    for (U32 lane = 0u; lane < lanes; ++lane) {
+                        DemoContact contact;
+                        B32 touches = demo_collider_sphere_contact_(test_collision_set_.colliders + at + lane,
+                                                                    probe, DEMO_GAME_PLAYER_RADIUS, &contact);
+                        B32 candidate = (candidates & (1u << lane)) != 0u;
+                        missed += (touches && !candidate) ? 1u : 0u;
+                        rejected += candidate ? 0u : 1u;
+                        tested += 1u;
+                    }
+                }
+            }
+        }
+        TEST_CHECK(missed == 0u);
+        TEST_CHECK(rejected * 2u > tested);
+    }
 }
@@ -0,0 +1,261 @@
+//
+// File stream seams: a mapped publish never outlives the bytes it names.
+// Only paths seen replaced by rename are mapped, and a replaced file's old
+// mapping keeps its bytes, retained or not. An in-place rewrite drops the
+// mapping (its hash misses from then on) and the path is copied after it.
+// Bytes that dedupe onto another owner's blob never invalidate that blob.
+// On Linux, where inotify delivers synchronously, watches report entry
+// names, two watches on one directory both hear it, a removed directory
+// closes its watch, and a watched file reloads on its event alone (with a
+// slow safety poll under it). Files live under build/ and are removed
+// again; POSIX only, since the mapped path needs a file identity and
+// rename over an existing file.
+//
+
+#define TEST_FILE_STREAM_DIR "build/test_file_stream"
+
+#if defined(PLATFORM_OS_LINUX) || defined(PLATFORM_OS_MACOS)
+
+// Writes size bytes of fill. In place keeps the file (and its identity),
+// truncating first unless keepSize; otherwise a temp file is renamed over.
+static void test_file_stream_write_(const char* path, U8 fill, U64 size, B32 inPlace, B32 keepSize) {
+    Temp scratch = get_scratch(0, 0);
+    U8* bytes = ARENA_PUSH_ARRAY(scratch.arena, U8, size);
+    MEMSET(bytes, fill, size);
+
+    StringU8 tempPath = str8_fmt(scratch.arena, "{}.tmp", path);
+    const char* target = inPlace ? path : (const char*)tempPath.data;
+    OS_Handle file = OS_file_open(target, (inPlace && keepSize) ? OS_FileOpenMode_Write : OS_FileOpenMode_Create);
+    OS_file_write(file, RangeU64{0u, size}, bytes);
+    OS_file_close(file);
+    if (!inPlace) {
+        rename(target, path);
+    }
+    temp_end(&scratch);
+}
+
+// In-place rewrites of the same size are only seen through the write
+// timestamp, which the kernel keeps at tick granularity.
+static void test_file_stream_settle_(void) {
+    OS_sleep_milliseconds(20u);
+}
+
+static void test_file_stream_tick_(FileStream* stream) {
+    file_stream_tick(stream, OS_get_time_nanoseconds(), 64u);
+}
+
+static void test_file_stream_mapped_(Arena* arena) {
+    ContentStoreDesc contentDesc = {};
+    contentDesc.arena = arena;
+    ContentStore store = {};
+    TEST_CHECK(content_store_create(&contentDesc, &store));
+
+    FileStreamDesc desc = {};
+    desc.arena = arena;
+    desc.content = &store;
+    desc.mapMinSize = KB(4);
+    FileStream stream = {};
+    TEST_CHECK(file_stream_create(&desc, &stream));
+
+    // First load copies: nothing is known about how the path gets saved.
+    const char* path = TEST_FILE_STREAM_DIR "/mapped.bin";
+    test_file_stream_write_(path, 'a', KB(8), 0, 0);
+    FileHandle handle = file_watch(&stream, str8(path), 1u);
+    FileView view = file_view(&stream, handle);
+    TEST_CHECK(view.status == FileStatus_Ready && view.size == KB(8) && view.data[KB(8) - 1u] == 'a');
+    TEST_CHECK(!(view.flags & FileViewFlags_Mapped));
+
+    // Replaced by rename: mapped from now on, and a retained old version
+    // keeps its bytes because the mapping pins the replaced file.
+    test_file_stream_write_(path, 'b', KB(8), 0, 0);
+    test_file_stream_tick_(&stream);
+    FileView mapped = file_view(&stream, handle);
+    TEST_CHECK(mapped.generation > view.generation && (mapped.flags & FileViewFlags_Mapped));
+    TEST_CHECK(mapped.size == KB(8) && mapped.data[0] == 'b' && mapped.data[KB(8) - 1u] == 'b');
+    TEST_CHECK(content_retain_hash(&store, mapped.hash));
+
+    test_file_stream_write_(path, 'c', KB(12), 0, 0);
+    test_file_stream_tick_(&stream);
+    view = file_view(&stream, handle);
+    TEST_CHECK(view.generation > mapped.generation && (view.flags & FileViewFlags_Mapped));
+    TEST_CHECK(view.size == KB(12) && view.data[KB(12) - 1u] == 'c');
+    ContentView retained = content_view_hash(&store, mapped.hash);
+    TEST_CHECK(retained.valid && retained.size == KB(8) && retained.data[KB(8) - 1u] == 'b');
+    content_release_hash(&store, mapped.hash);
+
+    // Rewritten in place under the mapping, same size and then smaller:
+    // the mapped hash misses (never its new bytes under the old name), the
+    // new bytes publish as a copy, and the path stays copied after that.
+    ContentHash rewrittenHash = view.hash;
+    U64 generation = view.generation;
+    TEST_CHECK(content_retain_hash(&store, rewrittenHash));
+    test_file_stream_settle_();
+    test_file_stream_write_(path, 'd', KB(12), 1, 1);
+    test_file_stream_tick_(&stream);
+    TEST_CHECK(!content_view_hash(&store, rewrittenHash).valid);
+    view = file_view(&stream, handle);
+    TEST_CHECK(view.generation > generation && !(view.flags & FileViewFlags_Mapped));
+    TEST_CHECK(view.size == KB(12) && view.data[0] == 'd' && view.data[KB(12) - 1u] == 'd');
+    content_release_hash(&store, rewrittenHash);
+
+    generation = view.generation;
+    test_file_stream_settle_();
+    test_file_stream_write_(path, 'e', KB(6), 1, 0);
+    test_file_stream_tick_(&stream);
+    view = file_view(&stream, handle);
+    TEST_CHECK(view.generation > generation && view.size == KB(6) && view.data[KB(6) - 1u] == 'e');
+
+    generation = view.generation;
+    test_file_stream_write_(path, 'f', KB(8), 0, 0);
+    test_file_stream_tick_(&stream);
+    view = file_view(&stream, handle);
+    TEST_CHECK(view.generation > generation && view.data[0] == 'f' && !(view.flags & FileViewFlags_Mapped));
+
+    // Mapped bytes that dedupe onto another owner's copy leave the mapping
+    // behind; a later rewrite of the file must not take that blob with it.
+    U8* other = ARENA_PUSH_ARRAY(arena, U8, KB(8));
+    MEMSET(other, 'x', KB(8));
+    ContentRoot root = content_root_alloc(&store);
+    ContentKey otherKey = content_key_make(root, content_id_from_u64(1u));
+    ContentHash otherHash = content_submit_bytes(&store, otherKey, other, KB(8), str8("other"));
+
+    const char* sharedPath = TEST_FILE_STREAM_DIR "/shared.bin";
+    test_file_stream_write_(sharedPath, 'y', KB(8), 0, 0);
+    FileHandle shared = file_watch(&stream, str8(sharedPath), 1u);
+    test_file_stream_write_(sharedPath, 'x', KB(8), 0, 0);
+    test_file_stream_tick_(&stream);
+    view = file_view(&stream, shared);
+    TEST_CHECK(content_hash_equal(view.hash, otherHash) && !(view.flags & FileViewFlags_Mapped));
+
+    test_file_stream_settle_();
+    test_file_stream_write_(sharedPath, 'z', KB(8), 1, 1);
+    test_file_stream_tick_(&stream);
+    view = file_view(&stream, shared);
+    TEST_CHECK(view.data && view.data[0] == 'z');
+    ContentView survivor = content_view_hash(&store, otherHash);
+    TEST_CHECK(survivor.valid && survivor.data[KB(8) - 1u] == 'x');
+    TEST_CHECK(content_hash_equal(content_hash_from_key(&store, otherKey, 0u), otherHash));
+
+    file_stream_destroy(&stream);
+    content_root_release(&store, root);
+    content_store_destroy(&store);
+    remove(path);
+    remove(sharedPath);
+}
+
+#endif
+
+#if defined(PLATFORM_OS_LINUX)
+
+static B32 test_file_stream_has_event_(OS_WatchEvent* events, U32 count, const char* name, U32 flags) {
+    for (U32 at = 0u; at < count; ++at) {
+        if ((events[at].flags & flags) == flags && (!name || str8_equal(events[at].name, str8(name)))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void test_file_stream_watch_(Arena* arena) {
+    Temp scratch = get_scratch(0, 0);
+    OS_WatchEvent events[32];
+
+    // Names come through for writes, renames and deletes, to every watch
+    // on the directory, and one watch going leaves the other working.
+    OS_Handle watch = OS_watch_directory(TEST_FILE_STREAM_DIR);
+    OS_Handle twin = OS_watch_directory(TEST_FILE_STREAM_DIR);
+    TEST_CHECK(watch.handle && twin.handle);
+    TEST_CHECK(OS_poll_watch_events(watch, scratch.arena, events, 32u) == 0u);
+
+    const char* written = TEST_FILE_STREAM_DIR "/written.txt";
+    const char* renamed = TEST_FILE_STREAM_DIR "/renamed.txt";
+    test_file_stream_write_(written, 'w', 16u, 1, 0);
+    test_file_stream_write_(renamed, 'r', 16u, 0, 0);
+    remove(written);
+    U32 count = OS_poll_watch_events(watch, scratch.arena, events, 32u);
+    TEST_CHECK(test_file_stream_has_event_(events, count, "written.txt", OS_WatchEvent_Changed));
+    TEST_CHECK(test_file_stream_has_event_(events, count, "renamed.txt.tmp", OS_WatchEvent_Changed));
+    TEST_CHECK(test_file_stream_has_event_(events, count, "renamed.txt", OS_WatchEvent_Changed));
+    TEST_CHECK(!test_file_stream_has_event_(events, count, 0, OS_WatchEvent_Rescan));
+    count = OS_poll_watch_events(twin, scratch.arena, events, 32u);
+    TEST_CHECK(test_file_stream_has_event_(events, count, "renamed.txt", OS_WatchEvent_Changed));
+
+    OS_unwatch_directory(twin);
+    remove(renamed);
+    count = OS_poll_watch_events(watch, scratch.arena, events, 32u);
+    TEST_CHECK(test_file_stream_has_event_(events, count, "renamed.txt", OS_WatchEvent_Changed));
+
+    // More than maxEvents pending collapse into a trailing Rescan.
+    for (U32 at = 0u; at < 8u; ++at) {
+        StringU8 path = str8_fmt(scratch.arena, TEST_FILE_STREAM_DIR "/burst{}.txt", at);
+        test_file_stream_write_((const char*)path.data, 'b', 1u, 1, 0);
+        remove((const char*)path.data);
+    }
+    count = OS_poll_watch_events(watch, scratch.arena, events, 4u);
+    TEST_CHECK(count == 4u && events[3].flags == OS_WatchEvent_Rescan);
+    OS_unwatch_directory(watch);
+
+    // The directory itself going away closes the watch.
+    const char* doomed = TEST_FILE_STREAM_DIR "/doomed";
+    TEST_CHECK(OS_create_directory(doomed));
+    OS_Handle closing = OS_watch_directory(doomed);
+    TEST_CHECK(closing.handle != 0);
+    remove(doomed);
+    count = OS_poll_watch_events(closing, scratch.arena, events, 32u);
+    TEST_CHECK(test_file_stream_has_event_(events, count, 0, OS_WatchEvent_Rescan | OS_WatchEvent_Closed));
+    OS_unwatch_directory(closing);
+
+    // A watched file reloads on its event alone: its interval never comes
+    // due, and a quiet tick checks nothing until the safety poll.
+    ContentStoreDesc contentDesc = {};
+    contentDesc.arena = arena;
+    ContentStore store = {};
+    TEST_CHECK(content_store_create(&contentDesc, &store));
+    FileStreamDesc desc = {};
+    desc.arena = arena;
+    desc.content = &store;
+    FileStream stream = {};
+    TEST_CHECK(file_stream_create(&desc, &stream));
+
+    const char* path = TEST_FILE_STREAM_DIR "/evented.txt";
+    U64 intervalNs = BILLION(3600ull);
+    test_file_stream_write_(path, '1', 64u, 0, 0);
+    FileHandle handle = file_watch(&stream, str8(path), intervalNs);
+    U64 nowNs = OS_get_time_nanoseconds();
+    FileView view = file_view(&stream, handle);
+    TEST_CHECK(view.status == FileStatus_Ready && view.data[0] == '1');
+
+    file_stream_tick(&stream, nowNs, 64u);
+    TEST_CHECK(file_stream_stats(&stream).checkedCount == 0u);
+    test_file_stream_write_(path, '2', 64u, 0, 0);
+    file_stream_tick(&stream, nowNs, 64u);
+    FileView reloaded = file_view(&stream, handle);
+    TEST_CHECK(file_stream_stats(&stream).checkedCount == 1u);
+    TEST_CHECK(reloaded.generation > view.generation && reloaded.data[0] == '2');
+
+    file_stream_tick(&stream, nowNs + intervalNs, 64u);
+    TEST_CHECK(file_stream_stats(&stream).checkedCount == 1u);
+    file_stream_tick(&stream, nowNs + intervalNs * 8u, 64u);
+    TEST_CHECK(file_stream_stats(&stream).checkedCount == 2u);
+
+    file_stream_destroy(&stream);
+    content_store_destroy(&store);
+    remove(path);
+    temp_end(&scratch);
+}
+
+#endif
+
+static void test_file_stream_(void) {
+#if defined(PLATFORM_OS_LINUX) || defined(PLATFORM_OS_MACOS)
+    Arena* arena = arena_alloc(.arenaSize = MB(4));
+    OS_create_directory("build");
+    TEST_CHECK(OS_create_directory(TEST_FILE_STREAM_DIR));
+    test_file_stream_mapped_(arena);
+#if defined(PLATFORM_OS_LINUX)
+    test_file_stream_watch_(arena);
+#endif
+    remove(TEST_FILE_STREAM_DIR);
+    arena_release(arena);
+#endif
+}
@@ -45,4 +45,45 @@ static void test_frustum_cull_(void) {
     TEST_CHECK(!eng_world_sphere_visible_(planes, beyondFar, 0.01f));
     F32 withinFar[3] = {0.0f, 0.0f, 80.0f};
     TEST_CHECK(eng_world_sphere_visible_(planes, withinFar, 0.01f));
+
+    // The eight-wide kernel against the scalar pair, lane for lane, over a
+    // spread of spheres straddling every plane.
+    {
+        Vec3F32 forward = vec3_normalize(test_vec3_(target.x - eye.x, target.y - eye.y, target.z - eye.z));
+        F32 eyeArray[3] = {eye.x, eye.y, eye.z};
+        U32 rng = 0x1234567u;
+        U32 mismatches = 0u;
+        U32 visibleCount = 0u;
+        F32 depthError = 0.0f;
+        for (U32 batch = 0u; batch < 64u; ++batch) {
+            F32 xs[8];
+            F32 ys[8];
+            F32 zs[8];
+            F32 radii[8];
+            for (U32 lane = 0u; lane < 8u; ++lane) {
+                rng = rng * 1664525u + 1013904223u;
+                xs[lane] = (F32)((rng >> 8) % 2000u) * 0.1f - 100.0f;
+                rng = rng * 1664525u + 1013904223u;
+                ys[lane] = (F32)((rng >> 8) % 2000u) * 0.1f - 100.0f;
+                rng = rng * 1664525u + 1013904223u;
+                zs[lane] = (F32)((rng >> 8) % 2400u) * 0.1f - 120.0f;
+                radii[lane] = (F32)(rng >> 28) * 0.75f;
+            }
+            F32 depths[8];
+            U32 visibleLanes = eng_world_cull_depth_x8_(planes, eyeArray, forward, vec3x8_load(xs, ys, zs),
+                                                        f32x8_load(radii), depths);
+            for (U32 lane = 0u; lane < 8u; ++lane) {
+                F32 center[3] = {xs[lane], ys[lane], zs[lane]};
+                B32 scalarVisible = eng_world_sphere_visible_(planes, center, radii[lane]);
+                B32 wideVisible = (visibleLanes & (1u << lane)) != 0u;
+                mismatches += (scalarVisible != wideVisible) ? 1u : 0u;
+                visibleCount += wideVisible ? 1u : 0u;
+                F32 scalarDepth = eng_world_transparent_depth_(center, radii[lane], eyeArray, forward);
+                depthError = MAX(depthError, test_abs_(depths[lane] - scalarDepth));
+            }
+        }
+        TEST_CHECK(mismatches == 0u);
+        TEST_CHECK(visibleCount > 0u && visibleCount < 512u);
+        TEST_CHECK_NEAR(depthError, 0.0f, 1e-4f);
+    }
 }
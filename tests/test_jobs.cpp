@@ -0,0 +1,417 @@
+//
+// Job system seams: batched and burst submits all run exactly once,
+// job_parallel_for covers [0, count) exactly once — from the owning
+// thread and nested inside jobs (the wait helps instead of deadlocking) —
+// job graph nodes run after every predecessor, across resubmits, critical
+// jobs start before queued background jobs and preempt a running one at
+// its checkpoints, and critical waiters still run background children.
+// Everything runs twice where fibers exist: once with nested waits, once
+// with waits that suspend (including a fiber pool smaller than the tree).
+//
+
+#define TEST_JOBS_ITEMS 10000u
+#define TEST_JOBS_BURST (JOB_SYSTEM_QUEUE_SIZE * 8u)
+
+struct TestJobsLoop {
+    U32* hits;
+    U64 maxRange;
+};
+
+static void test_jobs_count_(void* params) {
+    U64* counter = *(U64**)params;
+    ATOMIC_FETCH_ADD(counter, 1u, MEMORY_ORDER_RELAXED);
+}
+
+static void test_jobs_mark_(void* userData, U64 begin, U64 end) {
+    TestJobsLoop* loop = (TestJobsLoop*)userData;
+    U64 size = end - begin;
+    U64 seen = ATOMIC_LOAD(&loop->maxRange, MEMORY_ORDER_RELAXED);
+    while (size > seen &&
+           !ATOMIC_COMPARE_EXCHANGE(&loop->maxRange, &seen, size, true, MEMORY_ORDER_RELAXED, MEMORY_ORDER_RELAXED)) {
+    }
+    for (U64 at = begin; at < end; ++at) {
+        ATOMIC_FETCH_ADD(&loop->hits[at], 1u, MEMORY_ORDER_RELAXED);
+    }
+}
+
+struct TestJobsNested {
+    JobSystem* jobSystem;
+    TestJobsLoop* loop;
+};
+
+static void test_jobs_nested_(void* params) {
+    TestJobsNested* nested = (TestJobsNested*)params;
+    job_parallel_for(nested->jobSystem, TEST_JOBS_ITEMS, 16u, test_jobs_mark_, nested->loop);
+}
+
+struct TestJobsGraphNode {
+    U64* clock;
+    U64* stamp;
+    U64* fanIn;
+};
+
+static void test_jobs_graph_stamp_(void* params) {
+    TestJobsGraphNode* node = (TestJobsGraphNode*)params;
+    *node->stamp = ATOMIC_FETCH_ADD(node->clock, 1u, MEMORY_ORDER_ACQ_REL) + 1u;
+    if (node->fanIn) {
+        ATOMIC_FETCH_ADD(node->fanIn, 1u, MEMORY_ORDER_RELAXED);
+    }
+}
+
+struct TestJobsTree {
+    JobSystem* jobSystem;
+    U64* leaves;
+    U32 depth;
+};
+
+// Every inner node fans out four children and waits for them.
+static void test_jobs_tree_(void* params) {
+    TestJobsTree* node = (TestJobsTree*)params;
+    if (node->depth == 0u) {
+        ATOMIC_FETCH_ADD(node->leaves, 1u, MEMORY_ORDER_RELAXED);
+        return;
+    }
+    Job root = {};
+    TestJobsTree child = {node->jobSystem, node->leaves, node->depth - 1u};
+    for (U32 at = 0u; at < 4u; ++at) {
+        job_system_submit((.function = test_jobs_tree_, .parent = &root), child);
+    }
+    job_system_wait(node->jobSystem, &root);
+    TEST_CHECK(root.remainingJobs == 0u);
+}
+
+struct TestJobsOrder {
+    U64* clock;
+    U64* stamp;
+    U64* gate;     // non-null: spin until it opens
+    U32* priority; // non-null: record the priority the job ran at
+};
+
+static void test_jobs_ordered_(void* params) {
+    TestJobsOrder* order = (TestJobsOrder*)params;
+    while (order->gate && ATOMIC_LOAD(order->gate, MEMORY_ORDER_ACQUIRE) == 0u) {
+        OS_cpu_pause();
+    }
+    *order->stamp = ATOMIC_FETCH_ADD(order->clock, 1u, MEMORY_ORDER_ACQ_REL) + 1u;
+    if (order->priority) {
+        *order->priority = (U32)job_system_current_priority();
+    }
+}
+
+struct TestJobsPreempt {
+    U64* started;
+    U64* criticalDone;
+    U64* sawCritical;
+};
+
+// Background work that only finishes early if critical jobs get to run
+// through its checkpoints.
+static void test_jobs_preemptible_(void* params) {
+    TestJobsPreempt* preempt = (TestJobsPreempt*)params;
+    ATOMIC_STORE(preempt->started, 1u, MEMORY_ORDER_RELEASE);
+    U64 deadlineNs = OS_get_time_nanoseconds() + 2000000000ull;
+    while (ATOMIC_LOAD(preempt->criticalDone, MEMORY_ORDER_ACQUIRE) < 8u &&
+           OS_get_time_nanoseconds() < deadlineNs) {
+        job_system_checkpoint();
+        OS_cpu_pause();
+    }
+    *preempt->sawCritical = ATOMIC_LOAD(preempt->criticalDone, MEMORY_ORDER_ACQUIRE);
+}
+
+struct TestJobsCriticalWaiter {
+    JobSystem* jobSystem;
+    U64* started;
+    U64* leaves;
+};
+
+// A critical job that waits on background children.
+static void test_jobs_critical_waiter_(void* params) {
+    TestJobsCriticalWaiter* waiter = (TestJobsCriticalWaiter*)params;
+    ATOMIC_STORE(waiter->started, 1u, MEMORY_ORDER_RELEASE);
+    Job root = {};
+    for (U32 at = 0u; at < 4u; ++at) {
+        job_system_submit_at(JobPriority_Background, (.function = test_jobs_count_, .parent = &root), waiter->leaves);
+    }
+    job_system_wait(waiter->jobSystem, &root);
+}
+
+static void test_jobs_poll_(Job* root) {
+    while ((ATOMIC_LOAD(&root->remainingJobs, MEMORY_ORDER_ACQUIRE) & 0xFFFFFFFFull) != 0u) {
+        OS_thread_yield();
+    }
+}
+
+static B32 test_jobs_all_equal_(const U32* hits, U32 count, U32 expected) {
+    for (U32 at = 0u; at < count; ++at) {
+        if (hits[at] != expected) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void test_jobs_run_(U64 flags) {
+    Arena* arena = arena_alloc(.arenaSize = MB(16));
+    JobSystem* jobSystem = job_system_create(arena, .workerCount = 2u, .flags = flags, .fiberCount = 16u);
+    TEST_CHECK(jobSystem != 0);
+
+    // Batch then single submits, each run larger than a deque's initial
+    // ring, so the main thread's deque grows while workers steal from it:
+    // every job runs once and the parent drains to zero.
+    {
+        U64 counter = 0u;
+        U64* counterPtr = &counter;
+        Job root = {};
+        Job* jobs = ARENA_PUSH_ARRAY(arena, Job, TEST_JOBS_BURST);
+        for (U32 at = 0u; at < TEST_JOBS_BURST; ++at) {
+            MEMSET(&jobs[at], 0, sizeof(Job));
+            jobs[at].function = test_jobs_count_;
+            jobs[at].parent = &root;
+            job_set_parameters(&jobs[at], counterPtr);
+        }
+        TEST_CHECK(job_system_submit_batch(jobs, TEST_JOBS_BURST));
+        for (U32 at = 0u; at < TEST_JOBS_BURST; ++at) {
+            job_system_submit((.function = test_jobs_count_, .parent = &root), counterPtr);
+        }
+        job_system_wait(jobSystem, &root);
+        TEST_CHECK(ATOMIC_LOAD(&counter, MEMORY_ORDER_ACQUIRE) == 2u * TEST_JOBS_BURST);
+        TEST_CHECK(root.remainingJobs == 0u);
+    }
+
+    U32* hits = ARENA_PUSH_ARRAY(arena, U32, TEST_JOBS_ITEMS);
+
+    // Parallel for: exact cover, and fn never sees more than grain items.
+    {
+        MEMSET(hits, 0, sizeof(U32) * TEST_JOBS_ITEMS);
+        TestJobsLoop loop = {hits, 0u};
+        job_parallel_for(jobSystem, TEST_JOBS_ITEMS, 37u, test_jobs_mark_, &loop);
+        TEST_CHECK(test_jobs_all_equal_(hits, TEST_JOBS_ITEMS, 1u));
+        TEST_CHECK(loop.maxRange <= 37u);
+
+        MEMSET(hits, 0, sizeof(U32) * TEST_JOBS_ITEMS);
+        loop.maxRange = 0u;
+        job_parallel_for(jobSystem, TEST_JOBS_ITEMS, 0u, test_jobs_mark_, &loop);
+        TEST_CHECK(test_jobs_all_equal_(hits, TEST_JOBS_ITEMS, 1u));
+    }
+
+    // Nested: parallel_for from inside jobs, four loops over one array.
+    {
+        MEMSET(hits, 0, sizeof(U32) * TEST_JOBS_ITEMS);
+        TestJobsLoop loop = {hits, 0u};
+        TestJobsNested nested = {jobSystem, &loop};
+        Job root = {};
+        for (U32 at = 0u; at < 4u; ++at) {
+            job_system_submit((.function = test_jobs_nested_, .parent = &root), nested);
+        }
+        job_system_wait(jobSystem, &root);
+        TEST_CHECK(test_jobs_all_equal_(hits, TEST_JOBS_ITEMS, 4u));
+    }
+
+    // Graph: diamond a -> (b, c) -> d, plus a fan of 20 sources into one
+    // sink (more ready nodes than one submit batch). Run twice to cover the
+    // count reset.
+    {
+        U64 clock = 0u;
+        U64 stamps[4] = {};
+        U64 fanStamps[21] = {};
+        U64 fanIn = 0u;
+        JobGraph* graph = job_graph_create(arena, 32u);
+        TEST_CHECK(graph != 0);
+        JobGraphNode diamond[4];
+        for (U32 at = 0u; at < 4u; ++at) {
+            TestJobsGraphNode params = {&clock, &stamps[at], 0};
+            diamond[at] = job_graph_add(graph, (.function = test_jobs_graph_stamp_), params);
+        }
+        job_graph_depend(graph, diamond[0], diamond[1]);
+        job_graph_depend(graph, diamond[0], diamond[2]);
+        job_graph_depend(graph, diamond[1], diamond[3]);
+        job_graph_depend(graph, diamond[2], diamond[3]);
+
+        TestJobsGraphNode sinkParams = {&clock, &fanStamps[20], 0};
+        JobGraphNode sink = job_graph_add(graph, (.function = test_jobs_graph_stamp_), sinkParams);
+        for (U32 at = 0u; at < 20u; ++at) {
+            TestJobsGraphNode params = {&clock, &fanStamps[at], &fanIn};
+            JobGraphNode source = job_graph_add(graph, (.function = test_jobs_graph_stamp_), params);
+            job_graph_depend(graph, source, sink);
+        }
+
+        for (U32 run = 0u; run < 2u; ++run) {
+            fanIn = 0u;
+            job_graph_run(jobSystem, graph);
+            TEST_CHECK(stamps[0] < stamps[1] && stamps[0] < stamps[2]);
+            TEST_CHECK(stamps[1] < stamps[3] && stamps[2] < stamps[3]);
+            TEST_CHECK(fanIn == 20u);
+            U64 latestSource = 0u;
+            for (U32 at = 0u; at < 20u; ++at) {
+                latestSource = MAX(latestSource, fanStamps[at]);
+            }
+            TEST_CHECK(latestSource < fanStamps[20]);
+        }
+        TEST_CHECK(clock == 2u * 25u);
+    }
+
+    // Nested fan-out/fan-in: 4^5 leaves under 341 waiting inner jobs.
+    {
+        U64 leaves = 0u;
+        Job root = {};
+        TestJobsTree tree = {jobSystem, &leaves, 5u};
+        job_system_submit((.function = test_jobs_tree_, .parent = &root), tree);
+        job_system_wait(jobSystem, &root);
+        TEST_CHECK(leaves == 1024u);
+    }
+
+    job_system_destroy(jobSystem);
+    arena_release(arena);
+}
+
+// One worker and a main thread that only polls, so every job runs on the
+// worker in the order it picks them.
+static void test_jobs_priorities_(U64 flags) {
+    Arena* arena = arena_alloc(.arenaSize = MB(16));
+    JobSystem* jobSystem = job_system_create(arena, .workerCount = 1u, .flags = flags, .fiberCount = 16u);
+    TEST_CHECK(jobSystem != 0);
+
+    // The worker sits on a gate job while background and then critical
+    // jobs queue up; once the gate opens every critical job goes first.
+    {
+        U64 clock = 0u;
+        U64 gate = 0u;
+        U64 stamps[9] = {};
+        U32 priorities[4] = {};
+        Job root = {};
+        TestJobsOrder gateOrder = {&clock, &stamps[8], &gate, 0};
+        job_system_submit_at(JobPriority_Critical, (.function = test_jobs_ordered_, .parent = &root), gateOrder);
+        for (U32 at = 0u; at < 4u; ++at) {
+            TestJobsOrder order = {&clock, &stamps[at], 0, &priorities[at]};
+            job_system_submit_at(JobPriority_Background, (.function = test_jobs_ordered_, .parent = &root), order);
+        }
+        for (U32 at = 4u; at < 8u; ++at) {
+            TestJobsOrder order = {&clock, &stamps[at], 0, 0};
+            job_system_submit_at(JobPriority_Critical, (.function = test_jobs_ordered_, .parent = &root), order);
+        }
+        ATOMIC_STORE(&gate, 1u, MEMORY_ORDER_RELEASE);
+        test_jobs_poll_(&root);
+        job_system_wait(jobSystem, &root);
+
+        U64 latestCritical = stamps[8];
+        U64 earliestBackground = ~0ull;
+        for (U32 at = 0u; at < 4u; ++at) {
+            earliestBackground = MIN(earliestBackground, stamps[at]);
+            latestCritical = MAX(latestCritical, stamps[at + 4u]);
+            TEST_CHECK(priorities[at] == JobPriority_Background);
+        }
+        TEST_CHECK(latestCritical < earliestBackground);
+        TEST_CHECK(job_system_current_priority() == JobPriority_Critical);
+    }
+
+    // A running background job gives way at its checkpoints.
+    {
+        U64 started = 0u;
+        U64 criticalDone = 0u;
+        U64 sawCritical = 0u;
+        U64* donePtr = &criticalDone;
+        Job root = {};
+        TestJobsPreempt preempt = {&started, &criticalDone, &sawCritical};
+        job_system_submit_at(JobPriority_Background, (.function = test_jobs_preemptible_, .parent = &root), preempt);
+        while (ATOMIC_LOAD(&started, MEMORY_ORDER_ACQUIRE) == 0u) {
+            OS_thread_yield();
+        }
+        for (U32 at = 0u; at < 8u; ++at) {
+            job_system_submit_at(JobPriority_Critical, (.function = test_jobs_count_, .parent = &root), donePtr);
+        }
+        test_jobs_poll_(&root);
+        job_system_wait(jobSystem, &root);
+        TEST_CHECK(sawCritical == 8u);
+    }
+
+    // Stats are live: the main thread only polled, the worker ran it all.
+    TEST_CHECK(job_system_thread_count(jobSystem) == 2u);
+    JobSystemStats mainStats = job_system_stats(jobSystem, 0u);
+    JobSystemStats workerStats = job_system_stats(jobSystem, 1u);
+    TEST_CHECK(mainStats.executed[JobPriority_Critical] + mainStats.executed[JobPriority_Background] == 0u);
+    TEST_CHECK(workerStats.executed[JobPriority_Critical] == 5u + 8u);
+    TEST_CHECK(workerStats.executed[JobPriority_Background] == 4u + 1u);
+    TEST_CHECK(workerStats.steals != 0u && workerStats.stealAttempts >= workerStats.steals);
+    TEST_CHECK(mainStats.queueHighWater != 0u);
+    JobSystemStats totals = job_system_get_totals(jobSystem);
+    TEST_CHECK(totals.executed[JobPriority_Critical] == 5u + 8u);
+    TEST_CHECK(totals.preemptions != 0u);
+
+    // Both threads block in critical waits on background children: the
+    // worker inside a job, the main thread on its own. Neither may wait for
+    // the other to run them.
+    {
+        U64 started = 0u;
+        U64 leaves = 0u;
+        U64* leavesPtr = &leaves;
+        Job root = {};
+        TestJobsCriticalWaiter waiter = {jobSystem, &started, &leaves};
+        job_system_submit_at(JobPriority_Critical, (.function = test_jobs_critical_waiter_, .parent = &root), waiter);
+        while (ATOMIC_LOAD(&started, MEMORY_ORDER_ACQUIRE) == 0u) {
+            OS_thread_yield();
+        }
+        Job mainRoot = {};
+        for (U32 at = 0u; at < 4u; ++at) {
+            job_system_submit_at(JobPriority_Background, (.function = test_jobs_count_, .parent = &mainRoot), leavesPtr);
+        }
+        job_system_wait(jobSystem, &mainRoot);
+        job_system_wait(jobSystem, &root);
+        TEST_CHECK(leaves == 8u);
+    }
+
+    job_system_destroy(jobSystem);
+    arena_release(arena);
+}
+
+// Whatever the host reports, the topology must be self-consistent.
+static void test_jobs_topology_(void) {
+    const OS_SystemInfo* info = OS_get_system_info();
+    TEST_CHECK(info->coreCount != 0u && info->coreCount <= info->logicalCores);
+    TEST_CHECK(info->physicalCores != 0u && info->physicalCores <= info->coreCount);
+    TEST_CHECK(info->efficiencyCores <= info->coreCount);
+    for (U32 at = 0u; at < info->coreCount; ++at) {
+        const OS_CoreInfo* core = &info->cores[at];
+        TEST_CHECK(core->physicalCore < info->physicalCores);
+        TEST_CHECK(core->l2Group < info->coreCount && core->l3Group < info->coreCount);
+        for (U32 prior = 0u; prior < at; ++prior) {
+            TEST_CHECK(info->cores[prior].osIndex != core->osIndex);
+        }
+    }
+
+    // A hybrid part: 4 SMT-2 performance cores with private L2s, then a
+    // cluster of 4 efficiency cores sharing one L2; one L3 for all.
+    Temp scratch = get_scratch(0, 0);
+    OS_SystemInfo* hybrid = ARENA_PUSH_STRUCT(scratch.arena, OS_SystemInfo);
+    MEMSET(hybrid, 0, sizeof(*hybrid));
+    hybrid->logicalCores = 12u;
+    hybrid->coreCount = 12u;
+    for (U32 at = 0u; at < 12u; ++at) {
+        OS_CoreInfo* core = &hybrid->cores[at];
+        core->osIndex = at;
+        core->physicalCore = (at < 8u) ? at / 2u : at - 4u;
+        core->l2Group = (at < 8u) ? at / 2u : 4u;
+        core->kind = (at < 8u) ? OS_CoreKind_Performance : OS_CoreKind_Efficiency;
+    }
+    U32 coreOfThread[10];
+    job_system_place_threads_(hybrid, coreOfThread, 10u);
+    U32 expectedCores[10] = {0u, 2u, 4u, 6u, 1u, 3u, 5u, 7u, 8u, 9u};
+    for (U32 at = 0u; at < 10u; ++at) {
+        TEST_CHECK(coreOfThread[at] == expectedCores[at]);
+    }
+    JobVictimOrder* orders = job_system_build_victim_orders_(scratch.arena, hybrid, coreOfThread, 10u);
+    TEST_CHECK(orders[0].victims[0] == 4u && orders[0].ringEnd[0] == 1u);  // SMT sibling first
+    TEST_CHECK(orders[8].ringEnd[0] == 1u && orders[8].victims[0] == 9u);  // shared efficiency L2
+    TEST_CHECK(orders[0].ringEnd[JOB_SYSTEM_STEAL_TRIES - 1u] == 9u);
+    temp_end(&scratch);
+}
+
+static void test_jobs_(void) {
+    test_jobs_topology_();
+    test_jobs_run_(JobSystemFlags_None);
+    test_jobs_run_(JobSystemFlags_PinWorkers | JobSystemFlags_TopologySteal);
+    test_jobs_priorities_(JobSystemFlags_None);
+#if FIBER_SUPPORTED
+    test_jobs_run_(JobSystemFlags_Fibers);
+    test_jobs_priorities_(JobSystemFlags_Fibers);
+#endif
+}
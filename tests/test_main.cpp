@@ -15,6 +15,8 @@
 #include "nstl/os/core/windows/os_core_windows.hpp"
 #elif defined(PLATFORM_OS_MACOS)
 #include "nstl/os/core/macos/os_core_macos.hpp"
+#elif defined(PLATFORM_OS_LINUX)
+#include "nstl/os/core/linux/os_core_linux.hpp"
 #endif
 
 #include "nstl/os/core/os_core.cpp"
@@ -22,6 +24,8 @@
 #include "nstl/os/core/windows/os_core_windows.cpp"
 #elif defined(PLATFORM_OS_MACOS)
 #include "nstl/os/core/macos/os_core_macos.cpp"
+#elif defined(PLATFORM_OS_LINUX)
+#include "nstl/os/core/linux/os_core_linux.cpp"
 #endif
 #include "nstl/base/base_include.cpp"
 
@@ -44,6 +48,14 @@
 #include "nstl/ui/ui_include.hpp"
 #include "nstl/ui/ui_include.cpp"
 
+// Content store + artifact cache + file stream, CPU only.
+#include "nstl/content/content_include.hpp"
+#include "nstl/content/content_include.cpp"
+#include "nstl/artifact/artifact_include.hpp"
+#include "nstl/artifact/artifact_include.cpp"
+#include "nstl/file_stream/file_stream_include.hpp"
+#include "nstl/file_stream/file_stream_include.cpp"
+
 #include "engine/shaders/shader_records.generated.hpp"
 #include "engine/engine_sim.hpp"
 #include "engine/engine_world_kernels.hpp"
@@ -107,6 +119,9 @@ static Vec4F32 test_mul_point_(const Mat4x4F32* m, Vec3F32 p) {
 #include "test_game.cpp"
 #include "test_collision.cpp"
 #include "test_audio.cpp"
+#include "test_jobs.cpp"
+#include "test_cache.cpp"
+#include "test_file_stream.cpp"
 
 typedef void TestSuiteProc(void);
 
@@ -128,6 +143,9 @@ void entry_point(void) {
         {"game", test_game_},
         {"collision", test_collision_},
         {"audio", test_audio_},
+        {"jobs", test_jobs_},
+        {"cache", test_cache_},
+        {"file_stream", test_file_stream_},
     };
 
     for (U32 at = 0u; at < (U32)(sizeof(suites) / sizeof(suites[0])); ++at) {
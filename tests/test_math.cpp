@@ -84,4 +84,89 @@ static void test_math_(void) {
     TEST_CHECK(above.y / above.w > 0.0f);
     Vec4F32 worldRight = test_mul_point_(&level, test_vec3_(1.0f, 0.0f, 0.0f));
     TEST_CHECK(worldRight.x / worldRight.w < 0.0f);
+
+    // The SIMD forms against their scalar twins: same evaluation order, and
+    // the build turns FP contraction off, so they agree bit for bit.
+    Mat4x4F32 a = vp;
+    Mat4x4F32 b = mat4_translate(test_vec3_(0.5f, -3.0f, 2.0f)) * mat4_scale(test_vec3_(2.0f, 0.25f, 1.5f));
+    b.v[0][1] = 0.75f;
+    b.v[2][3] = -0.125f;
+    Mat4x4F32 ab = mat4_mul(a, b);
+    Mat4x4F32 abExact = mat4_mul_exact(a, b);
+    Mat4x4F32 at = mat4_transpose(a);
+    F32 matrixError = 0.0f;
+    F32 transposeError = 0.0f;
+    for (U32 row = 0u; row < 4u; ++row) {
+        for (U32 col = 0u; col < 4u; ++col) {
+            matrixError = MAX(matrixError, test_abs_(ab.v[row][col] - abExact.v[row][col]));
+            transposeError = MAX(transposeError, test_abs_(at.v[row][col] - a.v[col][row]));
+        }
+    }
+    TEST_CHECK(matrixError == 0.0f);
+    TEST_CHECK(transposeError == 0.0f);
+
+    Vec4F32 probe;
+    probe.x = 1.5f;
+    probe.y = -2.0f;
+    probe.z = 7.25f;
+    probe.w = 1.0f;
+    Vec4F32 column = mat4_mul_vec4(b, probe);
+    Vec4F32 columnExact = mat4_mul_vec4_exact(b, probe);
+    Vec4F32 rowVector = vec4_mul_mat4(probe, a);
+    Vec4F32 rowVectorExact = vec4_mul_mat4_exact(probe, a);
+    for (U32 lane = 0u; lane < 4u; ++lane) {
+        TEST_CHECK(column.v[lane] == columnExact.v[lane]);
+        TEST_CHECK(rowVector.v[lane] == rowVectorExact.v[lane]);
+    }
+    Vec3F32 point = mat4_transform_point(b, test_vec3_(1.5f, -2.0f, 7.25f));
+    Vec3F32 pointExact = mat4_transform_point_exact(b, test_vec3_(1.5f, -2.0f, 7.25f));
+    TEST_CHECK(point.x == pointExact.x && point.y == pointExact.y && point.z == pointExact.z);
+
+    QuatF32 qa = quat_from_axis_angle(test_vec3_(0.0f, 1.0f, 0.0f), 0.7f);
+    QuatF32 qb = quat_from_axis_angle(vec3_normalize(test_vec3_(1.0f, -2.0f, 0.5f)), -1.3f);
+    QuatF32 qab = quat_mul(qa, qb);
+    QuatF32 qabExact = quat_mul_exact(qa, qb);
+    for (U32 lane = 0u; lane < 4u; ++lane) {
+        TEST_CHECK(qab.v[lane] == qabExact.v[lane]);
+    }
+    Vec3F32 spun = quat_rotate(qab, test_vec3_(3.0f, -1.0f, 2.0f));
+    Vec3F32 spunExact = quat_rotate_exact(qab, test_vec3_(3.0f, -1.0f, 2.0f));
+    TEST_CHECK(spun.x == spunExact.x && spun.y == spunExact.y && spun.z == spunExact.z);
+    // And the rotation is the one quat_to_mat4 applies under v·M.
+    Vec3F32 viaMatrix = mat4_transform_point(quat_to_mat4(qab), test_vec3_(3.0f, -1.0f, 2.0f));
+    TEST_CHECK_NEAR(spun.x, viaMatrix.x, 1e-4f);
+    TEST_CHECK_NEAR(spun.y, viaMatrix.y, 1e-4f);
+    TEST_CHECK_NEAR(spun.z, viaMatrix.z, 1e-4f);
+
+    // SoA transform: thirteen points take the eight-wide, four-wide and
+    // scalar tail paths, each against the exact point transform.
+    F32 xs[13];
+    F32 ys[13];
+    F32 zs[13];
+    for (U32 at = 0u; at < 13u; ++at) {
+        xs[at] = (F32)at * 0.75f - 4.0f;
+        ys[at] = 3.0f - (F32)at * 0.5f;
+        zs[at] = (F32)(at * at) * 0.125f;
+    }
+    F32 outX[13];
+    F32 outY[13];
+    F32 outZ[13];
+    mat4_transform_points_soa(b, xs, ys, zs, outX, outY, outZ, 13u);
+    F32 soaError = 0.0f;
+    for (U32 at = 0u; at < 13u; ++at) {
+        Vec3F32 expected = mat4_transform_point_exact(b, test_vec3_(xs[at], ys[at], zs[at]));
+        soaError = MAX(soaError, test_abs_(outX[at] - expected.x));
+        soaError = MAX(soaError, test_abs_(outY[at] - expected.y));
+        soaError = MAX(soaError, test_abs_(outZ[at] - expected.z));
+    }
+    TEST_CHECK(soaError == 0.0f);
+
+    // Masks: select picks per lane, bits follow lane order.
+    F32x4 low = f32x4_set(1.0f, 5.0f, -2.0f, 8.0f);
+    F32x4 high = f32x4_set1(4.0f);
+    M32x4 below = f32x4_lt(low, high);
+    TEST_CHECK(m32x4_bits(below) == 0x5u);
+    F32 picked[4];
+    f32x4_store(picked, f32x4_select(below, low, high));
+    TEST_CHECK(picked[0] == 1.0f && picked[1] == 4.0f && picked[2] == -2.0f && picked[3] == 4.0f);
 }